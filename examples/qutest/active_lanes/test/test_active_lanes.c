@@ -0,0 +1,199 @@
+/*****************************************************************************
+* Purpose: priority lanes QUTEST fixture
+* Last Updated for Version: 6.9.1
+* Date of the Last Update:  2026-10-16
+*
+*                    Q u a n t u m  L e a P s
+*                    ------------------------
+*                    Modern Embedded Software
+*
+* Copyright (C) 2005-2020 Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <www.gnu.org/licenses/>.
+*
+* Contact information:
+* <www.state-machine.com/licensing>
+* <info@state-machine.com>
+*****************************************************************************/
+#include "qpc.h" /* QUTest interface */
+
+Q_DEFINE_THIS_FILE
+
+/*..........................................................................*/
+enum {
+    N_LANES   = QF_ACTIVE_LANES, /* the lanes of the event queue */
+    QUEUE_LEN = 8U, /* the length of the lane 0 (the regular event queue) */
+    LANE_LEN  = 4U  /* the length of the higher lanes */
+};
+
+enum TestSignals {
+    WORK_SIG = Q_USER_SIG,
+    MAX_SIG
+};
+
+typedef struct {
+    QEvt super;
+    uint8_t lane; /* the lane the event was posted to */
+    uint8_t seq;  /* the sequence number of the event in its lane */
+} WorkEvt;
+
+typedef struct {
+    QActive super;
+} Worker;
+
+static QState Worker_initial(Worker * const me, QEvt const * const e);
+static QState Worker_active (Worker * const me, QEvt const * const e);
+
+static Worker l_worker;
+static uint8_t const l_fixture = 0U; /* QS sender of the posted events */
+static uint8_t l_seq[N_LANES]; /* the next sequence number in each lane */
+
+enum {
+    RECV = QS_USER, /* the Worker received event 'seq' posted to 'lane' */
+    POSTED          /* the number of the events posted */
+};
+
+enum {
+    POST_SEQ = 0 /* post up to 'param2' events to the lanes given by the
+                 * hex digits of 'param1' (the lowest digit first),
+                 * with the margin 'param3' */
+};
+
+/*..........................................................................*/
+int main(int argc, char *argv[]) {
+    static QF_MPOOL_EL(WorkEvt) smlPoolSto[QUEUE_LEN + 2U * LANE_LEN];
+    static QEvt const *workerQueueSto[QUEUE_LEN];
+    static QEvt const *workerLaneSto[N_LANES - 1][LANE_LEN];
+    uint_fast8_t lane;
+
+    QF_init();   /* initialize the framework */
+
+    /* initialize the QS software tracing */
+    Q_ALLEGE(QS_INIT(argc > 1 ? argv[1] : (void *)0));
+
+    /* object dictionaries... */
+    QS_OBJ_DICTIONARY(&l_worker);
+    QS_OBJ_DICTIONARY(&l_fixture);
+
+    QS_TEST_PAUSE();
+
+    /* initialize event pools... */
+    QF_poolInit(smlPoolSto, sizeof(smlPoolSto), sizeof(smlPoolSto[0]));
+
+    /* start active objects... */
+    QActive_ctor(&l_worker.super, Q_STATE_CAST(&Worker_initial));
+    for (lane = 1U; lane < N_LANES; ++lane) {
+        QActive_setLane(&l_worker.super, lane,
+                        workerLaneSto[lane - 1U], LANE_LEN);
+    }
+    QACTIVE_START(&l_worker.super,        /* AO to start */
+                  (uint_fast8_t)1,        /* QP priority of the AO */
+                  workerQueueSto,         /* event queue storage */
+                  Q_DIM(workerQueueSto),  /* queue length [events] */
+                  (void *)0,              /* stack storage (not used) */
+                  0U,                     /* size of the stack [bytes] */
+                  (QEvt *)0);             /* initialization event */
+
+    return QF_run(); /* run the QF application */
+}
+
+/*..........................................................................*/
+static QState Worker_initial(Worker * const me, QEvt const * const e) {
+    (void)me; /* unused parameter */
+    (void)e;  /* unused parameter */
+    return Q_TRAN(&Worker_active);
+}
+/*..........................................................................*/
+static QState Worker_active(Worker * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case WORK_SIG: {
+            QS_BEGIN_ID(RECV, me->super.prio) /* app-specific record */
+                QS_U8(0, Q_EVT_CAST(WorkEvt)->lane);
+                QS_U8(0, Q_EVT_CAST(WorkEvt)->seq);
+            QS_END()
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status_;
+}
+
+/*--------------------------------------------------------------------------*/
+void QS_onTestSetup(void) {
+    QS_USR_DICTIONARY(RECV);
+    QS_USR_DICTIONARY(POSTED);
+    QS_USR_DICTIONARY(POST_SEQ);
+}
+/*..........................................................................*/
+void QS_onTestTeardown(void) {
+}
+
+/*..........................................................................*/
+/*! callback function to execute user commands */
+void QS_onCommand(uint8_t cmdId,
+                  uint32_t param1, uint32_t param2, uint32_t param3)
+{
+    switch (cmdId) {
+        case POST_SEQ: {
+            uint32_t n = 0U;
+            for (; param2 > 0U; --param2) {
+                uint8_t const lane = (uint8_t)(param1 & 0xFU);
+                WorkEvt *we = Q_NEW(WorkEvt, WORK_SIG);
+                we->lane = lane;
+                we->seq  = l_seq[lane % N_LANES];
+                if (QACTIVE_POST_LANE_X(&l_worker, &we->super, lane,
+                                        (uint_fast16_t)param3, &l_fixture))
+                {
+                    ++l_seq[lane % N_LANES];
+                    ++n;
+                }
+                param1 >>= 4U;
+            }
+            QS_BEGIN_ID(POSTED, 0U) /* app-specific record */
+                QS_U32(0, n);
+            QS_END()
+            break;
+        }
+        default:
+            break;
+    }
+}
+/*..........................................................................*/
+/*! callback function to "massage" the injected QP events (not used here) */
+void QS_onTestEvt(QEvt *e) {
+    (void)e;
+#ifdef Q_HOST  /* is this test compiled for a desktop Host computer? */
+#else /* embedded Target */
+#endif /* embedded Target */
+}
+/*..........................................................................*/
+/*! callback function to output the posted QP events (not used here) */
+void QS_onTestPost(void const *sender, QActive *recipient,
+                   QEvt const *e, bool status)
+{
+    (void)sender;
+    (void)recipient;
+    (void)e;
+    (void)status;
+}
@@ -0,0 +1,61 @@
+# test-script for QUTest unit testing harness
+# see https://www.state-machine.com/qtools/html
+
+# preamble...
+def on_reset():
+    expect_pause()
+    glb_filter(GRP_UA)
+    continue_test()
+    expect_run()
+
+# the Worker AO has the lane 0 (its regular event queue) of 8 events and
+# the higher lanes 1 and 2 of 4 events each. POST_SEQ posts the events to
+# the lanes given by the hex digits of its first parameter, the lowest
+# digit first, and then the Worker processes them all
+# (see test_active_lanes.c)
+
+# tests...
+test("Deliver the events from the higher lanes first")
+command("POST_SEQ", 0x2100, 4)
+expect("@timestamp POSTED 4")
+# the first event takes the front of the empty queue
+expect("@timestamp RECV 0 0")
+expect("@timestamp RECV 2 0")
+expect("@timestamp RECV 1 0")
+expect("@timestamp RECV 0 1")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+
+test("Keep the FIFO order within each lane")
+command("POST_SEQ", 0x1212121, 7)
+expect("@timestamp POSTED 7")
+expect("@timestamp RECV 1 0")
+expect("@timestamp RECV 2 0")
+expect("@timestamp RECV 2 1")
+expect("@timestamp RECV 2 2")
+expect("@timestamp RECV 1 1")
+expect("@timestamp RECV 1 2")
+expect("@timestamp RECV 1 3")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+
+test("Reject the events beyond the margin of a lane")
+command("POST_SEQ", 0x11111111, 8)
+expect("@timestamp POSTED 5")
+expect("@timestamp RECV 1 0")
+expect("@timestamp RECV 1 1")
+expect("@timestamp RECV 1 2")
+expect("@timestamp RECV 1 3")
+expect("@timestamp RECV 1 4")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+# the lane 0 is not affected by the full lane 1
+command("POST_SEQ", 0x00000, 5, 3)
+expect("@timestamp POSTED 5")
+expect("@timestamp RECV 0 0")
+expect("@timestamp RECV 0 1")
+expect("@timestamp RECV 0 2")
+expect("@timestamp RECV 0 3")
+expect("@timestamp RECV 0 4")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+
+test("Post to a lane out of range")
+command("POST_SEQ", 0x3, 1)
+expect("@timestamp =ASSERT= Mod=qf_actq,Loc=510")
@@ -0,0 +1,179 @@
+/*****************************************************************************
+* Purpose: event magazines QUTEST fixture
+* Last Updated for Version: 6.9.1
+* Date of the Last Update:  2026-10-16
+*
+*                    Q u a n t u m  L e a P s
+*                    ------------------------
+*                    Modern Embedded Software
+*
+* Copyright (C) 2005-2020 Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <www.gnu.org/licenses/>.
+*
+* Contact information:
+* <www.state-machine.com/licensing>
+* <info@state-machine.com>
+*****************************************************************************/
+#include "qpc.h" /* QUTest interface */
+
+Q_DEFINE_THIS_FILE
+
+/*..........................................................................*/
+enum {
+    POOL_LEN = 8U /* the number of events in the pool */
+};
+
+static QEvt const *l_evts[POOL_LEN]; /* the allocated events */
+static uint32_t l_nEvts; /* the number of the allocated events */
+
+enum {
+    ALLOC = QS_USER, /* the number of the events just allocated */
+    FREE,            /* the number of the events still allocated */
+    MIN              /* the minimum of the free events in the pool */
+};
+
+enum {
+    NEW_EVTS = 0, /* allocate 'param1' events through the magazine */
+    NEW_X_EVTS,   /* allocate up to 'param1' events from the shared pool */
+    FREE_EVTS,    /* free 'param1' events, the latest allocated first */
+    FLUSH,        /* flush the magazine back to the shared pool */
+    GET_MIN       /* report the minimum of the free events in the pool */
+};
+
+/*..........................................................................*/
+int main(int argc, char *argv[]) {
+    static QF_MPOOL_EL(QEvt) smlPoolSto[POOL_LEN];
+
+    QF_init();   /* initialize the framework */
+
+    /* initialize the QS software tracing */
+    Q_ALLEGE(QS_INIT(argc > 1 ? argv[1] : (void *)0));
+
+    QS_TEST_PAUSE();
+
+    /* initialize event pools... */
+    QF_poolInit(smlPoolSto, sizeof(smlPoolSto), sizeof(smlPoolSto[0]));
+
+    return QF_run(); /* run the QF application */
+}
+
+/*--------------------------------------------------------------------------*/
+void QS_onTestSetup(void) {
+    QS_USR_DICTIONARY(ALLOC);
+    QS_USR_DICTIONARY(FREE);
+    QS_USR_DICTIONARY(MIN);
+    QS_USR_DICTIONARY(NEW_EVTS);
+    QS_USR_DICTIONARY(NEW_X_EVTS);
+    QS_USR_DICTIONARY(FREE_EVTS);
+    QS_USR_DICTIONARY(FLUSH);
+    QS_USR_DICTIONARY(GET_MIN);
+}
+/*..........................................................................*/
+void QS_onTestTeardown(void) {
+    /* free all events, so that every test starts with the same pool */
+    while (l_nEvts > 0U) {
+        --l_nEvts;
+        QF_gc(l_evts[l_nEvts]);
+    }
+    QF_magazineFlush();
+}
+
+/*..........................................................................*/
+/*! callback function to execute user commands */
+void QS_onCommand(uint8_t cmdId,
+                  uint32_t param1, uint32_t param2, uint32_t param3)
+{
+    uint32_t n = 0U;
+
+    (void)param2; /* unused parameter */
+    (void)param3; /* unused parameter */
+
+    switch (cmdId) {
+        case NEW_EVTS: {
+            /* Q_NEW() takes the events from the magazine (and asserts
+            * when both the magazine and the shared pool are empty)
+            */
+            for (; (n < param1) && (l_nEvts < Q_DIM(l_evts)); ++n) {
+                l_evts[l_nEvts] = Q_NEW(QEvt, Q_USER_SIG);
+                ++l_nEvts;
+            }
+            QS_BEGIN_ID(ALLOC, 0U) /* app-specific record */
+                QS_U32(0, n);
+            QS_END()
+            break;
+        }
+        case NEW_X_EVTS: {
+            /* the allocations with a margin bypass the magazine */
+            for (; (n < param1) && (l_nEvts < Q_DIM(l_evts)); ++n) {
+                QEvt *e;
+                Q_NEW_X(e, QEvt, 0U, Q_USER_SIG); /* margin 0, may fail */
+                if (e == (QEvt *)0) {
+                    break;
+                }
+                l_evts[l_nEvts] = e;
+                ++l_nEvts;
+            }
+            QS_BEGIN_ID(ALLOC, 0U) /* app-specific record */
+                QS_U32(0, n);
+            QS_END()
+            break;
+        }
+        case FREE_EVTS: {
+            for (; (n < param1) && (l_nEvts > 0U); ++n) {
+                --l_nEvts;
+                QF_gc(l_evts[l_nEvts]);
+            }
+            QS_BEGIN_ID(FREE, 0U) /* app-specific record */
+                QS_U32(0, l_nEvts);
+            QS_END()
+            break;
+        }
+        case FLUSH: {
+            QF_magazineFlush();
+            break;
+        }
+        case GET_MIN: {
+            QS_BEGIN_ID(MIN, 0U) /* app-specific record */
+                QS_U32(0, QF_getPoolMin(1U));
+            QS_END()
+            break;
+        }
+        default:
+            break;
+    }
+}
+/*..........................................................................*/
+/*! callback function to "massage" the injected QP events (not used here) */
+void QS_onTestEvt(QEvt *e) {
+    (void)e;
+#ifdef Q_HOST  /* is this test compiled for a desktop Host computer? */
+#else /* embedded Target */
+#endif /* embedded Target */
+}
+/*..........................................................................*/
+/*! callback function to output the posted QP events (not used here) */
+void QS_onTestPost(void const *sender, QActive *recipient,
+                   QEvt const *e, bool status)
+{
+    (void)sender;
+    (void)recipient;
+    (void)e;
+    (void)status;
+}
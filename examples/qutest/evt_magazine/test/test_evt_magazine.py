@@ -0,0 +1,70 @@
+# test-script for QUTest unit testing harness
+# see https://www.state-machine.com/qtools/html
+
+# preamble...
+def on_reset():
+    expect_pause()
+    glb_filter(GRP_UA)
+    continue_test()
+    expect_run()
+
+# the pool has 8 events and the magazine caches up to 4 of them, it is
+# refilled from (and flushed to) the shared pool by 2 events at a time
+# (see test_evt_magazine.c)
+
+# tests...
+test("Refill the empty magazine by half")
+command("NEW_EVTS", 1)
+expect("@timestamp ALLOC 1")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("GET_MIN")
+expect("@timestamp MIN 6")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+# the second event comes from the magazine
+command("NEW_EVTS", 1)
+expect("@timestamp ALLOC 1")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("GET_MIN")
+expect("@timestamp MIN 6")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("NEW_EVTS", 1)
+expect("@timestamp ALLOC 1")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("GET_MIN")
+expect("@timestamp MIN 4")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+
+test("Keep the recycled events in the magazine")
+command("NEW_EVTS", 3)
+expect("@timestamp ALLOC 3")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("FREE_EVTS", 3)
+expect("@timestamp FREE 0")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+# the 4 events cached in the magazine are not in the shared pool
+command("NEW_X_EVTS", 8)
+expect("@timestamp ALLOC 4")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("FREE_EVTS", 4)
+expect("@timestamp FREE 0")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("FLUSH")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("NEW_X_EVTS", 8)
+expect("@timestamp ALLOC 8")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+
+test("Flush the full magazine by half")
+command("NEW_EVTS", 8)
+expect("@timestamp ALLOC 8")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("GET_MIN")
+expect("@timestamp MIN 0")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+# the magazine keeps at most 4 of the recycled events
+command("FREE_EVTS", 8)
+expect("@timestamp FREE 0")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("NEW_X_EVTS", 8)
+expect("@timestamp ALLOC 4")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
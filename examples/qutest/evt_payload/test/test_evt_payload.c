@@ -0,0 +1,258 @@
+/*****************************************************************************
+* Purpose: zero-copy payload events QUTEST fixture
+* Last Updated for Version: 6.9.1
+* Date of the Last Update:  2026-10-16
+*
+*                    Q u a n t u m  L e a P s
+*                    ------------------------
+*                    Modern Embedded Software
+*
+* Copyright (C) 2005-2020 Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <www.gnu.org/licenses/>.
+*
+* Contact information:
+* <www.state-machine.com/licensing>
+* <info@state-machine.com>
+*****************************************************************************/
+#include "qpc.h" /* QUTest interface */
+
+Q_DEFINE_THIS_FILE
+
+/*..........................................................................*/
+enum {
+    N_READERS   = 2U,  /* the number of the reader AOs */
+    N_FRAMES    = 2U,  /* the number of the external frame buffers */
+    FRAME_LEN   = 64U, /* the size of the frame buffers [bytes] */
+    PAYLOAD_LEN = 2U   /* the number of events in the payload pool */
+};
+
+enum TestSignals {
+    FRAME_SIG = Q_USER_SIG, /* carries a frame as the external payload */
+    MAX_PUB_SIG
+};
+
+typedef struct {
+    QActive super;
+} Reader;
+
+static QState Reader_initial(Reader * const me, QEvt const * const e);
+static QState Reader_active (Reader * const me, QEvt const * const e);
+
+static void releaseFrame(QPayload * const payload);
+
+static Reader l_readers[N_READERS];
+static uint8_t l_frameBuf[N_FRAMES][FRAME_LEN]; /* the external buffers */
+static QPayload l_frames[N_FRAMES]; /* the payloads of the frame buffers */
+static uint8_t const l_fixture = 0U; /* QS sender of the events */
+
+enum {
+    RECV = QS_USER, /* reader 'prio' received the frame 'idx' of 'len' */
+    POSTED,         /* the number of the events just posted */
+    RELEASED        /* the frame 'idx' has been released */
+};
+
+enum {
+    LOAD = 0, /* fill the frame 'param1' with 'param2' bytes */
+    CHAIN,    /* chain the frame 'param2' after the frame 'param1' */
+    PUBLISH,  /* publish the frame 'param1' to all readers */
+    POST,     /* post the frame 'param1' to reader 1 in 'param2' events */
+    HOLD,     /* add a reference to the frame 'param1' */
+    DROP      /* release a reference to the frame 'param1' */
+};
+
+/*..........................................................................*/
+int main(int argc, char *argv[]) {
+    static QSubscrList subscrSto[MAX_PUB_SIG];
+    static QF_MPOOL_EL(QPayloadEvt) payloadPoolSto[PAYLOAD_LEN];
+    static QEvt const *readerQueueSto[N_READERS][4];
+    uint_fast8_t n;
+
+    QF_init();   /* initialize the framework */
+
+    /* initialize the QS software tracing */
+    Q_ALLEGE(QS_INIT(argc > 1 ? argv[1] : (void *)0));
+
+    /* object dictionaries... */
+    QS_OBJ_DICTIONARY(&l_fixture);
+
+    QS_TEST_PAUSE();
+
+    /* initialize publish-subscribe... */
+    QF_psInit(subscrSto, Q_DIM(subscrSto));
+
+    /* initialize event pools... */
+    QF_payloadPoolInit(payloadPoolSto, sizeof(payloadPoolSto),
+                       sizeof(payloadPoolSto[0]));
+
+    /* start active objects... */
+    for (n = 0U; n < N_READERS; ++n) {
+        QActive_ctor(&l_readers[n].super, Q_STATE_CAST(&Reader_initial));
+        QACTIVE_START(&l_readers[n].super, /* AO to start */
+                      (uint_fast8_t)(n + 1U),  /* QP priority of the AO */
+                      readerQueueSto[n],       /* event queue storage */
+                      Q_DIM(readerQueueSto[n]),/* queue length [events] */
+                      (void *)0,               /* stack storage (not used) */
+                      0U,                      /* size of the stack [bytes] */
+                      (QEvt *)0);              /* initialization event */
+    }
+
+    return QF_run(); /* run the QF application */
+}
+
+/*..........................................................................*/
+static QState Reader_initial(Reader * const me, QEvt const * const e) {
+    (void)e; /* unused parameter */
+    QActive_subscribe(&me->super, FRAME_SIG);
+    return Q_TRAN(&Reader_active);
+}
+/*..........................................................................*/
+static QState Reader_active(Reader * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case FRAME_SIG: {
+            QPayload const *p = Q_EVT_CAST(QPayloadEvt)->payload;
+            uint32_t len = 0U;
+            uint_fast8_t const idx = (uint_fast8_t)(p - &l_frames[0]);
+
+            /* the payload refers to the frame buffer itself (no copy) */
+            Q_ASSERT(p->buf == &l_frameBuf[idx][0]);
+
+            for (; p != (QPayload *)0; p = p->next) { /* whole chain */
+                len += p->len;
+            }
+            QS_BEGIN_ID(RECV, 0U) /* app-specific record */
+                QS_U8(0, me->super.prio);
+                QS_U8(0, idx);
+                QS_U32(0, len);
+            QS_END()
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status_;
+}
+
+/*..........................................................................*/
+/* the release handler of the frames, releases the whole chain */
+static void releaseFrame(QPayload * const payload) {
+    QPayload *p;
+    for (p = payload; p != (QPayload *)0; p = p->next) {
+        QS_BEGIN_ID(RELEASED, 0U) /* app-specific record */
+            QS_U8(0, (uint8_t)(p - &l_frames[0]));
+        QS_END()
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+void QS_onTestSetup(void) {
+    QS_USR_DICTIONARY(RECV);
+    QS_USR_DICTIONARY(POSTED);
+    QS_USR_DICTIONARY(RELEASED);
+    QS_USR_DICTIONARY(LOAD);
+    QS_USR_DICTIONARY(CHAIN);
+    QS_USR_DICTIONARY(PUBLISH);
+    QS_USR_DICTIONARY(POST);
+    QS_USR_DICTIONARY(HOLD);
+    QS_USR_DICTIONARY(DROP);
+}
+/*..........................................................................*/
+void QS_onTestTeardown(void) {
+}
+
+/*..........................................................................*/
+/*! callback function to execute user commands */
+void QS_onCommand(uint8_t cmdId,
+                  uint32_t param1, uint32_t param2, uint32_t param3)
+{
+    QPayload * const frame = &l_frames[param1 % N_FRAMES];
+
+    (void)param3; /* unused parameter */
+
+    switch (cmdId) {
+        case LOAD: {
+            uint32_t i;
+            for (i = 0U; (i < param2) && (i < FRAME_LEN); ++i) {
+                l_frameBuf[param1 % N_FRAMES][i] = (uint8_t)i;
+            }
+            QPayload_ctor(frame, &l_frameBuf[param1 % N_FRAMES][0], i,
+                          &releaseFrame);
+            break;
+        }
+        case CHAIN: {
+            frame->next = &l_frames[param2 % N_FRAMES];
+            break;
+        }
+        case PUBLISH: {
+            QPayloadEvt *pe = Q_NEW_PAYLOAD(QPayloadEvt, FRAME_SIG, frame);
+            QF_PUBLISH(&pe->super, &l_fixture);
+            break;
+        }
+        case POST: {
+            uint32_t n;
+            /* keep the frame alive while attaching it to the events */
+            QPayload_addRef(frame);
+            for (n = 0U; n < param2; ++n) {
+                QPayloadEvt *pe;
+                Q_NEW_PAYLOAD_X(pe, QPayloadEvt, 0U, FRAME_SIG, frame);
+                if (pe == (QPayloadEvt *)0) { /* the payload pool empty? */
+                    break;
+                }
+                QACTIVE_POST(&l_readers[0].super, &pe->super, &l_fixture);
+            }
+            QS_BEGIN_ID(POSTED, 0U) /* app-specific record */
+                QS_U32(0, n);
+            QS_END()
+            QPayload_release(frame);
+            break;
+        }
+        case HOLD: {
+            QPayload_addRef(frame);
+            break;
+        }
+        case DROP: {
+            QPayload_release(frame);
+            break;
+        }
+        default:
+            break;
+    }
+}
+/*..........................................................................*/
+/*! callback function to "massage" the injected QP events (not used here) */
+void QS_onTestEvt(QEvt *e) {
+    (void)e;
+#ifdef Q_HOST  /* is this test compiled for a desktop Host computer? */
+#else /* embedded Target */
+#endif /* embedded Target */
+}
+/*..........................................................................*/
+/*! callback function to output the posted QP events (not used here) */
+void QS_onTestPost(void const *sender, QActive *recipient,
+                   QEvt const *e, bool status)
+{
+    (void)sender;
+    (void)recipient;
+    (void)e;
+    (void)status;
+}
@@ -0,0 +1,74 @@
+# test-script for QUTest unit testing harness
+# see https://www.state-machine.com/qtools/html
+
+# preamble...
+def on_reset():
+    expect_pause()
+    glb_filter(GRP_UA)
+    continue_test()
+    expect_run()
+
+# two readers (priorities 1 and 2) subscribe to the frames, the frames 0
+# and 1 are external buffers and the payload pool has 2 events
+# (see test_evt_payload.c)
+
+# tests...
+test("Publish a frame without copying it")
+command("LOAD", 0, 48)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("PUBLISH", 0)
+expect("@timestamp RECV 2 0 48")
+expect("@timestamp RECV 1 0 48")
+expect("@timestamp RELEASED 0")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+
+test("Release the frame after the last of several events")
+command("LOAD", 1, 16)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+# the payload pool has only 2 events
+command("POST", 1, 3)
+expect("@timestamp POSTED 2")
+expect("@timestamp RECV 1 1 16")
+expect("@timestamp RECV 1 1 16")
+expect("@timestamp RELEASED 1")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+# the events of the payload pool have been recycled
+command("POST", 1, 2)
+expect("@timestamp POSTED 2")
+expect("@timestamp RECV 1 1 16")
+expect("@timestamp RECV 1 1 16")
+expect("@timestamp RELEASED 1")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+
+test("Keep the frame alive with an extra reference")
+command("LOAD", 0, 8)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("HOLD", 0)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("PUBLISH", 0)
+expect("@timestamp RECV 2 0 8")
+expect("@timestamp RECV 1 0 8")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("DROP", 0)
+expect("@timestamp RELEASED 0")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+
+test("Release a scatter/gather chain of frames at once")
+command("LOAD", 0, 64)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("LOAD", 1, 32)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("CHAIN", 0, 1)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("PUBLISH", 0)
+expect("@timestamp RECV 2 0 96")
+expect("@timestamp RECV 1 0 96")
+expect("@timestamp RELEASED 0")
+expect("@timestamp RELEASED 1")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+
+test("Assert on releasing the unreferenced frame")
+command("LOAD", 1, 4)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("DROP", 1)
+expect("@timestamp =ASSERT= Mod=qf_dyn,Loc=900")
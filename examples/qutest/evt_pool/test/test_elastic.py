@@ -0,0 +1,74 @@
+# test-script for QUTest unit testing harness
+# see https://www.state-machine.com/qtools/html
+
+# preamble...
+def on_reset():
+    expect_pause()
+    glb_filter(GRP_UA)
+    continue_test()
+    expect_run()
+
+# the pool starts with 4 events, grows by 4 events when only 1 event is free
+# and cannot grow beyond 12 events (see test_evt_pool.c)
+
+# tests...
+test("Grow the pool up to the maximum")
+command("ALLOC_EVTS", 20)
+expect("@timestamp ALLOC 12")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("FREE_EVTS", 20)
+expect("@timestamp FREE 0")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+# release all events grown beyond the initial 4, but not more
+command("TRIM_POOL")
+expect("@timestamp TRIM 8")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("TRIM_POOL")
+expect("@timestamp TRIM 0")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+# the trimmed pool grows again
+command("ALLOC_EVTS", 20)
+expect("@timestamp ALLOC 12")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+
+test("Keep the grown events in use")
+command("ALLOC_EVTS", 6)
+expect("@timestamp ALLOC 6")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("TRIM_POOL")
+expect("@timestamp TRIM 0")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+# the events still in use in the grown part of the pool
+command("FREE_EVTS", 1)
+expect("@timestamp FREE 5")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("TRIM_POOL")
+expect("@timestamp TRIM 0")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("FREE_EVTS", 5)
+expect("@timestamp FREE 0")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("TRIM_POOL")
+expect("@timestamp TRIM 4")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+
+test("Shrink the pool in steps")
+command("ALLOC_EVTS", 4)
+expect("@timestamp ALLOC 4")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("ALLOC_EVTS", 4)
+expect("@timestamp ALLOC 4")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+# the events in the last step of the growth are free
+command("FREE_EVTS", 4)
+expect("@timestamp FREE 4")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("TRIM_POOL")
+expect("@timestamp TRIM 4")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("FREE_EVTS", 4)
+expect("@timestamp FREE 0")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("TRIM_POOL")
+expect("@timestamp TRIM 4")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
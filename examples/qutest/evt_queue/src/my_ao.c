@@ -0,0 +1,98 @@
+#include "qpc.h"
+#include "my_app.h"
+
+//Q_DEFINE_THIS_FILE
+
+/* MyAO declaration --------------------------------------------------------*/
+typedef struct {
+    QActive super;
+
+/* private: */
+    QEQueue deferredQueue;
+    QEvt const *deferredQSto[4];
+} MyAO;
+
+/* protected: */
+static QState MyAO_initial(MyAO * const me, QEvt const * const e);
+static QState MyAO_busy(MyAO * const me, QEvt const * const e);
+static QState MyAO_idle(MyAO * const me, QEvt const * const e);
+
+/* Local objects -----------------------------------------------------------*/
+static MyAO l_MyAO; /* the single instance of the MyAO active object */
+
+/* Global-scope objects ----------------------------------------------------*/
+QActive * const AO_MyAO = &l_MyAO.super; /* "opaque" AO pointer */
+
+/* MyAO_ctor ...............................................................*/
+void MyAO_ctor(void) {
+    MyAO *me = &l_MyAO;
+    QActive_ctor(&me->super, Q_STATE_CAST(&MyAO_initial));
+    QEQueue_init(&me->deferredQueue,
+                 me->deferredQSto, Q_DIM(me->deferredQSto));
+}
+
+/* MyAO::SM ................................................................*/
+static QState MyAO_initial(MyAO * const me, QEvt const * const e) {
+    (void)e; /* unused parameter */
+
+    QS_OBJ_DICTIONARY(&l_MyAO.deferredQueue);
+
+    QS_FUN_DICTIONARY(&QHsm_top);
+    QS_FUN_DICTIONARY(&MyAO_initial);
+    QS_FUN_DICTIONARY(&MyAO_busy);
+    QS_FUN_DICTIONARY(&MyAO_idle);
+
+    QS_SIG_DICTIONARY(WORK_SIG, (void *)0);
+    QS_SIG_DICTIONARY(DONE_SIG, (void *)0);
+
+    return Q_TRAN(&MyAO_busy);
+}
+/*${AOs::MyAO::SM::busy} ..................................................*/
+static QState MyAO_busy(MyAO * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case WORK_SIG: {
+            if (QActive_defer(&me->super, &me->deferredQueue, e)) {
+                QS_BEGIN_ID(DEFER, me->super.prio) /* app-specific record */
+                    QS_U32(0, Q_EVT_CAST(WorkEvt)->id);
+                QS_END()
+            }
+            status_ = Q_HANDLED();
+            break;
+        }
+        case DONE_SIG: {
+            status_ = Q_TRAN(&MyAO_idle);
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status_;
+}
+/*${AOs::MyAO::SM::idle} ..................................................*/
+static QState MyAO_idle(MyAO * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case Q_ENTRY_SIG: {
+            /* recall all deferred work items (each one posted LIFO) */
+            while (QActive_recall(&me->super, &me->deferredQueue)) {
+            }
+            status_ = Q_HANDLED();
+            break;
+        }
+        case WORK_SIG: {
+            QS_BEGIN_ID(WORK, me->super.prio) /* app-specific record */
+                QS_U32(0, Q_EVT_CAST(WorkEvt)->id);
+            QS_END()
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status_;
+}
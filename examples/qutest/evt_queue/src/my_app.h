@@ -0,0 +1,26 @@
+#ifndef MY_APP_H
+#define MY_APP_H
+
+enum MySignals {
+    WORK_SIG = Q_USER_SIG, /* work item, deferred while the AO is busy */
+    DONE_SIG,              /* the AO is no longer busy */
+    MAX_SIG                /* the last signal */
+};
+
+typedef struct {
+    QEvt super; /* inherit QEvt */
+
+    uint32_t id; /* identifies the work item in the trace */
+} WorkEvt;
+
+/* application-specific trace records */
+enum AppSpecRecords {
+    DEFER = QS_USER, /* work item deferred */
+    WORK,            /* work item processed */
+    BATCH            /* batch of work items posted (1) or rejected (0) */
+};
+
+void MyAO_ctor(void);
+extern QActive * const AO_MyAO;
+
+#endif /* MY_APP_H */
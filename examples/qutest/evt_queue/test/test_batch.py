@@ -0,0 +1,56 @@
+# test-script for QUTest unit testing harness
+# see https://www.state-machine.com/qtools/html
+
+# preamble...
+def on_reset():
+    expect_pause()
+    glb_filter(GRP_UA)
+    current_obj(OBJ_SM_AO, "AO_MyAO")
+    continue_test()
+    expect_run()
+
+# the queue of the AO has 11 free entries and the event pool has 10 events
+# (see test_evt_queue.c)
+
+# tests...
+test("Post a batch of events in FIFO order")
+command("POST_DONE", 0, 0)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("POST_BATCH", 1, 6, 0)
+expect("@timestamp BATCH 1")
+expect("@timestamp WORK 1")
+expect("@timestamp WORK 2")
+expect("@timestamp WORK 3")
+expect("@timestamp WORK 4")
+expect("@timestamp WORK 5")
+expect("@timestamp WORK 6")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+
+test("Reject the whole batch when the margin would be violated")
+command("POST_DONE", 0, 0)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("POST_BATCH", 1, 10, 2)
+expect("@timestamp BATCH 0")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+# all events of the rejected batch have been recycled to the pool
+command("POST_BATCH", 11, 10, 1)
+expect("@timestamp BATCH 1")
+expect("@timestamp WORK 11")
+expect("@timestamp WORK 12")
+expect("@timestamp WORK 13")
+expect("@timestamp WORK 14")
+expect("@timestamp WORK 15")
+expect("@timestamp WORK 16")
+expect("@timestamp WORK 17")
+expect("@timestamp WORK 18")
+expect("@timestamp WORK 19")
+expect("@timestamp WORK 20")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+
+test("Defer the events of a batch while busy")
+command("POST_BATCH", 1, 3, 0)
+expect("@timestamp BATCH 1")
+expect("@timestamp DEFER 1")
+expect("@timestamp DEFER 2")
+expect("@timestamp DEFER 3")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
@@ -0,0 +1,36 @@
+# test-script for QUTest unit testing harness
+# see https://www.state-machine.com/qtools/html
+
+# preamble...
+def on_reset():
+    expect_pause()
+    glb_filter(GRP_UA)
+    current_obj(OBJ_SM_AO, "AO_MyAO")
+    continue_test()
+    expect_run()
+
+# tests...
+test("Conflate the events with the same key")
+# WORK 22 replaces WORK 21 in place (the same key 2), so it stays in front
+# of WORK 11
+command("POST_CONF", 21, 11, 22)
+expect("@timestamp DEFER 22")
+expect("@timestamp DEFER 11")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+
+test("Conflate all the events with the same signal")
+command("POST_LATEST", 1, 2, 3)
+expect("@timestamp DEFER 3")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+
+test("Conflate only the undelivered events")
+command("POST_DONE", 0, 0)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("POST_CONF", 11, 12, 21)
+expect("@timestamp WORK 12")
+expect("@timestamp WORK 21")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+# WORK 12 has been delivered, so WORK 13 cannot replace it
+command("POST_CONF", 13)
+expect("@timestamp WORK 13")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
@@ -0,0 +1,205 @@
+/*****************************************************************************
+* Purpose: event queue QUTEST fixture
+* Last Updated for Version: 6.9.1
+* Date of the Last Update:  2026-10-16
+*
+*                    Q u a n t u m  L e a P s
+*                    ------------------------
+*                    Modern Embedded Software
+*
+* Copyright (C) 2005-2020 Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <www.gnu.org/licenses/>.
+*
+* Contact information:
+* <www.state-machine.com/licensing>
+* <info@state-machine.com>
+*****************************************************************************/
+#include "qpc.h"    /* QUTest interface */
+#include "my_app.h" /* My Application */
+
+Q_DEFINE_THIS_FILE
+
+/*..........................................................................*/
+static uint8_t const l_fixture = 0U; /* QS sender of the posted events */
+static void postWork(uint32_t const id, uint32_t const n);
+static void postConf(uint32_t const ids[], QEvtMatchHandler const match);
+static void postBatch(uint32_t const id, uint32_t const n,
+                      uint32_t const margin);
+static bool sameKey(QEvt const * const queued, QEvt const * const e);
+
+enum {
+    POST_WORK = 0, /* post 'param2' work items numbered from 'param1' */
+    POST_DONE,     /* post DONE and then the work items as POST_WORK */
+    POST_CONF,     /* conflate the work items 'param1..3' with the same key */
+    POST_LATEST,   /* conflate the work items 'param1..3' (all of them) */
+    POST_BATCH     /* post as POST_WORK in one batch with margin 'param3' */
+};
+
+/*..........................................................................*/
+int main(int argc, char *argv[]) {
+    static QF_MPOOL_EL(WorkEvt) smlPoolSto[10];
+    static QEvt const *myAoQueueSto[10];
+
+    QF_init();   /* initialize the framework */
+
+    /* initialize the QS software tracing */
+    Q_ALLEGE(QS_INIT(argc > 1 ? argv[1] : (void *)0));
+
+    /* object dictionaries... */
+    QS_OBJ_DICTIONARY(AO_MyAO);
+    QS_OBJ_DICTIONARY(&l_fixture);
+
+    QS_TEST_PAUSE();
+
+    /* initialize event pools... */
+    QF_poolInit(smlPoolSto, sizeof(smlPoolSto), sizeof(smlPoolSto[0]));
+
+    /* start active objects... */
+    MyAO_ctor(); /* instantiate the MyAO active object */
+    QACTIVE_START(AO_MyAO,              /* AO to start */
+                  (uint_fast8_t)1,      /* QP priority of the AO */
+                  myAoQueueSto,         /* event queue storage */
+                  Q_DIM(myAoQueueSto),  /* queue length [events] */
+                  (void *)0,            /* stack storage (not used) */
+                  0U,                   /* size of the stack [bytes] */
+                  (QEvt *)0);           /* initialization event */
+
+    return QF_run(); /* run the QF application */
+}
+
+/*--------------------------------------------------------------------------*/
+void QS_onTestSetup(void) {
+    QS_USR_DICTIONARY(DEFER);
+    QS_USR_DICTIONARY(WORK);
+    QS_USR_DICTIONARY(BATCH);
+    QS_USR_DICTIONARY(POST_WORK);
+    QS_USR_DICTIONARY(POST_DONE);
+    QS_USR_DICTIONARY(POST_CONF);
+    QS_USR_DICTIONARY(POST_LATEST);
+    QS_USR_DICTIONARY(POST_BATCH);
+}
+/*..........................................................................*/
+void QS_onTestTeardown(void) {
+}
+
+/*..........................................................................*/
+/*! callback function to execute user commands
+*
+* All the events posted by one command are in the queue of the AO before
+* it runs, so they are taken together in one batch (QF_ACTIVE_GET_BATCH).
+*/
+void QS_onCommand(uint8_t cmdId,
+                  uint32_t param1, uint32_t param2, uint32_t param3)
+{
+    uint32_t const ids[] = { param1, param2, param3 };
+
+    switch (cmdId) {
+        case POST_WORK: {
+            postWork(param1, param2);
+            break;
+        }
+        case POST_DONE: {
+            static QEvt const doneEvt = { DONE_SIG, 0U, 0U };
+            QACTIVE_POST(AO_MyAO, &doneEvt, &l_fixture);
+            postWork(param1, param2);
+            break;
+        }
+        case POST_CONF: {
+            postConf(ids, &sameKey);
+            break;
+        }
+        case POST_LATEST: {
+            postConf(ids, (QEvtMatchHandler)0);
+            break;
+        }
+        case POST_BATCH: {
+            postBatch(param1, param2, param3);
+            break;
+        }
+        default:
+            break;
+    }
+}
+/*..........................................................................*/
+/*! callback function to "massage" the injected QP events (not used here) */
+void QS_onTestEvt(QEvt *e) {
+    (void)e;
+#ifdef Q_HOST  /* is this test compiled for a desktop Host computer? */
+#else /* embedded Target */
+#endif /* embedded Target */
+}
+/*..........................................................................*/
+/*! callback function to output the posted QP events (not used here) */
+void QS_onTestPost(void const *sender, QActive *recipient,
+                   QEvt const *e, bool status)
+{
+    (void)sender;
+    (void)recipient;
+    (void)e;
+    (void)status;
+}
+
+/*--------------------------------------------------------------------------*/
+static void postWork(uint32_t const id, uint32_t const n) {
+    uint32_t i;
+    for (i = 0U; i < n; ++i) {
+        WorkEvt *we = Q_NEW(WorkEvt, WORK_SIG);
+        we->id = id + i;
+        QACTIVE_POST(AO_MyAO, &we->super, &l_fixture);
+    }
+}
+/*..........................................................................*/
+/* post the work items 'ids' (except 0), conflating the undelivered ones */
+static void postConf(uint32_t const ids[], QEvtMatchHandler const match) {
+    uint_fast8_t i;
+    for (i = 0U; i < 3U; ++i) {
+        if (ids[i] != 0U) {
+            WorkEvt *we = Q_NEW(WorkEvt, WORK_SIG);
+            we->id = ids[i];
+            QACTIVE_POST_CONFLATE(AO_MyAO, &we->super, match, &l_fixture);
+        }
+    }
+}
+/*..........................................................................*/
+/* post 'n' work items numbered from 'id' all at once or not at all */
+static void postBatch(uint32_t const id, uint32_t const n,
+                      uint32_t const margin)
+{
+    QEvt const *batch[10];
+    uint32_t i;
+    bool posted;
+
+    Q_REQUIRE((n != 0U) && (n <= Q_DIM(batch)));
+    for (i = 0U; i < n; ++i) {
+        WorkEvt *we = Q_NEW(WorkEvt, WORK_SIG);
+        we->id = id + i;
+        batch[i] = &we->super;
+    }
+    posted = QACTIVE_POST_BATCH(AO_MyAO, batch, n, margin, &l_fixture);
+    QS_BEGIN_ID(BATCH, 0U) /* app-specific record */
+        QS_U8(0, posted ? 1U : 0U);
+    QS_END()
+}
+/*..........................................................................*/
+/* the work items with the same tens (key) replace each other */
+static bool sameKey(QEvt const * const queued, QEvt const * const e) {
+    return (((WorkEvt const *)queued)->id / 10U)
+           == (((WorkEvt const *)e)->id / 10U);
+}
@@ -0,0 +1,37 @@
+# test-script for QUTest unit testing harness
+# see https://www.state-machine.com/qtools/html
+
+# preamble...
+def on_reset():
+    expect_pause()
+    glb_filter(GRP_UA)
+    current_obj(OBJ_SM_AO, "AO_MyAO")
+    continue_test()
+    expect_run()
+
+# tests...
+test("Recall during a batch")
+command("POST_WORK", 1, 1)
+expect("@timestamp DEFER 1")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+# batch: DONE, WORK 2, WORK 3; DONE recalls WORK 1 (LIFO)
+command("POST_DONE", 2, 2)
+expect("@timestamp WORK 1")
+expect("@timestamp WORK 2")
+expect("@timestamp WORK 3")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+
+test("Recall more events than the dispatched events of a batch")
+command("POST_WORK", 1, 2)
+expect("@timestamp DEFER 1")
+expect("@timestamp DEFER 2")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+# full batch: DONE, WORK 3, WORK 4, WORK 5; DONE recalls WORK 1 and then
+# WORK 2 in front of it (LIFO), which pushes WORK 5 back to the queue
+command("POST_DONE", 3, 3)
+expect("@timestamp WORK 2")
+expect("@timestamp WORK 1")
+expect("@timestamp WORK 3")
+expect("@timestamp WORK 4")
+expect("@timestamp WORK 5")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
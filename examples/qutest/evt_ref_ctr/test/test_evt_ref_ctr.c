@@ -0,0 +1,179 @@
+/*****************************************************************************
+* Purpose: atomic event reference counter QUTEST fixture
+* Last Updated for Version: 6.9.1
+* Date of the Last Update:  2026-10-16
+*
+*                    Q u a n t u m  L e a P s
+*                    ------------------------
+*                    Modern Embedded Software
+*
+* Copyright (C) 2005-2020 Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <www.gnu.org/licenses/>.
+*
+* Contact information:
+* <www.state-machine.com/licensing>
+* <info@state-machine.com>
+*****************************************************************************/
+#include "qpc.h" /* QUTest interface */
+
+Q_DEFINE_THIS_FILE
+
+/*..........................................................................*/
+enum {
+    POOL_LEN = 2U /* the number of events in the pool */
+};
+
+static QEvt const *l_evt;   /* the referenced event (NULL when recycled) */
+static uint32_t    l_nRefs; /* the number of the references to l_evt */
+
+static void deleteRef(void);
+static uint32_t freeEvts(void);
+
+enum {
+    STATE = QS_USER /* the reference counter of l_evt and the free events */
+};
+
+enum {
+    NEW_EVT = 0, /* allocate l_evt and reference it */
+    NEW_REFS,    /* add 'param1' references to l_evt */
+    DELETE_REFS  /* delete 'param1' references to l_evt */
+};
+
+/*..........................................................................*/
+int main(int argc, char *argv[]) {
+    static QF_MPOOL_EL(QEvt) smlPoolSto[POOL_LEN];
+
+    QF_init();   /* initialize the framework */
+
+    /* initialize the QS software tracing */
+    Q_ALLEGE(QS_INIT(argc > 1 ? argv[1] : (void *)0));
+
+    QS_TEST_PAUSE();
+
+    /* initialize event pools... */
+    QF_poolInit(smlPoolSto, sizeof(smlPoolSto), sizeof(smlPoolSto[0]));
+
+    return QF_run(); /* run the QF application */
+}
+
+/*..........................................................................*/
+static void deleteRef(void) {
+    QEvt const *evtRef = l_evt;
+
+    --l_nRefs;
+    if (l_nRefs == 0U) { /* the last reference? */
+        l_evt = (QEvt const *)0; /* the event is recycled below */
+    }
+    Q_DELETE_REF(evtRef);
+}
+/*..........................................................................*/
+/* the number of the free events in the pool (allocates and frees them all) */
+static uint32_t freeEvts(void) {
+    QEvt *evts[POOL_LEN];
+    uint32_t n;
+    uint32_t i;
+
+    for (n = 0U; n < POOL_LEN; ++n) {
+        Q_NEW_X(evts[n], QEvt, 0U, Q_USER_SIG); /* margin 0, may fail */
+        if (evts[n] == (QEvt *)0) {
+            break;
+        }
+    }
+    for (i = 0U; i < n; ++i) {
+        QF_gc(evts[i]);
+    }
+    return n;
+}
+
+/*--------------------------------------------------------------------------*/
+void QS_onTestSetup(void) {
+    QS_USR_DICTIONARY(STATE);
+    QS_USR_DICTIONARY(NEW_EVT);
+    QS_USR_DICTIONARY(NEW_REFS);
+    QS_USR_DICTIONARY(DELETE_REFS);
+}
+/*..........................................................................*/
+void QS_onTestTeardown(void) {
+    /* delete all references, so that every test starts with a full pool */
+    while (l_nRefs > 0U) {
+        deleteRef();
+    }
+}
+
+/*..........................................................................*/
+/*! callback function to execute user commands */
+void QS_onCommand(uint8_t cmdId,
+                  uint32_t param1, uint32_t param2, uint32_t param3)
+{
+    (void)param2; /* unused parameter */
+    (void)param3; /* unused parameter */
+
+    switch (cmdId) {
+        case NEW_EVT: {
+            if (l_evt == (QEvt const *)0) {
+                QEvt const *evtRef = (QEvt const *)0;
+                QEvt const * const e = Q_NEW(QEvt, Q_USER_SIG);
+                l_evt = Q_NEW_REF(evtRef, QEvt);
+                l_nRefs = 1U;
+            }
+            break;
+        }
+        case NEW_REFS: {
+            QEvt const * const e = l_evt;
+            for (; (param1 > 0U) && (e != (QEvt const *)0); --param1) {
+                QEvt const *evtRef = (QEvt const *)0;
+                Q_NEW_REF(evtRef, QEvt);
+                ++l_nRefs;
+            }
+            break;
+        }
+        case DELETE_REFS: {
+            for (; (param1 > 0U) && (l_nRefs > 0U); --param1) {
+                deleteRef();
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    QS_BEGIN_ID(STATE, 0U) /* app-specific record */
+        QS_U32(0, (l_evt != (QEvt const *)0) ? l_evt->refCtr_ : 0U);
+        QS_U32(0, freeEvts());
+    QS_END()
+}
+/*..........................................................................*/
+/*! callback function to "massage" the injected QP events (not used here) */
+void QS_onTestEvt(QEvt *e) {
+    (void)e;
+#ifdef Q_HOST  /* is this test compiled for a desktop Host computer? */
+#else /* embedded Target */
+#endif /* embedded Target */
+}
+/*..........................................................................*/
+/*! callback function to output the posted QP events (not used here) */
+void QS_onTestPost(void const *sender, QActive *recipient,
+                   QEvt const *e, bool status)
+{
+    (void)sender;
+    (void)recipient;
+    (void)e;
+    (void)status;
+}
@@ -0,0 +1,55 @@
+# test-script for QUTest unit testing harness
+# see https://www.state-machine.com/qtools/html
+
+# preamble...
+def on_reset():
+    expect_pause()
+    glb_filter(GRP_UA)
+    continue_test()
+    expect_run()
+
+# every command reports the reference counter of the event and the number
+# of the free events in the pool of 2 events (see test_evt_ref_ctr.c)
+
+# tests...
+test("Recycle the event when its last reference is deleted")
+command("NEW_EVT")
+expect("@timestamp STATE 1 1")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("NEW_REFS", 2)
+expect("@timestamp STATE 3 1")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("DELETE_REFS", 2)
+expect("@timestamp STATE 1 1")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("DELETE_REFS", 1)
+expect("@timestamp STATE 0 2")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+
+test("Count more references than an 8-bit counter can hold")
+command("NEW_EVT")
+expect("@timestamp STATE 1 1")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("NEW_REFS", 299)
+expect("@timestamp STATE 300 1")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+# the event stays allocated until the 300th reference is deleted
+command("DELETE_REFS", 299)
+expect("@timestamp STATE 1 1")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("DELETE_REFS", 1)
+expect("@timestamp STATE 0 2")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+
+test("Delete the references in the teardown")
+command("NEW_EVT")
+expect("@timestamp STATE 1 1")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("NEW_REFS", 1000)
+expect("@timestamp STATE 1001 1")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+
+test("Start with the full pool after the teardown", NORESET)
+command("DELETE_REFS", 1)
+expect("@timestamp STATE 0 2")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
@@ -0,0 +1,165 @@
+/*****************************************************************************
+* Purpose: event pool size classes QUTEST fixture
+* Last Updated for Version: 6.9.1
+* Date of the Last Update:  2026-10-16
+*
+*                    Q u a n t u m  L e a P s
+*                    ------------------------
+*                    Modern Embedded Software
+*
+* Copyright (C) 2005-2020 Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <www.gnu.org/licenses/>.
+*
+* Contact information:
+* <www.state-machine.com/licensing>
+* <info@state-machine.com>
+*****************************************************************************/
+#include "qpc.h" /* QUTest interface */
+
+Q_DEFINE_THIS_FILE
+
+/*..........................................................................*/
+enum {
+    N_POOLS  = 10U, /* the number of the event pools (QF_MAX_EPOOL) */
+    POOL_LEN = 2U,  /* the number of events in each pool */
+    MAX_SIZE = 256U /* the event size of the largest pool */
+};
+
+/* the event sizes of the pools (in the ascending order), the size-class
+* table covers the event sizes up to 64 (QF_EVT_SIZE_LUT)
+*/
+static uint16_t const l_poolSize[N_POOLS] = {
+    8U, 16U, 24U, 32U, 40U, 48U, 56U, 64U, 96U, MAX_SIZE
+};
+
+static QEvt const *l_evts[N_POOLS * POOL_LEN]; /* the allocated events */
+static uint32_t l_nEvts; /* the number of the allocated events */
+
+enum {
+    ALLOC = QS_USER, /* the pool ID of the event just allocated (0 if none) */
+    STATS            /* the statistics of the event pool */
+};
+
+enum {
+    NEW_EVT = 0, /* allocate an event of the size 'param1' (may fail) */
+    FREE_EVTS,   /* free all allocated events */
+    GET_STATS    /* report the statistics of the event pool 'param1' */
+};
+
+/*..........................................................................*/
+int main(int argc, char *argv[]) {
+    static uint64_t poolSto[N_POOLS][POOL_LEN * MAX_SIZE / sizeof(uint64_t)];
+    uint_fast8_t n;
+
+    QF_init();   /* initialize the framework */
+
+    /* initialize the QS software tracing */
+    Q_ALLEGE(QS_INIT(argc > 1 ? argv[1] : (void *)0));
+
+    QS_TEST_PAUSE();
+
+    /* initialize event pools... */
+    for (n = 0U; n < N_POOLS; ++n) {
+        QF_poolInit(poolSto[n], POOL_LEN * l_poolSize[n], l_poolSize[n]);
+    }
+
+    return QF_run(); /* run the QF application */
+}
+
+/*--------------------------------------------------------------------------*/
+void QS_onTestSetup(void) {
+    QS_USR_DICTIONARY(ALLOC);
+    QS_USR_DICTIONARY(STATS);
+    QS_USR_DICTIONARY(NEW_EVT);
+    QS_USR_DICTIONARY(FREE_EVTS);
+    QS_USR_DICTIONARY(GET_STATS);
+}
+/*..........................................................................*/
+void QS_onTestTeardown(void) {
+    /* free all events, so that every test starts with the same pools */
+    while (l_nEvts > 0U) {
+        --l_nEvts;
+        QF_gc(l_evts[l_nEvts]);
+    }
+}
+
+/*..........................................................................*/
+/*! callback function to execute user commands */
+void QS_onCommand(uint8_t cmdId,
+                  uint32_t param1, uint32_t param2, uint32_t param3)
+{
+    (void)param2; /* unused parameter */
+    (void)param3; /* unused parameter */
+
+    switch (cmdId) {
+        case NEW_EVT: {
+            /* allocate as Q_NEW_X() does, but for any event size */
+            QEvt *e = QF_newX_((uint_fast16_t)param1, 0U, Q_USER_SIG);
+            if ((e != (QEvt *)0) && (l_nEvts < Q_DIM(l_evts))) {
+                l_evts[l_nEvts] = e;
+                ++l_nEvts;
+            }
+            QS_BEGIN_ID(ALLOC, 0U) /* app-specific record */
+                QS_U8(0, (e != (QEvt *)0) ? e->poolId_ : 0U);
+            QS_END()
+            break;
+        }
+        case FREE_EVTS: {
+            while (l_nEvts > 0U) {
+                --l_nEvts;
+                QF_gc(l_evts[l_nEvts]);
+            }
+            break;
+        }
+        case GET_STATS: {
+            QPoolStats stats;
+            QF_getPoolStats((uint_fast8_t)param1, &stats);
+            QS_BEGIN_ID(STATS, 0U) /* app-specific record */
+                QS_U8(0, (uint8_t)param1);
+                QS_U32(0, stats.nAlloc);
+                QS_U32(0, stats.nFail);
+                QS_U16(0, stats.minSize);
+                QS_U16(0, stats.maxSize);
+                QS_U16(0, stats.blockSize);
+            QS_END()
+            break;
+        }
+        default:
+            break;
+    }
+}
+/*..........................................................................*/
+/*! callback function to "massage" the injected QP events (not used here) */
+void QS_onTestEvt(QEvt *e) {
+    (void)e;
+#ifdef Q_HOST  /* is this test compiled for a desktop Host computer? */
+#else /* embedded Target */
+#endif /* embedded Target */
+}
+/*..........................................................................*/
+/*! callback function to output the posted QP events (not used here) */
+void QS_onTestPost(void const *sender, QActive *recipient,
+                   QEvt const *e, bool status)
+{
+    (void)sender;
+    (void)recipient;
+    (void)e;
+    (void)status;
+}
@@ -0,0 +1,79 @@
+# test-script for QUTest unit testing harness
+# see https://www.state-machine.com/qtools/html
+
+# preamble...
+def on_reset():
+    expect_pause()
+    glb_filter(GRP_UA)
+    continue_test()
+    expect_run()
+
+# 10 event pools of 2 events each, sized 8, 16, 24, 32, 40, 48, 56, 64, 96
+# and 256 bytes, the size-class table covers the sizes up to 64 bytes
+# (see test_evt_size_class.c)
+
+# tests...
+test("Allocate the events from the smallest fitting size class")
+command("NEW_EVT", 8)
+expect("@timestamp ALLOC 1")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("NEW_EVT", 9)
+expect("@timestamp ALLOC 2")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("NEW_EVT", 40)
+expect("@timestamp ALLOC 5")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("NEW_EVT", 41)
+expect("@timestamp ALLOC 6")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("NEW_EVT", 64)
+expect("@timestamp ALLOC 8")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+# the sizes above the table continue the search from the pool 8
+command("NEW_EVT", 65)
+expect("@timestamp ALLOC 9")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("NEW_EVT", 200)
+expect("@timestamp ALLOC 10")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+
+test("Fail the allocation from the exhausted size class")
+command("NEW_EVT", 16)
+expect("@timestamp ALLOC 2")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("NEW_EVT", 12)
+expect("@timestamp ALLOC 2")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+# the larger size classes are not used for the smaller events
+command("NEW_EVT", 16)
+expect("@timestamp ALLOC 0")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("GET_STATS", 2)
+expect("@timestamp STATS 2 2 1 12 16 16")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("GET_STATS", 3)
+expect("@timestamp STATS 3 0 0 0 0 24")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+
+test("Collect the statistics of the size class")
+command("NEW_EVT", 20)
+expect("@timestamp ALLOC 3")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("FREE_EVTS")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("NEW_EVT", 24)
+expect("@timestamp ALLOC 3")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("NEW_EVT", 17)
+expect("@timestamp ALLOC 3")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("GET_STATS", 3)
+expect("@timestamp STATS 3 3 0 17 24 24")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("GET_STATS", 10)
+expect("@timestamp STATS 10 0 0 0 0 256")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+
+test("Assert on the event larger than all size classes")
+command("NEW_EVT", 257)
+expect("@timestamp =ASSERT= Mod=qf_dyn,Loc=310")
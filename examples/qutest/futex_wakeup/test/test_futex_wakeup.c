@@ -0,0 +1,242 @@
+/*****************************************************************************
+* Purpose: futex-based AO wakeup test for the POSIX port
+* Last Updated for Version: 6.9.1
+* Date of the Last Update:  2026-10-16
+*
+*                    Q u a n t u m  L e a P s
+*                    ------------------------
+*                    Modern Embedded Software
+*
+* Copyright (C) 2005-2020 Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <www.gnu.org/licenses/>.
+*
+* Contact information:
+* <www.state-machine.com/licensing>
+* <info@state-machine.com>
+*****************************************************************************/
+/* expose features from the 2008 POSIX standard (IEEE Standard 1003.1-2008) */
+#define _POSIX_C_SOURCE 200809L
+
+#include "qpc.h"
+
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>   /* for nanosleep() and clock_gettime() */
+
+Q_DEFINE_THIS_FILE
+
+/* Every wakeup lost between the spin phase and the parking of an AO thread
+* stalls the ping-pong of the two AOs or a request of the client thread,
+* which then fails the test by the timeout.
+*/
+
+/*..........................................................................*/
+enum {
+    N_ROUNDS    = 20000, /* the number of the ping-pong round trips */
+    N_REQUESTS  = 2000,  /* the number of the requests of the client */
+    MAX_PAUSE   = 32,    /* the pauses of the client [8us] cycle so far */
+    QUEUE_LEN   = 8,     /* the length of the AO event queues */
+    MAX_TICKS   = 3000   /* the test timeout [clock ticks] */
+};
+
+enum TestSignals {
+    PING_SIG = Q_USER_SIG, /* posted by the Ping AO to the Pong AO */
+    PONG_SIG,              /* posted by the Pong AO back to the Ping AO */
+    REQUEST_SIG,           /* posted by the client thread to the Pong AO */
+    MAX_SIG
+};
+
+typedef struct {
+    QActive super;
+    uint32_t nRounds; /* the number of the round trips */
+} Ping;
+
+typedef struct {
+    QActive super;
+} Pong;
+
+static QState Ping_initial(Ping * const me, QEvt const * const e);
+static QState Ping_active (Ping * const me, QEvt const * const e);
+static QState Pong_initial(Pong * const me, QEvt const * const e);
+static QState Pong_active (Pong * const me, QEvt const * const e);
+
+static void *client_thread(void *arg);
+static void partDone(void);
+static void fail(char const *reason);
+
+static Ping l_ping;
+static Pong l_pong;
+static sem_t l_reply;   /* signaled by the Pong AO for each request */
+static int l_nDone;     /* the number of the parts of the test done */
+static char const * volatile l_failure; /* the reason of the failure */
+static uint32_t l_ticks;
+
+static QEvt const l_pingEvt    = { PING_SIG,    0U, 0U };
+static QEvt const l_pongEvt    = { PONG_SIG,    0U, 0U };
+static QEvt const l_requestEvt = { REQUEST_SIG, 0U, 0U };
+
+/*..........................................................................*/
+int main(void) {
+    static QEvt const *pingQueueSto[QUEUE_LEN];
+    static QEvt const *pongQueueSto[QUEUE_LEN];
+
+    QF_init();    /* initialize the framework */
+    Q_ALLEGE(sem_init(&l_reply, 0, 0U) == 0);
+
+    QActive_ctor(&l_ping.super, Q_STATE_CAST(&Ping_initial));
+    QActive_ctor(&l_pong.super, Q_STATE_CAST(&Pong_initial));
+    QACTIVE_START(&l_pong.super, 1U,
+                  pongQueueSto, Q_DIM(pongQueueSto),
+                  (void *)0, 0U, (void *)0);
+    QACTIVE_START(&l_ping.super, 2U,
+                  pingQueueSto, Q_DIM(pingQueueSto),
+                  (void *)0, 0U, (void *)0);
+
+    (void)QF_run(); /* run until both parts or the timeout stop QF */
+
+    if (l_failure != (char const *)0) {
+        printf("FAIL: %s\n", l_failure);
+        return 1;
+    }
+    printf("PASS: %d round trips, %d requests\n", N_ROUNDS, N_REQUESTS);
+    return 0;
+}
+
+/*..........................................................................*/
+static QState Ping_initial(Ping * const me, QEvt const * const e) {
+    (void)e; /* unused parameter */
+    QACTIVE_POST(&l_pong.super, &l_pingEvt, me); /* start the ping-pong */
+    return Q_TRAN(&Ping_active);
+}
+/*..........................................................................*/
+static QState Ping_active(Ping * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case PONG_SIG: {
+            ++me->nRounds;
+            if (me->nRounds < N_ROUNDS) {
+                QACTIVE_POST(&l_pong.super, &l_pingEvt, me);
+            }
+            else {
+                partDone();
+            }
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status_;
+}
+
+/*..........................................................................*/
+static QState Pong_initial(Pong * const me, QEvt const * const e) {
+    (void)e; /* unused parameter */
+    return Q_TRAN(&Pong_active);
+}
+/*..........................................................................*/
+static QState Pong_active(Pong * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case PING_SIG: {
+            QACTIVE_POST(&l_ping.super, &l_pongEvt, me);
+            status_ = Q_HANDLED();
+            break;
+        }
+        case REQUEST_SIG: {
+            sem_post(&l_reply);
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status_;
+}
+
+/*..........................................................................*/
+static void *client_thread(void *arg) {
+    uint32_t n;
+
+    (void)arg; /* unused parameter */
+    for (n = 0U; n < N_REQUESTS; ++n) {
+        /* pause for 0..248us, so that the Pong AO sometimes spins and
+        * sometimes is parked in the kernel when the request arrives
+        */
+        struct timespec ts = { 0, (long)(n % MAX_PAUSE) * 8000L };
+        nanosleep(&ts, (struct timespec *)0);
+
+        QACTIVE_POST(&l_pong.super, &l_requestEvt, (void *)0);
+
+        clock_gettime(CLOCK_REALTIME, &ts);
+        ts.tv_sec += 2; /* the reply must come much sooner than that */
+        if (sem_timedwait(&l_reply, &ts) != 0) {
+            fail("the request did not wake up the AO");
+            return (void *)0;
+        }
+    }
+    partDone();
+    return (void *)0;
+}
+/*..........................................................................*/
+static void partDone(void) {
+    if (__atomic_add_fetch(&l_nDone, 1, __ATOMIC_SEQ_CST) == 2) {
+        QF_stop(); /* both the ping-pong and the client are done */
+    }
+}
+/*..........................................................................*/
+static void fail(char const *reason) {
+    if (l_failure == (char const *)0) { /* report only the first failure */
+        l_failure = reason;
+    }
+    QF_stop();
+}
+
+/*..........................................................................*/
+void QF_onStartup(void) {
+    pthread_t thread;
+
+    QF_setTickRate(100U, 30); /* 100Hz clock tick rate, ticker priority 30 */
+
+    Q_ALLEGE(pthread_create(&thread, (pthread_attr_t *)0,
+                            &client_thread, (void *)0) == 0);
+    pthread_detach(thread);
+}
+/*..........................................................................*/
+void QF_onCleanup(void) {
+}
+/*..........................................................................*/
+void QF_onClockTick(void) {
+    ++l_ticks;
+    if (l_ticks > MAX_TICKS) {
+        fail("timeout");
+    }
+}
+/*..........................................................................*/
+Q_NORETURN Q_onAssert(char const * const module, int_t const loc) {
+    fprintf(stderr, "Assertion failed in %s:%d\n", module, loc);
+    exit(-1);
+}
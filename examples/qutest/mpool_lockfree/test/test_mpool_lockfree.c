@@ -0,0 +1,190 @@
+/*****************************************************************************
+* Purpose: lock-free event pool QUTEST fixture
+* Last Updated for Version: 6.9.1
+* Date of the Last Update:  2026-10-16
+*
+*                    Q u a n t u m  L e a P s
+*                    ------------------------
+*                    Modern Embedded Software
+*
+* Copyright (C) 2005-2020 Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <www.gnu.org/licenses/>.
+*
+* Contact information:
+* <www.state-machine.com/licensing>
+* <info@state-machine.com>
+*****************************************************************************/
+#include "qpc.h" /* QUTest interface */
+
+Q_DEFINE_THIS_FILE
+
+/*..........................................................................*/
+enum {
+    SML_POOL_LEN = 8U, /* the events in the lock-free pool of small events */
+    BIG_POOL_LEN = 4U  /* the events in the locked pool of big events */
+};
+
+typedef struct {
+    QEvt super;
+    uint32_t payload[4];
+} BigEvt;
+
+static QEvt const *l_evts[SML_POOL_LEN + BIG_POOL_LEN]; /* allocated events */
+static uint32_t l_nEvts; /* the number of the allocated events */
+
+enum {
+    ALLOC = QS_USER, /* the number of the events just allocated */
+    FREE,            /* the number of the events still allocated */
+    MIN,             /* the minimum of the free events in pool 'poolId' */
+    REUSED           /* was the last freed event allocated again? */
+};
+
+enum {
+    ALLOC_EVTS = 0, /* allocate up to 'param1' events with margin 'param2',
+                    * small events when 'param3' is 0, big events otherwise */
+    FREE_EVTS,      /* free 'param1' events, the latest allocated first */
+    GET_MIN,        /* report the minimum of the free events in 'param1' */
+    REUSE           /* free the latest allocated event and allocate again */
+};
+
+/*..........................................................................*/
+int main(int argc, char *argv[]) {
+    static QF_MPOOL_EL(QEvt)   smlPoolSto[SML_POOL_LEN];
+    static QF_MPOOL_EL(BigEvt) bigPoolSto[BIG_POOL_LEN];
+
+    QF_init();   /* initialize the framework */
+
+    /* initialize the QS software tracing */
+    Q_ALLEGE(QS_INIT(argc > 1 ? argv[1] : (void *)0));
+
+    QS_TEST_PAUSE();
+
+    /* initialize event pools (only the first one is lock-free)... */
+    QF_poolInit(smlPoolSto, sizeof(smlPoolSto), sizeof(smlPoolSto[0]));
+    QF_poolInit(bigPoolSto, sizeof(bigPoolSto), sizeof(bigPoolSto[0]));
+
+    return QF_run(); /* run the QF application */
+}
+
+/*--------------------------------------------------------------------------*/
+void QS_onTestSetup(void) {
+    QS_USR_DICTIONARY(ALLOC);
+    QS_USR_DICTIONARY(FREE);
+    QS_USR_DICTIONARY(MIN);
+    QS_USR_DICTIONARY(REUSED);
+    QS_USR_DICTIONARY(ALLOC_EVTS);
+    QS_USR_DICTIONARY(FREE_EVTS);
+    QS_USR_DICTIONARY(GET_MIN);
+    QS_USR_DICTIONARY(REUSE);
+}
+/*..........................................................................*/
+void QS_onTestTeardown(void) {
+    /* free all events, so that every test starts with the same pools */
+    while (l_nEvts > 0U) {
+        --l_nEvts;
+        QF_gc(l_evts[l_nEvts]);
+    }
+}
+
+/*..........................................................................*/
+/*! callback function to execute user commands */
+void QS_onCommand(uint8_t cmdId,
+                  uint32_t param1, uint32_t param2, uint32_t param3)
+{
+    uint32_t n = 0U;
+
+    switch (cmdId) {
+        case ALLOC_EVTS: {
+            for (; (n < param1) && (l_nEvts < Q_DIM(l_evts)); ++n) {
+                QEvt *e;
+                if (param3 == 0U) {
+                    Q_NEW_X(e, QEvt, (uint_fast16_t)param2, Q_USER_SIG);
+                }
+                else {
+                    BigEvt *be;
+                    Q_NEW_X(be, BigEvt, (uint_fast16_t)param2, Q_USER_SIG);
+                    e = &be->super;
+                }
+                if (e == (QEvt *)0) {
+                    break;
+                }
+                l_evts[l_nEvts] = e;
+                ++l_nEvts;
+            }
+            QS_BEGIN_ID(ALLOC, 0U) /* app-specific record */
+                QS_U32(0, n);
+            QS_END()
+            break;
+        }
+        case FREE_EVTS: {
+            for (; (n < param1) && (l_nEvts > 0U); ++n) {
+                --l_nEvts;
+                QF_gc(l_evts[l_nEvts]);
+            }
+            QS_BEGIN_ID(FREE, 0U) /* app-specific record */
+                QS_U32(0, l_nEvts);
+            QS_END()
+            break;
+        }
+        case GET_MIN: {
+            QS_BEGIN_ID(MIN, 0U) /* app-specific record */
+                QS_U8(0, (uint8_t)param1);
+                QS_U32(0, QF_getPoolMin((uint_fast8_t)param1));
+            QS_END()
+            break;
+        }
+        case REUSE: {
+            /* the lock-free free list is a stack, so the event freed
+            * last must be allocated first
+            */
+            if (l_nEvts > 0U) {
+                QEvt const * const last = l_evts[l_nEvts - 1U];
+                QEvt *e;
+                QF_gc(last);
+                Q_NEW_X(e, QEvt, 0U, Q_USER_SIG); /* margin 0, may fail */
+                l_evts[l_nEvts - 1U] = e;
+                QS_BEGIN_ID(REUSED, 0U) /* app-specific record */
+                    QS_U8(0, (e == last) ? 1U : 0U);
+                QS_END()
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+/*..........................................................................*/
+/*! callback function to "massage" the injected QP events (not used here) */
+void QS_onTestEvt(QEvt *e) {
+    (void)e;
+#ifdef Q_HOST  /* is this test compiled for a desktop Host computer? */
+#else /* embedded Target */
+#endif /* embedded Target */
+}
+/*..........................................................................*/
+/*! callback function to output the posted QP events (not used here) */
+void QS_onTestPost(void const *sender, QActive *recipient,
+                   QEvt const *e, bool status)
+{
+    (void)sender;
+    (void)recipient;
+    (void)e;
+    (void)status;
+}
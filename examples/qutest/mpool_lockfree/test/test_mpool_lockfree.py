@@ -0,0 +1,68 @@
+# test-script for QUTest unit testing harness
+# see https://www.state-machine.com/qtools/html
+
+# preamble...
+def on_reset():
+    expect_pause()
+    glb_filter(GRP_UA)
+    continue_test()
+    expect_run()
+
+# the lock-free pool 1 has 8 small events and the locked pool 2 has 4 big
+# events (see test_mpool_lockfree.c)
+
+# tests...
+test("Allocate all events of the lock-free pool")
+command("ALLOC_EVTS", 8)
+expect("@timestamp ALLOC 8")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("ALLOC_EVTS", 1)
+expect("@timestamp ALLOC 0")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("GET_MIN", 1)
+expect("@timestamp MIN 1 0")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+# all freed events can be allocated again
+command("FREE_EVTS", 8)
+expect("@timestamp FREE 0")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("ALLOC_EVTS", 10)
+expect("@timestamp ALLOC 8")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+
+test("Keep the margin of the lock-free pool", NORESET)
+command("FREE_EVTS", 8)
+expect("@timestamp FREE 0")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("ALLOC_EVTS", 8, 3)
+expect("@timestamp ALLOC 5")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("ALLOC_EVTS", 8, 2)
+expect("@timestamp ALLOC 1")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("ALLOC_EVTS", 8, 2)
+expect("@timestamp ALLOC 0")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+
+test("Reuse the event freed last")
+command("ALLOC_EVTS", 3)
+expect("@timestamp ALLOC 3")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("REUSE")
+expect("@timestamp REUSED 1")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("GET_MIN", 1)
+expect("@timestamp MIN 1 5")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+
+test("Allocate the big events from the locked pool")
+command("ALLOC_EVTS", 6, 0, 1)
+expect("@timestamp ALLOC 4")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("GET_MIN", 2)
+expect("@timestamp MIN 2 0")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+# the lock-free pool is not used by the big events
+command("GET_MIN", 1)
+expect("@timestamp MIN 1 8")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
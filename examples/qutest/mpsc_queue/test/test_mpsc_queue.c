@@ -0,0 +1,249 @@
+/*****************************************************************************
+* Purpose: lock-free MPSC event queue test for the POSIX port
+* Last Updated for Version: 6.9.1
+* Date of the Last Update:  2026-10-16
+*
+*                    Q u a n t u m  L e a P s
+*                    ------------------------
+*                    Modern Embedded Software
+*
+* Copyright (C) 2005-2020 Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <www.gnu.org/licenses/>.
+*
+* Contact information:
+* <www.state-machine.com/licensing>
+* <info@state-machine.com>
+*****************************************************************************/
+/* expose features from the 2008 POSIX standard (IEEE Standard 1003.1-2008) */
+#define _POSIX_C_SOURCE 200809L
+
+#include "qpc.h"
+
+#include <pthread.h>
+#include <sched.h>  /* for sched_yield() */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>   /* for nanosleep() */
+
+Q_DEFINE_THIS_FILE
+
+/*..........................................................................*/
+enum {
+    N_PRODUCERS = 4,     /* the number of the producer threads */
+    N_EVTS      = 20000, /* the number of the events of each producer */
+    LIFO_EVERY  = 1000,  /* the consumer posts to itself LIFO so often */
+    QUEUE_LEN   = 16,    /* the length of the consumer's event queue */
+    POOL_LEN    = 64,    /* the number of the events in the pool */
+    MAX_TICKS   = 3000   /* the test timeout [clock ticks] */
+};
+
+enum TestSignals {
+    SEQ_SIG = Q_USER_SIG, /* the next event of a producer */
+    LIFO_SIG,             /* posted LIFO by the consumer to itself */
+    DONE_SIG,             /* all events of the producers received */
+    MAX_SIG
+};
+
+typedef struct {
+    QEvt super;
+    uint32_t producer; /* the producer of the event */
+    uint32_t seq;      /* the sequence number of the event */
+} SeqEvt;
+
+typedef struct {
+    QActive super;
+    uint32_t last[N_PRODUCERS]; /* the last sequence number per producer */
+    uint32_t nEvts;             /* the number of the events received */
+    bool     lifoNext;          /* must the LIFO event come next? */
+} Consumer;
+
+static QState Consumer_initial(Consumer * const me, QEvt const * const e);
+static QState Consumer_active (Consumer * const me, QEvt const * const e);
+
+static void *producer_thread(void *arg);
+static uint32_t freeEvts(void);
+static void fail(char const *reason);
+
+static Consumer l_consumer;
+static char const * volatile l_failure; /* the reason of the failure */
+static uint32_t l_ticks;
+
+/*..........................................................................*/
+int main(void) {
+    static QEvt const *consumerQueueSto[QUEUE_LEN];
+    static QF_MPOOL_EL(SeqEvt) poolSto[POOL_LEN];
+
+    QF_init();    /* initialize the framework */
+    QF_poolInit(poolSto, sizeof(poolSto), sizeof(poolSto[0]));
+
+    QActive_ctor(&l_consumer.super, Q_STATE_CAST(&Consumer_initial));
+    QACTIVE_START(&l_consumer.super, 1U,
+                  consumerQueueSto, Q_DIM(consumerQueueSto),
+                  (void *)0, 0U, (void *)0);
+
+    (void)QF_run(); /* run until the consumer or the timeout stops QF */
+
+    if (l_failure != (char const *)0) {
+        printf("FAIL: %s\n", l_failure);
+        return 1;
+    }
+    printf("PASS: %d producers x %d events\n", N_PRODUCERS, N_EVTS);
+    return 0;
+}
+
+/*..........................................................................*/
+static QState Consumer_initial(Consumer * const me, QEvt const * const e) {
+    (void)e; /* unused parameter */
+    return Q_TRAN(&Consumer_active);
+}
+/*..........................................................................*/
+static QState Consumer_active(Consumer * const me, QEvt const * const e) {
+    static QEvt const lifoEvt = { LIFO_SIG, 0U, 0U };
+    static QEvt const doneEvt = { DONE_SIG, 0U, 0U };
+    QState status_;
+
+    if (me->lifoNext && (e->sig != LIFO_SIG)) {
+        fail("the LIFO event was not the next event");
+    }
+    switch (e->sig) {
+        case SEQ_SIG: {
+            SeqEvt const *se = Q_EVT_CAST(SeqEvt);
+            if (se->seq != me->last[se->producer] + 1U) {
+                fail("the events of a producer are out of order");
+            }
+            me->last[se->producer] = se->seq;
+            ++me->nEvts;
+            if ((me->nEvts % LIFO_EVERY) == 0U) {
+                /* let the producers fill the queue, but for the one
+                * free entry that they leave for the LIFO event
+                */
+                static struct timespec const fill = { 0, 2000000L };
+                nanosleep(&fill, (struct timespec *)0);
+                QACTIVE_POST_LIFO(&me->super, &lifoEvt);
+                me->lifoNext = true;
+            }
+            if (me->nEvts == (uint32_t)N_PRODUCERS * N_EVTS) {
+                QACTIVE_POST(&me->super, &doneEvt, me);
+            }
+            status_ = Q_HANDLED();
+            break;
+        }
+        case LIFO_SIG: {
+            me->lifoNext = false;
+            status_ = Q_HANDLED();
+            break;
+        }
+        case DONE_SIG: {
+            /* all events of the producers have been recycled by now */
+            if (freeEvts() != POOL_LEN) {
+                fail("the event pool leaks events");
+            }
+            QF_stop();
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status_;
+}
+
+/*..........................................................................*/
+static void *producer_thread(void *arg) {
+    uint32_t const producer = (uint32_t)(uintptr_t)arg;
+    uint32_t seq;
+
+    for (seq = 1U; seq <= N_EVTS; ++seq) {
+        for (;;) { /* retry until the event is posted */
+            SeqEvt *se;
+            Q_NEW_X(se, SeqEvt, 0U, SEQ_SIG); /* margin 0, may fail */
+            if (se != (SeqEvt *)0) {
+                se->producer = producer;
+                se->seq = seq;
+                /* margin 1 leaves a free entry for the LIFO event */
+                if (QACTIVE_POST_X(&l_consumer.super, &se->super, 1U,
+                                   (void *)0))
+                {
+                    break;
+                }
+                /* the event not posted has been recycled already */
+            }
+            sched_yield();
+        }
+    }
+    return (void *)0;
+}
+/*..........................................................................*/
+/* the number of the free events in the pool (allocates and frees them all) */
+static uint32_t freeEvts(void) {
+    static QEvt *evts[POOL_LEN];
+    uint32_t n;
+    uint32_t i;
+
+    for (n = 0U; n < POOL_LEN; ++n) {
+        Q_NEW_X(evts[n], QEvt, 0U, SEQ_SIG); /* margin 0, may fail */
+        if (evts[n] == (QEvt *)0) {
+            break;
+        }
+    }
+    for (i = 0U; i < n; ++i) {
+        QF_gc(evts[i]);
+    }
+    return n;
+}
+/*..........................................................................*/
+static void fail(char const *reason) {
+    if (l_failure == (char const *)0) { /* report only the first failure */
+        l_failure = reason;
+    }
+    QF_stop();
+}
+
+/*..........................................................................*/
+void QF_onStartup(void) {
+    uint32_t i;
+
+    QF_setTickRate(100U, 30); /* 100Hz clock tick rate, ticker priority 30 */
+
+    for (i = 0U; i < N_PRODUCERS; ++i) {
+        pthread_t thread;
+        Q_ALLEGE(pthread_create(&thread, (pthread_attr_t *)0,
+                                &producer_thread, (void *)(uintptr_t)i)
+                 == 0);
+        pthread_detach(thread);
+    }
+}
+/*..........................................................................*/
+void QF_onCleanup(void) {
+}
+/*..........................................................................*/
+void QF_onClockTick(void) {
+    ++l_ticks;
+    if (l_ticks > MAX_TICKS) {
+        fail("timeout");
+    }
+}
+/*..........................................................................*/
+Q_NORETURN Q_onAssert(char const * const module, int_t const loc) {
+    fprintf(stderr, "Assertion failed in %s:%d\n", module, loc);
+    exit(-1);
+}
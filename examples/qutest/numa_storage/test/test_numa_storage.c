@@ -0,0 +1,292 @@
+/*****************************************************************************
+* Purpose: NUMA-aware storage test for the POSIX port
+* Last Updated for Version: 6.9.1
+* Date of the Last Update:  2026-10-16
+*
+*                    Q u a n t u m  L e a P s
+*                    ------------------------
+*                    Modern Embedded Software
+*
+* Copyright (C) 2005-2020 Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <www.gnu.org/licenses/>.
+*
+* Contact information:
+* <www.state-machine.com/licensing>
+* <info@state-machine.com>
+*****************************************************************************/
+/* expose features from the 2008 POSIX standard (IEEE Standard 1003.1-2008) */
+#define _POSIX_C_SOURCE 200809L
+/* expose the GNU extensions (CPU affinity, mincore(), syscall()) */
+#define _GNU_SOURCE
+
+#include "qpc.h"
+
+#include <linux/mempolicy.h> /* for MPOL_DEFAULT and MPOL_PREFERRED */
+#include <sched.h>  /* for sched_getaffinity() */
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>     /* for mincore() */
+#include <sys/syscall.h>  /* for SYS_get_mempolicy and SYS_getcpu */
+#include <unistd.h>
+
+Q_DEFINE_THIS_FILE
+
+/* The event pool and the event queue of the Sink AO are mapped with
+* QF_stoAlloc() on the NUMA node of the CPU the Sink is pinned to. The test
+* checks that the storage is page-aligned, zeroed, prefaulted and bound to
+* that node, and then passes the events through the storage. The binding
+* is checked only when the kernel supports NUMA.
+*/
+
+/*..........................................................................*/
+enum {
+    POOL_SIZE = 3 * 1024 * 1024, /* above the 2MB huge page [bytes] */
+    QUEUE_LEN = 32,   /* the length of the event queue of the Sink */
+    N_EVTS    = 16,   /* the number of the events passed to the Sink */
+    DATA_LEN  = 1000, /* the size of the data in the events [bytes] */
+    MAX_NODES = 1024, /* the NUMA nodes in the mask of get_mempolicy() */
+    MAX_TICKS = 3000  /* the test timeout [clock ticks] */
+};
+
+enum TestSignals {
+    DATA_SIG = Q_USER_SIG, /* the event with the data for the Sink */
+    MAX_SIG
+};
+
+typedef struct {
+    QEvt super;
+    uint32_t seq;            /* the sequence number of the event */
+    uint8_t data[DATA_LEN];  /* the data filled with the sequence number */
+} DataEvt;
+
+typedef struct {
+    QActive super;
+    cpu_set_t cpuSet; /* the CPU the thread runs on */
+    uint32_t nEvts;   /* the number of the events received */
+} Sink;
+
+static QState Sink_initial(Sink * const me, QEvt const * const e);
+static QState Sink_active (Sink * const me, QEvt const * const e);
+
+static void checkStorage(void const * const sto, size_t const size,
+                         int const node);
+static void fail(char const *reason);
+
+static Sink l_sink;
+static uint8_t *l_poolSto; /* the storage of the event pool */
+static char const * volatile l_failure; /* the reason of the failure */
+static uint32_t l_ticks;
+
+/*..........................................................................*/
+int main(void) {
+    QEvt const **queueSto;
+    cpu_set_t allowed;
+    int cpu;
+    int node;
+
+    QF_init();    /* initialize the framework */
+
+    /* pin the Sink to the first allowed CPU */
+    Q_ALLEGE(sched_getaffinity(0, sizeof(allowed), &allowed) == 0);
+    for (cpu = 0; !CPU_ISSET(cpu, &allowed); ++cpu) {
+    }
+    QActive_ctor(&l_sink.super, Q_STATE_CAST(&Sink_initial));
+    CPU_ZERO(&l_sink.cpuSet);
+    CPU_SET(cpu, &l_sink.cpuSet);
+    QActive_setAttr(&l_sink.super, CPU_AFFINITY_ATTR, &l_sink.cpuSet);
+
+    node = QActive_numaNode(&l_sink.super);
+    if (node != QF_numaNodeOfCpu(cpu)) {
+        fail("the AO is not on the NUMA node of its CPU");
+    }
+
+    /* the storage next to the Sink... */
+    l_poolSto = (uint8_t *)QF_stoAlloc(POOL_SIZE, node);
+    checkStorage(l_poolSto, POOL_SIZE, node);
+    queueSto = (QEvt const **)QF_stoAlloc(QUEUE_LEN * sizeof(QEvt *), node);
+    checkStorage(queueSto, QUEUE_LEN * sizeof(QEvt *), node);
+
+    /* ... and the storage not bound to any NUMA node */
+    checkStorage(QF_stoAlloc(1U, -1), 1U, -1);
+
+    QF_poolInit(l_poolSto, POOL_SIZE, sizeof(DataEvt));
+    QACTIVE_START(&l_sink.super, 1U, queueSto, QUEUE_LEN,
+                  (void *)0, 0U, (void *)0);
+
+    (void)QF_run(); /* run until the Sink or the timeout stop QF */
+
+    if (l_failure != (char const *)0) {
+        printf("FAIL: %s\n", l_failure);
+        return 1;
+    }
+    printf("PASS: %d events through the storage on the NUMA node %d\n",
+           N_EVTS, node);
+    return 0;
+}
+
+/*..........................................................................*/
+static QState Sink_initial(Sink * const me, QEvt const * const e) {
+    (void)me; /* unused parameter */
+    (void)e;  /* unused parameter */
+    return Q_TRAN(&Sink_active);
+}
+/*..........................................................................*/
+static QState Sink_active(Sink * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case DATA_SIG: {
+            DataEvt const *de = Q_EVT_CAST(DataEvt);
+            uint32_t i;
+
+            if (((uint8_t const *)de < l_poolSto)
+                || ((uint8_t const *)de >= l_poolSto + POOL_SIZE))
+            {
+                fail("the event is not in the storage of the pool");
+            }
+            for (i = 0U; i < DATA_LEN; ++i) {
+                if (de->data[i] != (uint8_t)de->seq) {
+                    fail("the data of the event are corrupted");
+                }
+            }
+
+            ++me->nEvts;
+            if (me->nEvts == N_EVTS) { /* the last event? */
+                unsigned cpu = 0U;
+                unsigned node = 0U;
+                int const aoNode = QActive_numaNode(&me->super);
+
+                /* the AO thread runs on the NUMA node of the storage */
+                if ((aoNode >= 0)
+                    && (syscall(SYS_getcpu, &cpu, &node, (void *)0) == 0)
+                    && ((int)node != aoNode))
+                {
+                    fail("the AO thread runs on another NUMA node");
+                }
+                QF_stop();
+            }
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status_;
+}
+
+/*..........................................................................*/
+/* check the storage mapped by QF_stoAlloc() on the NUMA 'node' */
+static void checkStorage(void const * const sto, size_t const size,
+                         int const node)
+{
+    static unsigned char resident[POOL_SIZE / 4096 + 1];
+    static unsigned long nodeMask[MAX_NODES / (8 * sizeof(long))];
+    size_t const pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    size_t const nPages = (size + pageSize - 1U) / pageSize;
+    int mode = -1;
+    size_t i;
+
+    if (((uintptr_t)sto % pageSize) != 0U) {
+        fail("the storage is not page-aligned");
+    }
+
+    /* the pages are prefaulted, so they are all resident
+    * (checked before reading them, which would fault them in)
+    */
+    Q_ASSERT(nPages <= sizeof(resident));
+    if (mincore((void *)sto, size, resident) != 0) {
+        fail("the storage is not mapped");
+    }
+    for (i = 0U; i < nPages; ++i) {
+        if ((resident[i] & 1U) == 0U) {
+            fail("the storage is not prefaulted");
+        }
+    }
+
+    for (i = 0U; i < size; ++i) {
+        if (((uint8_t const *)sto)[i] != 0U) {
+            fail("the storage is not zeroed");
+        }
+    }
+
+    /* without the NUMA support in the kernel the binding fails */
+    if (syscall(SYS_get_mempolicy, &mode, nodeMask,
+                (unsigned long)MAX_NODES, sto, MPOL_F_ADDR) == 0)
+    {
+        if (node < 0) {
+            if (mode != MPOL_DEFAULT) {
+                fail("the unbound storage has a NUMA policy");
+            }
+        }
+        else if ((mode != MPOL_PREFERRED)
+                 || ((nodeMask[(size_t)node / (8U * sizeof(long))]
+                      & (1UL << ((size_t)node % (8U * sizeof(long)))))
+                     == 0U))
+        {
+            fail("the storage is not bound to the NUMA node");
+        }
+        else {
+            /* the storage is bound to the NUMA node */
+        }
+    }
+}
+/*..........................................................................*/
+static void fail(char const *reason) {
+    if (l_failure == (char const *)0) { /* report only the first failure */
+        l_failure = reason;
+    }
+    QF_stop();
+}
+
+/*..........................................................................*/
+void QF_onStartup(void) {
+    QF_setTickRate(100U, 30); /* 100Hz clock tick rate, ticker priority 30 */
+}
+/*..........................................................................*/
+void QF_onCleanup(void) {
+}
+/*..........................................................................*/
+void QF_onClockTick(void) {
+    ++l_ticks;
+    if (l_ticks == 1U) { /* the first tick (QF is running)? */
+        uint32_t seq;
+        for (seq = 0U; seq < N_EVTS; ++seq) {
+            DataEvt *de = Q_NEW(DataEvt, DATA_SIG);
+            uint32_t i;
+            de->seq = seq;
+            for (i = 0U; i < DATA_LEN; ++i) {
+                de->data[i] = (uint8_t)seq;
+            }
+            QACTIVE_POST(&l_sink.super, &de->super, (void *)0);
+        }
+    }
+    else if (l_ticks > MAX_TICKS) {
+        fail("timeout");
+    }
+    else {
+        /* the events are on their way */
+    }
+}
+/*..........................................................................*/
+Q_NORETURN Q_onAssert(char const * const module, int_t const loc) {
+    fprintf(stderr, "Assertion failed in %s:%d\n", module, loc);
+    exit(-1);
+}
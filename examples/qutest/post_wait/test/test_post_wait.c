@@ -0,0 +1,335 @@
+/*****************************************************************************
+* Purpose: blocking post test for the POSIX port
+* Last Updated for Version: 6.9.1
+* Date of the Last Update:  2026-10-16
+*
+*                    Q u a n t u m  L e a P s
+*                    ------------------------
+*                    Modern Embedded Software
+*
+* Copyright (C) 2005-2020 Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <www.gnu.org/licenses/>.
+*
+* Contact information:
+* <www.state-machine.com/licensing>
+* <info@state-machine.com>
+*****************************************************************************/
+/* expose features from the 2008 POSIX standard (IEEE Standard 1003.1-2008) */
+#define _POSIX_C_SOURCE 200809L
+
+#include "qpc.h"
+
+#include <pthread.h>
+#include <sched.h>  /* for sched_yield() */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>   /* for nanosleep() and clock_gettime() */
+
+Q_DEFINE_THIS_FILE
+
+/* The producers post to the Sink AO faster than it processes the events,
+* so they keep waiting for the free entries in its short queue, and no
+* QACTIVE_POST_WAIT() may time out. Then the Sink stalls, so that the queue
+* stays full, and QACTIVE_POST_WAIT() must time out and recycle the event.
+*/
+
+/*..........................................................................*/
+#define NSEC_PER_MSEC 1000000LL
+
+enum {
+    N_PRODUCERS = 4,     /* the number of the producer threads */
+    N_EVTS      = 20000, /* the number of the events of each producer */
+    POOL_LEN    = 32,    /* the number of the events in the pool */
+    QUEUE_LEN   = 8,     /* the length of the Sink event queue */
+    MARGIN      = 1,     /* the margin of QACTIVE_POST_WAIT() */
+    WAIT_MS     = 2000,  /* the timeout of QACTIVE_POST_WAIT() [ms] */
+    STALL_MS    = 300,   /* the stall of the Sink [ms] */
+    TIMEOUT_MS  = 1,     /* the timeout expected to expire [ms] */
+    MAX_TICKS   = 3000   /* the test timeout [clock ticks] */
+};
+
+enum TestSignals {
+    UPD_SIG = Q_USER_SIG, /* posted by the producers to the Sink AO */
+    STALL_SIG,            /* stalls the Sink AO for STALL_MS */
+    DONE_SIG,             /* all events of the producers posted */
+    MAX_SIG
+};
+
+typedef struct {
+    QEvt super;
+    uint32_t producer; /* the producer of the event (N_PRODUCERS: stalled) */
+    uint32_t seq;      /* the sequence number of the event */
+} SeqEvt;
+
+typedef struct {
+    QActive super;
+    uint32_t last[N_PRODUCERS + 1]; /* the last sequence number */
+    uint32_t nEvts;                 /* the number of the events received */
+} Sink;
+
+static QState Sink_initial(Sink * const me, QEvt const * const e);
+static QState Sink_active (Sink * const me, QEvt const * const e);
+
+static void *producer_thread(void *arg);
+static void timeoutPost(void);
+static SeqEvt *newSeqEvt(uint32_t const producer, uint32_t const seq);
+static int64_t nowNsec(void);
+static void sleepNsec(int64_t const nsec);
+static uint32_t freeEvts(void);
+static void fail(char const *reason);
+
+static Sink l_sink;
+static pthread_t l_producers[N_PRODUCERS];
+static int l_nDone;     /* the number of the producers done (atomic) */
+static uint32_t l_nStalled; /* the events posted while the Sink stalled */
+static char const * volatile l_failure; /* the reason of the failure */
+static uint32_t l_ticks;
+
+/*..........................................................................*/
+int main(void) {
+    static QEvt const *sinkQueueSto[QUEUE_LEN];
+    static QF_MPOOL_EL(SeqEvt) poolSto[POOL_LEN];
+    uint_fast8_t n;
+
+    QF_init();    /* initialize the framework */
+    QF_poolInit(poolSto, sizeof(poolSto), sizeof(poolSto[0]));
+
+    QActive_ctor(&l_sink.super, Q_STATE_CAST(&Sink_initial));
+    QACTIVE_START(&l_sink.super, 1U,
+                  sinkQueueSto, Q_DIM(sinkQueueSto),
+                  (void *)0, 0U, (void *)0);
+
+    (void)QF_run(); /* run until the Sink AO or a failure stops QF */
+
+    for (n = 0U; n < N_PRODUCERS; ++n) {
+        pthread_join(l_producers[n], (void **)0);
+    }
+    if (freeEvts() != POOL_LEN) {
+        fail("the event pool leaks events");
+    }
+
+    if (l_failure != (char const *)0) {
+        printf("FAIL: %s\n", l_failure);
+        return 1;
+    }
+    printf("PASS: %d producers x %d events, %u events before the timeout\n",
+           N_PRODUCERS, N_EVTS, (unsigned)l_nStalled);
+    return 0;
+}
+
+/*..........................................................................*/
+static QState Sink_initial(Sink * const me, QEvt const * const e) {
+    (void)e; /* unused parameter */
+    return Q_TRAN(&Sink_active);
+}
+/*..........................................................................*/
+static QState Sink_active(Sink * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case UPD_SIG: {
+            SeqEvt const *se = Q_EVT_CAST(SeqEvt);
+            if (se->seq != me->last[se->producer] + 1U) {
+                fail("the events of a producer are out of order");
+            }
+            me->last[se->producer] = se->seq;
+            ++me->nEvts;
+            if ((me->nEvts & 7U) == 0U) { /* slow down the Sink */
+                sleepNsec(10000);
+            }
+            status_ = Q_HANDLED();
+            break;
+        }
+        case STALL_SIG: {
+            sleepNsec(STALL_MS * NSEC_PER_MSEC);
+            status_ = Q_HANDLED();
+            break;
+        }
+        case DONE_SIG: {
+            if (me->nEvts != ((uint32_t)N_PRODUCERS * N_EVTS) + l_nStalled) {
+                fail("the Sink did not receive all posted events");
+            }
+            QF_stop();
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status_;
+}
+
+/*..........................................................................*/
+static void *producer_thread(void *arg) {
+    uint32_t const producer = (uint32_t)(uintptr_t)arg;
+    uint32_t seq;
+
+    for (seq = 1U; seq <= N_EVTS; ++seq) {
+        SeqEvt *se = newSeqEvt(producer, seq);
+        if (se == (SeqEvt *)0) { /* test already failed? */
+            return (void *)0;
+        }
+        if (!QACTIVE_POST_WAIT(&l_sink.super, &se->super, MARGIN,
+                               WAIT_MS * NSEC_PER_MSEC, (void *)0))
+        {
+            fail("QACTIVE_POST_WAIT() timed out with a running Sink");
+            return (void *)0;
+        }
+    }
+
+    /* the last producer done? */
+    if (__atomic_add_fetch(&l_nDone, 1, __ATOMIC_SEQ_CST) == N_PRODUCERS) {
+        timeoutPost();
+    }
+    return (void *)0;
+}
+/*..........................................................................*/
+/* stall the Sink, post to its full queue until QACTIVE_POST_WAIT() times
+* out and then post DONE_SIG, which waits until the Sink recovers
+*/
+static void timeoutPost(void) {
+    static QEvt const stallEvt = { STALL_SIG, 0U, 0U };
+    static QEvt const doneEvt  = { DONE_SIG,  0U, 0U };
+    bool posted = true;
+
+    if (!QACTIVE_POST_WAIT(&l_sink.super, &stallEvt, MARGIN,
+                           WAIT_MS * NSEC_PER_MSEC, (void *)0))
+    {
+        fail("QACTIVE_POST_WAIT() of STALL_SIG timed out");
+        return;
+    }
+    while (posted && (l_nStalled <= QUEUE_LEN)) {
+        SeqEvt *se = newSeqEvt(N_PRODUCERS, l_nStalled + 1U);
+        int64_t const start = nowNsec();
+        int64_t elapsed;
+
+        if (se == (SeqEvt *)0) { /* test already failed? */
+            return;
+        }
+        posted = QACTIVE_POST_WAIT(&l_sink.super, &se->super, MARGIN,
+                                   TIMEOUT_MS * NSEC_PER_MSEC, (void *)0);
+        elapsed = nowNsec() - start;
+        if (posted) {
+            ++l_nStalled;
+        }
+        else if (elapsed < TIMEOUT_MS * NSEC_PER_MSEC) {
+            fail("QACTIVE_POST_WAIT() timed out too early");
+        }
+        else if (elapsed > (STALL_MS / 2) * NSEC_PER_MSEC) {
+            fail("QACTIVE_POST_WAIT() timed out too late");
+        }
+        else {
+            /* QACTIVE_POST_WAIT() timed out on time */
+        }
+    }
+    if (posted) {
+        fail("QACTIVE_POST_WAIT() did not time out with a full queue");
+    }
+    if (!QACTIVE_POST_WAIT(&l_sink.super, &doneEvt, MARGIN,
+                           WAIT_MS * NSEC_PER_MSEC, (void *)0))
+    {
+        fail("QACTIVE_POST_WAIT() of DONE_SIG timed out");
+    }
+}
+/*..........................................................................*/
+/* a new SeqEvt, or NULL when the test already failed */
+static SeqEvt *newSeqEvt(uint32_t const producer, uint32_t const seq) {
+    SeqEvt *se;
+    for (;;) { /* retry until an event is available */
+        Q_NEW_X(se, SeqEvt, 0U, UPD_SIG); /* margin 0, may fail */
+        if (se != (SeqEvt *)0) {
+            break;
+        }
+        if (l_failure != (char const *)0) { /* test already failed? */
+            return (SeqEvt *)0;
+        }
+        sched_yield();
+    }
+    se->producer = producer;
+    se->seq = seq;
+    return se;
+}
+/*..........................................................................*/
+static int64_t nowNsec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((int64_t)ts.tv_sec * 1000 * NSEC_PER_MSEC) + ts.tv_nsec;
+}
+/*..........................................................................*/
+static void sleepNsec(int64_t const nsec) {
+    struct timespec ts;
+    ts.tv_sec  = (time_t)(nsec / (1000 * NSEC_PER_MSEC));
+    ts.tv_nsec = (long)(nsec % (1000 * NSEC_PER_MSEC));
+    nanosleep(&ts, (struct timespec *)0);
+}
+/*..........................................................................*/
+/* the number of the free events in the pool (allocates and frees them all) */
+static uint32_t freeEvts(void) {
+    static QEvt *evts[POOL_LEN];
+    uint32_t n;
+    uint32_t i;
+
+    for (n = 0U; n < POOL_LEN; ++n) {
+        Q_NEW_X(evts[n], QEvt, 0U, UPD_SIG); /* margin 0, may fail */
+        if (evts[n] == (QEvt *)0) {
+            break;
+        }
+    }
+    for (i = 0U; i < n; ++i) {
+        QF_gc(evts[i]);
+    }
+    return n;
+}
+/*..........................................................................*/
+static void fail(char const *reason) {
+    if (l_failure == (char const *)0) { /* report only the first failure */
+        l_failure = reason;
+    }
+    QF_stop();
+}
+
+/*..........................................................................*/
+void QF_onStartup(void) {
+    uint32_t i;
+
+    QF_setTickRate(100U, 30); /* 100Hz clock tick rate, ticker priority 30 */
+
+    for (i = 0U; i < N_PRODUCERS; ++i) {
+        Q_ALLEGE(pthread_create(&l_producers[i], (pthread_attr_t *)0,
+                                &producer_thread, (void *)(uintptr_t)i)
+                 == 0);
+    }
+}
+/*..........................................................................*/
+void QF_onCleanup(void) {
+}
+/*..........................................................................*/
+void QF_onClockTick(void) {
+    ++l_ticks;
+    if (l_ticks > MAX_TICKS) {
+        fail("timeout");
+    }
+}
+/*..........................................................................*/
+Q_NORETURN Q_onAssert(char const * const module, int_t const loc) {
+    fprintf(stderr, "Assertion failed in %s:%d\n", module, loc);
+    exit(-1);
+}
@@ -0,0 +1,234 @@
+/*****************************************************************************
+* Purpose: hierarchical priority set QUTEST fixture
+* Last Updated for Version: 6.9.1
+* Date of the Last Update:  2026-10-16
+*
+*                    Q u a n t u m  L e a P s
+*                    ------------------------
+*                    Modern Embedded Software
+*
+* Copyright (C) 2005-2020 Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <www.gnu.org/licenses/>.
+*
+* Contact information:
+* <www.state-machine.com/licensing>
+* <info@state-machine.com>
+*****************************************************************************/
+#include "qpc.h" /* QUTest interface */
+
+Q_DEFINE_THIS_FILE
+
+/*..........................................................................*/
+enum {
+    N_WORKERS = 6U /* the number of the worker AOs */
+};
+
+/* the priorities of the workers, at the edges of the 64-element leaves */
+static uint8_t const l_workerPrio[N_WORKERS] = {
+    1U, 63U, 64U, 65U, 129U, 200U
+};
+
+enum TestSignals {
+    PING_SIG = Q_USER_SIG, /* posted or published to the workers */
+    MAX_PUB_SIG
+};
+
+typedef struct {
+    QActive super;
+} Worker;
+
+static QState Worker_initial(Worker * const me, QEvt const * const e);
+static QState Worker_active (Worker * const me, QEvt const * const e);
+
+static Worker l_workers[N_WORKERS];
+static QPSet l_set; /* the priority set manipulated by the commands */
+static uint8_t const l_fixture = 0U; /* QS sender of the events */
+
+enum {
+    RECV = QS_USER, /* the worker with priority 'prio' received PING_SIG */
+    MAX,            /* the maximum element of the set */
+    HAS             /* the set has the element 'n' (1) or not (0) */
+};
+
+enum {
+    POST = 0,  /* post PING_SIG to the workers in the bitmask 'param1' */
+    PUBLISH,   /* publish PING_SIG to all workers */
+    INSERT,    /* insert the element 'param1' into the set */
+    REMOVE,    /* remove the element 'param1' from the set */
+    HAS_ELEM,  /* report whether the set has the element 'param1' */
+    FIND_MAX,  /* report the maximum element of the set */
+    SET_EMPTY  /* make the set empty */
+};
+
+/*..........................................................................*/
+int main(int argc, char *argv[]) {
+    static QSubscrList subscrSto[MAX_PUB_SIG];
+    static QF_MPOOL_EL(QEvt) smlPoolSto[N_WORKERS];
+    static QEvt const *workerQueueSto[N_WORKERS][4];
+    uint_fast8_t n;
+
+    QF_init();   /* initialize the framework */
+
+    /* initialize the QS software tracing */
+    Q_ALLEGE(QS_INIT(argc > 1 ? argv[1] : (void *)0));
+
+    /* object dictionaries... */
+    QS_OBJ_DICTIONARY(&l_fixture);
+
+    QS_TEST_PAUSE();
+
+    /* initialize publish-subscribe... */
+    QF_psInit(subscrSto, Q_DIM(subscrSto));
+
+    /* initialize event pools... */
+    QF_poolInit(smlPoolSto, sizeof(smlPoolSto), sizeof(smlPoolSto[0]));
+
+    /* start active objects... */
+    for (n = 0U; n < N_WORKERS; ++n) {
+        QActive_ctor(&l_workers[n].super, Q_STATE_CAST(&Worker_initial));
+        QACTIVE_START(&l_workers[n].super, /* AO to start */
+                      l_workerPrio[n],       /* QP priority of the AO */
+                      workerQueueSto[n],     /* event queue storage */
+                      Q_DIM(workerQueueSto[n]),/* queue length [events] */
+                      (void *)0,             /* stack storage (not used) */
+                      0U,                    /* size of the stack [bytes] */
+                      (QEvt *)0);            /* initialization event */
+    }
+
+    return QF_run(); /* run the QF application */
+}
+
+/*..........................................................................*/
+static QState Worker_initial(Worker * const me, QEvt const * const e) {
+    (void)e; /* unused parameter */
+    QActive_subscribe(&me->super, PING_SIG);
+    return Q_TRAN(&Worker_active);
+}
+/*..........................................................................*/
+static QState Worker_active(Worker * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case PING_SIG: {
+            QS_BEGIN_ID(RECV, 0U) /* app-specific record */
+                QS_U16(0, (uint16_t)me->super.prio);
+            QS_END()
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status_;
+}
+
+/*--------------------------------------------------------------------------*/
+void QS_onTestSetup(void) {
+    QS_USR_DICTIONARY(RECV);
+    QS_USR_DICTIONARY(MAX);
+    QS_USR_DICTIONARY(HAS);
+    QS_USR_DICTIONARY(POST);
+    QS_USR_DICTIONARY(PUBLISH);
+    QS_USR_DICTIONARY(INSERT);
+    QS_USR_DICTIONARY(REMOVE);
+    QS_USR_DICTIONARY(HAS_ELEM);
+    QS_USR_DICTIONARY(FIND_MAX);
+    QS_USR_DICTIONARY(SET_EMPTY);
+}
+/*..........................................................................*/
+void QS_onTestTeardown(void) {
+    QPSet_setEmpty(&l_set);
+}
+
+/*..........................................................................*/
+/*! callback function to execute user commands */
+void QS_onCommand(uint8_t cmdId,
+                  uint32_t param1, uint32_t param2, uint32_t param3)
+{
+    (void)param2; /* unused parameter */
+    (void)param3; /* unused parameter */
+
+    switch (cmdId) {
+        case POST: {
+            uint_fast8_t n;
+            /* post in the order of increasing priorities */
+            for (n = 0U; n < N_WORKERS; ++n) {
+                if ((param1 & (1U << n)) != 0U) {
+                    QEvt *e = Q_NEW(QEvt, PING_SIG);
+                    QACTIVE_POST(&l_workers[n].super, e, &l_fixture);
+                }
+            }
+            break;
+        }
+        case PUBLISH: {
+            QEvt *e = Q_NEW(QEvt, PING_SIG);
+            QF_PUBLISH(e, &l_fixture);
+            break;
+        }
+        case INSERT: {
+            QPSet_insert(&l_set, param1);
+            break;
+        }
+        case REMOVE: {
+            QPSet_remove(&l_set, param1);
+            break;
+        }
+        case HAS_ELEM: {
+            QS_BEGIN_ID(HAS, 0U) /* app-specific record */
+                QS_U16(0, (uint16_t)param1);
+                QS_U8(0, QPSet_hasElement(&l_set, param1) ? 1U : 0U);
+            QS_END()
+            break;
+        }
+        case FIND_MAX: {
+            uint_fast16_t n;
+            QPSet_findMax(&l_set, n);
+            QS_BEGIN_ID(MAX, 0U) /* app-specific record */
+                QS_U16(0, (uint16_t)n);
+            QS_END()
+            break;
+        }
+        case SET_EMPTY: {
+            QPSet_setEmpty(&l_set);
+            break;
+        }
+        default:
+            break;
+    }
+}
+/*..........................................................................*/
+/*! callback function to "massage" the injected QP events (not used here) */
+void QS_onTestEvt(QEvt *e) {
+    (void)e;
+#ifdef Q_HOST  /* is this test compiled for a desktop Host computer? */
+#else /* embedded Target */
+#endif /* embedded Target */
+}
+/*..........................................................................*/
+/*! callback function to output the posted QP events (not used here) */
+void QS_onTestPost(void const *sender, QActive *recipient,
+                   QEvt const *e, bool status)
+{
+    (void)sender;
+    (void)recipient;
+    (void)e;
+    (void)status;
+}
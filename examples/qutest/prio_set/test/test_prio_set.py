@@ -0,0 +1,103 @@
+# test-script for QUTest unit testing harness
+# see https://www.state-machine.com/qtools/html
+
+# preamble...
+def on_reset():
+    expect_pause()
+    glb_filter(GRP_UA)
+    continue_test()
+    expect_run()
+
+# QF_MAX_ACTIVE is 200, so the priority set has four 64-element leaves,
+# and the workers have the priorities 1, 63, 64, 65, 129 and 200
+# (see test_prio_set.c)
+
+# tests...
+test("Dispatch the events to the AOs in all leaves by priority")
+command("POST", 0x3F)
+expect("@timestamp RECV 200")
+expect("@timestamp RECV 129")
+expect("@timestamp RECV 65")
+expect("@timestamp RECV 64")
+expect("@timestamp RECV 63")
+expect("@timestamp RECV 1")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("POST", 0x15)
+expect("@timestamp RECV 129")
+expect("@timestamp RECV 64")
+expect("@timestamp RECV 1")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+
+test("Publish to the subscribers in all leaves by priority")
+command("PUBLISH")
+expect("@timestamp RECV 200")
+expect("@timestamp RECV 129")
+expect("@timestamp RECV 65")
+expect("@timestamp RECV 64")
+expect("@timestamp RECV 63")
+expect("@timestamp RECV 1")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+
+test("Find the maximum element across the leaves")
+command("FIND_MAX")
+expect("@timestamp MAX 0")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("INSERT", 1)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("INSERT", 64)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("INSERT", 65)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("INSERT", 200)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("FIND_MAX")
+expect("@timestamp MAX 200")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("REMOVE", 200)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("FIND_MAX")
+expect("@timestamp MAX 65")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("REMOVE", 65)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("FIND_MAX")
+expect("@timestamp MAX 64")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("REMOVE", 64)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("FIND_MAX")
+expect("@timestamp MAX 1")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("REMOVE", 1)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("FIND_MAX")
+expect("@timestamp MAX 0")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+
+test("Ignore the stale elements of the lazily cleared leaves")
+command("INSERT", 70)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("INSERT", 100)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("SET_EMPTY")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+# the leaf of the elements 65..128 still holds 70 and 100
+command("HAS_ELEM", 100)
+expect("@timestamp HAS 100 0")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("INSERT", 127)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("HAS_ELEM", 70)
+expect("@timestamp HAS 70 0")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("HAS_ELEM", 127)
+expect("@timestamp HAS 127 1")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+# removing from a stale leaf leaves the set empty
+command("REMOVE", 127)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("REMOVE", 190)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("FIND_MAX")
+expect("@timestamp MAX 0")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
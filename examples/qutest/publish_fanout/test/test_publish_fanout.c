@@ -0,0 +1,284 @@
+/*****************************************************************************
+* Purpose: publish fan-out test for the POSIX port
+* Last Updated for Version: 6.9.1
+* Date of the Last Update:  2026-10-16
+*
+*                    Q u a n t u m  L e a P s
+*                    ------------------------
+*                    Modern Embedded Software
+*
+* Copyright (C) 2005-2020 Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <www.gnu.org/licenses/>.
+*
+* Contact information:
+* <www.state-machine.com/licensing>
+* <info@state-machine.com>
+*****************************************************************************/
+/* expose features from the 2008 POSIX standard (IEEE Standard 1003.1-2008) */
+#define _POSIX_C_SOURCE 200809L
+
+#include "qpc.h"
+
+#include <pthread.h>
+#include <sched.h>  /* for sched_yield() */
+#include <stdio.h>
+#include <stdlib.h>
+
+Q_DEFINE_THIS_FILE
+
+/* The FAN_SIG events have more subscribers than QF_PUBLISH_FANOUT, so they
+* take the single-pass fan-out, which leaves the QTicker subscriber (which
+* overrides the post operation) to QACTIVE_POST(). The SOLO_SIG events have
+* only one subscriber, so they are posted by QACTIVE_POST() alone.
+*/
+
+/*..........................................................................*/
+enum {
+    N_PRODUCERS = 4,     /* the number of the producer threads */
+    N_CONSUMERS = 3,     /* the number of the subscriber AOs */
+    N_EVTS      = 20000, /* the number of the events of each producer */
+    POOL_LEN    = 32,    /* the number of the events in the pool */
+    QUEUE_LEN   = 40,    /* more than all events that can be in flight */
+    TICKER_PRIO = N_CONSUMERS + 1, /* the priority of the QTicker */
+    MAX_TICKS   = 3000   /* the test timeout [clock ticks] */
+};
+
+enum TestSignals {
+    FAN_SIG = Q_USER_SIG, /* published to all consumers and the QTicker */
+    SOLO_SIG,             /* published to the consumer 0 only */
+    MAX_PUB_SIG,          /* the last published signal */
+
+    TIMEOUT_SIG,          /* the time event of the consumer 0 at rate 1 */
+    DONE_SIG,             /* all events of the producers received */
+    MAX_SIG
+};
+
+typedef struct {
+    QEvt super;
+    uint32_t producer; /* the producer of the event */
+    uint32_t seq;      /* the sequence number of the event */
+} SeqEvt;
+
+typedef struct {
+    QActive super;
+    QTimeEvt timeEvt;           /* one-shot time event at the tick rate 1 */
+    uint32_t last[N_PRODUCERS]; /* the last sequence number per producer */
+    uint32_t nEvts;             /* the number of the events received */
+    uint32_t nExpected;         /* the number of the events expected */
+    bool     isTimeout;         /* has the time event expired? */
+} Consumer;
+
+static QState Consumer_initial(Consumer * const me, QEvt const * const e);
+static QState Consumer_active (Consumer * const me, QEvt const * const e);
+
+static void *producer_thread(void *arg);
+static uint32_t freeEvts(void);
+static void fail(char const *reason);
+
+static Consumer l_consumers[N_CONSUMERS];
+static QTicker l_ticker1; /* ticks the rate 1 for every FAN_SIG event */
+static pthread_t l_producers[N_PRODUCERS];
+static int l_nDone; /* the number of the consumers done (atomic) */
+static char const * volatile l_failure; /* the reason of the failure */
+static uint32_t l_ticks;
+
+/*..........................................................................*/
+int main(void) {
+    static QEvt const *consumerQueueSto[N_CONSUMERS][QUEUE_LEN];
+    static QSubscrList subscrSto[MAX_PUB_SIG];
+    static QF_MPOOL_EL(SeqEvt) poolSto[POOL_LEN];
+    uint_fast8_t n;
+
+    QF_init();    /* initialize the framework */
+    QF_psInit(subscrSto, Q_DIM(subscrSto));
+    QF_poolInit(poolSto, sizeof(poolSto), sizeof(poolSto[0]));
+
+    for (n = 0U; n < N_CONSUMERS; ++n) {
+        QActive_ctor(&l_consumers[n].super,
+                     Q_STATE_CAST(&Consumer_initial));
+        QTimeEvt_ctorX(&l_consumers[n].timeEvt, &l_consumers[n].super,
+                       TIMEOUT_SIG, 1U);
+        l_consumers[n].nExpected = (n == 0U)
+            ? (uint32_t)N_PRODUCERS * N_EVTS      /* FAN_SIG + SOLO_SIG */
+            : (uint32_t)(N_PRODUCERS - 1) * N_EVTS; /* FAN_SIG only */
+        QACTIVE_START(&l_consumers[n].super, (uint_fast8_t)(n + 1U),
+                      consumerQueueSto[n], Q_DIM(consumerQueueSto[n]),
+                      (void *)0, 0U, (void *)0);
+    }
+
+    QTicker_ctor(&l_ticker1, 1U); /* ticker AO for the tick rate 1 */
+    QACTIVE_START(&l_ticker1.super, TICKER_PRIO,
+                  (QEvt const **)0, 0U, (void *)0, 0U, (void *)0);
+    QActive_subscribe(&l_ticker1.super, FAN_SIG);
+
+    (void)QF_run(); /* run until the consumers or the timeout stop QF */
+
+    /* the publishers hold the events until QF_publish_() returns, so the
+    * event pool can be checked only after all producers are done
+    */
+    for (n = 0U; n < N_PRODUCERS; ++n) {
+        pthread_join(l_producers[n], (void **)0);
+    }
+    if (freeEvts() != POOL_LEN) {
+        fail("the event pool leaks events");
+    }
+
+    if (l_failure != (char const *)0) {
+        printf("FAIL: %s\n", l_failure);
+        return 1;
+    }
+    printf("PASS: %d producers x %d events to %d subscribers\n",
+           N_PRODUCERS, N_EVTS, N_CONSUMERS + 1);
+    return 0;
+}
+
+/*..........................................................................*/
+static QState Consumer_initial(Consumer * const me, QEvt const * const e) {
+    (void)e; /* unused parameter */
+    QActive_subscribe(&me->super, FAN_SIG);
+    if (me == &l_consumers[0]) {
+        QActive_subscribe(&me->super, SOLO_SIG);
+    }
+    QTimeEvt_armX(&me->timeEvt, 100U, 0U); /* 100 ticks at the rate 1 */
+    return Q_TRAN(&Consumer_active);
+}
+/*..........................................................................*/
+static QState Consumer_active(Consumer * const me, QEvt const * const e) {
+    static QEvt const doneEvt = { DONE_SIG, 0U, 0U };
+    QState status_;
+    switch (e->sig) {
+        case FAN_SIG: /* intentionally fall through */
+        case SOLO_SIG: {
+            SeqEvt const *se = Q_EVT_CAST(SeqEvt);
+            if (se->seq != me->last[se->producer] + 1U) {
+                fail("the events of a producer are out of order");
+            }
+            me->last[se->producer] = se->seq;
+            ++me->nEvts;
+            if (me->nEvts == me->nExpected) {
+                QACTIVE_POST(&me->super, &doneEvt, me);
+            }
+            status_ = Q_HANDLED();
+            break;
+        }
+        case TIMEOUT_SIG: {
+            me->isTimeout = true;
+            status_ = Q_HANDLED();
+            break;
+        }
+        case DONE_SIG: {
+            if (!me->isTimeout) {
+                fail("the QTicker subscriber did not tick the rate 1");
+            }
+            if (__atomic_add_fetch(&l_nDone, 1, __ATOMIC_SEQ_CST)
+                == N_CONSUMERS) /* the last consumer done? */
+            {
+                QF_stop();
+            }
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status_;
+}
+
+/*..........................................................................*/
+static void *producer_thread(void *arg) {
+    uint32_t const producer = (uint32_t)(uintptr_t)arg;
+    /* the last producer publishes to the consumer 0 only */
+    enum_t const sig = (producer < N_PRODUCERS - 1) ? FAN_SIG : SOLO_SIG;
+    uint32_t seq;
+
+    for (seq = 1U; seq <= N_EVTS; ++seq) {
+        SeqEvt *se;
+        for (;;) { /* retry until an event is available */
+            Q_NEW_X(se, SeqEvt, 0U, sig); /* margin 0, may fail */
+            if (se != (SeqEvt *)0) {
+                break;
+            }
+            if (l_failure != (char const *)0) { /* test already failed? */
+                return (void *)0;
+            }
+            sched_yield();
+        }
+        se->producer = producer;
+        se->seq = seq;
+        /* the subscriber queues can take all events of the pool */
+        QF_PUBLISH(&se->super, (void *)0);
+    }
+    return (void *)0;
+}
+/*..........................................................................*/
+/* the number of the free events in the pool (allocates and frees them all) */
+static uint32_t freeEvts(void) {
+    static QEvt *evts[POOL_LEN];
+    uint32_t n;
+    uint32_t i;
+
+    for (n = 0U; n < POOL_LEN; ++n) {
+        Q_NEW_X(evts[n], QEvt, 0U, FAN_SIG); /* margin 0, may fail */
+        if (evts[n] == (QEvt *)0) {
+            break;
+        }
+    }
+    for (i = 0U; i < n; ++i) {
+        QF_gc(evts[i]);
+    }
+    return n;
+}
+/*..........................................................................*/
+static void fail(char const *reason) {
+    if (l_failure == (char const *)0) { /* report only the first failure */
+        l_failure = reason;
+    }
+    QF_stop();
+}
+
+/*..........................................................................*/
+void QF_onStartup(void) {
+    uint32_t i;
+
+    QF_setTickRate(100U, 30); /* 100Hz clock tick rate, ticker priority 30 */
+
+    for (i = 0U; i < N_PRODUCERS; ++i) {
+        Q_ALLEGE(pthread_create(&l_producers[i], (pthread_attr_t *)0,
+                                &producer_thread, (void *)(uintptr_t)i)
+                 == 0);
+    }
+}
+/*..........................................................................*/
+void QF_onCleanup(void) {
+}
+/*..........................................................................*/
+void QF_onClockTick(void) {
+    ++l_ticks;
+    if (l_ticks > MAX_TICKS) {
+        fail("timeout");
+    }
+}
+/*..........................................................................*/
+Q_NORETURN Q_onAssert(char const * const module, int_t const loc) {
+    fprintf(stderr, "Assertion failed in %s:%d\n", module, loc);
+    exit(-1);
+}
@@ -59,6 +59,14 @@ int main(int argc, char *argv[]) {
 
     QHsmTst_ctor(); /* instantiate the QHsmTst object */
 
+#ifdef QHSM_SUPER_CACHE
+    /* run the same tests through the cached transitions (QHsm_tranCache_) */
+    {
+        static QHsmSuperCache l_cache; /* superstate cache for the_hsm */
+        QHsm_setCache(the_hsm, &l_cache);
+    }
+#endif
+
     return QF_run();
 }
 
@@ -0,0 +1,310 @@
+/*****************************************************************************
+* Purpose: QV partitions test for the POSIX-QV port
+* Last Updated for Version: 6.9.1
+* Date of the Last Update:  2026-10-16
+*
+*                    Q u a n t u m  L e a P s
+*                    ------------------------
+*                    Modern Embedded Software
+*
+* Copyright (C) 2005-2020 Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <www.gnu.org/licenses/>.
+*
+* Contact information:
+* <www.state-machine.com/licensing>
+* <info@state-machine.com>
+*****************************************************************************/
+/* expose features from the 2008 POSIX standard (IEEE Standard 1003.1-2008) */
+#define _POSIX_C_SOURCE 200809L
+/* expose the GNU extensions (CPU affinity) */
+#define _GNU_SOURCE
+
+#include "qpc.h"
+
+#include <pthread.h>
+#include <sched.h>  /* for sched_getaffinity() */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>   /* for nanosleep() */
+
+Q_DEFINE_THIS_FILE
+
+/* Tokens travel around the ring of the AOs assigned to three partitions.
+* The AOs of one partition must run in its event-loop thread, one RTC step
+* at a time. Then the Stall AO of the partition 1 waits for the Probe AO
+* of the partition 2, which can respond only when the partitions run
+* concurrently.
+*/
+
+/*..........................................................................*/
+enum {
+    N_PARTS      = QV_MAX_PARTITIONS, /* the number of the QV partitions */
+    N_PART_AOS   = 2,       /* the number of the AOs in each partition */
+    N_AOS        = N_PARTS * N_PART_AOS, /* the number of the Ring AOs */
+    N_TOKENS     = 3,       /* the tokens traveling around the ring */
+    N_HOPS       = 60000,   /* the total hops of all tokens */
+    QUEUE_LEN    = 8,       /* the length of the AO event queues */
+    STALL_MS     = 2000,    /* the longest wait of the Stall AO [ms] */
+    MAX_TICKS    = 3000     /* the test timeout [clock ticks] */
+};
+
+enum TestSignals {
+    TOKEN_SIG = Q_USER_SIG, /* forwarded to the next AO in the ring */
+    STALL_SIG,              /* the AO waits for the AO in another partition */
+    PROBE_SIG,              /* the AO sets the flag the stalled AO waits for */
+    MAX_SIG
+};
+
+typedef struct {
+    QEvt super;
+    uint8_t token; /* the token number */
+} TokenEvt;
+
+typedef struct {
+    QActive super;
+    uint8_t part;     /* the QV partition of the AO */
+    pthread_t thread; /* the thread of the first RTC step */
+    bool isStarted;   /* has the AO run any RTC step? */
+} Ring;
+
+static QState Ring_initial(Ring * const me, QEvt const * const e);
+static QState Ring_active (Ring * const me, QEvt const * const e);
+
+static void rtcStep(Ring * const me);
+static void stall(void);
+static void sleepMsec(uint32_t const ms);
+static void fail(char const *reason);
+
+static Ring l_ring[N_AOS];
+static TokenEvt const l_tokens[N_TOKENS] = {
+    { { TOKEN_SIG, 0U, 0U }, 0U },
+    { { TOKEN_SIG, 0U, 0U }, 1U },
+    { { TOKEN_SIG, 0U, 0U }, 2U }
+};
+static cpu_set_t l_part1CpuSet; /* the CPU the partition 1 is pinned to */
+static int l_part1Cpu;
+static int l_busy[N_PARTS]; /* is an RTC step in the partition? (atomic) */
+static int l_nHops;         /* the number of the token hops (atomic) */
+static int l_nTokensDone;   /* the number of the tokens stopped (atomic) */
+static int l_isProbed;      /* has the Probe AO run? (atomic) */
+static char const * volatile l_failure; /* the reason of the failure */
+static uint32_t l_ticks;
+
+/*..........................................................................*/
+int main(void) {
+    static QEvt const *ringQueueSto[N_AOS][QUEUE_LEN];
+    cpu_set_t allowed;
+    uint_fast8_t n;
+
+    QF_init();    /* initialize the framework */
+
+    /* pin the partition 1 to the first allowed CPU, leave the others */
+    Q_ALLEGE(sched_getaffinity(0, sizeof(allowed), &allowed) == 0);
+    for (l_part1Cpu = 0; !CPU_ISSET(l_part1Cpu, &allowed); ++l_part1Cpu) {
+    }
+    CPU_ZERO(&l_part1CpuSet);
+    CPU_SET(l_part1Cpu, &l_part1CpuSet);
+    for (n = 0U; n < N_PARTS; ++n) {
+        QF_setPartition(n, (n * N_PART_AOS) + 1U, (n + 1U) * N_PART_AOS,
+                        (n == 1U) ? l_part1Cpu : -1);
+    }
+
+    for (n = 0U; n < N_AOS; ++n) {
+        QActive_ctor(&l_ring[n].super, Q_STATE_CAST(&Ring_initial));
+        l_ring[n].part = (uint8_t)(n / N_PART_AOS);
+        QACTIVE_START(&l_ring[n].super, (uint_fast8_t)(n + 1U),
+                      ringQueueSto[n], Q_DIM(ringQueueSto[n]),
+                      (void *)0, 0U, (void *)0);
+    }
+
+    (void)QF_run(); /* run until the Stall AO or a failure stops QF */
+
+    for (n = 0U; n < N_AOS; ++n) {
+        Ring const * const me = &l_ring[n];
+        Ring const * const first = &l_ring[me->part * N_PART_AOS];
+        if (!me->isStarted) {
+            fail("an AO has not run");
+        }
+        else if (me->part == 0U) {
+            if (!pthread_equal(me->thread, pthread_self())) {
+                fail("the partition 0 did not run in the QF_run() thread");
+            }
+        }
+        else if (!pthread_equal(me->thread, first->thread)) {
+            fail("the AOs of one partition ran in different threads");
+        }
+        else if (pthread_equal(me->thread, pthread_self())
+                 || pthread_equal(me->thread, l_ring[0].thread)
+                 || ((me->part == 2U)
+                     && pthread_equal(me->thread, l_ring[N_PART_AOS].thread)))
+        {
+            fail("two partitions ran in the same thread");
+        }
+        else {
+            /* the AO ran in the thread of its partition */
+        }
+    }
+
+    if (l_failure != (char const *)0) {
+        printf("FAIL: %s\n", l_failure);
+        return 1;
+    }
+    printf("PASS: %d tokens x %d hops among %d AOs in %d partitions\n",
+           N_TOKENS, N_HOPS / N_TOKENS, N_AOS, N_PARTS);
+    return 0;
+}
+
+/*..........................................................................*/
+static QState Ring_initial(Ring * const me, QEvt const * const e) {
+    (void)e; /* unused parameter */
+
+    /* the first AO of every partition starts one token */
+    if ((me - &l_ring[0]) % N_PART_AOS == 0) {
+        QACTIVE_POST(&me->super, &l_tokens[me->part].super, me);
+    }
+    return Q_TRAN(&Ring_active);
+}
+/*..........................................................................*/
+static QState Ring_active(Ring * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case TOKEN_SIG: {
+            rtcStep(me);
+            if (__atomic_add_fetch(&l_nHops, 1, __ATOMIC_RELAXED)
+                <= N_HOPS)
+            {
+                Ring * const next = &l_ring[((me - &l_ring[0]) + 1) % N_AOS];
+                QACTIVE_POST(&next->super, e, me);
+            }
+            /* the last token stopped? */
+            else if (__atomic_add_fetch(&l_nTokensDone, 1, __ATOMIC_SEQ_CST)
+                     == N_TOKENS)
+            {
+                static QEvt const stallEvt = { STALL_SIG, 0U, 0U };
+                QACTIVE_POST(&l_ring[N_PART_AOS].super, &stallEvt, me);
+            }
+            else {
+                /* the token stopped */
+            }
+            __atomic_store_n(&l_busy[me->part], 0, __ATOMIC_RELEASE);
+            status_ = Q_HANDLED();
+            break;
+        }
+        case STALL_SIG: {
+            rtcStep(me);
+            stall();
+            __atomic_store_n(&l_busy[me->part], 0, __ATOMIC_RELEASE);
+            QF_stop();
+            status_ = Q_HANDLED();
+            break;
+        }
+        case PROBE_SIG: {
+            rtcStep(me);
+            __atomic_store_n(&l_isProbed, 1, __ATOMIC_RELEASE);
+            __atomic_store_n(&l_busy[me->part], 0, __ATOMIC_RELEASE);
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status_;
+}
+
+/*..........................................................................*/
+/* check the thread of the RTC step, which must end by clearing l_busy */
+static void rtcStep(Ring * const me) {
+    if (__atomic_exchange_n(&l_busy[me->part], 1, __ATOMIC_ACQUIRE) != 0) {
+        fail("two RTC steps ran in one partition at the same time");
+    }
+    if (!me->isStarted) { /* the first RTC step? */
+        me->thread = pthread_self();
+        me->isStarted = true;
+        if (me->part == 1U) { /* the pinned partition? */
+            cpu_set_t cpuSet;
+            if ((pthread_getaffinity_np(me->thread, sizeof(cpuSet), &cpuSet)
+                 != 0) || (!CPU_EQUAL(&cpuSet, &l_part1CpuSet)))
+            {
+                fail("the partition 1 is not pinned to its CPU");
+            }
+        }
+    }
+    else if (!pthread_equal(me->thread, pthread_self())) {
+        fail("an AO ran in more than one thread");
+    }
+    else {
+        /* the RTC step runs in the thread of the AO */
+    }
+}
+/*..........................................................................*/
+/* wait for the Probe AO in the partition 2 without returning */
+static void stall(void) {
+    static QEvt const probeEvt = { PROBE_SIG, 0U, 0U };
+    uint32_t ms;
+
+    QACTIVE_POST(&l_ring[2 * N_PART_AOS].super, &probeEvt,
+                 &l_ring[N_PART_AOS]);
+    for (ms = 0U;
+         (ms < STALL_MS) && (__atomic_load_n(&l_isProbed, __ATOMIC_ACQUIRE)
+                             == 0);
+         ++ms)
+    {
+        sleepMsec(1U);
+    }
+    if (ms == STALL_MS) {
+        fail("the partitions did not run concurrently");
+    }
+}
+/*..........................................................................*/
+static void sleepMsec(uint32_t const ms) {
+    struct timespec ts;
+    ts.tv_sec  = (time_t)(ms / 1000U);
+    ts.tv_nsec = (long)(ms % 1000U) * 1000000L;
+    nanosleep(&ts, (struct timespec *)0);
+}
+/*..........................................................................*/
+static void fail(char const *reason) {
+    if (l_failure == (char const *)0) { /* report only the first failure */
+        l_failure = reason;
+    }
+    QF_stop();
+}
+
+/*..........................................................................*/
+void QF_onStartup(void) {
+    QF_setTickRate(100U, 30); /* 100Hz clock tick rate, ticker priority 30 */
+}
+/*..........................................................................*/
+void QF_onCleanup(void) {
+}
+/*..........................................................................*/
+void QF_onClockTick(void) {
+    ++l_ticks;
+    if (l_ticks > MAX_TICKS) {
+        fail("timeout");
+    }
+}
+/*..........................................................................*/
+Q_NORETURN Q_onAssert(char const * const module, int_t const loc) {
+    fprintf(stderr, "Assertion failed in %s:%d\n", module, loc);
+    exit(-1);
+}
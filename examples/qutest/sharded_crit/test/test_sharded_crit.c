@@ -0,0 +1,285 @@
+/*****************************************************************************
+* Purpose: sharded critical sections test for the POSIX port
+* Last Updated for Version: 6.9.1
+* Date of the Last Update:  2026-10-16
+*
+*                    Q u a n t u m  L e a P s
+*                    ------------------------
+*                    Modern Embedded Software
+*
+* Copyright (C) 2005-2020 Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <www.gnu.org/licenses/>.
+*
+* Contact information:
+* <www.state-machine.com/licensing>
+* <info@state-machine.com>
+*****************************************************************************/
+/* expose features from the 2008 POSIX standard (IEEE Standard 1003.1-2008) */
+#define _POSIX_C_SOURCE 200809L
+
+#include "qpc.h"
+
+#include <pthread.h>
+#include <sched.h>  /* for sched_yield() */
+#include <stdio.h>
+#include <stdlib.h>
+
+Q_DEFINE_THIS_FILE
+
+/*..........................................................................*/
+enum {
+    N_PRODUCERS = 4,     /* the number of the producer threads */
+    N_CONSUMERS = 2,     /* the number of the subscriber AOs */
+    N_EVTS      = 20000, /* the number of the events of each producer */
+    POOL_LEN    = 32,    /* the number of the events in each pool */
+    QUEUE_LEN   = 48,    /* more than all events that can be in flight */
+    MAX_TICKS   = 3000   /* the test timeout [clock ticks] */
+};
+
+enum TestSignals {
+    SEQ_SIG = Q_USER_SIG, /* small event published by a producer */
+    BIG_SIG,              /* big event published by a producer */
+    MAX_PUB_SIG,          /* the last published signal */
+
+    TIMEOUT_SIG,          /* the periodic time event of a consumer */
+    DONE_SIG,             /* all events of the producers received */
+    MAX_SIG
+};
+
+typedef struct {
+    QEvt super;
+    uint32_t producer; /* the producer of the event */
+    uint32_t seq;      /* the sequence number of the event */
+} SeqEvt;
+
+typedef struct {
+    SeqEvt super;
+    uint32_t payload[16]; /* makes the event come from the second pool */
+} BigEvt;
+
+typedef struct {
+    QActive super;
+    QTimeEvt timeEvt;           /* the periodic time event */
+    uint32_t last[N_PRODUCERS]; /* the last sequence number per producer */
+    uint32_t nEvts;             /* the number of the events received */
+    uint32_t nTimeouts;         /* the number of the timeouts received */
+} Consumer;
+
+static QState Consumer_initial(Consumer * const me, QEvt const * const e);
+static QState Consumer_active (Consumer * const me, QEvt const * const e);
+
+static void *producer_thread(void *arg);
+static uint32_t freeEvts(uint_fast16_t const evtSize, enum_t const sig);
+static void fail(char const *reason);
+
+static Consumer l_consumers[N_CONSUMERS];
+static pthread_t l_producers[N_PRODUCERS];
+static int l_nDone; /* the number of the consumers done (atomic) */
+static char const * volatile l_failure; /* the reason of the failure */
+static uint32_t l_ticks;
+
+/*..........................................................................*/
+int main(void) {
+    static QEvt const *consumerQueueSto[N_CONSUMERS][QUEUE_LEN];
+    static QSubscrList subscrSto[MAX_PUB_SIG];
+    static QF_MPOOL_EL(SeqEvt) smlPoolSto[POOL_LEN];
+    static QF_MPOOL_EL(BigEvt) bigPoolSto[POOL_LEN];
+    uint_fast8_t n;
+
+    QF_init();    /* initialize the framework */
+    QF_psInit(subscrSto, Q_DIM(subscrSto));
+
+    /* initialize the event pools in the order of increasing event size */
+    QF_poolInit(smlPoolSto, sizeof(smlPoolSto), sizeof(smlPoolSto[0]));
+    QF_poolInit(bigPoolSto, sizeof(bigPoolSto), sizeof(bigPoolSto[0]));
+
+    for (n = 0U; n < N_CONSUMERS; ++n) {
+        QActive_ctor(&l_consumers[n].super,
+                     Q_STATE_CAST(&Consumer_initial));
+        QTimeEvt_ctorX(&l_consumers[n].timeEvt, &l_consumers[n].super,
+                       TIMEOUT_SIG, 0U);
+        QACTIVE_START(&l_consumers[n].super, (uint_fast8_t)(n + 1U),
+                      consumerQueueSto[n], Q_DIM(consumerQueueSto[n]),
+                      (void *)0, 0U, (void *)0);
+    }
+
+    (void)QF_run(); /* run until the consumers or the timeout stop QF */
+
+    /* the publishers hold the events until QF_publish_() returns, so the
+    * event pools can be checked only after all producers are done
+    */
+    for (n = 0U; n < N_PRODUCERS; ++n) {
+        pthread_join(l_producers[n], (void **)0);
+    }
+    if ((freeEvts(sizeof(SeqEvt), SEQ_SIG) != POOL_LEN)
+        || (freeEvts(sizeof(BigEvt), BIG_SIG) != POOL_LEN))
+    {
+        fail("the event pools leak events");
+    }
+
+    if (l_failure != (char const *)0) {
+        printf("FAIL: %s\n", l_failure);
+        return 1;
+    }
+    printf("PASS: %d producers x %d events to %d subscribers\n",
+           N_PRODUCERS, N_EVTS, N_CONSUMERS);
+    return 0;
+}
+
+/*..........................................................................*/
+static QState Consumer_initial(Consumer * const me, QEvt const * const e) {
+    (void)e; /* unused parameter */
+    QActive_subscribe(&me->super, SEQ_SIG);
+    QActive_subscribe(&me->super, BIG_SIG);
+    QTimeEvt_armX(&me->timeEvt, 1U, 1U); /* every clock tick */
+    return Q_TRAN(&Consumer_active);
+}
+/*..........................................................................*/
+static QState Consumer_active(Consumer * const me, QEvt const * const e) {
+    static QEvt const doneEvt = { DONE_SIG, 0U, 0U };
+    QState status_;
+    switch (e->sig) {
+        case SEQ_SIG: /* intentionally fall through */
+        case BIG_SIG: {
+            SeqEvt const *se = Q_EVT_CAST(SeqEvt);
+            if (se->seq != me->last[se->producer] + 1U) {
+                fail("the events of a producer are out of order");
+            }
+            me->last[se->producer] = se->seq;
+            ++me->nEvts;
+            if (me->nEvts == (uint32_t)N_PRODUCERS * N_EVTS) {
+                QACTIVE_POST(&me->super, &doneEvt, me);
+            }
+            status_ = Q_HANDLED();
+            break;
+        }
+        case TIMEOUT_SIG: {
+            ++me->nTimeouts;
+            status_ = Q_HANDLED();
+            break;
+        }
+        case DONE_SIG: {
+            if (me->nTimeouts == 0U) {
+                fail("the periodic time event did not expire");
+            }
+            (void)QTimeEvt_disarm(&me->timeEvt);
+            if (__atomic_add_fetch(&l_nDone, 1, __ATOMIC_SEQ_CST)
+                == N_CONSUMERS) /* the last consumer done? */
+            {
+                QF_stop();
+            }
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status_;
+}
+
+/*..........................................................................*/
+static void *producer_thread(void *arg) {
+    uint32_t const producer = (uint32_t)(uintptr_t)arg;
+    uint32_t seq;
+
+    for (seq = 1U; seq <= N_EVTS; ++seq) {
+        SeqEvt *se;
+        /* every other producer publishes the events from the big pool */
+        for (;;) { /* retry until an event is available */
+            if ((producer & 1U) == 0U) {
+                Q_NEW_X(se, SeqEvt, 0U, SEQ_SIG); /* margin 0, may fail */
+            }
+            else {
+                BigEvt *be;
+                Q_NEW_X(be, BigEvt, 0U, BIG_SIG); /* margin 0, may fail */
+                se = &be->super;
+            }
+            if (se != (SeqEvt *)0) {
+                break;
+            }
+            if (l_failure != (char const *)0) { /* test already failed? */
+                return (void *)0;
+            }
+            sched_yield();
+        }
+        se->producer = producer;
+        se->seq = seq;
+        /* the subscriber queues can take all events of the pools */
+        QF_PUBLISH(&se->super, (void *)0);
+    }
+    return (void *)0;
+}
+/*..........................................................................*/
+/* the number of the free events in a pool (allocates and frees them all) */
+static uint32_t freeEvts(uint_fast16_t const evtSize, enum_t const sig) {
+    static QEvt *evts[POOL_LEN];
+    uint32_t n;
+    uint32_t i;
+
+    for (n = 0U; n < POOL_LEN; ++n) {
+        evts[n] = QF_newX_(evtSize, 0U, sig); /* margin 0, may fail */
+        if (evts[n] == (QEvt *)0) {
+            break;
+        }
+    }
+    for (i = 0U; i < n; ++i) {
+        QF_gc(evts[i]);
+    }
+    return n;
+}
+/*..........................................................................*/
+static void fail(char const *reason) {
+    if (l_failure == (char const *)0) { /* report only the first failure */
+        l_failure = reason;
+    }
+    QF_stop();
+}
+
+/*..........................................................................*/
+void QF_onStartup(void) {
+    uint32_t i;
+
+    QF_setTickRate(100U, 30); /* 100Hz clock tick rate, ticker priority 30 */
+
+    for (i = 0U; i < N_PRODUCERS; ++i) {
+        Q_ALLEGE(pthread_create(&l_producers[i], (pthread_attr_t *)0,
+                                &producer_thread, (void *)(uintptr_t)i)
+                 == 0);
+    }
+}
+/*..........................................................................*/
+void QF_onCleanup(void) {
+}
+/*..........................................................................*/
+void QF_onClockTick(void) {
+    QF_TICK_X(0U, (void *)0); /* process the time events at rate 0 */
+
+    ++l_ticks;
+    if (l_ticks > MAX_TICKS) {
+        fail("timeout");
+    }
+}
+/*..........................................................................*/
+Q_NORETURN Q_onAssert(char const * const module, int_t const loc) {
+    fprintf(stderr, "Assertion failed in %s:%d\n", module, loc);
+    exit(-1);
+}
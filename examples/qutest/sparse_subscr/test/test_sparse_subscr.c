@@ -0,0 +1,194 @@
+/*****************************************************************************
+* Purpose: sparse subscriber store QUTEST fixture
+* Last Updated for Version: 6.9.1
+* Date of the Last Update:  2026-10-16
+*
+*                    Q u a n t u m  L e a P s
+*                    ------------------------
+*                    Modern Embedded Software
+*
+* Copyright (C) 2005-2020 Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <www.gnu.org/licenses/>.
+*
+* Contact information:
+* <www.state-machine.com/licensing>
+* <info@state-machine.com>
+*****************************************************************************/
+#include "qpc.h" /* QUTest interface */
+
+Q_DEFINE_THIS_FILE
+
+/*..........................................................................*/
+enum {
+    N_SUBSCRIBERS = 2U, /* the number of the subscriber AOs */
+    SUBSCR_LEN    = 4U  /* the number of the subscriptions in the store */
+};
+
+enum {
+    MAX_PUB_SIG = 60000 /* the signals published in the test scripts are
+                        * sparse in the range Q_USER_SIG..MAX_PUB_SIG-1 */
+};
+
+typedef struct {
+    QActive super;
+} Subscriber;
+
+static QState Subscriber_initial(Subscriber * const me, QEvt const * const e);
+static QState Subscriber_active (Subscriber * const me, QEvt const * const e);
+
+static Subscriber l_subscribers[N_SUBSCRIBERS];
+static uint8_t const l_fixture = 0U; /* QS sender of the published events */
+
+enum {
+    RECV = QS_USER /* subscriber 'ao' received the event with signal 'sig' */
+};
+
+enum {
+    SUBSCRIBE = 0,   /* subscribe AO 'param1' to signal 'param2' */
+    UNSUBSCRIBE,     /* unsubscribe AO 'param1' from signal 'param2' */
+    UNSUBSCRIBE_ALL, /* unsubscribe AO 'param1' from all signals */
+    PUBLISH          /* publish an event with signal 'param1' */
+};
+
+/*..........................................................................*/
+int main(int argc, char *argv[]) {
+    static QSubscr subscrSto[SUBSCR_LEN];
+    static QF_MPOOL_EL(QEvt) smlPoolSto[4];
+    static QEvt const *subscrQueueSto[N_SUBSCRIBERS][4];
+    uint_fast8_t n;
+
+    QF_init();   /* initialize the framework */
+
+    /* initialize the QS software tracing */
+    Q_ALLEGE(QS_INIT(argc > 1 ? argv[1] : (void *)0));
+
+    /* object dictionaries... */
+    QS_OBJ_DICTIONARY(&l_subscribers[0]);
+    QS_OBJ_DICTIONARY(&l_subscribers[1]);
+    QS_OBJ_DICTIONARY(&l_fixture);
+
+    QS_TEST_PAUSE();
+
+    /* initialize publish-subscribe... */
+    QF_psInitSparse(subscrSto, Q_DIM(subscrSto), MAX_PUB_SIG);
+
+    /* initialize event pools... */
+    QF_poolInit(smlPoolSto, sizeof(smlPoolSto), sizeof(smlPoolSto[0]));
+
+    /* start active objects... */
+    for (n = 0U; n < N_SUBSCRIBERS; ++n) {
+        QActive_ctor(&l_subscribers[n].super,
+                     Q_STATE_CAST(&Subscriber_initial));
+        QACTIVE_START(&l_subscribers[n].super, /* AO to start */
+                      (uint_fast8_t)(n + 1U),  /* QP priority of the AO */
+                      subscrQueueSto[n],       /* event queue storage */
+                      Q_DIM(subscrQueueSto[n]),/* queue length [events] */
+                      (void *)0,               /* stack storage (not used) */
+                      0U,                      /* size of the stack [bytes] */
+                      (QEvt *)0);              /* initialization event */
+    }
+
+    return QF_run(); /* run the QF application */
+}
+
+/*..........................................................................*/
+static QState Subscriber_initial(Subscriber * const me, QEvt const * const e) {
+    (void)me; /* unused parameter */
+    (void)e;  /* unused parameter */
+    return Q_TRAN(&Subscriber_active);
+}
+/*..........................................................................*/
+static QState Subscriber_active(Subscriber * const me, QEvt const * const e) {
+    QState status_;
+    if (e->sig >= (QSignal)Q_USER_SIG) {
+        QS_BEGIN_ID(RECV, me->super.prio) /* app-specific record */
+            QS_U8(0, (uint8_t)(me - &l_subscribers[0]));
+            QS_U16(0, e->sig);
+        QS_END()
+        status_ = Q_HANDLED();
+    }
+    else {
+        status_ = Q_SUPER(&QHsm_top);
+    }
+    return status_;
+}
+
+/*--------------------------------------------------------------------------*/
+void QS_onTestSetup(void) {
+    QS_USR_DICTIONARY(RECV);
+    QS_USR_DICTIONARY(SUBSCRIBE);
+    QS_USR_DICTIONARY(UNSUBSCRIBE);
+    QS_USR_DICTIONARY(UNSUBSCRIBE_ALL);
+    QS_USR_DICTIONARY(PUBLISH);
+}
+/*..........................................................................*/
+void QS_onTestTeardown(void) {
+}
+
+/*..........................................................................*/
+/*! callback function to execute user commands */
+void QS_onCommand(uint8_t cmdId,
+                  uint32_t param1, uint32_t param2, uint32_t param3)
+{
+    QActive const * const ao =
+        &l_subscribers[param1 % N_SUBSCRIBERS].super;
+
+    (void)param3; /* unused parameter */
+
+    switch (cmdId) {
+        case SUBSCRIBE: {
+            QActive_subscribe(ao, (enum_t)param2);
+            break;
+        }
+        case UNSUBSCRIBE: {
+            QActive_unsubscribe(ao, (enum_t)param2);
+            break;
+        }
+        case UNSUBSCRIBE_ALL: {
+            QActive_unsubscribeAll(ao);
+            break;
+        }
+        case PUBLISH: {
+            QEvt *e = Q_NEW(QEvt, (enum_t)param1);
+            QF_PUBLISH(e, &l_fixture);
+            break;
+        }
+        default:
+            break;
+    }
+}
+/*..........................................................................*/
+/*! callback function to "massage" the injected QP events (not used here) */
+void QS_onTestEvt(QEvt *e) {
+    (void)e;
+#ifdef Q_HOST  /* is this test compiled for a desktop Host computer? */
+#else /* embedded Target */
+#endif /* embedded Target */
+}
+/*..........................................................................*/
+/*! callback function to output the posted QP events (not used here) */
+void QS_onTestPost(void const *sender, QActive *recipient,
+                   QEvt const *e, bool status)
+{
+    (void)sender;
+    (void)recipient;
+    (void)e;
+    (void)status;
+}
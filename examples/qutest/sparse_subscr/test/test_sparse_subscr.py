@@ -0,0 +1,94 @@
+# test-script for QUTest unit testing harness
+# see https://www.state-machine.com/qtools/html
+
+# preamble...
+def on_reset():
+    expect_pause()
+    glb_filter(GRP_UA)
+    continue_test()
+    expect_run()
+
+# the signals 1000 and 1377 fall into the same bucket of the signal hash,
+# the store holds 4 subscriptions and the subscriber 1 has the higher
+# priority (see test_sparse_subscr.c)
+
+# tests...
+test("Publish the signals sharing a hash bucket")
+command("SUBSCRIBE", 0, 1000)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("SUBSCRIBE", 1, 1377)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("SUBSCRIBE", 1, 1000)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("PUBLISH", 1000)
+expect("@timestamp RECV 1 1000")
+expect("@timestamp RECV 0 1000")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("PUBLISH", 1377)
+expect("@timestamp RECV 1 1377")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+# no subscribers
+command("PUBLISH", 50000)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+
+test("Unsubscribe from one of the signals sharing a hash bucket")
+command("SUBSCRIBE", 0, 1000)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("SUBSCRIBE", 0, 1377)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("SUBSCRIBE", 1, 1377)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("UNSUBSCRIBE", 0, 1377)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("PUBLISH", 1377)
+expect("@timestamp RECV 1 1377")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("PUBLISH", 1000)
+expect("@timestamp RECV 0 1000")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+# subscribing twice keeps one subscription
+command("SUBSCRIBE", 0, 1000)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("UNSUBSCRIBE", 0, 1000)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("PUBLISH", 1000)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+
+test("Reuse the storage of the released subscriptions")
+command("SUBSCRIBE", 0, 1000)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("SUBSCRIBE", 0, 1377)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("SUBSCRIBE", 0, 50000)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("SUBSCRIBE", 1, 50000)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("UNSUBSCRIBE_ALL", 0)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("PUBLISH", 50000)
+expect("@timestamp RECV 1 50000")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("PUBLISH", 1000)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+# the three subscriptions released by UNSUBSCRIBE_ALL are available again
+command("SUBSCRIBE", 1, 1000)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("SUBSCRIBE", 1, 1377)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("SUBSCRIBE", 1, 13)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("PUBLISH", 13)
+expect("@timestamp RECV 1 13")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+
+test("Exhaust the subscription store")
+command("SUBSCRIBE", 0, 1000)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("SUBSCRIBE", 0, 1377)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("SUBSCRIBE", 1, 1000)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("SUBSCRIBE", 1, 1377)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("SUBSCRIBE", 1, 50000)
+expect("@timestamp =ASSERT= Mod=qf_ps,Loc=310")
@@ -0,0 +1,234 @@
+/*****************************************************************************
+* Purpose: AO thread attributes test for the POSIX port
+* Last Updated for Version: 6.9.1
+* Date of the Last Update:  2026-10-16
+*
+*                    Q u a n t u m  L e a P s
+*                    ------------------------
+*                    Modern Embedded Software
+*
+* Copyright (C) 2005-2020 Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <www.gnu.org/licenses/>.
+*
+* Contact information:
+* <www.state-machine.com/licensing>
+* <info@state-machine.com>
+*****************************************************************************/
+/* expose features from the 2008 POSIX standard (IEEE Standard 1003.1-2008) */
+#define _POSIX_C_SOURCE 200809L
+/* expose the GNU extensions (thread names, CPU affinity, thread attributes) */
+#define _GNU_SOURCE
+
+#include "qpc.h"
+
+#include <pthread.h>
+#include <sched.h>  /* for sched_getaffinity() */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+Q_DEFINE_THIS_FILE
+
+/* Every Worker AO checks from its own thread that the thread was created
+* with the attributes set by QActive_setAttr() before the AO was started.
+*/
+
+/*..........................................................................*/
+enum {
+    N_WORKERS = 2,       /* the number of the Worker AOs */
+    NAME_LEN  = 15,      /* the longest thread name on Linux */
+    STACK_LEN = 1048576, /* the stack size of the Worker threads [bytes] */
+    MAX_TICKS = 3000     /* the test timeout [clock ticks] */
+};
+
+enum TestSignals {
+    CHECK_SIG = Q_USER_SIG, /* the Worker checks its thread attributes */
+    MAX_SIG
+};
+
+typedef struct {
+    QActive super;
+    char const *name; /* the name of the thread (longer than NAME_LEN) */
+    cpu_set_t cpuSet; /* the CPU the thread runs on */
+} Worker;
+
+static QState Worker_initial(Worker * const me, QEvt const * const e);
+static QState Worker_active (Worker * const me, QEvt const * const e);
+
+static int nextCpu(cpu_set_t const * const allowed, int const cpu);
+static void fail(char const *reason);
+
+static Worker l_workers[N_WORKERS];
+static char const * const l_names[N_WORKERS] = {
+    "qp-worker-0-with-a-long-name",
+    "qp-worker-1-with-a-long-name"
+};
+static int l_nDone; /* the number of the Workers done (atomic) */
+static char const * volatile l_failure; /* the reason of the failure */
+static uint32_t l_ticks;
+
+/*..........................................................................*/
+int main(void) {
+    static QEvt const *workerQueueSto[N_WORKERS][4];
+    static int const policy = SCHED_OTHER; /* needs no privileges */
+    static int const prio = 0;
+    static size_t const stkSize = STACK_LEN;
+    cpu_set_t allowed;
+    int cpu = -1;
+    uint_fast8_t n;
+
+    QF_init();    /* initialize the framework */
+
+    /* pin the Workers to different allowed CPUs (if there are any) */
+    Q_ALLEGE(sched_getaffinity(0, sizeof(allowed), &allowed) == 0);
+
+    for (n = 0U; n < N_WORKERS; ++n) {
+        Worker * const me = &l_workers[n];
+
+        QActive_ctor(&me->super, Q_STATE_CAST(&Worker_initial));
+        me->name = l_names[n];
+        cpu = nextCpu(&allowed, cpu + 1);
+        CPU_ZERO(&me->cpuSet);
+        CPU_SET(cpu, &me->cpuSet);
+
+        QActive_setAttr(&me->super, THREAD_NAME_ATTR, me->name);
+        QActive_setAttr(&me->super, CPU_AFFINITY_ATTR, &me->cpuSet);
+        QActive_setAttr(&me->super, SCHED_POLICY_ATTR, &policy);
+        QActive_setAttr(&me->super, SCHED_PRIO_ATTR, &prio);
+        QActive_setAttr(&me->super, STACK_SIZE_ATTR, &stkSize);
+        QACTIVE_START(&me->super, (uint_fast8_t)(n + 1U),
+                      workerQueueSto[n], Q_DIM(workerQueueSto[n]),
+                      (void *)0, 0U, (void *)0);
+    }
+
+    (void)QF_run(); /* run until the Workers or the timeout stop QF */
+
+    if (l_failure != (char const *)0) {
+        printf("FAIL: %s\n", l_failure);
+        return 1;
+    }
+    printf("PASS: %d AO threads with the name, CPU, policy and stack set\n",
+           N_WORKERS);
+    return 0;
+}
+
+/*..........................................................................*/
+static QState Worker_initial(Worker * const me, QEvt const * const e) {
+    static QEvt const checkEvt = { CHECK_SIG, 0U, 0U };
+
+    (void)e; /* unused parameter */
+
+    /* the initial transition does not run in the AO thread yet */
+    QACTIVE_POST(&me->super, &checkEvt, me);
+    return Q_TRAN(&Worker_active);
+}
+/*..........................................................................*/
+static QState Worker_active(Worker * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case CHECK_SIG: {
+            pthread_t const self = pthread_self();
+            char name[NAME_LEN + 1];
+            cpu_set_t cpuSet;
+            struct sched_param param;
+            pthread_attr_t attr;
+            size_t stkSize = 0U;
+            int policy = -1;
+
+            /* the name is truncated to the longest Linux thread name */
+            if ((pthread_getname_np(self, name, sizeof(name)) != 0)
+                || (strncmp(name, me->name, NAME_LEN) != 0)
+                || (name[NAME_LEN] != '\0'))
+            {
+                fail("the AO thread has not got its name");
+            }
+            if ((pthread_getaffinity_np(self, sizeof(cpuSet), &cpuSet) != 0)
+                || (!CPU_EQUAL(&cpuSet, &me->cpuSet)))
+            {
+                fail("the AO thread has not got its CPU affinity");
+            }
+            if ((pthread_getschedparam(self, &policy, &param) != 0)
+                || (policy != SCHED_OTHER) || (param.sched_priority != 0))
+            {
+                fail("the AO thread has not got its scheduling policy");
+            }
+            if (pthread_getattr_np(self, &attr) == 0) {
+                (void)pthread_attr_getstacksize(&attr, &stkSize);
+                pthread_attr_destroy(&attr);
+            }
+            if (stkSize < (size_t)STACK_LEN) {
+                fail("the AO thread has not got its stack size");
+            }
+
+            if (__atomic_add_fetch(&l_nDone, 1, __ATOMIC_SEQ_CST)
+                == N_WORKERS) /* the last Worker done? */
+            {
+                QF_stop();
+            }
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status_;
+}
+
+/*..........................................................................*/
+/* the first allowed CPU from 'cpu' on, or the first allowed CPU at all */
+static int nextCpu(cpu_set_t const * const allowed, int const cpu) {
+    int c;
+    for (c = cpu; (c < CPU_SETSIZE) && (!CPU_ISSET(c, allowed)); ++c) {
+    }
+    if (c == CPU_SETSIZE) { /* no more allowed CPUs? */
+        for (c = 0; !CPU_ISSET(c, allowed); ++c) {
+        }
+    }
+    return c;
+}
+/*..........................................................................*/
+static void fail(char const *reason) {
+    if (l_failure == (char const *)0) { /* report only the first failure */
+        l_failure = reason;
+    }
+    QF_stop();
+}
+
+/*..........................................................................*/
+void QF_onStartup(void) {
+    QF_setTickRate(100U, 30); /* 100Hz clock tick rate, ticker priority 30 */
+}
+/*..........................................................................*/
+void QF_onCleanup(void) {
+}
+/*..........................................................................*/
+void QF_onClockTick(void) {
+    ++l_ticks;
+    if (l_ticks > MAX_TICKS) {
+        fail("timeout");
+    }
+}
+/*..........................................................................*/
+Q_NORETURN Q_onAssert(char const * const module, int_t const loc) {
+    fprintf(stderr, "Assertion failed in %s:%d\n", module, loc);
+    exit(-1);
+}
@@ -0,0 +1,198 @@
+/*****************************************************************************
+* Purpose: drift-free ticker test for the POSIX port
+* Last Updated for Version: 6.9.1
+* Date of the Last Update:  2026-10-16
+*
+*                    Q u a n t u m  L e a P s
+*                    ------------------------
+*                    Modern Embedded Software
+*
+* Copyright (C) 2005-2020 Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <www.gnu.org/licenses/>.
+*
+* Contact information:
+* <www.state-machine.com/licensing>
+* <info@state-machine.com>
+*****************************************************************************/
+/* expose features from the 2008 POSIX standard (IEEE Standard 1003.1-2008) */
+#define _POSIX_C_SOURCE 200809L
+
+#include "qpc.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>   /* for nanosleep() and clock_gettime() */
+
+Q_DEFINE_THIS_FILE
+
+/* Every clock tick spends WORK_MS in QF_onClockTick() and one tick is
+* late by LATE_MS, which would accumulate as drift with the relative
+* sleeping. The ticker must instead stay in phase with its deadlines and
+* catch up the missed ticks, at the tick rate 0 (QF_onClockTick()) and at
+* the tick rate 1 (ticked by the port).
+*/
+
+/*..........................................................................*/
+#define NSEC_PER_MSEC 1000000LL
+
+enum {
+    RATE0_HZ   = 100,  /* the tick rate 0 [Hz] */
+    RATE1_HZ   = 200,  /* the tick rate 1 [Hz] */
+    N_TICKS    = 200,  /* the measured ticks of the rate 0 */
+    WORK_MS    = 3,    /* the time spent in every tick [ms] */
+    LATE_TICK  = 100,  /* the tick that is late */
+    LATE_MS    = 55,   /* the time spent in the late tick [ms] */
+    TOLER_MS   = 30,   /* the allowed lateness of the last tick [ms] */
+    TOLER_TICKS = 6    /* the allowed difference of the rate 1 ticks */
+};
+
+enum TestSignals {
+    TICK1_SIG = Q_USER_SIG, /* the periodic time event at the tick rate 1 */
+    MAX_SIG
+};
+
+typedef struct {
+    QActive super;
+    QTimeEvt tick1; /* expires with every tick of the rate 1 */
+} Counter;
+
+static QState Counter_initial(Counter * const me, QEvt const * const e);
+static QState Counter_active (Counter * const me, QEvt const * const e);
+
+static int64_t nowNsec(void);
+static void sleepMsec(uint32_t const ms);
+
+static Counter l_counter;
+static uint32_t l_ticks;     /* the ticks of the rate 0 */
+static uint32_t l_ticks1;    /* the expirations at the rate 1 (atomic) */
+static uint32_t l_startTicks1;
+static uint32_t l_endTicks1;
+static int64_t l_start;      /* the time of the first measured tick [ns] */
+static int64_t l_end;        /* the time of the last measured tick [ns] */
+
+/*..........................................................................*/
+int main(void) {
+    static QEvt const *counterQueueSto[16];
+    int64_t const expected = N_TICKS * (1000 / RATE0_HZ) * NSEC_PER_MSEC;
+    int64_t elapsed;
+    int32_t ticks1;
+
+    QF_init();    /* initialize the framework */
+
+    QActive_ctor(&l_counter.super, Q_STATE_CAST(&Counter_initial));
+    QTimeEvt_ctorX(&l_counter.tick1, &l_counter.super, TICK1_SIG, 1U);
+    QACTIVE_START(&l_counter.super, 1U,
+                  counterQueueSto, Q_DIM(counterQueueSto),
+                  (void *)0, 0U, (void *)0);
+
+    (void)QF_run(); /* run until the last measured tick stops QF */
+
+    elapsed = l_end - l_start;
+    ticks1 = (int32_t)(l_endTicks1 - l_startTicks1)
+             - (N_TICKS * RATE1_HZ / RATE0_HZ);
+    if (elapsed < expected - NSEC_PER_MSEC) { /* 1ms for the clock reads */
+        printf("FAIL: %d ticks took only %d ms\n",
+               N_TICKS, (int)(elapsed / NSEC_PER_MSEC));
+        return 1;
+    }
+    if (elapsed > expected + (TOLER_MS * NSEC_PER_MSEC)) {
+        printf("FAIL: %d ticks drifted to %d ms\n",
+               N_TICKS, (int)(elapsed / NSEC_PER_MSEC));
+        return 1;
+    }
+    if ((ticks1 < -TOLER_TICKS) || (ticks1 > TOLER_TICKS)) {
+        printf("FAIL: the tick rate 1 is off by %d ticks\n", (int)ticks1);
+        return 1;
+    }
+    printf("PASS: %d ticks in %d ms, the tick rate 1 off by %d ticks\n",
+           N_TICKS, (int)(elapsed / NSEC_PER_MSEC), (int)ticks1);
+    return 0;
+}
+
+/*..........................................................................*/
+static QState Counter_initial(Counter * const me, QEvt const * const e) {
+    (void)e; /* unused parameter */
+    QTimeEvt_armX(&me->tick1, 1U, 1U); /* every tick of the rate 1 */
+    return Q_TRAN(&Counter_active);
+}
+/*..........................................................................*/
+static QState Counter_active(Counter * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case TICK1_SIG: {
+            (void)__atomic_add_fetch(&l_ticks1, 1U, __ATOMIC_RELAXED);
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    (void)me; /* unused parameter */
+    return status_;
+}
+
+/*..........................................................................*/
+static int64_t nowNsec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((int64_t)ts.tv_sec * 1000 * NSEC_PER_MSEC) + ts.tv_nsec;
+}
+/*..........................................................................*/
+static void sleepMsec(uint32_t const ms) {
+    struct timespec ts;
+    ts.tv_sec  = (time_t)(ms / 1000U);
+    ts.tv_nsec = (long)(ms % 1000U) * 1000000L;
+    nanosleep(&ts, (struct timespec *)0);
+}
+
+/*..........................................................................*/
+void QF_onStartup(void) {
+    QF_setTickRate(RATE0_HZ, 30); /* the tick rate 0, ticker priority 30 */
+    QF_setTickRateX(1U, RATE1_HZ); /* the tick rate 1 ticked by the port */
+}
+/*..........................................................................*/
+void QF_onCleanup(void) {
+}
+/*..........................................................................*/
+void QF_onClockTick(void) {
+    QF_TICK_X(0U, (void *)0); /* the tick rate 0 (not used by the AO) */
+
+    ++l_ticks;
+    if (l_ticks == 1U) { /* the first measured tick? */
+        l_start = nowNsec();
+        l_startTicks1 = __atomic_load_n(&l_ticks1, __ATOMIC_RELAXED);
+    }
+    else if (l_ticks == N_TICKS + 1U) { /* the last measured tick? */
+        l_end = nowNsec();
+        l_endTicks1 = __atomic_load_n(&l_ticks1, __ATOMIC_RELAXED);
+        QF_stop();
+    }
+    else {
+        /* the tick in the middle */
+    }
+    sleepMsec((l_ticks == LATE_TICK) ? LATE_MS : WORK_MS);
+}
+/*..........................................................................*/
+Q_NORETURN Q_onAssert(char const * const module, int_t const loc) {
+    fprintf(stderr, "Assertion failed in %s:%d\n", module, loc);
+    exit(-1);
+}
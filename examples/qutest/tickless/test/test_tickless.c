@@ -0,0 +1,287 @@
+/*****************************************************************************
+* Purpose: tickless time events test for the POSIX port
+* Last Updated for Version: 6.9.1
+* Date of the Last Update:  2026-10-16
+*
+*                    Q u a n t u m  L e a P s
+*                    ------------------------
+*                    Modern Embedded Software
+*
+* Copyright (C) 2005-2020 Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <www.gnu.org/licenses/>.
+*
+* Contact information:
+* <www.state-machine.com/licensing>
+* <info@state-machine.com>
+*****************************************************************************/
+/* expose features from the 2008 POSIX standard (IEEE Standard 1003.1-2008) */
+#define _POSIX_C_SOURCE 200809L
+
+#include "qpc.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>   /* for clock_gettime() */
+
+Q_DEFINE_THIS_FILE
+
+/* The periodic clock tick is stopped (QF_setTickRate(0U, ...)), so all time
+* events below, including the timeout of the test, are timed only by their
+* nanosecond deadlines.
+*/
+
+/*..........................................................................*/
+#define NSEC_PER_MSEC 1000000LL
+
+enum {
+    N_ONESHOTS  = 8,    /* the number of the one-shot time events */
+    N_PERIODS   = 20,   /* the expirations of the periodic time event */
+    PERIOD_MS   = 5,    /* the period of the periodic time event [ms] */
+    REARM_MS    = 15,   /* the deadline of the rearmed time event [ms] */
+    LATE_MS     = 200,  /* the allowed lateness of the time events [ms] */
+    TIMEOUT_MS  = 5000  /* the test timeout [ms] */
+};
+
+/* the deadlines of the one-shot time events, armed in this order [ms] */
+static uint32_t const l_deadlineMs[N_ONESHOTS] = {
+    80U, 10U, 50U, 30U, 70U, 20U, 60U, 40U
+};
+
+enum TestSignals {
+    ONESHOT0_SIG = Q_USER_SIG, /* the signal of the one-shot time event 0 */
+    PERIODIC_SIG = ONESHOT0_SIG + N_ONESHOTS, /* the periodic time event */
+    REARMED_SIG,  /* armed for 1s, then rearmed for REARM_MS */
+    DISARMED_SIG, /* disarmed right after arming, must not expire */
+    SETTLE_SIG,   /* ends the test after the periodic time event */
+    TIMEOUT_SIG,  /* the test timeout */
+    MAX_SIG
+};
+
+typedef struct {
+    QActive super;
+    QTimeEvt oneShot[N_ONESHOTS];
+    QTimeEvt periodic;
+    QTimeEvt rearmed;
+    QTimeEvt disarmed;
+    QTimeEvt settle;
+    QTimeEvt timeout;
+    int64_t  start;         /* the start of the one-shot time events [ns] */
+    int64_t  periodicStart; /* the start of the periodic time event [ns] */
+    uint32_t nOneShots;     /* the number of the one-shots expired */
+    uint32_t lastMs;        /* the deadline of the last one-shot expired */
+    uint32_t nPeriods;      /* the expirations of the periodic time event */
+    bool     isRearmedDone; /* has the rearmed time event expired? */
+} Timer;
+
+static QState Timer_initial(Timer * const me, QEvt const * const e);
+static QState Timer_active (Timer * const me, QEvt const * const e);
+
+static int64_t nowNsec(void);
+static void checkDeadline(int64_t const start, int64_t const deadline);
+static void fail(char const *reason);
+
+static Timer l_timer;
+static char const * volatile l_failure; /* the reason of the failure */
+static uint32_t l_ticks;
+
+/*..........................................................................*/
+int main(void) {
+    static QEvt const *timerQueueSto[N_ONESHOTS + 8];
+    uint_fast8_t n;
+
+    QF_init();    /* initialize the framework */
+
+    QActive_ctor(&l_timer.super, Q_STATE_CAST(&Timer_initial));
+    for (n = 0U; n < N_ONESHOTS; ++n) {
+        QTimeEvt_ctorX(&l_timer.oneShot[n], &l_timer.super,
+                       (enum_t)(ONESHOT0_SIG + n), 0U);
+    }
+    QTimeEvt_ctorX(&l_timer.periodic, &l_timer.super, PERIODIC_SIG, 0U);
+    QTimeEvt_ctorX(&l_timer.rearmed,  &l_timer.super, REARMED_SIG,  0U);
+    QTimeEvt_ctorX(&l_timer.disarmed, &l_timer.super, DISARMED_SIG, 0U);
+    QTimeEvt_ctorX(&l_timer.settle,   &l_timer.super, SETTLE_SIG,   0U);
+    QTimeEvt_ctorX(&l_timer.timeout,  &l_timer.super, TIMEOUT_SIG,  0U);
+    QACTIVE_START(&l_timer.super, 1U,
+                  timerQueueSto, Q_DIM(timerQueueSto),
+                  (void *)0, 0U, (void *)0);
+
+    (void)QF_run(); /* run until the Timer AO or a failure stops QF */
+
+    if (l_ticks != 0U) {
+        fail("the stopped clock tick kept ticking");
+    }
+    if (l_failure != (char const *)0) {
+        printf("FAIL: %s\n", l_failure);
+        return 1;
+    }
+    printf("PASS: %d one-shot and %d periodic expirations without a tick\n",
+           N_ONESHOTS, N_PERIODS);
+    return 0;
+}
+
+/*..........................................................................*/
+static QState Timer_initial(Timer * const me, QEvt const * const e) {
+    uint_fast8_t n;
+
+    (void)e; /* unused parameter */
+
+    QTimeEvt_armNsec(&me->timeout, TIMEOUT_MS * NSEC_PER_MSEC, 0U);
+
+    me->start = nowNsec();
+    for (n = 0U; n < N_ONESHOTS; ++n) {
+        QTimeEvt_armNsec(&me->oneShot[n],
+                         l_deadlineMs[n] * NSEC_PER_MSEC, 0U);
+    }
+
+    QTimeEvt_armNsec(&me->disarmed, 25 * NSEC_PER_MSEC, 0U);
+    if (!QTimeEvt_disarmNsec(&me->disarmed)) {
+        fail("the armed time event was not disarmed");
+    }
+
+    /* the rearmed time event must expire by its new, earlier deadline */
+    QTimeEvt_armNsec(&me->rearmed, 1000 * NSEC_PER_MSEC, 0U);
+    if (!QTimeEvt_rearmNsec(&me->rearmed, REARM_MS * NSEC_PER_MSEC)) {
+        fail("the armed time event was not rearmed");
+    }
+    if (QTimeEvt_currNsec(&me->rearmed) > REARM_MS * NSEC_PER_MSEC) {
+        fail("the rearmed time event kept its old deadline");
+    }
+    return Q_TRAN(&Timer_active);
+}
+/*..........................................................................*/
+static QState Timer_active(Timer * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case PERIODIC_SIG: {
+            ++me->nPeriods;
+            if (me->nPeriods == N_PERIODS) {
+                checkDeadline(me->periodicStart,
+                              N_PERIODS * PERIOD_MS * NSEC_PER_MSEC);
+                if (!QTimeEvt_disarmNsec(&me->periodic)) {
+                    fail("the periodic time event was not armed");
+                }
+                if (QTimeEvt_disarmNsec(&me->periodic)) {
+                    fail("the periodic time event was disarmed twice");
+                }
+                QTimeEvt_armNsec(&me->settle,
+                                 3 * PERIOD_MS * NSEC_PER_MSEC, 0U);
+            }
+            /* one expiration might have been posted before the disarming */
+            else if (me->nPeriods > N_PERIODS + 1) {
+                fail("the disarmed periodic time event kept expiring");
+            }
+            status_ = Q_HANDLED();
+            break;
+        }
+        case REARMED_SIG: {
+            checkDeadline(me->start, REARM_MS * NSEC_PER_MSEC);
+            me->isRearmedDone = true;
+            status_ = Q_HANDLED();
+            break;
+        }
+        case DISARMED_SIG: {
+            fail("the disarmed time event expired");
+            status_ = Q_HANDLED();
+            break;
+        }
+        case SETTLE_SIG: {
+            if (!me->isRearmedDone) {
+                fail("the rearmed time event did not expire");
+            }
+            (void)QTimeEvt_disarmNsec(&me->timeout);
+            QF_stop();
+            status_ = Q_HANDLED();
+            break;
+        }
+        case TIMEOUT_SIG: {
+            fail("timeout");
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            if ((e->sig >= ONESHOT0_SIG) && (e->sig < PERIODIC_SIG)) {
+                uint32_t const ms = l_deadlineMs[e->sig - ONESHOT0_SIG];
+                checkDeadline(me->start, ms * NSEC_PER_MSEC);
+                if (ms < me->lastMs) {
+                    fail("the one-shot time events expired out of order");
+                }
+                me->lastMs = ms;
+                ++me->nOneShots;
+                if (me->nOneShots == N_ONESHOTS) { /* the last one-shot? */
+                    me->periodicStart = nowNsec();
+                    QTimeEvt_armNsec(&me->periodic,
+                                     PERIOD_MS * NSEC_PER_MSEC,
+                                     PERIOD_MS * NSEC_PER_MSEC);
+                }
+                status_ = Q_HANDLED();
+            }
+            else {
+                status_ = Q_SUPER(&QHsm_top);
+            }
+            break;
+        }
+    }
+    return status_;
+}
+
+/*..........................................................................*/
+static int64_t nowNsec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((int64_t)ts.tv_sec * 1000 * NSEC_PER_MSEC) + ts.tv_nsec;
+}
+/*..........................................................................*/
+/* check that a time event expired after its deadline, but not too late */
+static void checkDeadline(int64_t const start, int64_t const deadline) {
+    int64_t const elapsed = nowNsec() - start;
+    if (elapsed < deadline) {
+        fail("a time event expired before its deadline");
+    }
+    else if (elapsed > deadline + (LATE_MS * NSEC_PER_MSEC)) {
+        fail("a time event expired too late");
+    }
+    else {
+        /* the time event expired on time */
+    }
+}
+/*..........................................................................*/
+static void fail(char const *reason) {
+    if (l_failure == (char const *)0) { /* report only the first failure */
+        l_failure = reason;
+    }
+    QF_stop();
+}
+
+/*..........................................................................*/
+void QF_onStartup(void) {
+    QF_setTickRate(0U, 30); /* no periodic clock tick, ticker priority 30 */
+}
+/*..........................................................................*/
+void QF_onCleanup(void) {
+}
+/*..........................................................................*/
+void QF_onClockTick(void) {
+    ++l_ticks; /* must not be called at all */
+}
+/*..........................................................................*/
+Q_NORETURN Q_onAssert(char const * const module, int_t const loc) {
+    fprintf(stderr, "Assertion failed in %s:%d\n", module, loc);
+    exit(-1);
+}
@@ -0,0 +1,221 @@
+/*****************************************************************************
+* Purpose: hierarchical timing wheel QUTEST fixture
+* Last Updated for Version: 6.9.1
+* Date of the Last Update:  2026-10-16
+*
+*                    Q u a n t u m  L e a P s
+*                    ------------------------
+*                    Modern Embedded Software
+*
+* Copyright (C) 2005-2020 Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <www.gnu.org/licenses/>.
+*
+* Contact information:
+* <www.state-machine.com/licensing>
+* <info@state-machine.com>
+*****************************************************************************/
+#include "qpc.h" /* QUTest interface */
+
+Q_DEFINE_THIS_FILE
+
+/*..........................................................................*/
+enum {
+    N_TIMEEVTS = 4U /* the number of the time events of the Timer AO */
+};
+
+enum TestSignals {
+    TIMEOUT0_SIG = Q_USER_SIG, /* the signal of the time event 0 */
+    MAX_SIG = TIMEOUT0_SIG + N_TIMEEVTS
+};
+
+typedef struct {
+    QActive super;
+    QTimeEvt timeEvt[N_TIMEEVTS];
+} Timer;
+
+static QState Timer_initial(Timer * const me, QEvt const * const e);
+static QState Timer_active (Timer * const me, QEvt const * const e);
+
+static Timer l_timer;
+static uint8_t const l_ticker = 0U; /* QS sender of the time events */
+static uint32_t l_now; /* the number of the clock ticks since the reset */
+
+enum {
+    EXPIRED = QS_USER, /* time event 'te' expired at the tick 'now' */
+    DISARMED,          /* time event 'te' was armed when disarmed */
+    REARMED,           /* time event 'te' was armed when rearmed */
+    CTR,               /* the ticks remaining until 'te' expires */
+    IDLE               /* no time events armed */
+};
+
+enum {
+    ARM = 0,  /* arm time event 'param1' for 'param2' ticks, 'param3' intvl */
+    DISARM,   /* disarm time event 'param1' */
+    REARM,    /* rearm time event 'param1' for 'param2' ticks */
+    GET_CTR,  /* report the ticks remaining until time event 'param1' */
+    GET_IDLE, /* report whether any time events are armed */
+    TICKS     /* run 'param1' clock ticks through QF_tickX_() */
+};
+
+/*..........................................................................*/
+int main(int argc, char *argv[]) {
+    static QEvt const *timerQueueSto[N_TIMEEVTS];
+    uint_fast8_t n;
+
+    QF_init();   /* initialize the framework */
+
+    /* initialize the QS software tracing */
+    Q_ALLEGE(QS_INIT(argc > 1 ? argv[1] : (void *)0));
+
+    /* object dictionaries... */
+    QS_OBJ_DICTIONARY(&l_timer);
+    QS_OBJ_DICTIONARY(&l_ticker);
+
+    QS_TEST_PAUSE();
+
+    /* start active objects... */
+    QActive_ctor(&l_timer.super, Q_STATE_CAST(&Timer_initial));
+    for (n = 0U; n < N_TIMEEVTS; ++n) {
+        QTimeEvt_ctorX(&l_timer.timeEvt[n], &l_timer.super,
+                       (enum_t)(TIMEOUT0_SIG + n), 0U);
+    }
+    QACTIVE_START(&l_timer.super,        /* AO to start */
+                  (uint_fast8_t)1,       /* QP priority of the AO */
+                  timerQueueSto,         /* event queue storage */
+                  Q_DIM(timerQueueSto),  /* queue length [events] */
+                  (void *)0,             /* stack storage (not used) */
+                  0U,                    /* size of the stack [bytes] */
+                  (QEvt *)0);            /* initialization event */
+
+    return QF_run(); /* run the QF application */
+}
+
+/*..........................................................................*/
+static QState Timer_initial(Timer * const me, QEvt const * const e) {
+    (void)e; /* unused parameter */
+    return Q_TRAN(&Timer_active);
+}
+/*..........................................................................*/
+static QState Timer_active(Timer * const me, QEvt const * const e) {
+    QState status_;
+    if ((e->sig >= TIMEOUT0_SIG) && (e->sig < MAX_SIG)) {
+        QS_BEGIN_ID(EXPIRED, me->super.prio) /* app-specific record */
+            QS_U8(0, (uint8_t)(e->sig - TIMEOUT0_SIG));
+            QS_U32(0, l_now);
+        QS_END()
+        status_ = Q_HANDLED();
+    }
+    else {
+        status_ = Q_SUPER(&QHsm_top);
+    }
+    return status_;
+}
+
+/*--------------------------------------------------------------------------*/
+void QS_onTestSetup(void) {
+    QS_USR_DICTIONARY(EXPIRED);
+    QS_USR_DICTIONARY(DISARMED);
+    QS_USR_DICTIONARY(REARMED);
+    QS_USR_DICTIONARY(CTR);
+    QS_USR_DICTIONARY(IDLE);
+    QS_USR_DICTIONARY(ARM);
+    QS_USR_DICTIONARY(DISARM);
+    QS_USR_DICTIONARY(REARM);
+    QS_USR_DICTIONARY(GET_CTR);
+    QS_USR_DICTIONARY(GET_IDLE);
+    QS_USR_DICTIONARY(TICKS);
+}
+/*..........................................................................*/
+void QS_onTestTeardown(void) {
+}
+
+/*..........................................................................*/
+/*! callback function to execute user commands */
+void QS_onCommand(uint8_t cmdId,
+                  uint32_t param1, uint32_t param2, uint32_t param3)
+{
+    QTimeEvt * const te = &l_timer.timeEvt[param1 % N_TIMEEVTS];
+
+    switch (cmdId) {
+        case ARM: {
+            QTimeEvt_armX(te, (QTimeEvtCtr)param2, (QTimeEvtCtr)param3);
+            break;
+        }
+        case DISARM: {
+            QS_BEGIN_ID(DISARMED, 0U) /* app-specific record */
+                QS_U8(0, (uint8_t)param1);
+                QS_U8(0, QTimeEvt_disarm(te) ? 1U : 0U);
+            QS_END()
+            break;
+        }
+        case REARM: {
+            QS_BEGIN_ID(REARMED, 0U) /* app-specific record */
+                QS_U8(0, (uint8_t)param1);
+                QS_U8(0, QTimeEvt_rearm(te, (QTimeEvtCtr)param2) ? 1U : 0U);
+            QS_END()
+            break;
+        }
+        case GET_CTR: {
+            QS_BEGIN_ID(CTR, 0U) /* app-specific record */
+                QS_U8(0, (uint8_t)param1);
+                QS_U32(0, (uint32_t)QTimeEvt_currCtr(te));
+            QS_END()
+            break;
+        }
+        case GET_IDLE: {
+            QS_BEGIN_ID(IDLE, 0U) /* app-specific record */
+                QS_U8(0, QF_noTimeEvtsActiveX(0U) ? 1U : 0U);
+            QS_END()
+            break;
+        }
+        case TICKS: {
+            /* unlike tick() in the test scripts, which expires only the
+            * current time event object, run the real QF_tickX_() and
+            * dispatch the expired time events after every tick
+            */
+            for (; param1 > 0U; --param1) {
+                ++l_now;
+                QF_TICK_X(0U, &l_ticker);
+                QS_processTestEvts_();
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+/*..........................................................................*/
+/*! callback function to "massage" the injected QP events (not used here) */
+void QS_onTestEvt(QEvt *e) {
+    (void)e;
+#ifdef Q_HOST  /* is this test compiled for a desktop Host computer? */
+#else /* embedded Target */
+#endif /* embedded Target */
+}
+/*..........................................................................*/
+/*! callback function to output the posted QP events (not used here) */
+void QS_onTestPost(void const *sender, QActive *recipient,
+                   QEvt const *e, bool status)
+{
+    (void)sender;
+    (void)recipient;
+    (void)e;
+    (void)status;
+}
@@ -0,0 +1,97 @@
+# test-script for QUTest unit testing harness
+# see https://www.state-machine.com/qtools/html
+
+# preamble...
+def on_reset():
+    expect_pause()
+    glb_filter(GRP_UA)
+    continue_test()
+    expect_run()
+
+# the timing wheel resolves 4 bits of the 16-bit time event counter per level
+# and the TICKS command runs the real QF_tickX_() (see test_time_wheel.c)
+
+# tests...
+test("One-shot time events at every level of the wheel")
+command("ARM", 0, 3)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("ARM", 1, 20)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("ARM", 2, 300)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("ARM", 3, 5000)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("TICKS", 5000)
+expect("@timestamp EXPIRED 0 3")
+expect("@timestamp EXPIRED 1 20")
+expect("@timestamp EXPIRED 2 300")
+expect("@timestamp EXPIRED 3 5000")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("GET_IDLE")
+expect("@timestamp IDLE 1")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+
+test("Periodic time event")
+command("ARM", 0, 5, 7)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("TICKS", 20)
+expect("@timestamp EXPIRED 0 5")
+expect("@timestamp EXPIRED 0 12")
+expect("@timestamp EXPIRED 0 19")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("GET_CTR", 0)
+expect("@timestamp CTR 0 6")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("GET_IDLE")
+expect("@timestamp IDLE 0")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("DISARM", 0)
+expect("@timestamp DISARMED 0 1")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("DISARM", 0)
+expect("@timestamp DISARMED 0 0")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("TICKS", 100)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("GET_IDLE")
+expect("@timestamp IDLE 1")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+
+test("Rearm a time event in a higher level of the wheel")
+command("ARM", 1, 40)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("TICKS", 10)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("GET_CTR", 1)
+expect("@timestamp CTR 1 30")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("REARM", 1, 100)
+expect("@timestamp REARMED 1 1")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("TICKS", 99)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("TICKS", 1)
+expect("@timestamp EXPIRED 1 110")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+# rearming a disarmed time event arms it
+command("REARM", 1, 5)
+expect("@timestamp REARMED 1 0")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("TICKS", 5)
+expect("@timestamp EXPIRED 1 115")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+
+test("Wrap around of the tick counter of the wheel")
+command("TICKS", 65530)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("ARM", 0, 20)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("ARM", 1, 6)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("ARM", 2, 4096)
+expect("@timestamp Trg-Done QS_RX_COMMAND")
+command("TICKS", 5000)
+expect("@timestamp EXPIRED 1 65536")
+expect("@timestamp EXPIRED 0 65550")
+expect("@timestamp EXPIRED 2 69626")
+expect("@timestamp Trg-Done QS_RX_COMMAND")
@@ -0,0 +1,277 @@
+/*****************************************************************************
+* Purpose: thread-pool executor test for the POSIX-POOL port
+* Last Updated for Version: 6.9.1
+* Date of the Last Update:  2026-10-16
+*
+*                    Q u a n t u m  L e a P s
+*                    ------------------------
+*                    Modern Embedded Software
+*
+* Copyright (C) 2005-2020 Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <www.gnu.org/licenses/>.
+*
+* Contact information:
+* <www.state-machine.com/licensing>
+* <info@state-machine.com>
+*****************************************************************************/
+/* expose features from the 2008 POSIX standard (IEEE Standard 1003.1-2008) */
+#define _POSIX_C_SOURCE 200809L
+
+#include "qpc.h"
+
+#include <pthread.h>
+#include <sched.h>  /* for sched_yield() */
+#include <stdio.h>
+#include <stdlib.h>
+
+Q_DEFINE_THIS_FILE
+
+/* More AOs than worker threads receive the events of the producer threads.
+* The RTC steps of every AO must stay serialized and in the FIFO order of
+* each producer, even though the steps are executed by different workers.
+*/
+
+/*..........................................................................*/
+enum {
+    N_WORKERS   = 4,     /* the number of the worker threads */
+    N_COUNTERS  = 8,     /* the number of the Counter AOs */
+    N_PRODUCERS = 4,     /* the number of the producer threads */
+    N_EVTS      = 20000, /* the number of the events of each producer */
+    POOL_LEN    = 32,    /* the number of the events in the pool */
+    QUEUE_LEN   = 40,    /* more than all events that can be in flight */
+    MAX_TICKS   = 3000   /* the test timeout [clock ticks] */
+};
+
+enum TestSignals {
+    COUNT_SIG = Q_USER_SIG, /* posted by the producers to the Counter AOs */
+    MAX_SIG
+};
+
+typedef struct {
+    QEvt super;
+    uint32_t producer; /* the producer of the event */
+    uint32_t seq;      /* the sequence number of the event */
+} SeqEvt;
+
+typedef struct {
+    QActive super;
+    uint32_t last[N_PRODUCERS]; /* the last sequence number per producer */
+    uint32_t nEvts;             /* the number of the events received */
+    int busy;                   /* is an RTC step in progress? (atomic) */
+} Counter;
+
+static QState Counter_initial(Counter * const me, QEvt const * const e);
+static QState Counter_active (Counter * const me, QEvt const * const e);
+
+static void *producer_thread(void *arg);
+static void seenThread(void);
+static uint32_t freeEvts(void);
+static void fail(char const *reason);
+
+static Counter l_counters[N_COUNTERS];
+static pthread_t l_producers[N_PRODUCERS];
+static pthread_mutex_t l_seenMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_t l_seen[N_WORKERS]; /* the workers that executed the AOs */
+static uint32_t l_nSeen;
+static int l_nDone; /* the number of the Counters done (atomic) */
+static char const * volatile l_failure; /* the reason of the failure */
+static uint32_t l_ticks;
+
+/*..........................................................................*/
+int main(void) {
+    static QEvt const *counterQueueSto[N_COUNTERS][QUEUE_LEN];
+    static QF_MPOOL_EL(SeqEvt) poolSto[POOL_LEN];
+    uint_fast8_t n;
+
+    QF_init();    /* initialize the framework */
+    QF_setPoolSize(N_WORKERS); /* more AOs than the workers */
+    QF_poolInit(poolSto, sizeof(poolSto), sizeof(poolSto[0]));
+
+    for (n = 0U; n < N_COUNTERS; ++n) {
+        QActive_ctor(&l_counters[n].super, Q_STATE_CAST(&Counter_initial));
+        QACTIVE_START(&l_counters[n].super, (uint_fast8_t)(n + 1U),
+                      counterQueueSto[n], Q_DIM(counterQueueSto[n]),
+                      (void *)0, 0U, (void *)0);
+    }
+
+    (void)QF_run(); /* run until the Counters or the timeout stop QF */
+
+    for (n = 0U; n < N_PRODUCERS; ++n) {
+        pthread_join(l_producers[n], (void **)0);
+    }
+    if (freeEvts() != POOL_LEN) {
+        fail("the event pool leaks events");
+    }
+    if ((l_failure == (char const *)0) && (l_nSeen < 2U)) {
+        fail("the AOs were not executed by several workers");
+    }
+
+    if (l_failure != (char const *)0) {
+        printf("FAIL: %s\n", l_failure);
+        return 1;
+    }
+    printf("PASS: %d producers x %d events to %d AOs on %u of %d workers\n",
+           N_PRODUCERS, N_EVTS, N_COUNTERS, (unsigned)l_nSeen, N_WORKERS);
+    return 0;
+}
+
+/*..........................................................................*/
+static QState Counter_initial(Counter * const me, QEvt const * const e) {
+    (void)e; /* unused parameter */
+    return Q_TRAN(&Counter_active);
+}
+/*..........................................................................*/
+static QState Counter_active(Counter * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case COUNT_SIG: {
+            SeqEvt const *se = Q_EVT_CAST(SeqEvt);
+
+            if (__atomic_exchange_n(&me->busy, 1, __ATOMIC_ACQUIRE) != 0) {
+                fail("two workers executed one AO at the same time");
+            }
+            seenThread();
+            if (se->seq != me->last[se->producer] + 1U) {
+                fail("the events of a producer are out of order");
+            }
+            me->last[se->producer] = se->seq;
+            ++me->nEvts;
+            if ((me->nEvts & 15U) == 0U) {
+                sched_yield(); /* let other workers in while still busy */
+            }
+            __atomic_store_n(&me->busy, 0, __ATOMIC_RELEASE);
+
+            /* every producer posts N_EVTS / N_COUNTERS events to each AO */
+            if ((me->nEvts == (N_PRODUCERS * N_EVTS) / N_COUNTERS)
+                && (__atomic_add_fetch(&l_nDone, 1, __ATOMIC_SEQ_CST)
+                    == N_COUNTERS)) /* the last Counter done? */
+            {
+                QF_stop();
+            }
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status_;
+}
+
+/*..........................................................................*/
+static void *producer_thread(void *arg) {
+    uint32_t const producer = (uint32_t)(uintptr_t)arg;
+    uint32_t n;
+
+    for (n = 0U; n < N_EVTS; ++n) {
+        /* the events go round-robin to all Counters */
+        Counter * const counter = &l_counters[n % N_COUNTERS];
+        SeqEvt *se;
+        for (;;) { /* retry until an event is available */
+            Q_NEW_X(se, SeqEvt, 0U, COUNT_SIG); /* margin 0, may fail */
+            if (se != (SeqEvt *)0) {
+                break;
+            }
+            if (l_failure != (char const *)0) { /* test already failed? */
+                return (void *)0;
+            }
+            sched_yield();
+        }
+        se->producer = producer;
+        se->seq = (n / N_COUNTERS) + 1U; /* the sequence for the Counter */
+        /* the queues of the Counters can take all events of the pool */
+        QACTIVE_POST(&counter->super, &se->super, (void *)0);
+    }
+    return (void *)0;
+}
+/*..........................................................................*/
+/* remember the worker thread executing the current RTC step */
+static void seenThread(void) {
+    pthread_t const self = pthread_self();
+    uint32_t i;
+
+    pthread_mutex_lock(&l_seenMutex);
+    for (i = 0U; (i < l_nSeen) && (!pthread_equal(l_seen[i], self)); ++i) {
+    }
+    if (i == l_nSeen) { /* a new worker? */
+        if (l_nSeen < N_WORKERS) {
+            l_seen[l_nSeen] = self;
+            ++l_nSeen;
+        }
+        else {
+            fail("more threads than the workers executed the AOs");
+        }
+    }
+    pthread_mutex_unlock(&l_seenMutex);
+}
+/*..........................................................................*/
+/* the number of the free events in the pool (allocates and frees them all) */
+static uint32_t freeEvts(void) {
+    static QEvt *evts[POOL_LEN];
+    uint32_t n;
+    uint32_t i;
+
+    for (n = 0U; n < POOL_LEN; ++n) {
+        Q_NEW_X(evts[n], QEvt, 0U, COUNT_SIG); /* margin 0, may fail */
+        if (evts[n] == (QEvt *)0) {
+            break;
+        }
+    }
+    for (i = 0U; i < n; ++i) {
+        QF_gc(evts[i]);
+    }
+    return n;
+}
+/*..........................................................................*/
+static void fail(char const *reason) {
+    if (l_failure == (char const *)0) { /* report only the first failure */
+        l_failure = reason;
+    }
+    QF_stop();
+}
+
+/*..........................................................................*/
+void QF_onStartup(void) {
+    uint32_t i;
+
+    QF_setTickRate(100U, 30); /* 100Hz clock tick rate, ticker priority 30 */
+
+    for (i = 0U; i < N_PRODUCERS; ++i) {
+        Q_ALLEGE(pthread_create(&l_producers[i], (pthread_attr_t *)0,
+                                &producer_thread, (void *)(uintptr_t)i)
+                 == 0);
+    }
+}
+/*..........................................................................*/
+void QF_onCleanup(void) {
+}
+/*..........................................................................*/
+void QF_onClockTick(void) {
+    ++l_ticks;
+    if (l_ticks > MAX_TICKS) {
+        fail("timeout");
+    }
+}
+/*..........................................................................*/
+Q_NORETURN Q_onAssert(char const * const module, int_t const loc) {
+    fprintf(stderr, "Assertion failed in %s:%d\n", module, loc);
+    exit(-1);
+}
@@ -55,7 +55,7 @@ void CompTimeEvt_ctor(
     QHsm * comp,
     enum_t const sig,
     uint_fast8_t const tickRate);
-void CompTimeEvt_dispatchToComp(CompTimeEvt const * const me, uint_fast8_t const qs_id);
+void CompTimeEvt_dispatchToComp(CompTimeEvt const * const me, uint_fast16_t const qs_id);
 /*.$enddecl${Cont::CompTimeEvt} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
 
 /*.$declare${Comp::Philo} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
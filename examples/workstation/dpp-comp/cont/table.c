@@ -70,7 +70,7 @@ void CompTimeEvt_ctor(
 }
 
 /*.${Cont::CompTimeEvt::dispatchToComp} ....................................*/
-void CompTimeEvt_dispatchToComp(CompTimeEvt const * const me, uint_fast8_t const qs_id) {
+void CompTimeEvt_dispatchToComp(CompTimeEvt const * const me, uint_fast16_t const qs_id) {
     (void)qs_id; /* unused parameter outside Q_SPY */
     QHSM_DISPATCH(me->comp, (QEvt const *)me, qs_id);
 }
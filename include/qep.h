@@ -132,6 +132,31 @@ extern char_t const QP_versionStr[7];
     #error "Q_SIGNAL_SIZE defined incorrectly, expected 1U, 2U, or 4U"
 #endif
 
+#ifndef Q_EVT_REF_CTR_SIZE
+
+    /*! The size (in bytes) of the reference counter of an event. Valid
+    * values: 1U, 2U, or 4U; default 1U */
+    /**
+    * @description
+    * This macro can be defined in the QEP port file (qep_port.h) to
+    * configure the ::QEvtRefCtr type. The wider counter is needed when
+    * a single dynamic event can be referenced more than 255 times, e.g.,
+    * when it is published to a large number of subscribers.
+    * When the macro is not defined, the default of 1 byte is applied.
+    */
+    #define Q_EVT_REF_CTR_SIZE 1U
+#endif
+#if (Q_EVT_REF_CTR_SIZE == 1U)
+    /*! QEvtRefCtr represents the reference counter of an event. */
+    typedef uint8_t QEvtRefCtr;
+#elif (Q_EVT_REF_CTR_SIZE == 2U)
+    typedef uint16_t QEvtRefCtr;
+#elif (Q_EVT_REF_CTR_SIZE == 4U)
+    typedef uint32_t QEvtRefCtr;
+#else
+    #error "Q_EVT_REF_CTR_SIZE defined incorrectly, expected 1U, 2U, or 4U"
+#endif
+
 
 /****************************************************************************/
 /*! Event class */
@@ -151,7 +176,7 @@ extern char_t const QP_versionStr[7];
 typedef struct {
     QSignal sig;              /*!< signal of the event instance */
     uint8_t poolId_;          /*!< pool ID (0 for static event) */
-    uint8_t volatile refCtr_; /*!< reference counter */
+    QEvtRefCtr volatile refCtr_; /*!< reference counter */
 } QEvt;
 
 #ifdef Q_EVT_CTOR /* Shall the constructor for the QEvt class be provided? */
@@ -255,6 +280,47 @@ union QHsmAttr {
     QMTranActTable const *tatbl; /*!< transition-action table */
 };
 
+#ifdef QHSM_SUPER_CACHE
+    #if (QHSM_SUPER_CACHE < 4) || (QHSM_SUPER_CACHE > 256) \
+        || ((QHSM_SUPER_CACHE & (QHSM_SUPER_CACHE - 1)) != 0)
+    #error "QHSM_SUPER_CACHE defined incorrectly, expected power of 2 in 4..256"
+    #endif
+
+/*! Cache of the superstates of the state-handlers of ::QHsm subclasses */
+/**
+* @description
+* QEP discovers the superstate of a ::QHsm state by calling its
+* state-handler with the reserved empty signal, which repeats the same
+* calls in every transition, QHsm_isIn() and QHsm_childState(). With the
+* macro QHSM_SUPER_CACHE defined (as the number of entries, a power of 2),
+* QEP memoizes the superstate and the nesting depth of each state-handler
+* in the cache attached with QHsm_setCache() upon the first discovery,
+* and uses them for the exit/entry paths and the least common ancestor
+* (LCA) of transitions.
+*
+* @note
+* The superstate of a state-handler never changes, so one static
+* (zero-initialized) cache can be shared by all instances of a class, or
+* of several classes, as long as it has more entries than the states.
+* The state machines sharing the cache can be dispatched in different
+* threads, because the cache is filled in the QF critical section (so
+* the superstate cache requires the QF port). A full cache is asserted.
+*
+* @usage
+* @code
+* static QHsmSuperCache l_philoCache; (shared by all Philo instances)
+* ...
+* QActive_ctor(&me->super, Q_STATE_CAST(&Philo_initial));
+* QHsm_setCache(&me->super, &l_philoCache);
+* @endcode
+*/
+typedef struct {
+    QStateHandler state[QHSM_SUPER_CACHE]; /*!< cached state-handlers */
+    QStateHandler super[QHSM_SUPER_CACHE]; /*!< superstates of the states */
+    uint8_t depth[QHSM_SUPER_CACHE]; /*!< nesting depth (QHsm_top() is 0) */
+} QHsmSuperCache;
+#endif /* QHSM_SUPER_CACHE */
+
 /****************************************************************************/
 /*! Hierarchical State Machine class */
 /**
@@ -283,6 +349,9 @@ typedef struct {
     struct QHsmVtable const *vptr; /*!< virtual pointer */
     union QHsmAttr state; /*!< current active state (state-variable) */
     union QHsmAttr temp;  /*!< temporary: tran. chain, target state, etc. */
+#ifdef QHSM_SUPER_CACHE
+    QHsmSuperCache *cache; /*!< superstate cache (NULL for none) */
+#endif
 } QHsm;
 
 /*! Virtual table for the ::QHsm class. */
@@ -290,7 +359,7 @@ struct QHsmVtable {
 #ifdef Q_SPY
     /*! Triggers the top-most initial transition in a HSM. */
     void (*init)(QHsm * const me, void const * const e,
-                 uint_fast8_t const qs_id);
+                 uint_fast16_t const qs_id);
 #else
     void (*init)(QHsm * const me, void const * const e);
 #endif /* Q_SPY */
@@ -298,7 +367,7 @@ struct QHsmVtable {
 #ifdef Q_SPY
     /*! Dispatches an event to a SM. */
     void (*dispatch)(QHsm * const me, QEvt const * const e,
-                     uint_fast8_t const qs_id);
+                     uint_fast16_t const qs_id);
 #else
     void (*dispatch)(QHsm * const me, QEvt const * const e);
 #endif /* Q_SPY */
@@ -328,7 +397,7 @@ struct QHsmVtable {
 
     /*! Implementation of the top-most initial transition in ::QHsm subclass */
     void QHsm_init_(QHsm * const me, void const * const e,
-                    uint_fast8_t const qs_id);
+                    uint_fast16_t const qs_id);
 #else
 
     #define QHSM_INIT(me_, par_, dummy) do { \
@@ -360,7 +429,7 @@ struct QHsmVtable {
 
     /*! Implementation of dispatching events to a ::QHsm subclass */
     void QHsm_dispatch_(QHsm * const me, QEvt const * const e,
-                        uint_fast8_t const qs_id);
+                        uint_fast16_t const qs_id);
 #else
 
     #define QHSM_DISPATCH(me_, e_, dummy) \
@@ -399,6 +468,19 @@ struct QHsmVtable {
 */
 bool QHsm_isIn(QHsm * const me, QStateHandler const state);
 
+#ifdef QHSM_SUPER_CACHE
+/*! Attach the superstate cache to a ::QHsm subclass (NULL to detach)
+* @public @memberof QHsm
+*/
+/**
+* @param[in,out] me_    pointer (see @ref oop)
+* @param[in]     cache_ pointer to the ::QHsmSuperCache (might be shared)
+* @note must be called after the "constructor" (which detaches the cache)
+*/
+#define QHsm_setCache(me_, cache_) \
+    ((void)(Q_HSM_UPCAST(me_)->cache = (cache_)))
+#endif
+
 /* QHsm protected operations... */
 /*! Protected "constructor" of ::QHsm
 * @protected @memberof QHsm
@@ -519,7 +601,7 @@ void QMsm_ctor(QMsm * const me, QStateHandler initial);
 */
 #ifdef Q_SPY
 void QMsm_init_(QHsm * const me, void const * const e,
-                uint_fast8_t const qs_id);
+                uint_fast16_t const qs_id);
 #else
 void QMsm_init_(QHsm * const me, void const * const e);
 #endif
@@ -529,7 +611,7 @@ void QMsm_init_(QHsm * const me, void const * const e);
 */
 #ifdef Q_SPY
 void QMsm_dispatch_(QHsm * const me, QEvt const * const e,
-                    uint_fast8_t const qs_id);
+                    uint_fast16_t const qs_id);
 #else
 void QMsm_dispatch_(QHsm * const me, QEvt const * const e);
 #endif
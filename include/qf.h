@@ -66,8 +66,12 @@
 #endif
 
 #ifndef QF_MAX_EPOOL
-    /*! Default value of the macro configurable value in qf_port.h */
+    /*! Default value of the macro configurable value in qf_port.h.
+    * Valid values: [1U..15U]; default 3U
+    */
     #define QF_MAX_EPOOL         3U
+#elif (QF_MAX_EPOOL > 15U) /* the range of the QS event-pool IDs */
+    #error "QF_MAX_EPOOL exceeds the maximum of 15"
 #endif
 
 #ifndef QF_MAX_TICK_RATE
@@ -86,6 +90,26 @@
     #define QF_TIMEEVT_CTR_SIZE  2U
 #endif
 
+#ifdef QF_TIMEEVT_WHEEL
+    #ifndef QF_TIMEEVT_WHEEL_BITS
+    /*! macro to override the default number of bits of the time event
+    * counter resolved by one level of the timing wheel.
+    * Valid values: 1, 2, 4, or 8; default 4
+    */
+    #define QF_TIMEEVT_WHEEL_BITS 4U
+    #endif
+    #if (((QF_TIMEEVT_CTR_SIZE * 8U) % QF_TIMEEVT_WHEEL_BITS) != 0U) \
+        || (QF_TIMEEVT_WHEEL_BITS > 8U)
+    #error "QF_TIMEEVT_WHEEL_BITS defined incorrectly, expected 1, 2, 4, or 8"
+    #endif
+#endif
+
+#ifdef QF_ACTIVE_LANES
+    #if (QF_ACTIVE_LANES < 2) || (QF_ACTIVE_LANES > 8)
+    #error "QF_ACTIVE_LANES defined incorrectly, expected 2..8"
+    #endif
+#endif
+
 /****************************************************************************/
 struct QEQueue; /* forward declaration */
 
@@ -132,6 +156,46 @@ typedef struct QActive {
     QF_EQUEUE_TYPE eQueue;
 #endif
 
+#ifdef QF_ACTIVE_LANES
+    /*! Higher-priority lanes of the native event queue. */
+    /**
+    * @description
+    * The @c eQueue member is the lane 0 (the lowest priority) and
+    * lane[k-1] is the lane k of the event queue. QActive_get_() always
+    * delivers the events from the highest non-empty lane first, while
+    * the events within one lane are delivered in the FIFO order.
+    *
+    * @sa QActive_setLane(), QACTIVE_POST_LANE()
+    */
+    struct QEQueue lane[QF_ACTIVE_LANES - 1];
+
+    /*! the lane of the event at the front of @c eQueue (0 for lane 0) */
+    uint8_t frontLane;
+#endif
+
+#ifdef QF_ACTIVE_GET_BATCH
+    /*! The batch of events taken from the queue by QActive_getBatch_(). */
+    /**
+    * @description
+    * The events batch[batchNext..batchEnd-1] are not dispatched yet and
+    * are delivered before all events still in the queue. Therefore,
+    * QActive_postLIFO_() inserts the event in front of them and
+    * QActive_batchNext_() delivers them one by one.
+    */
+    QEvt const * *batch;
+
+    /*! index of the next event to deliver from @c batch */
+    uint_fast16_t batchNext;
+
+    /*! index past the last event in @c batch */
+    uint_fast16_t batchEnd;
+
+#ifdef QF_ACTIVE_LANES
+    /*! an event was posted to a higher lane during the batch */
+    uint8_t volatile batchBreak;
+#endif
+#endif
+
 #ifdef QF_OS_OBJECT_TYPE
     /*! OS-dependent per-thread object. */
     /**
@@ -157,11 +221,11 @@ typedef struct QActive {
 
 #ifdef QXK_H  /* QXK kernel used? */
     /*! QXK dynamic priority (1..#QF_MAX_ACTIVE) of this AO/thread */
-    uint8_t dynPrio;
+    QPrio dynPrio;
 #endif
 
     /*! QF priority (1..#QF_MAX_ACTIVE) of this active object. */
-    uint8_t prio;
+    QPrio prio;
 
 } QActive;
 
@@ -171,7 +235,7 @@ typedef struct {
 
     /*! virtual function to start the active object (thread) */
     /** @sa QACTIVE_START() */
-    void (*start)(QActive * const me, uint_fast8_t prio,
+    void (*start)(QActive * const me, uint_fast16_t prio,
                   QEvt const * * const qSto, uint_fast16_t const qLen,
                   void * const stkSto, uint_fast16_t const stkSize,
                   void const * const par);
@@ -315,6 +379,211 @@ typedef struct {
     ((*((QActiveVtable const *)((Q_HSM_UPCAST(me_))->vptr))->postLIFO)( \
         (me_), (e_)))
 
+#ifdef Q_SPY
+    /*! Posts a batch of events to an active object (FIFO) in one
+    * critical section.
+    * @public @memberof QActive
+    */
+    /**
+    * @description
+    * This macro posts all @p n_ events from the array @p batch_ or none of
+    * them, depending on whether the queue can accept all the events with
+    * the specified margin of free slots remaining. The consumer is signaled
+    * at most once per batch.
+    *
+    * @param[in,out] me_    pointer (see @ref oop)
+    * @param[in]     batch_ array of pointers to the events to post
+    * @param[in]     n_     number of events in the @p batch_ array
+    * @param[in]     margin_ the minimum free slots in the queue, which
+    *                must still be available after posting all the events.
+    *                The special value #QF_NO_MARGIN causes asserting failure
+    *                in case the batch cannot be posted.
+    * @param[in]     sender_ pointer to the sender object.
+    *
+    * @returns 'true' if all the events have been posted, and 'false' if
+    * none of them have been posted due to insufficient margin of free slots.
+    *
+    * @note
+    * Unlike QACTIVE_POST_X(), this macro is not polymorphic and can be used
+    * only with the active objects using the event queue of the QF port
+    * (::QActive and ::QMActive, but not ::QTicker or ::QXThread), which
+    * QActive_postBatch_() asserts.
+    *
+    * @sa #QACTIVE_POST_X, QActive_postBatch_()
+    */
+    #define QACTIVE_POST_BATCH(me_, batch_, n_, margin_, sender_) \
+        (QActive_postBatch_((QActive *)(me_), (batch_), (n_), \
+                            (margin_), (sender_)))
+
+    /*! Implementation of the active object batch post (FIFO) operation */
+    bool QActive_postBatch_(QActive * const me, QEvt const * const batch[],
+                            uint_fast16_t const n,
+                            uint_fast16_t const margin,
+                            void const * const sender);
+#else
+
+    #define QACTIVE_POST_BATCH(me_, batch_, n_, margin_, sender_) \
+        (QActive_postBatch_((QActive *)(me_), (batch_), (n_), (margin_)))
+
+    bool QActive_postBatch_(QActive * const me, QEvt const * const batch[],
+                            uint_fast16_t const n,
+                            uint_fast16_t const margin);
+#endif
+
+#ifndef QF_NON_NATIVE_EQUEUE /* conflating post needs the native QEQueue */
+
+/*! Pointer to a function deciding whether the queued event @p queued
+* can be replaced by the event @p e with the same signal.
+* @sa QACTIVE_POST_CONFLATE_X()
+*/
+typedef bool (*QEvtMatchHandler)(QEvt const * const queued,
+                                 QEvt const * const e);
+
+#ifdef Q_SPY
+    /*! Posts an event to an active object, replacing the undelivered
+    * event with the same signal (conflating post).
+    * @public @memberof QActive
+    */
+    /**
+    * @description
+    * If the event queue of the active object @p me_ still holds an event
+    * with the same signal as @p e_ (and for which the optional function
+    * @p match_ returns 'true'), this macro replaces that event in place
+    * with @p e_ and recycles the old event. Otherwise, the event is posted
+    * just like with QACTIVE_POST_X(). This bounds the depth of the queue
+    * by the number of distinct signals (keys) of the "latest value" events
+    * rather than by the rate of the updates.
+    *
+    * @param[in,out] me_    pointer (see @ref oop)
+    * @param[in]     e_     pointer to the event to post
+    * @param[in]     match_ pointer to the function comparing the keys of
+    *                the queued event and @p e_, or NULL to conflate all
+    *                the events with the same signal
+    * @param[in]     margin_ the minimum free slots in the queue, which
+    *                must still be available after posting the event (not
+    *                used when an event is replaced). The special value
+    *                #QF_NO_MARGIN causes asserting failure in case the
+    *                event cannot be posted.
+    * @param[in]     sender_ pointer to the sender object.
+    *
+    * @returns 'true' if the event has been posted or has replaced a queued
+    * event, and 'false' if the posting failed due to insufficient margin.
+    *
+    * @note
+    * The @p match_ function is called inside the critical section, so it
+    * must be short and must not call any QF services.
+    *
+    * @note
+    * Just like QACTIVE_POST_BATCH(), this macro is not polymorphic and can
+    * be used only with the active objects using the event queue of the QF
+    * port (::QActive and ::QMActive, but not ::QTicker or ::QXThread),
+    * which QActive_postConflate_() asserts. The macro is not available in
+    * the QF ports with their own event queues (macro QF_NON_NATIVE_EQUEUE,
+    * e.g., the POSIX port with QF_MPSC_QUEUE).
+    *
+    * @sa #QACTIVE_POST_X, QActive_postConflate_()
+    */
+    #define QACTIVE_POST_CONFLATE_X(me_, e_, match_, margin_, sender_) \
+        (QActive_postConflate_((QActive *)(me_), (e_), (match_), \
+                               (margin_), (sender_)))
+
+    /*! Implementation of the active object conflating post operation */
+    bool QActive_postConflate_(QActive * const me, QEvt const * const e,
+                               QEvtMatchHandler const match,
+                               uint_fast16_t const margin,
+                               void const * const sender);
+#else
+
+    #define QACTIVE_POST_CONFLATE_X(me_, e_, match_, margin_, sender_) \
+        (QActive_postConflate_((QActive *)(me_), (e_), (match_), \
+                               (margin_)))
+
+    bool QActive_postConflate_(QActive * const me, QEvt const * const e,
+                               QEvtMatchHandler const match,
+                               uint_fast16_t const margin);
+#endif
+
+/*! Posts an event to an active object, replacing the undelivered event
+* with the same signal, with the delivery guarantee
+* (see QACTIVE_POST_CONFLATE_X()).
+* @public @memberof QActive
+*/
+#define QACTIVE_POST_CONFLATE(me_, e_, match_, sender_) \
+    ((void)QACTIVE_POST_CONFLATE_X((me_), (e_), (match_), QF_NO_MARGIN, \
+                                   (sender_)))
+#endif /* QF_NON_NATIVE_EQUEUE */
+
+#ifdef QF_ACTIVE_LANES
+/*! Provides the storage for the given priority lane of the event queue
+* of an active object.
+* @public @memberof QActive
+*/
+void QActive_setLane(QActive * const me, uint_fast8_t const lane,
+                     QEvt const * * const qSto, uint_fast16_t const qLen);
+
+#ifdef Q_SPY
+    /*! Posts an event to the given priority lane of the event queue of
+    * an active object (FIFO within the lane).
+    * @public @memberof QActive
+    */
+    /**
+    * @description
+    * This macro works like QACTIVE_POST_X(), except that the event is
+    * queued in the priority lane @p lane_ (0..#QF_ACTIVE_LANES-1) of the
+    * event queue. The events from the higher lanes are always delivered
+    * before the events from the lower lanes, so the urgent events (e.g.,
+    * control messages) are not delayed by the backlog of the bulk events
+    * posted to the lane 0 (e.g., with QACTIVE_POST()).
+    *
+    * @param[in,out] me_    pointer (see @ref oop)
+    * @param[in]     e_     pointer to the event to post
+    * @param[in]     lane_  the priority lane (0 is the lowest)
+    * @param[in]     margin_ the minimum free slots in the lane, which
+    *                must still be available after posting the event.
+    *                The special value #QF_NO_MARGIN causes asserting failure
+    *                in case the event cannot be posted.
+    * @param[in]     sender_ pointer to the sender object.
+    *
+    * @returns 'true' if the posting succeeded, and 'false' if the posting
+    * failed due to insufficient margin of free slots available in the lane.
+    *
+    * @note
+    * Just like QACTIVE_POST_BATCH(), this macro is not polymorphic and
+    * can be used only with the active objects using the event queue of
+    * the QF port, which QActive_postLane_() asserts. The lanes
+    * 1..#QF_ACTIVE_LANES-1 must be provided with storage by
+    * QActive_setLane() before posting to them.
+    *
+    * @sa QActive_setLane(), QActive_postLane_()
+    */
+    #define QACTIVE_POST_LANE_X(me_, e_, lane_, margin_, sender_) \
+        (QActive_postLane_((QActive *)(me_), (e_), (lane_), \
+                           (margin_), (sender_)))
+
+    /*! Implementation of the active object post to a priority lane */
+    bool QActive_postLane_(QActive * const me, QEvt const * const e,
+                           uint_fast8_t const lane,
+                           uint_fast16_t const margin,
+                           void const * const sender);
+#else
+
+    #define QACTIVE_POST_LANE_X(me_, e_, lane_, margin_, sender_) \
+        (QActive_postLane_((QActive *)(me_), (e_), (lane_), (margin_)))
+
+    bool QActive_postLane_(QActive * const me, QEvt const * const e,
+                           uint_fast8_t const lane,
+                           uint_fast16_t const margin);
+#endif
+
+/*! Posts an event to the given priority lane of the event queue of
+* an active object with the delivery guarantee (see QACTIVE_POST_LANE_X()).
+* @public @memberof QActive
+*/
+#define QACTIVE_POST_LANE(me_, e_, lane_, sender_) \
+    ((void)QACTIVE_POST_LANE_X((me_), (e_), (lane_), QF_NO_MARGIN, \
+                               (sender_)))
+#endif /* QF_ACTIVE_LANES */
+
 /* QActive protected operations... */
 /*! protected "constructor" of an ::QActive active object
 * @protected @memberof QActive
@@ -465,6 +734,12 @@ void QMActive_ctor(QMActive * const me, QStateHandler initial);
 * invocation of the QF_tickX_() function. Only armed (timing out) time events
 * are in the list, so only armed time events consume CPU cycles.
 *
+* When the macro #QF_TIMEEVT_WHEEL is defined, the armed time events are
+* instead organized into a hierarchical timing wheel for every tick rate,
+* where arming, disarming and rearming take O(1) time and every invocation
+* of QF_tickX_() processes only the time events that expire in this tick
+* (plus the occasional cascading of time events to the lower levels).
+*
 * @sa ::QTimeEvt for the description of the data members @n @ref oop
 *
 * @note
@@ -503,6 +778,20 @@ typedef struct QTimeEvt {
     * periodically.
     */
     QTimeEvtCtr interval;
+
+#ifdef QF_TIMEEVT_WHEEL
+    /*! the link pointing to this time event in the timing wheel */
+    /**
+    * @description
+    * The time events in one slot of the timing wheel are linked through
+    * the @c next pointers. The @c prevNext pointer allows a time event to
+    * be unlinked from its slot in O(1) time when it is disarmed or rearmed.
+    */
+    struct QTimeEvt * volatile *prevNext;
+
+    /*! the tick (at the associated rate) when the time event expires */
+    QTimeEvtCtr expiry;
+#endif /* QF_TIMEEVT_WHEEL */
 } QTimeEvt;
 
 /* QTimeEvt public operations... */
@@ -554,21 +843,160 @@ QTimeEvtCtr QTimeEvt_currCtr(QTimeEvt const * const me);
 */
 typedef QPSet QSubscrList;
 
+#ifdef QF_SPARSE_SUBSCR
+/*! Subscription of an active object to a signal in the sparse
+* subscriber store */
+/**
+* @description
+* When the macro #QF_SPARSE_SUBSCR is defined, the subscriptions are kept
+* in a hash map keyed by the signal, which holds one ::QSubscr object for
+* every subscribed pair of (signal, active object). Every active object
+* also has its own list of the subscriptions (reverse index), so that
+* QActive_unsubscribeAll() visits only the subscriptions of that active
+* object. The storage for the ::QSubscr objects is provided to
+* QF_psInitSparse() and the memory is proportional to the maximum number
+* of simultaneous subscriptions rather than to the number of signals.
+*
+* @note
+* The application should treat this structure as opaque.
+*/
+typedef struct QSubscr {
+    struct QSubscr *sigNext; /*!< next subscription in the same hash bucket */
+    struct QSubscr *aoNext;  /*!< next subscription of the same AO */
+    QSignal sig;             /*!< the subscribed signal */
+    QPrio prio;              /*!< priority of the subscribed AO */
+} QSubscr;
+
+#ifndef QF_SUBSCR_HASH_BITS
+    /*! macro to override the default number of bits of the signal hash
+    * (the sparse subscriber store has 2^QF_SUBSCR_HASH_BITS buckets)
+    */
+    #define QF_SUBSCR_HASH_BITS 8U
+#endif
+#endif /* QF_SPARSE_SUBSCR */
+
+#ifdef QF_EVT_PAYLOAD
+#if (QF_MAX_EPOOL > 14U) /* the payload pool ID is QF_MAX_EPOOL + 1 */
+    #error "QF_EVT_PAYLOAD requires QF_MAX_EPOOL of at most 14"
+#endif
+
+struct QPayload;
+
+/*! Pointer to the function that releases an external payload buffer */
+typedef void (*QPayloadReleaseHandler)(struct QPayload * const payload);
+
+/*! External reference-counted payload buffer of ::QPayloadEvt */
+/**
+* @description
+* QPayload describes a buffer allocated outside of the QF event pools
+* (e.g., a large sensor frame in a DMA buffer), which can be attached to
+* any number of payload events (::QPayloadEvt) without copying the data.
+* The payload counts the payload events referencing it. When the last
+* such event is recycled by QF_gc(), QF calls the @c release handler of
+* the payload, which gives the buffer back to its allocator.
+*
+* A scatter/gather list of buffers is represented by chaining QPayload
+* objects through the @c next pointer. Only the head of the chain is
+* reference-counted and its @c release handler is responsible for the
+* whole chain.
+*
+* @sa QPayload_ctor(), Q_NEW_PAYLOAD()
+*/
+typedef struct QPayload {
+    struct QPayload *next;          /*!< next buffer in the chain or NULL */
+    void *buf;                      /*!< the external buffer */
+    uint32_t len;                   /*!< length of the data in @c buf */
+    QPayloadReleaseHandler release; /*!< called when no longer referenced */
+    QEvtRefCtr volatile refCtr_;    /*!< number of outstanding references */
+} QPayload;
+
+/*! Event carrying a reference to an external payload buffer */
+/**
+* @description
+* Payload events are allocated from the dedicated payload event pool
+* (see QF_payloadPoolInit()) by the macros Q_NEW_PAYLOAD() and
+* Q_NEW_PAYLOAD_X(). They can be posted, published, deferred and recalled
+* as any other dynamic events. Application events with additional
+* parameters derive from QPayloadEvt (with QPayloadEvt as the first member).
+*/
+typedef struct {
+    QEvt super;               /*!< inherits ::QEvt */
+    QPayload *payload;        /*!< the external payload (head of chain) */
+} QPayloadEvt;
+
+/*! Constructor of the ::QPayload */
+void QPayload_ctor(QPayload * const me, void * const buf, uint32_t len,
+                   QPayloadReleaseHandler release);
+
+/*! Add a reference to the payload held outside of payload events */
+void QPayload_addRef(QPayload * const me);
+
+/*! Release a reference to the payload */
+void QPayload_release(QPayload * const me);
+#endif /* QF_EVT_PAYLOAD */
+
 /* public functions */
 
 /*! QF initialization. */
 void QF_init(void);
 
+#ifndef QF_SPARSE_SUBSCR
 /*! Publish-subscribe initialization. */
 void QF_psInit(QSubscrList * const subscrSto, enum_t const maxSignal);
+#else
+/*! Publish-subscribe initialization with the sparse subscriber store. */
+void QF_psInitSparse(QSubscr * const subscrSto,
+                     uint_fast16_t const subscrLen,
+                     enum_t const maxSignal);
+#endif
 
 /*! Event pool initialization for dynamic allocation of events. */
 void QF_poolInit(void * const poolSto, uint_fast32_t const poolSize,
                  uint_fast16_t const evtSize);
 
+#ifdef QF_MPOOL_ELASTIC
+/*! Elastic event pool initialization for dynamic allocation of events. */
+void QF_poolInitElastic(uint_fast16_t const evtSize,
+                        uint_fast32_t const nInit, uint_fast32_t const nMax,
+                        uint_fast16_t const nGrow,
+                        uint_fast16_t const lowMark);
+
+/*! Release the grown capacity of an elastic event pool. */
+uint_fast32_t QF_poolTrim(uint_fast8_t const poolId);
+#endif
+
 /*! Obtain the block size of any registered event pools */
 uint_fast16_t QF_poolGetMaxBlockSize(void);
 
+#ifdef QF_EVT_PAYLOAD
+/*! Initialization of the event pool for the payload events. */
+void QF_payloadPoolInit(void * const poolSto, uint_fast32_t const poolSize,
+                        uint_fast16_t const evtSize);
+#endif
+
+#ifdef QF_EPOOL_STATS
+/*! Statistics of the allocations from one event pool (size class) */
+/**
+* @sa QF_getPoolStats()
+*/
+typedef struct {
+    uint32_t nAlloc;     /*!< number of successful allocations */
+    uint32_t nFail;      /*!< number of failed allocations (with margin) */
+    QEvtSize minSize;    /*!< the smallest event size allocated so far */
+    QEvtSize maxSize;    /*!< the largest event size allocated so far */
+    QEvtSize blockSize;  /*!< the block size of the event pool */
+} QPoolStats;
+
+/*! Obtain the allocation statistics of the given event pool. */
+void QF_getPoolStats(uint_fast8_t const poolId, QPoolStats * const stats);
+#endif /* QF_EPOOL_STATS */
+
+#ifdef QF_EVT_MAGAZINE
+/*! Return the event blocks cached in the event magazines of the calling
+* thread to the event pools. */
+void QF_magazineFlush(void);
+#endif
+
 /*! Transfers control to QF to run the application. */
 int_t QF_run(void);
 
@@ -703,12 +1131,19 @@ uint_fast16_t QF_getPoolMin(uint_fast8_t const poolId);
 
 /*! This function returns the minimum of free entries of
 * the given event queue. */
-uint_fast16_t QF_getQueueMin(uint_fast8_t const prio);
+uint_fast16_t QF_getQueueMin(uint_fast16_t const prio);
 
 /*! Internal QF implementation of creating new dynamic event. */
 QEvt *QF_newX_(uint_fast16_t const evtSize,
                uint_fast16_t const margin, enum_t const sig);
 
+#ifdef QF_EVT_PAYLOAD
+/*! Internal QF implementation of creating new payload event. */
+QPayloadEvt *QF_newPayload_(uint_fast16_t const evtSize,
+                            uint_fast16_t const margin, enum_t const sig,
+                            QPayload * const payload);
+#endif
+
 /*! Internal QF implementation of creating new event reference. */
 QEvt const *QF_newRef_(QEvt const * const e, void const * const evtRef);
 
@@ -789,6 +1224,39 @@ void QF_deleteRef_(void const * const evtRef);
 
 #endif /* Q_EVT_CTOR */
 
+#ifdef QF_EVT_PAYLOAD
+/*! Allocate a payload event referencing the external payload */
+/**
+* @description
+* This macro allocates a new event of the type @p evtT_ (::QPayloadEvt or
+* a subclass of it) from the payload event pool and attaches to it the
+* external payload @p payload_ without copying the payload data. The macro
+* asserts when the event cannot be allocated.
+*
+* @param[in] evtT_    event type (class name) of the event to allocate
+* @param[in] sig_     signal to assign to the newly allocated event
+* @param[in] payload_ pointer to the ::QPayload to attach to the event
+*
+* @returns a valid event pointer cast to the type @p evtT_.
+*
+* @sa Q_NEW_PAYLOAD_X(), QF_payloadPoolInit()
+*/
+#define Q_NEW_PAYLOAD(evtT_, sig_, payload_)                   \
+    ((evtT_ *)QF_newPayload_((uint_fast16_t)sizeof(evtT_),     \
+                             QF_NO_MARGIN, (sig_), (payload_)))
+
+/*! Allocate a payload event (non-asserting version). */
+/**
+* @description
+* Same as Q_NEW_PAYLOAD(), but leaves at least @p margin_ events still
+* available in the payload event pool and sets @p e_ to NULL when the
+* allocation fails, in which case the payload is not referenced.
+*/
+#define Q_NEW_PAYLOAD_X(e_, evtT_, margin_, sig_, payload_) ((e_) = \
+    (evtT_ *)QF_newPayload_((uint_fast16_t)sizeof(evtT_),          \
+                            (margin_), (sig_), (payload_)))
+#endif /* QF_EVT_PAYLOAD */
+
 /*! Create a new reference of the current event `e` */
 /**
 * @description
@@ -60,10 +60,10 @@
 /****************************************************************************/
 /*! private attributes of the QK kernel */
 typedef struct {
-    uint8_t volatile actPrio;    /*!< prio of the active AO */
-    uint8_t volatile nextPrio;   /*!< prio of the next AO to execute */
-    uint8_t volatile lockPrio;   /*!< lock prio (0 == no-lock) */
-    uint8_t volatile lockHolder; /*!< prio of the AO holding the lock */
+    QPrio volatile actPrio;      /*!< prio of the active AO */
+    QPrio volatile nextPrio;     /*!< prio of the next AO to execute */
+    QPrio volatile lockPrio;     /*!< lock prio (0 == no-lock) */
+    QPrio volatile lockHolder;   /*!< prio of the AO holding the lock */
     uint8_t volatile intNest;    /*!< ISR nesting level */
     QPSet readySet;              /*!< QK ready-set of AOs */
 } QK_PrivAttr;
@@ -118,7 +118,7 @@ void QK_onIdle(void);
 
 /****************************************************************************/
 /*! QK scheduler finds the highest-priority thread ready to run */
-uint_fast8_t QK_sched_(void);
+uint_fast16_t QK_sched_(void);
 
 /*! QK activator activates the next active object. The activated AO preempts
 * the currently executing AOs.
@@ -129,10 +129,19 @@ void QK_activate_(void);
 /*! QK Scheduler locking */
 
 /*! The scheduler lock status */
+/**
+* @description
+* The status holds the previous lock priority and the previous lock
+* holder, each in the number of bits of ::QPrio.
+*/
+#if (QF_MAX_ACTIVE <= 255U)
 typedef uint_fast16_t QSchedStatus;
+#else
+typedef uint_fast32_t QSchedStatus;
+#endif
 
 /*! QK Scheduler lock */
-QSchedStatus QK_schedLock(uint_fast8_t ceiling);
+QSchedStatus QK_schedLock(uint_fast16_t ceiling);
 
 /*! QK Scheduler unlock */
 void QK_schedUnlock(QSchedStatus stat);
@@ -177,7 +186,7 @@ void QK_schedUnlock(QSchedStatus stat);
         (Q_ASSERT_ID(110, (me_)->eQueue.frontEvt != (QEvt *)0))
 
     #define QACTIVE_EQUEUE_SIGNAL_(me_) do {                         \
-        QPSet_insert(&QK_attr_.readySet, (uint_fast8_t)(me_)->prio); \
+        QPSet_insert(&QK_attr_.readySet, (uint_fast16_t)(me_)->prio);\
         if (!QK_ISR_CONTEXT_()) {                                    \
             if (QK_sched_() != 0U) {                                 \
                 QK_activate_();                                      \
@@ -142,6 +142,39 @@ typedef struct {
     * @sa QF_getPoolMin().
     */
     QMPoolCtr nMin;
+
+#ifdef QF_MPOOL_LOCKFREE
+    /*! head of the lock-free list of free blocks */
+    /**
+    * @description
+    * The low 32 bits hold the byte offset of the head block from the
+    * @c start of the pool plus one (zero means empty list) and the high
+    * 32 bits hold the ABA tag incremented by every update of the head.
+    * @sa QMPool_initLockFree()
+    */
+    uint64_t volatile top;
+
+    /*! true when this pool is managed without the critical section */
+    bool lockFree;
+#endif /* QF_MPOOL_LOCKFREE */
+
+#ifdef QF_MPOOL_ELASTIC
+    /*! the end of the memory reserved for the elastic pool (NULL for the
+    * pools that cannot grow) */
+    /**
+    * @sa QMPool_initElastic()
+    */
+    void *limit;
+
+    /*! the number of blocks added to the elastic pool at once */
+    QMPoolCtr nGrow;
+
+    /*! the elastic pool grows when its free blocks drop to this number */
+    QMPoolCtr lowMark;
+
+    /*! the initial number of blocks, below which the pool is not trimmed */
+    QMPoolCtr nInit;
+#endif /* QF_MPOOL_ELASTIC */
 } QMPool;
 
 /* public functions: */
@@ -150,13 +183,32 @@ typedef struct {
 void QMPool_init(QMPool * const me, void * const poolSto,
                  uint_fast32_t poolSize, uint_fast16_t blockSize);
 
+#ifdef QF_MPOOL_LOCKFREE
+/*! Initializes the native QF memory pool managed without the critical
+* section (lock-free) */
+void QMPool_initLockFree(QMPool * const me, void * const poolSto,
+                         uint_fast32_t poolSize, uint_fast16_t blockSize);
+#endif /* QF_MPOOL_LOCKFREE */
+
+#ifdef QF_MPOOL_ELASTIC
+/*! Initializes the native QF memory pool that grows on demand (elastic) */
+void QMPool_initElastic(QMPool * const me, uint_fast16_t blockSize,
+                        uint_fast32_t const nInit, uint_fast32_t const nMax,
+                        uint_fast16_t const nGrow,
+                        uint_fast16_t const lowMark);
+
+/*! Releases the free blocks grown beyond the initial size of the elastic
+* memory pool */
+uint_fast32_t QMPool_trim(QMPool * const me, uint_fast16_t const qs_id);
+#endif /* QF_MPOOL_ELASTIC */
+
 /*! Obtains a memory block from a memory pool. */
 void *QMPool_get(QMPool * const me, uint_fast16_t const margin,
-                 uint_fast8_t const qs_id);
+                 uint_fast16_t const qs_id);
 
 /*! Recycles a memory block back to a memory pool. */
 void QMPool_put(QMPool * const me, void *b,
-                uint_fast8_t const qs_id);
+                uint_fast16_t const qs_id);
 
 /*! Memory pool element to allocate correctly aligned storage
 * for QMPool class.
@@ -1,6 +1,7 @@
 /**
 * @file
-* @brief QP native, platform-independent priority sets of 32 or 64 elements.
+* @brief QP native, platform-independent priority sets of 32, 64, or up to
+* 4096 elements.
 * @ingroup qf
 * @cond
 ******************************************************************************
@@ -45,8 +46,8 @@
     #define QF_MAX_ACTIVE 32U
 #endif
 
-#if (QF_MAX_ACTIVE < 1U) || (64U < QF_MAX_ACTIVE)
-    #error "QF_MAX_ACTIVE out of range. Valid range is 1U..64U"
+#if (QF_MAX_ACTIVE < 1U) || (4096U < QF_MAX_ACTIVE)
+    #error "QF_MAX_ACTIVE out of range. Valid range is 1U..4096U"
 #elif (QF_MAX_ACTIVE <= 8U)
     typedef uint8_t QPSetBits;
 #elif (QF_MAX_ACTIVE <= 16U)
@@ -56,6 +57,13 @@
     typedef uint32_t QPSetBits;
 #endif
 
+#if (QF_MAX_ACTIVE <= 255U)
+    /*! storage type for a QF priority (element of the QPSet) */
+    typedef uint8_t QPrio;
+#else
+    typedef uint16_t QPrio;
+#endif
+
 #if (QF_MAX_ACTIVE <= 32U)
 
 /****************************************************************************/
@@ -96,7 +104,7 @@ typedef struct {
 #define QPSet_findMax(me_, n_) \
     ((n_) = QF_LOG2((me_)->bits))
 
-#else /* QF_MAX_ACTIVE > 32U */
+#elif (QF_MAX_ACTIVE <= 64U)
 
 /****************************************************************************/
 /*! Priority Set of up to 64 elements */
@@ -163,6 +171,94 @@ typedef struct {
         ? (QF_LOG2((me_)->bits[1]) + 32U) \
         : (QF_LOG2((me_)->bits[0])))
 
+#else /* QF_MAX_ACTIVE > 64U */
+
+/****************************************************************************/
+/*! Priority Set of up to 4096 elements */
+/**
+* The priority set represents the set of active objects that are ready to
+* run and need to be considered by the scheduling algorithm. The set is
+* capable of storing up to 4096 priority levels.
+*
+* The set is a two-level bitmap. Each 64-bit @c leaf holds 64 consecutive
+* elements and the @c summary has a bit for each non-empty leaf, so that
+* inserting, removing, and finding the maximum element takes a constant
+* number of steps regardless of the size of the set (see NOTE1).
+*/
+typedef struct {
+    uint64_t volatile summary; /*!< bitmask with a bit for each leaf */
+    uint64_t volatile leaf[(QF_MAX_ACTIVE + 63U) / 64U]; /*!< elements */
+} QPSet;
+
+/*! Makes the priority set @p me_ empty */
+#define QPSet_setEmpty(me_) ((me_)->summary = 0U)
+
+/*! Evaluates to TRUE if the priority set @p me_ is empty */
+#define QPSet_isEmpty(me_) ((me_)->summary == 0U)
+
+/*! Evaluates to TRUE if the priority set @p me_ is not empty */
+#define QPSet_notEmpty(me_) ((me_)->summary != 0U)
+
+/*! Evaluates to TRUE if the priority set @p me_ has element @p n_. */
+#define QPSet_hasElement(me_, n_)                                      \
+    ((((me_)->summary & ((uint64_t)1 << (((n_) - 1U) >> 6U))) != 0U)   \
+     ? (((me_)->leaf[((n_) - 1U) >> 6U]                                \
+         & ((uint64_t)1 << (((n_) - 1U) & 0x3FU))) != 0U)              \
+     : false)
+
+/*! insert element @p n_ into the set @p me_, n_ = 1..QF_MAX_ACTIVE */
+#define QPSet_insert(me_, n_) do {                                     \
+    uint_fast16_t const w_ = (uint_fast16_t)(((n_) - 1U) >> 6U);       \
+    uint64_t const b_ = ((uint64_t)1 << (((n_) - 1U) & 0x3FU));        \
+    if (((me_)->summary & ((uint64_t)1 << w_)) != 0U) {                \
+        (me_)->leaf[w_] |= b_;                                         \
+    }                                                                  \
+    else {                                                             \
+        (me_)->leaf[w_] = b_;                                          \
+        (me_)->summary |= ((uint64_t)1 << w_);                         \
+    }                                                                  \
+} while (false)
+
+/*! Remove element n_ from the set @p me_, n_= 1..QF_MAX_ACTIVE */
+#define QPSet_remove(me_, n_) do {                                     \
+    uint_fast16_t const w_ = (uint_fast16_t)(((n_) - 1U) >> 6U);       \
+    if (((me_)->summary & ((uint64_t)1 << w_)) != 0U) {                \
+        (me_)->leaf[w_] &=                                             \
+            (uint64_t)(~((uint64_t)1 << (((n_) - 1U) & 0x3FU)));       \
+        if ((me_)->leaf[w_] == 0U) {                                   \
+            (me_)->summary &= (uint64_t)(~((uint64_t)1 << w_));        \
+        }                                                              \
+    }                                                                  \
+} while (false)
+
+/*! Find the maximum element in the set, and assign it to @p n_ */
+/** @note if the set @p me_ is empty, @p n_ is set to zero.
+*/
+#define QPSet_findMax(me_, n_) ((n_) = QPSet_findMax_((me_)))
+
+/*! Find the maximum element in the set @p me_ (0 if the set is empty) */
+uint_fast16_t QPSet_findMax_(QPSet const * const me);
+
+/*! log-base-2 of a 64-bit bitmask @p x_ composed from two QF_LOG2() */
+#define QF_LOG2_64_(x_)                                         \
+    ((((uint32_t)((x_) >> 32U)) != 0U)                          \
+     ? ((uint_fast16_t)QF_LOG2((QPSetBits)((x_) >> 32U)) + 32U) \
+     : (uint_fast16_t)QF_LOG2((QPSetBits)(x_)))
+
+/*****************************************************************************
+* NOTE1:
+* The leaves are cleared lazily: a leaf is valid only when its bit in the
+* @c summary is set, and the first element inserted into an invalid leaf
+* overwrites it. This makes QPSet_setEmpty() a single store, which matters
+* because the publish-subscribe code empties a local copy of a set on every
+* published event. The maximum element is found with two QF_LOG2_64_()
+* calls: one for the highest non-empty leaf in the @c summary and one for
+* the highest element in that leaf. Each QF_LOG2_64_() maps to two QF_LOG2()
+* calls on the 32-bit halves, so ports that implement QF_LOG2() with the
+* count-leading-zeros instruction (e.g., ARM Cortex-M3/M4/M7 and the POSIX
+* ports built with GCC/Clang) get that speed-up here as well.
+*/
+
 #endif /* QF_MAX_ACTIVE */
 
 
@@ -57,6 +57,14 @@
 * be turend off with the QS_GLB_FILTER() macro. Other QS trace records
 * can be disabled by means of the "global filters"
 *
+* @note
+* With more than 255 AO priorities (#QF_MAX_ACTIVE > 255U), the
+* priorities in the scheduler records (::QS_SCHED_LOCK, ::QS_SCHED_UNLOCK,
+* ::QS_SCHED_NEXT, ::QS_SCHED_IDLE, and ::QS_SCHED_RESUME) are 16-bit
+* instead of 8-bit. The ::QS_TARGET_INFO record then reports 255 as the
+* 8-bit maximum number of AOs and appends the 16-bit #QF_MAX_ACTIVE after
+* the build date, so the layout of the record is unchanged up to there.
+*
 * @sa QS_GLB_FILTER() macro
 */
 enum QSpyRecords {
@@ -161,12 +169,14 @@ enum QSpyRecords {
     QS_ASSERT_FAIL,       /*!< assertion failed in the code */
     QS_QF_RUN,            /*!< QF_run() was entered */
 
-    /* [71] Reserved QS records */
-    QS_RESERVED_71,
-    QS_RESERVED_72,
-    QS_RESERVED_73,
-    QS_RESERVED_74,
-    QS_RESERVED_75,
+    /* [71] Additional QF QS records */
+    QS_QF_TICK_OVERRUN,   /*!< the clock tick was late by whole periods */
+    QS_QF_MPOOL_GROW,     /*!< an elastic memory pool grew */
+    QS_QF_MPOOL_TRIM,     /*!< an elastic memory pool was trimmed */
+    QS_QF_ACTIVE_CONFLATE,/*!< AO replaced a queued event with a new one */
+    QS_QF_ACTIVE_POST_WAIT,/*!< a producer waited for the AO queue space */
+
+    /* [76] Reserved QS records */
     QS_RESERVED_76,
     QS_RESERVED_77,
     QS_RESERVED_78,
@@ -223,6 +233,8 @@ enum QSpyUserOffsets {
     QS_USER4 = (enum_t)QS_USER3 + 5  /*!< offset for User Group 4 */
 };
 
+#if (!defined QF_MAX_ACTIVE) || (QF_MAX_ACTIVE <= 64U)
+
 /*! QS ID offsets for QS_LOC_FILTER() */
 enum QSpyIdOffsets {
     QS_AO_ID = 0,  /*!< offset for AO priorities */
@@ -240,6 +252,29 @@ enum QSpyIdGroups {
     QS_AP_IDS  = (0x80 + (enum_t)QS_AP_ID), /*!< Application-specific IDs */
 };
 
+#else /* more than 64 AO priorities (hierarchical priority set) */
+
+/* the event-pool, event-queue, and Application-specific IDs start above
+* the AO priorities (at the next multiple of 32), and the ID groups above
+* all QS IDs, so that the IDs do not share the local filter bits.
+*/
+enum QSpyIdOffsets {
+    QS_AO_ID = 0,
+    QS_EP_ID = (enum_t)(((QF_MAX_ACTIVE + 32U) / 32U) * 32U),
+    QS_EQ_ID = (enum_t)QS_EP_ID + 16,
+    QS_AP_ID = (enum_t)QS_EP_ID + 32,
+};
+
+enum QSpyIdGroups {
+    QS_ALL_IDS = 0x7FF0,
+    QS_AO_IDS  = (0x4000 + (enum_t)QS_AO_ID),
+    QS_EP_IDS  = (0x4000 + (enum_t)QS_EP_ID),
+    QS_EQ_IDS  = (0x4000 + (enum_t)QS_EQ_ID),
+    QS_AP_IDS  = (0x4000 + (enum_t)QS_AP_ID),
+};
+
+#endif /* QF_MAX_ACTIVE */
+
 #ifndef QS_TIME_SIZE
 
     /*! The size [bytes] of the QS time stamp. Valid values: 1U, 2U, or 4U;
@@ -557,9 +592,15 @@ QSTimeCtr QS_onGetTime(void);
           & ((uint_fast8_t)1U << ((uint_fast8_t)(rec_) & 7U))) != 0U)
 
 /*! helper macro for checking the local QS filter */
+#if (!defined QF_MAX_ACTIVE) || (QF_MAX_ACTIVE <= 64U)
 #define QS_LOC_CHECK_(qs_id_)                                        \
     (((uint_fast8_t)QS_priv_.locFilter[(uint_fast8_t)(qs_id_) >> 3U] \
           & ((uint_fast8_t)1U << ((uint_fast8_t)(qs_id_) & 7U))) != 0U)
+#else
+#define QS_LOC_CHECK_(qs_id_)                                         \
+    (((uint_fast8_t)QS_priv_.locFilter[(uint_fast16_t)(qs_id_) >> 3U] \
+          & ((uint_fast8_t)1U << ((uint_fast8_t)(qs_id_) & 7U))) != 0U)
+#endif
 
 /*! Begin an application-specific (user) QS record with object-id
  * for the local filter. */
@@ -871,7 +912,8 @@ enum OSpyObjCombnation {
 /*! Private QS attributes to keep track of the filters and the trace buffer */
 typedef struct {
     uint8_t glbFilter[16]; /*!< global on/off QS filter */
-    uint8_t locFilter[16]; /*!< local QS filters */
+    /*! local QS filters (up to 32 Application-specific IDs) */
+    uint8_t locFilter[((uint_fast16_t)QS_AP_ID + 32U) / 8U];
     void const *locFilter_AP; /*!< deprecated local QS filter */
     uint8_t *buf;         /*!< pointer to the start of the ring buffer */
     QSCtr    end;         /*!< offset of the end of the ring buffer */
@@ -101,6 +101,8 @@
     #define QS_2U8_PRE_(data1_, data2_) ((void)0)
     #define QS_U16_PRE_(data_)          ((void)0)
     #define QS_U32_PRE_(data_)          ((void)0)
+    #define QS_PRIO_PRE_(prio_)         ((void)0)
+    #define QS_2PRIO_PRE_(prio1_, prio2_) ((void)0)
     #define QS_TIME_PRE_()              ((void)0)
     #define QS_SIG_PRE_(sig_)           ((void)0)
     #define QS_EVS_PRE_(size_)          ((void)0)
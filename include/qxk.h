@@ -45,6 +45,10 @@
 #include "qmpool.h"   /* QXK kernel uses the native QP memory pool  */
 #include "qpset.h"    /* QXK kernel uses the native QP priority set */
 
+#if (QF_MAX_ACTIVE > 255U)
+    #error "QXK supports QF_MAX_ACTIVE up to 255U"
+#endif
+
 /****************************************************************************/
 /* QF configuration for QXK -- data members of the QActive class... */
 
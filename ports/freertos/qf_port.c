@@ -58,6 +58,14 @@ Q_DEFINE_THIS_MODULE("qf_port")
     #error "FreeRTOS configMAX_PRIORITIES must not be less than QF_MAX_ACTIVE"
 #endif
 
+#ifdef QF_TIMEEVT_WHEEL
+    #error "QF_TIMEEVT_WHEEL is not supported in the FreeRTOS port"
+#endif
+
+#ifdef QF_SPARSE_SUBSCR
+    #error "QF_SPARSE_SUBSCR is not supported in the FreeRTOS port"
+#endif
+
 /* Local objects -----------------------------------------------------------*/
 static void task_function(void *pvParameters); /* FreeRTOS task signature */
 
@@ -84,7 +92,7 @@ void QF_stop(void) {
     QF_onCleanup(); /* cleanup callback */
 }
 /*..........................................................................*/
-void QActive_start_(QActive * const me, uint_fast8_t prio,
+void QActive_start_(QActive * const me, uint_fast16_t prio,
                     QEvt const * * const qSto, uint_fast16_t const qLen,
                     void * const stkSto, uint_fast16_t const stkSize,
                     void const * const par)
@@ -446,7 +454,7 @@ QEvt *QF_newXFromISR_(uint_fast16_t const evtSize,
 #ifdef Q_SPY
     e = QMPool_getFromISR(&QF_pool_[idx],
                   ((margin != QF_NO_MARGIN) ? margin : 0U),
-                  (uint_fast8_t)QS_EP_ID + idx + 1U);
+                  (uint_fast16_t)QS_EP_ID + idx + 1U);
 #else
     e = QMPool_getFromISR(&QF_pool_[idx],
                       ((margin != QF_NO_MARGIN) ? margin : 0U), 0U);
@@ -460,7 +468,7 @@ QEvt *QF_newXFromISR_(uint_fast16_t const evtSize,
 
 #ifdef Q_SPY
         uxSavedInterruptState = taskENTER_CRITICAL_FROM_ISR();
-        QS_BEGIN_PRE_(QS_QF_NEW, (uint_fast8_t)QS_EP_ID + e->poolId_)
+        QS_BEGIN_PRE_(QS_QF_NEW, (uint_fast16_t)QS_EP_ID + e->poolId_)
             QS_TIME_PRE_();         /* timestamp */
             QS_EVS_PRE_(evtSize);   /* the size of the event */
             QS_SIG_PRE_(sig);       /* the signal of the event */
@@ -475,7 +483,7 @@ QEvt *QF_newXFromISR_(uint_fast16_t const evtSize,
 
 #ifdef Q_SPY
         uxSavedInterruptState = taskENTER_CRITICAL_FROM_ISR();
-        QS_BEGIN_PRE_(QS_QF_NEW_ATTEMPT, (uint_fast8_t)QS_EP_ID + idx + 1U)
+        QS_BEGIN_PRE_(QS_QF_NEW_ATTEMPT, (uint_fast16_t)QS_EP_ID + idx + 1U)
             QS_TIME_PRE_();         /* timestamp */
             QS_EVS_PRE_(evtSize);   /* the size of the event */
             QS_SIG_PRE_(sig);       /* the signal of the event */
@@ -524,7 +532,7 @@ void QF_gcFromISR(QEvt const * const e) {
             /* cast 'const' away in (QEvt *)e is OK,
              * because it's a pool event */
             QMPool_putFromISR(&QF_pool_[idx], (QEvt *)e,
-                              (uint_fast8_t)QS_EP_ID + e->poolId_);
+                              (uint_fast16_t)QS_EP_ID + e->poolId_);
 #else
             QMPool_putFromISR(&QF_pool_[idx], (QEvt *)e, 0U);
 #endif
@@ -532,7 +540,7 @@ void QF_gcFromISR(QEvt const * const e) {
     }
 }
 /*..........................................................................*/
-void QMPool_putFromISR(QMPool * const me, void *b, uint_fast8_t const qs_id) {
+void QMPool_putFromISR(QMPool * const me, void *b, uint_fast16_t const qs_id) {
     UBaseType_t uxSavedInterruptState;
 
     /** @pre # free blocks cannot exceed the total # blocks and
@@ -559,7 +567,7 @@ void QMPool_putFromISR(QMPool * const me, void *b, uint_fast8_t const qs_id) {
 }
 /*..........................................................................*/
 void *QMPool_getFromISR(QMPool * const me, uint_fast16_t const margin,
-                 uint_fast8_t const qs_id)
+                 uint_fast16_t const qs_id)
 {
     QFreeBlock *fb;
     UBaseType_t uxSavedInterruptState;
@@ -163,8 +163,8 @@ QEvt *QF_newXFromISR_(uint_fast16_t const evtSize,
                       uint_fast16_t const margin, enum_t const sig);
 
 void *QMPool_getFromISR(QMPool * const me, uint_fast16_t const margin,
-                        uint_fast8_t const qs_id);
-void QMPool_putFromISR(QMPool * const me, void *b, uint_fast8_t const qs_id);
+                        uint_fast16_t const qs_id);
+void QMPool_putFromISR(QMPool * const me, void *b, uint_fast16_t const qs_id);
 
 enum FreeRTOS_TaskAttrs {
     TASK_NAME_ATTR
@@ -0,0 +1,482 @@
+/**
+* @file
+* @brief QF/C code shared by the POSIX ports (posix, posix-qv, posix-pool)
+* @ingroup ports
+* @cond
+******************************************************************************
+* Last updated for version 6.9.1
+* Last updated on  2020-10-03
+*
+*                    Q u a n t u m  L e a P s
+*                    ------------------------
+*                    Modern Embedded Software
+*
+* Copyright (C) 2005-2020 Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <www.gnu.org/licenses/>.
+*
+* Contact information:
+* <www.state-machine.com/licensing>
+* <info@state-machine.com>
+******************************************************************************
+* @endcond
+*/
+/* NOTE: this file is not compiled on its own, but is included by qf_port.c
+* of each POSIX port, after the port has declared the ticker data
+* (l_tickPeriod[], l_tickNext[], l_ticker, NANOSLEEP_NSEC_PER_SEC) and the
+* prototypes of the functions defined here. In the tickless mode the port
+* declares also the min-heap l_tickless[] with its mutex and condition
+* variable. For the elastic event pools the port includes <sys/mman.h>.
+* See NOTE00.
+*/
+
+/* the current time of the monotonic clock [ns], see NOTE01 */
+static int64_t tickerNow(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((int64_t)ts.tv_sec * NANOSLEEP_NSEC_PER_SEC) + ts.tv_nsec;
+}
+/*..........................................................................*/
+static void tickerStart(void) {
+    int64_t now = tickerNow();
+    uint_fast8_t r;
+    for (r = 0U; r < QF_MAX_TICK_RATE; ++r) {
+        l_tickNext[r] = now + (int64_t)l_tickPeriod[r];
+    }
+}
+/*..........................................................................*/
+/* set the period of the tick rate @p r [ns] (0 stops the rate) and restart
+* its deadline one period from now, see NOTE01
+*/
+static void tickerSetPeriod(uint_fast8_t const r, uint32_t const period) {
+#ifdef QF_TICKLESS
+    pthread_mutex_lock(&l_ticklessMutex);
+#endif
+    /* the deadline is updated before the period that enables it */
+    l_tickNext[r] = tickerNow() + (int64_t)period;
+    l_tickPeriod[r] = period;
+#ifdef QF_TICKLESS
+    pthread_cond_signal(&l_ticklessCond); /* re-compute the timeout */
+    pthread_mutex_unlock(&l_ticklessMutex);
+#endif
+}
+/*..........................................................................*/
+/* sleep until the earliest tick deadline and deliver the due ticks */
+static void tickerWait(void) {
+    int64_t next = INT64_MAX;
+    int64_t now;
+    struct timespec ts;
+    uint_fast8_t r;
+
+    for (r = 0U; r < QF_MAX_TICK_RATE; ++r) {
+        if ((l_tickPeriod[r] != 0U) && (l_tickNext[r] < next)) {
+            next = l_tickNext[r];
+        }
+    }
+
+    /* sleep until the absolute deadline, so that the time spent in the
+    * tick processing does not accumulate as drift, see NOTE01
+    */
+#ifdef QF_TICKLESS
+    /* in the tickless mode, wait also for the earliest deadline of the
+    * tickless time events or for arming of an earlier deadline, see NOTE02
+    */
+    pthread_mutex_lock(&l_ticklessMutex);
+    if ((l_nTickless != 0U) && (l_tickless[0].deadline < next)) {
+        next = l_tickless[0].deadline;
+    }
+    if (next == INT64_MAX) { /* no deadline at all? */
+        pthread_cond_wait(&l_ticklessCond, &l_ticklessMutex);
+    }
+    else {
+        ts.tv_sec  = (time_t)(next / NANOSLEEP_NSEC_PER_SEC);
+        ts.tv_nsec = (long)(next % NANOSLEEP_NSEC_PER_SEC);
+        (void)pthread_cond_timedwait(&l_ticklessCond, &l_ticklessMutex, &ts);
+    }
+    pthread_mutex_unlock(&l_ticklessMutex);
+#else
+    ts.tv_sec  = (time_t)(next / NANOSLEEP_NSEC_PER_SEC);
+    ts.tv_nsec = (long)(next % NANOSLEEP_NSEC_PER_SEC);
+    (void)clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+#endif
+
+    now = tickerNow();
+    for (r = 0U; r < QF_MAX_TICK_RATE; ++r) {
+        if ((l_tickPeriod[r] != 0U) && (l_tickNext[r] <= now)) {
+            /* the number of whole tick periods missed after the deadline */
+            int64_t missed = (now - l_tickNext[r]) / (int64_t)l_tickPeriod[r];
+            uint32_t n = (missed < (int64_t)QF_TICK_CATCHUP_MAX)
+                         ? (uint32_t)missed
+                         : (uint32_t)QF_TICK_CATCHUP_MAX;
+
+            /* the next deadline stays in phase with the original period */
+            l_tickNext[r] += (missed + 1) * (int64_t)l_tickPeriod[r];
+
+            if (missed != 0) { /* overrun? */
+                QF_CRIT_STAT_
+                QF_CRIT_E_();
+                QS_BEGIN_NOCRIT_PRE_(QS_QF_TICK_OVERRUN, 0U)
+                    QS_U8_PRE_(r);  /* tick rate */
+                    QS_U32_PRE_((missed < (int64_t)UINT32_MAX)
+                                ? (uint32_t)missed
+                                : UINT32_MAX); /* # missed ticks */
+                    QS_U32_PRE_(n); /* # missed ticks delivered */
+                QS_END_NOCRIT_PRE_()
+                QF_CRIT_X_();
+            }
+
+            do { /* deliver the due tick and the missed ticks to catch up */
+                if (r == 0U) {
+                    QF_onClockTick(); /* must call QF_TICK_X(0U, ...) */
+                }
+                else {
+                    QF_TICK_X(r, &l_ticker); /* ticks driven by the port */
+                }
+            } while (n-- != 0U);
+        }
+    }
+#ifdef QF_TICKLESS
+    ticklessExpire(now); /* post the expired tickless time events */
+#endif
+}
+
+#ifdef QF_TICKLESS
+/****************************************************************************/
+/* tickless time events, see NOTE02 */
+void QTimeEvt_armNsec(QTimeEvt * const me,
+                      uint64_t const nsec, uint64_t const intervalNsec)
+{
+    int64_t const now = tickerNow();
+    uint_fast16_t i;
+    QF_CRIT_STAT_
+
+    /** @pre the host AO must be valid, the deadline cannot be zero,
+    * and the signal must be valid
+    */
+    Q_REQUIRE_ID(800, (me->act != (void *)0)
+                      && (nsec != 0U)
+                      && (me->super.sig >= (QSignal)Q_USER_SIG));
+
+    /* the time event must be disarmed and must not be linked into the
+    * list of any tick rate, which would misinterpret its 'ctr', NOTE02
+    */
+    QF_CRIT_OBJ_E_(&QF_timeEvtHead_[
+        (uint_fast8_t)me->super.refCtr_ & TE_TICK_RATE]);
+    Q_ASSERT_CRIT_(810, (me->ctr == 0U)
+        && ((me->super.refCtr_ & (TE_IS_LINKED | TE_IS_TICKLESS)) == 0U));
+    me->super.refCtr_ |= TE_IS_TICKLESS; /* mark as tickless */
+    QF_CRIT_X_();
+
+    pthread_mutex_lock(&l_ticklessMutex);
+
+    /* the min-heap must have room for the time event */
+    if (l_nTickless >= QF_TICKLESS_MAX) {
+        pthread_mutex_unlock(&l_ticklessMutex);
+        Q_ERROR_ID(820);
+    }
+
+    i = l_nTickless;
+    ++l_nTickless;
+    l_tickless[i].deadline = now + (int64_t)nsec;
+    l_tickless[i].interval = (int64_t)intervalNsec;
+    l_tickless[i].te       = me;
+    ticklessUp(i);
+
+    if (me->ctr == 1U) { /* the new earliest deadline? */
+        pthread_cond_signal(&l_ticklessCond); /* wake up the ticker */
+    }
+    pthread_mutex_unlock(&l_ticklessMutex);
+}
+/*..........................................................................*/
+bool QTimeEvt_disarmNsec(QTimeEvt * const me) {
+    bool wasArmed = false;
+
+    if (ticklessIsArmed(me)) {
+        pthread_mutex_lock(&l_ticklessMutex);
+        if (me->ctr != 0U) { /* still armed? */
+            ticklessRemove((uint_fast16_t)me->ctr - 1U);
+            wasArmed = true;
+        }
+        pthread_mutex_unlock(&l_ticklessMutex);
+    }
+
+    return wasArmed;
+}
+/*..........................................................................*/
+bool QTimeEvt_rearmNsec(QTimeEvt * const me, uint64_t const nsec) {
+    int64_t const now = tickerNow();
+    bool wasArmed = false;
+
+    if (ticklessIsArmed(me)) {
+        pthread_mutex_lock(&l_ticklessMutex);
+        if (me->ctr != 0U) { /* still armed? */
+            uint_fast16_t const i = (uint_fast16_t)me->ctr - 1U;
+            int64_t const prev = l_tickless[i].deadline;
+
+            l_tickless[i].deadline = now + (int64_t)nsec;
+            if (l_tickless[i].deadline < prev) { /* earlier deadline? */
+                ticklessUp(i);
+                if (me->ctr == 1U) { /* the new earliest deadline? */
+                    pthread_cond_signal(&l_ticklessCond); /* wake ticker */
+                }
+            }
+            else {
+                ticklessDown(i);
+            }
+            wasArmed = true;
+        }
+        pthread_mutex_unlock(&l_ticklessMutex);
+    }
+
+    return wasArmed;
+}
+/*..........................................................................*/
+uint64_t QTimeEvt_currNsec(QTimeEvt const * const me) {
+    int64_t ret = 0;
+
+    if (ticklessIsArmed(me)) {
+        pthread_mutex_lock(&l_ticklessMutex);
+        if (me->ctr != 0U) { /* still armed? */
+            ret = l_tickless[me->ctr - 1U].deadline - tickerNow();
+            if (ret < 0) { /* already expired, but not posted yet? */
+                ret = 0;
+            }
+        }
+        pthread_mutex_unlock(&l_ticklessMutex);
+    }
+
+    return (uint64_t)ret;
+}
+/*..........................................................................*/
+/* is the time event armed in the tickless mode? (it must not be armed
+* with the tick-based API, whose 'ctr' has a different meaning, NOTE02)
+*/
+static bool ticklessIsArmed(QTimeEvt const * const me) {
+    bool isTickless;
+    QF_CRIT_STAT_
+
+    QF_CRIT_OBJ_E_(&QF_timeEvtHead_[
+        (uint_fast8_t)me->super.refCtr_ & TE_TICK_RATE]);
+    isTickless = ((me->super.refCtr_ & TE_IS_TICKLESS) != 0U);
+    Q_ASSERT_CRIT_(830, isTickless || (me->ctr == 0U));
+    QF_CRIT_X_();
+
+    return isTickless;
+}
+/*..........................................................................*/
+/* post all tickless time events whose deadlines have passed */
+static void ticklessExpire(int64_t const now) {
+    pthread_mutex_lock(&l_ticklessMutex);
+    while ((l_nTickless != 0U) && (l_tickless[0].deadline <= now)) {
+        QTimeEvt * const t = l_tickless[0].te;
+        QActive * const act = (QActive *)t->act; /* temp. for volatile */
+        QF_CRIT_STAT_
+
+        if (l_tickless[0].interval != 0) { /* periodic? */
+            l_tickless[0].deadline += l_tickless[0].interval;
+            if (l_tickless[0].deadline <= now) { /* missed periods? */
+                l_tickless[0].deadline = now + l_tickless[0].interval;
+            }
+            ticklessDown(0U);
+        }
+        else { /* one-shot time event: automatically disarm */
+            ticklessRemove(0U);
+        }
+        pthread_mutex_unlock(&l_ticklessMutex);
+
+        QF_CRIT_E_();
+        QS_BEGIN_NOCRIT_PRE_(QS_QF_TIMEEVT_POST, act->prio)
+            QS_TIME_PRE_();            /* timestamp */
+            QS_OBJ_PRE_(t);            /* the time event object */
+            QS_SIG_PRE_(t->super.sig); /* signal of this time event */
+            QS_OBJ_PRE_(act);          /* the target AO */
+            QS_U8_PRE_(t->super.refCtr_ & TE_TICK_RATE); /* tick rate */
+        QS_END_NOCRIT_PRE_()
+        QF_CRIT_X_();
+
+        /* QACTIVE_POST() asserts internally if the queue overflows */
+        QACTIVE_POST(act, &t->super, &l_ticker);
+
+        pthread_mutex_lock(&l_ticklessMutex);
+    }
+    pthread_mutex_unlock(&l_ticklessMutex);
+}
+/*..........................................................................*/
+/* sift the timer at heap index i towards the root of the min-heap */
+static void ticklessUp(uint_fast16_t i) {
+    QTicklessTimer const tmr = l_tickless[i];
+    while (i > 0U) {
+        uint_fast16_t const parent = (i - 1U) / 2U;
+        if (l_tickless[parent].deadline <= tmr.deadline) {
+            break;
+        }
+        l_tickless[i] = l_tickless[parent];
+        l_tickless[i].te->ctr = (QTimeEvtCtr)(i + 1U); /* heap index + 1 */
+        i = parent;
+    }
+    l_tickless[i] = tmr;
+    l_tickless[i].te->ctr = (QTimeEvtCtr)(i + 1U);
+}
+/*..........................................................................*/
+/* sift the timer at heap index i towards the leaves of the min-heap */
+static void ticklessDown(uint_fast16_t i) {
+    QTicklessTimer const tmr = l_tickless[i];
+    for (;;) {
+        uint_fast16_t child = (2U * i) + 1U;
+        if (child >= l_nTickless) {
+            break;
+        }
+        if (((child + 1U) < l_nTickless)
+            && (l_tickless[child + 1U].deadline < l_tickless[child].deadline))
+        {
+            ++child;
+        }
+        if (tmr.deadline <= l_tickless[child].deadline) {
+            break;
+        }
+        l_tickless[i] = l_tickless[child];
+        l_tickless[i].te->ctr = (QTimeEvtCtr)(i + 1U); /* heap index + 1 */
+        i = child;
+    }
+    l_tickless[i] = tmr;
+    l_tickless[i].te->ctr = (QTimeEvtCtr)(i + 1U);
+}
+/*..........................................................................*/
+/* remove the timer at heap index i from the min-heap */
+static void ticklessRemove(uint_fast16_t const i) {
+    QTimeEvt * const t = l_tickless[i].te;
+    QF_CRIT_STAT_
+
+    /* mark the time event as disarmed and no longer tickless */
+    QF_CRIT_OBJ_E_(&QF_timeEvtHead_[
+        (uint_fast8_t)t->super.refCtr_ & TE_TICK_RATE]);
+    t->ctr = 0U;
+    t->super.refCtr_ &= (uint8_t)(~TE_IS_TICKLESS & 0xFFU);
+    QF_CRIT_X_();
+
+    --l_nTickless;
+    if (i < l_nTickless) { /* not the last timer? */
+        l_tickless[i] = l_tickless[l_nTickless];
+        if ((i > 0U)
+            && (l_tickless[i].deadline < l_tickless[(i - 1U) / 2U].deadline))
+        {
+            ticklessUp(i);
+        }
+        else {
+            ticklessDown(i);
+        }
+    }
+}
+#endif /* QF_TICKLESS */
+
+#ifdef QF_MPOOL_ELASTIC
+/****************************************************************************/
+/* virtual memory for the elastic event pools, see NOTE03 */
+void *QF_memReserve_(uint_fast32_t const size) {
+    void * const sto = mmap((void *)0, (size_t)size, PROT_NONE,
+                            MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+                            -1, 0);
+    return (sto != MAP_FAILED) ? sto : (void *)0;
+}
+/*..........................................................................*/
+bool QF_memCommit_(void * const addr, uint_fast32_t const size) {
+    uintptr_t const pageMask = (uintptr_t)sysconf(_SC_PAGESIZE) - 1U;
+    /* commit all pages overlapping the range [addr, addr+size) */
+    uintptr_t const beg = (uintptr_t)addr & ~pageMask;
+    uintptr_t const end = ((uintptr_t)addr + size + pageMask) & ~pageMask;
+    return mprotect((void *)beg, (size_t)(end - beg),
+                    PROT_READ | PROT_WRITE) == 0;
+}
+/*..........................................................................*/
+void QF_memDecommit_(void * const addr, uint_fast32_t const size) {
+    uintptr_t const pageMask = (uintptr_t)sysconf(_SC_PAGESIZE) - 1U;
+    /* decommit only the pages entirely above addr (the page with the
+    * beginning of the range can still hold the blocks in use) */
+    uintptr_t const beg = ((uintptr_t)addr + pageMask) & ~pageMask;
+    uintptr_t const end = ((uintptr_t)addr + size + pageMask) & ~pageMask;
+    if (beg < end) {
+        (void)madvise((void *)beg, (size_t)(end - beg), MADV_DONTNEED);
+        (void)mprotect((void *)beg, (size_t)(end - beg), PROT_NONE);
+    }
+}
+#endif /* QF_MPOOL_ELASTIC */
+
+/*****************************************************************************
+* NOTE00:
+* The POSIX ports differ in how they run the active objects (one p-thread
+* per AO, the cooperative QV loops, or the pool of worker threads), but
+* they all time the QF clock ticks and the tickless time events, and they
+* all manage the memory of the elastic event pools, in the same way. The
+* code that does not depend on the execution model is therefore kept only
+* once in this file, which every POSIX qf_port.c includes, rather than in
+* three copies.
+*
+* NOTE01:
+* The ticker sleeps with clock_nanosleep(TIMER_ABSTIME) until absolute
+* deadlines of the monotonic clock, which advance by exactly one period
+* per tick. Therefore the time spent in QF_onClockTick() and the sleep
+* latency do not accumulate as drift. Each clock tick rate has its own
+* period: rate 0 calls QF_onClockTick() as before, while the other rates
+* set by QF_setTickRateX() are ticked by the port with QF_TICK_X().
+* When the ticker is late by whole periods (overrun), the missed ticks
+* are reported with the QS_QF_TICK_OVERRUN trace record and up to
+* QF_TICK_CATCHUP_MAX of them are delivered back-to-back to catch up.
+* The remaining missed ticks are dropped, but the deadlines stay in phase.
+* QF_setTickRate() and QF_setTickRateX() restart the deadline of the rate
+* one new period from the call, so that a tick rate enabled or changed
+* while QF is running does not start with a deadline in the past, which
+* would be reported as an overrun and caught up with a burst of ticks
+* (before QF_run() the deadlines are restarted by tickerStart() anyway).
+*
+* NOTE02:
+* In the tickless mode (macro QF_TICKLESS, see also qf_port.h) the time
+* events armed with QTimeEvt_armNsec() are kept in a binary min-heap
+* ordered by their absolute deadlines of the monotonic clock. The ticker
+* waits on a condition variable until the earliest deadline (of the
+* tickless time events and of the periodic tick rates), so it does not
+* wake up at all when there is nothing to time. Arming a time event with
+* a deadline earlier than all others wakes up the ticker, so that it can
+* re-compute its timeout. The 'ctr' member of an armed tickless time event
+* holds its index in the min-heap plus one, which gives O(log n) disarming
+* and rearming. The expired time events are posted outside of the mutex
+* of the min-heap.
+*
+* Because 'ctr' means something else for the tickless time events, they
+* are marked with the TE_IS_TICKLESS flag (in the 'refCtr_' attribute,
+* like the other flags of time events) for as long as they are in the
+* min-heap. The flag is changed only in the critical section of the tick
+* rate of the time event, so the tick-based API (QTimeEvt_armX(),
+* QTimeEvt_disarm(), QTimeEvt_rearm() and QTimeEvt_currCtr()) asserts
+* when it is applied to a tickless time event, and the *Nsec() functions
+* assert when they are applied to a time event armed by the tick-based
+* API. A time event disarmed with QTimeEvt_disarm() stays linked into the
+* list of its tick rate until the next tick, and only then it can be armed
+* with QTimeEvt_armNsec().
+*
+* NOTE03:
+* The elastic event pools (macro QF_MPOOL_ELASTIC, see QMPool_initElastic())
+* reserve the address space for their maximum size with mmap(PROT_NONE,
+* MAP_NORESERVE), which costs no memory, and commit the pages with
+* mprotect() only as the pools grow. The committed range is rounded out to
+* whole pages. When a pool shrinks, QF_memDecommit_() gives back to the OS
+* (madvise(MADV_DONTNEED)) and protects again only the pages that lie
+* entirely above the beginning of the released range, because the page
+* holding the beginning can still hold the blocks in use. The reserved
+* address space is never unmapped, so the blocks of a pool never move.
+*/
@@ -0,0 +1,637 @@
+/**
+* @file
+* @brief QF/C port to POSIX API (thread pool executing the active objects)
+* @ingroup ports
+* @cond
+******************************************************************************
+* Last updated for version 6.9.1
+* Last updated on  2020-10-03
+*
+*                    Q u a n t u m  L e a P s
+*                    ------------------------
+*                    Modern Embedded Software
+*
+* Copyright (C) 2005-2020 Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <www.gnu.org/licenses>.
+*
+* Contact information:
+* <www.state-machine.com/licensing>
+* <info@state-machine.com>
+******************************************************************************
+* @endcond
+*/
+
+/* expose features from the 2008 POSIX standard (IEEE Standard 1003.1-2008) */
+#define _POSIX_C_SOURCE 200809L
+/* expose the extensions of mmap() and madvise() (elastic event pools) */
+#define _DEFAULT_SOURCE
+
+#define QP_IMPL           /* this is QP implementation */
+#include "qf_port.h"      /* QF port */
+#include "qf_pkg.h"
+#include "qassert.h"
+#ifdef Q_SPY              /* QS software tracing enabled? */
+    #include "qs_port.h"  /* QS port */
+    #include "qs_pkg.h"   /* QS package-scope internal interface */
+#else
+    #include "qs_dummy.h" /* disable the QS software tracing */
+#endif /* Q_SPY */
+
+#include <pthread.h>      /* POSIX-thread API */
+#include <sys/mman.h>     /* for mlockall() */
+#include <sys/select.h>
+#include <sys/ioctl.h>
+#include <string.h>       /* for memcpy() and memset() */
+#include <stdlib.h>
+#include <stdio.h>
+#include <termios.h>
+#include <unistd.h>
+#include <signal.h>
+#include <time.h>         /* for clock_nanosleep() */
+
+Q_DEFINE_THIS_MODULE("qf_port")
+
+/* Local objects ===========================================================*/
+/*! worker thread of the pool, see NOTE2 in qf_port.h */
+typedef struct {
+    QPSet readySet;        /* AOs ready to run queued at this worker */
+    pthread_mutex_t mutex; /* mutex protecting the readySet */
+    uint_fast16_t top;     /* max prio in the readySet (atomic), NOTE03 */
+    pthread_t thread;      /* p-thread of this worker */
+} Worker;
+
+static Worker l_worker[QF_POOL_MAX_WORKERS];
+static uint_fast8_t l_nWorkers;   /* number of workers in the pool */
+static uint_fast8_t l_nextWorker; /* round-robin worker for new AOs */
+static _Thread_local uint_fast8_t l_self; /* 1 + index of this worker */
+static uint_fast8_t l_nIdle;      /* number of idle workers (atomic) */
+static pthread_mutex_t l_idleMutex; /* mutex for waiting for work */
+static pthread_cond_t  l_idleCond;  /* cond.var. signaled for new work */
+static bool l_aoStarted;          /* any active object started? */
+
+static pthread_mutex_t l_pThreadMutex; /* POSIX mutex for critical sections */
+static bool l_isRunning;      /* flag indicating when QF is running */
+static struct termios l_tsav; /* structure with saved terminal attributes */
+static uint32_t l_tickPeriod[QF_MAX_TICK_RATE]; /* 0 means not ticked */
+static int64_t l_tickNext[QF_MAX_TICK_RATE]; /* absolute tick deadlines */
+#ifdef Q_SPY
+static uint8_t const l_ticker = 0U; /* QS sender of the port-driven ticks */
+#endif
+#ifdef QF_TICKLESS
+/*! tickless time event in the min-heap of deadlines, see NOTE05 */
+typedef struct {
+    int64_t deadline;  /* absolute deadline [ns] */
+    int64_t interval;  /* period [ns] (0 for one-shot) */
+    QTimeEvt *te;      /* the armed time event */
+} QTicklessTimer;
+static QTicklessTimer l_tickless[QF_TICKLESS_MAX]; /* min-heap */
+static uint_fast16_t l_nTickless;  /* # armed tickless time events */
+static pthread_mutex_t l_ticklessMutex; /* protects the min-heap */
+static pthread_cond_t l_ticklessCond; /* wakes up the ticker */
+#endif
+static int_t l_tickPrio;
+enum { NANOSLEEP_NSEC_PER_SEC = 1000000000 }; /* see NOTE02 */
+
+static void *worker_thread(void *arg);
+static void pushReady(QActive * const me, bool const wake);
+static uint_fast16_t takeReady(void);
+static void waitForWork(void);
+static void tickerStart(void);
+static void tickerSetPeriod(uint_fast8_t const r, uint32_t const period);
+static void tickerWait(void);
+#ifdef QF_TICKLESS
+static int64_t tickerNow(void);
+static void ticklessExpire(int64_t const now);
+static void ticklessUp(uint_fast16_t i);
+static void ticklessDown(uint_fast16_t i);
+static void ticklessRemove(uint_fast16_t const i);
+static bool ticklessIsArmed(QTimeEvt const * const me);
+#endif
+static void sigIntHandler(int dummy);
+
+/* QF functions ============================================================*/
+void QF_init(void) {
+    struct sigaction sig_act;
+    long nCPU;
+    uint_fast8_t n;
+
+    /* lock memory so we're never swapped out to disk */
+    /*mlockall(MCL_CURRENT | MCL_FUTURE);  uncomment when supported */
+
+    /* init the global mutex with the default non-recursive initializer */
+    pthread_mutex_init(&l_pThreadMutex, NULL);
+
+    /* init the objects for waiting for work */
+    pthread_mutex_init(&l_idleMutex, NULL);
+    pthread_cond_init(&l_idleCond, NULL);
+
+    for (n = 0U; n < QF_POOL_MAX_WORKERS; ++n) {
+        QPSet_setEmpty(&l_worker[n].readySet);
+        pthread_mutex_init(&l_worker[n].mutex, NULL);
+        l_worker[n].top = 0U;
+    }
+
+    /* by default, one worker per online CPU */
+    nCPU = sysconf(_SC_NPROCESSORS_ONLN);
+    if (nCPU < 1L) {
+        l_nWorkers = 1U;
+    }
+    else if (nCPU > (long)QF_POOL_MAX_WORKERS) {
+        l_nWorkers = QF_POOL_MAX_WORKERS;
+    }
+    else {
+        l_nWorkers = (uint_fast8_t)nCPU;
+    }
+
+    l_tickPeriod[0] = (uint32_t)NANOSLEEP_NSEC_PER_SEC/100U; /* default */
+    l_tickPrio = sched_get_priority_min(SCHED_FIFO); /* default tick prio */
+
+#ifdef QF_TICKLESS
+    /* the tickless deadlines are measured by the monotonic clock */
+    {
+        pthread_condattr_t attr;
+        pthread_condattr_init(&attr);
+        pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+        pthread_cond_init(&l_ticklessCond, &attr);
+        pthread_condattr_destroy(&attr);
+    }
+    pthread_mutex_init(&l_ticklessMutex, NULL);
+#endif
+
+    /* install the SIGINT (Ctrl-C) signal handler */
+    sig_act.sa_handler = &sigIntHandler;
+    sigaction(SIGINT, &sig_act, NULL);
+}
+
+/****************************************************************************/
+void QF_enterCriticalSection_(void) {
+    pthread_mutex_lock(&l_pThreadMutex);
+}
+/****************************************************************************/
+void QF_leaveCriticalSection_(void) {
+    pthread_mutex_unlock(&l_pThreadMutex);
+}
+
+/****************************************************************************/
+int_t QF_run(void) {
+    struct sched_param sparam;
+    uint_fast8_t n;
+
+    QF_onStartup();  /* invoke startup callback */
+
+    /* produce the QS_QF_RUN trace record */
+    QS_BEGIN_NOCRIT_PRE_(QS_QF_RUN, 0U)
+    QS_END_NOCRIT_PRE_()
+
+    __atomic_store_n(&l_isRunning, true, __ATOMIC_RELEASE);
+
+    /* start the worker threads, which execute the ready AOs */
+    for (n = 0U; n < l_nWorkers; ++n) {
+        int err = pthread_create(&l_worker[n].thread, NULL, &worker_thread,
+                                 (void *)(uintptr_t)n);
+        Q_ASSERT_ID(320, err == 0); /* worker thread must be created */
+    }
+
+    /* try to set the priority of the ticker thread, see NOTE01 */
+    sparam.sched_priority = l_tickPrio;
+    if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &sparam) == 0) {
+        /* success, this application has sufficient privileges */
+    }
+    else {
+        /* setting priority failed, probably due to insufficient privieges */
+    }
+
+    /* the clock tick loop... */
+    tickerStart();
+    while (__atomic_load_n(&l_isRunning, __ATOMIC_ACQUIRE)) {
+        tickerWait(); /* wait for and deliver the due ticks, NOTE02, NOTE04 */
+    }
+
+    /* wait for the workers to complete their current RTC steps */
+    for (n = 0U; n < l_nWorkers; ++n) {
+        pthread_join(l_worker[n].thread, NULL);
+    }
+#ifdef QF_EVT_MAGAZINE
+    QF_magazineFlush(); /* return the cached events of this thread */
+#endif
+
+    QF_onCleanup(); /* invoke cleanup callback */
+    for (n = 0U; n < QF_POOL_MAX_WORKERS; ++n) {
+        pthread_mutex_destroy(&l_worker[n].mutex);
+    }
+    pthread_cond_destroy(&l_idleCond);
+    pthread_mutex_destroy(&l_idleMutex);
+    pthread_mutex_destroy(&l_pThreadMutex);
+#ifdef QF_TICKLESS
+    pthread_cond_destroy(&l_ticklessCond);
+    pthread_mutex_destroy(&l_ticklessMutex);
+#endif
+
+    return 0; /* return success */
+}
+/*..........................................................................*/
+void QF_setTickRate(uint32_t ticksPerSec, int_t tickPrio) {
+#ifdef QF_TICKLESS
+    /* in the tickless mode the periodic tick rate 0 can be stopped */
+    tickerSetPeriod(0U, (ticksPerSec != 0U)
+                        ? (uint32_t)NANOSLEEP_NSEC_PER_SEC / ticksPerSec
+                        : 0U);
+#else
+    Q_REQUIRE_ID(300, ticksPerSec != 0U);
+    tickerSetPeriod(0U, (uint32_t)NANOSLEEP_NSEC_PER_SEC / ticksPerSec);
+#endif
+    l_tickPrio = tickPrio;
+}
+/*..........................................................................*/
+void QF_setTickRateX(uint_fast8_t tickRate, uint32_t ticksPerSec) {
+    /** @pre the tick rate must be ticked by QF_TICK_X() from the port */
+    Q_REQUIRE_ID(330, (0U < tickRate) && (tickRate < QF_MAX_TICK_RATE));
+    tickerSetPeriod(tickRate, (ticksPerSec != 0U)
+                    ? (uint32_t)NANOSLEEP_NSEC_PER_SEC / ticksPerSec
+                    : 0U);
+}
+
+/*..........................................................................*/
+void QF_setPoolSize(uint_fast8_t nWorkers) {
+    /** @pre the number of workers must be in range and the pool size
+    * cannot be changed after starting any active objects
+    */
+    Q_REQUIRE_ID(310, (0U < nWorkers)
+                      && (nWorkers <= QF_POOL_MAX_WORKERS)
+                      && (!l_aoStarted));
+    l_nWorkers = nWorkers;
+}
+/*..........................................................................*/
+void QF_stop(void) {
+    /* stop the loop in QF_run() and the loops of the workers */
+    __atomic_store_n(&l_isRunning, false, __ATOMIC_RELEASE);
+
+    /* unblock the idle workers, so they can terminate */
+    pthread_mutex_lock(&l_idleMutex);
+    pthread_cond_broadcast(&l_idleCond);
+    pthread_mutex_unlock(&l_idleMutex);
+
+#ifdef QF_TICKLESS
+    /* unblock the ticker waiting for the tickless deadlines */
+    pthread_mutex_lock(&l_ticklessMutex);
+    pthread_cond_signal(&l_ticklessCond);
+    pthread_mutex_unlock(&l_ticklessMutex);
+#endif
+}
+
+/*..........................................................................*/
+void QF_consoleSetup(void) {
+    struct termios tio;   /* modified terminal attributes */
+
+    tcgetattr(0, &l_tsav); /* save the current terminal attributes */
+    tcgetattr(0, &tio);    /* obtain the current terminal attributes */
+    tio.c_lflag &= ~(ICANON | ECHO); /* disable the canonical mode & echo */
+    tcsetattr(0, TCSANOW, &tio);     /* set the new attributes */
+}
+/*..........................................................................*/
+void QF_consoleCleanup(void) {
+    tcsetattr(0, TCSANOW, &l_tsav); /* restore the saved attributes */
+}
+/*..........................................................................*/
+int QF_consoleGetKey(void) {
+    int byteswaiting;
+    ioctl(0, FIONREAD, &byteswaiting);
+    if (byteswaiting > 0) {
+        char ch;
+        ssize_t size;
+
+        size = read(0, &ch, 1);
+        (void)size;
+        return (int)ch;
+    }
+    return 0; /* no input at this time */
+}
+/*..........................................................................*/
+int QF_consoleWaitForKey(void) {
+    return getchar();
+}
+
+/****************************************************************************/
+void QActive_start_(QActive * const me, uint_fast16_t prio,
+                  QEvt const * * const qSto, uint_fast16_t const qLen,
+                  void * const stkSto, uint_fast16_t const stkSize,
+                  void const * const par)
+{
+    QF_CRIT_STAT_
+
+    (void)stkSize; /* unused parameter in the POSIX-POOL port */
+
+    Q_REQUIRE_ID(600, (0U < prio)  /* priority...*/
+        && (prio <= QF_MAX_ACTIVE) /*... in range */
+        && (stkSto == (void *)0)); /* statck storage must NOT...
+                                       * ... be provided */
+    QEQueue_init(&me->eQueue, qSto, qLen);
+    me->prio = (QPrio)prio;
+
+    /* the AO must not be executed before the top-most initial tran. */
+    me->thread = true;
+    l_aoStarted = true;
+
+    QF_add_(me); /* make QF aware of this active object */
+
+    /* the top-most initial tran. (virtual) */
+    QHSM_INIT(&me->super, par, me->prio);
+    QS_FLUSH(); /* flush the trace buffer to the host */
+
+    /* the AO can be executed now, if it has any events already */
+    QF_CRIT_E_();
+    me->thread = false;
+    if (me->eQueue.frontEvt != (QEvt *)0) {
+        QF_poolSchedule_(me);
+    }
+    QF_CRIT_X_();
+}
+/*..........................................................................*/
+#ifdef QF_ACTIVE_STOP
+void QActive_stop(QActive * const me) {
+    uint_fast8_t n;
+    QF_CRIT_STAT_
+
+    QActive_unsubscribeAll(me); /* unsubscribe from all events */
+
+    /* make sure the AO is no longer in any ready-set */
+    QF_CRIT_E_();
+    for (n = 0U; n < l_nWorkers; ++n) {
+        Worker * const w = &l_worker[n];
+        uint_fast16_t p;
+
+        pthread_mutex_lock(&w->mutex);
+        QPSet_remove(&w->readySet, me->prio);
+        QPSet_findMax(&w->readySet, p);
+        __atomic_store_n(&w->top, p, __ATOMIC_RELAXED);
+        pthread_mutex_unlock(&w->mutex);
+    }
+    QF_CRIT_X_();
+
+    QF_remove_(me); /* remove this AO from QF */
+}
+#endif
+/*..........................................................................*/
+void QActive_setAttr(QActive *const me, uint32_t attr1, void const *attr2) {
+    (void)me;    /* unused parameter */
+    (void)attr1; /* unused parameter */
+    (void)attr2; /* unused parameter */
+    Q_ERROR_ID(900); /* this function should not be called in this QP port */
+}
+
+/****************************************************************************/
+/* NOTE: called from QACTIVE_EQUEUE_SIGNAL_() inside the critical section */
+void QF_poolSchedule_(QActive * const me) {
+    if (!me->thread) { /* the AO is neither ready nor executed? */
+        me->thread = true;
+        pushReady(me, true);
+    }
+}
+/*..........................................................................*/
+/* NOTE: must be called inside the critical section, see NOTE03 */
+static void pushReady(QActive * const me, bool const wake) {
+    Worker *w;
+
+    /* keep the AO at the current worker, if called from a worker */
+    if (l_self != 0U) {
+        w = &l_worker[l_self - 1U];
+    }
+    else {
+        w = &l_worker[l_nextWorker];
+        ++l_nextWorker;
+        if (l_nextWorker >= l_nWorkers) {
+            l_nextWorker = 0U;
+        }
+    }
+
+    pthread_mutex_lock(&w->mutex);
+    QPSet_insert(&w->readySet, me->prio);
+    if (me->prio > w->top) {
+        __atomic_store_n(&w->top, me->prio, __ATOMIC_RELAXED);
+    }
+    pthread_mutex_unlock(&w->mutex);
+
+    if (wake) {
+        /* order the insertion before the load of l_nIdle, see NOTE03 */
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&l_nIdle, __ATOMIC_RELAXED) != 0U) {
+            pthread_mutex_lock(&l_idleMutex);
+            pthread_cond_signal(&l_idleCond);
+            pthread_mutex_unlock(&l_idleMutex);
+        }
+    }
+}
+/*..........................................................................*/
+/* take the highest-priority ready AO from any worker, see NOTE03 */
+static uint_fast16_t takeReady(void) {
+    uint_fast16_t p = 0U;
+
+    while (p == 0U) {
+        uint_fast16_t top = 0U;
+        uint_fast8_t victim = 0U;
+        uint_fast8_t n;
+        Worker *w;
+
+        for (n = 0U; n < l_nWorkers; ++n) {
+            uint_fast16_t t = __atomic_load_n(&l_worker[n].top,
+                                              __ATOMIC_RELAXED);
+            if (t > top) {
+                top = t;
+                victim = n;
+            }
+        }
+        if (top == 0U) { /* no AOs ready to run? */
+            break;
+        }
+
+        w = &l_worker[victim];
+        pthread_mutex_lock(&w->mutex);
+        QPSet_findMax(&w->readySet, p); /* 0 if already taken by others */
+        if (p != 0U) {
+            QPSet_remove(&w->readySet, p);
+            QPSet_findMax(&w->readySet, top);
+            __atomic_store_n(&w->top, top, __ATOMIC_RELAXED);
+        }
+        pthread_mutex_unlock(&w->mutex);
+    }
+    return p;
+}
+/*..........................................................................*/
+/* block the calling worker until any AO becomes ready, see NOTE03 */
+static void waitForWork(void) {
+    pthread_mutex_lock(&l_idleMutex);
+    (void)__atomic_add_fetch(&l_nIdle, 1U, __ATOMIC_SEQ_CST);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    for (;;) {
+        uint_fast8_t n;
+        bool ready = false;
+
+        for (n = 0U; n < l_nWorkers; ++n) {
+            if (__atomic_load_n(&l_worker[n].top, __ATOMIC_RELAXED) != 0U) {
+                ready = true;
+            }
+        }
+        if (ready || !__atomic_load_n(&l_isRunning, __ATOMIC_ACQUIRE)) {
+            break;
+        }
+        pthread_cond_wait(&l_idleCond, &l_idleMutex);
+    }
+    (void)__atomic_sub_fetch(&l_nIdle, 1U, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&l_idleMutex);
+}
+/*..........................................................................*/
+static void *worker_thread(void *arg) { /* for pthread_create() */
+    l_self = (uint_fast8_t)((uintptr_t)arg + 1U);
+
+    while (__atomic_load_n(&l_isRunning, __ATOMIC_ACQUIRE)) {
+        uint_fast16_t p = takeReady();
+
+        if (p != 0U) {
+            QActive *a;
+            QF_CRIT_STAT_
+
+            QF_CRIT_E_();
+            a = QF_active_[p];
+            QF_CRIT_X_();
+
+            /* the AO might have been stopped in the meantime */
+            if (a != (QActive *)0) {
+                /* perform the run-to-completion (RTC) step...
+                * 1. retrieve the event from the AO's event queue, which
+                *    by this time must be non-empty (asserted).
+                * 2. dispatch the event to the AO's state machine.
+                * 3. determine if event is garbage and collect it if so
+                */
+#ifdef QF_ACTIVE_GET_BATCH /* batched RTC steps? see NOTE06 */
+                QEvt const *batch[QF_ACTIVE_GET_BATCH];
+                QEvt const *e;
+                (void)QActive_getBatch_(a, batch, Q_DIM(batch));
+                for (e = QActive_batchNext_(a);
+                     e != (QEvt *)0;
+                     e = QActive_batchNext_(a))
+                {
+                    if (QF_active_[p] == a) { /* not stopped meanwhile? */
+                        QHSM_DISPATCH(&a->super, e, a->prio);
+                    }
+                    QF_gc(e);
+                }
+#else
+                QEvt const *e = QActive_get_(a);
+                QHSM_DISPATCH(&a->super, e, a->prio);
+                QF_gc(e);
+#endif
+
+                QF_CRIT_E_();
+                if (QF_active_[p] != a) {
+                    /* the AO has been stopped during the RTC step */
+                }
+                else if (a->eQueue.frontEvt != (QEvt *)0) {
+                    pushReady(a, false); /* still ready to run */
+                }
+                else {
+                    a->thread = false; /* no longer ready */
+                }
+                QF_CRIT_X_();
+            }
+        }
+        else {
+            waitForWork();
+        }
+    }
+#ifdef QF_EVT_MAGAZINE
+    QF_magazineFlush(); /* return the cached events of this worker */
+#endif
+    return (void *)0; /* return success */
+}
+/****************************************************************************/
+/* the code shared by all POSIX ports (ticker, elastic pools), see NOTE04 */
+#include "../posix-common/qf_posix.c"
+
+/*..........................................................................*/
+static void sigIntHandler(int dummy) {
+    (void)dummy; /* unused parameter */
+    QF_onCleanup();
+    exit(-1);
+}
+
+/*****************************************************************************
+* NOTE01:
+* In Linux, the scheduler policy closest to real-time is the SCHED_FIFO
+* policy, available only with superuser privileges. QF_run() attempts to set
+* this policy as well as to maximize its priority, so that the ticking
+* occurrs in the most timely manner (as close to an interrupt as possible).
+* However, setting the SCHED_FIFO policy might fail, most probably due to
+* insufficient privileges.
+*
+* NOTE02:
+* In some (older) Linux kernels, the POSIX nanosleep() system call might
+* deliver only 2*actual-system-tick granularity. To compensate for this,
+* you would need to reduce the constant NANOSLEEP_NSEC_PER_SEC by factor 2.
+*
+* NOTE03:
+* Every worker owns a ready-set of AOs protected by the mutex of the worker.
+* An AO that becomes ready is inserted into the ready-set of the worker
+* that has made it ready (e.g., by posting an event from an RTC step), or
+* into the ready-set of the next worker in the round-robin order when it
+* was made ready from outside of the pool (e.g., from the ticker thread).
+* An AO that remains ready after an RTC step stays with the same worker.
+* This keeps the AOs that communicate with each other at the same CPU.
+*
+* The 'top' member of each worker holds the highest priority in its
+* ready-set. The workers read the 'top' members of all workers without
+* locking to find the highest-priority ready AO in the whole pool, and only
+* then lock the ready-set of that worker to take the AO (stealing it, if the
+* ready-set belongs to another worker). The 'top' is only a hint, so the
+* taking worker re-checks the ready-set under the mutex.
+*
+* An idle worker blocks on the l_idleCond condition variable. The number of
+* idle workers (l_nIdle) and the 'top' members are accessed in opposite
+* order by the idle worker and by pushReady() with a full fence in between
+* (Dekker), so a newly ready AO is either seen by the worker before it
+* blocks, or the worker is signaled.
+*
+* The lock order is: the QF critical section, the mutex of a worker, the
+* l_idleMutex. The mutex of a worker is never held while entering the
+* QF critical section.
+*
+* NOTE04:
+* The ticker is the same in all POSIX ports and is implemented in the file
+* ports/posix-common/qf_posix.c (see NOTE01 in that file). The virtual
+* memory of the elastic event pools is implemented in the same file (see
+* NOTE03 in that file).
+*
+* NOTE05:
+* The tickless time events are the same in all POSIX ports and are
+* implemented in the file ports/posix-common/qf_posix.c (see NOTE02 in
+* that file).
+*
+* NOTE06:
+* When the macro QF_ACTIVE_GET_BATCH is defined, a worker removes up to
+* QF_ACTIVE_GET_BATCH events from the queue of the AO it runs at once
+* with QActive_getBatch_(), which takes the critical section only once
+* for the whole batch, and dispatches them back-to-back. Every event
+* still produces its own QS_QF_ACTIVE_GET (or QS_QF_ACTIVE_GET_LAST)
+* trace record. The AO returns to the ready-set only after the whole
+* batch, so the other ready AOs of the same worker can wait for up to
+* QF_ACTIVE_GET_BATCH run-to-completion steps. The events are taken from
+* the batch with QActive_batchNext_(), so that an event posted LIFO (e.g.,
+* QActive_recall()) or to a higher lane during the batch is still
+* dispatched before the rest of the batch (see NOTE2 in qf_actq.c).
+*/
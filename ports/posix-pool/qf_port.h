@@ -0,0 +1,277 @@
+/**
+* @file
+* @brief QF/C port to POSIX API (thread pool executing the active objects)
+* @ingroup ports
+* @cond
+******************************************************************************
+* Last updated for version 6.9.1
+* Last updated on  2020-09-08
+*
+*                    Q u a n t u m  L e a P s
+*                    ------------------------
+*                    Modern Embedded Software
+*
+* Copyright (C) 2002-2020 Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <www.gnu.org/licenses/>.
+*
+* Contact information:
+* <www.state-machine.com/licensing>
+* <info@state-machine.com>
+******************************************************************************
+* @endcond
+*/
+#ifndef QF_PORT_H
+#define QF_PORT_H
+
+/* POSIX-POOL event queue and thread types */
+#define QF_EQUEUE_TYPE       QEQueue
+/* QF_OS_OBJECT_TYPE not used in this port */
+#define QF_THREAD_TYPE       bool
+
+/* The maximum number of active objects in the application */
+#ifndef QF_MAX_ACTIVE
+#define QF_MAX_ACTIVE        64U
+#endif
+
+/* The number of system clock tick rates */
+#define QF_MAX_TICK_RATE     2U
+
+/* Storage class of the thread-local objects, e.g., the event magazines */
+#define QF_THREAD_LOCAL      _Thread_local
+
+/* Dynamic events use atomic reference counting, see NOTE4 */
+#define QF_EVT_REF_CTR_ATOMIC 1
+
+/* The maximum number of missed clock ticks delivered after an overrun
+* of the ticker (see NOTE04 in qf_port.c)
+*/
+#ifndef QF_TICK_CATCHUP_MAX
+#define QF_TICK_CATCHUP_MAX  100U
+#endif
+
+#ifdef QF_TICKLESS /* tickless time events? see NOTE3 */
+/* the maximum number of simultaneously armed tickless time events */
+#ifndef QF_TICKLESS_MAX
+#define QF_TICKLESS_MAX      1024U
+#endif
+#endif
+
+/* The maximum number of events taken from the queue of an AO and
+* dispatched in one batch (see NOTE06 in qf_port.c)
+*/
+#ifdef QF_ACTIVE_GET_BATCH
+#if (QF_ACTIVE_GET_BATCH < 1)
+#error "QF_ACTIVE_GET_BATCH must be at least 1"
+#endif
+#endif
+
+/* Activate the QF QActive_stop() API */
+#define QF_ACTIVE_STOP       1
+
+/* various QF object sizes configuration for this port */
+#define QF_EVENT_SIZ_SIZE    4U
+#define QF_EQUEUE_CTR_SIZE   4U
+#define QF_MPOOL_SIZ_SIZE    4U
+#define QF_MPOOL_CTR_SIZE    4U
+#define QF_TIMEEVT_CTR_SIZE  4U
+
+/* The maximum number of worker threads in the pool, see NOTE2 */
+#ifndef QF_POOL_MAX_WORKERS
+#define QF_POOL_MAX_WORKERS  32U
+#endif
+
+/* QF critical section entry/exit for POSIX-POOL, see NOTE1 */
+/* QF_CRIT_STAT_TYPE not defined */
+#define QF_CRIT_ENTRY(dummy) QF_enterCriticalSection_()
+#define QF_CRIT_EXIT(dummy)  QF_leaveCriticalSection_()
+
+/* QF_LOG2 with the count-leading-zeros built-in of GCC/Clang. The argument
+* is shifted into 64 bits with the lowest bit set, so that QF_LOG2(0) is 0
+* without a branch (__builtin_clz(0) is undefined).
+*/
+#if (defined __GNUC__) || (defined __clang__)
+    #define QF_LOG2(n_) ((uint_fast8_t)(63U \
+        - (unsigned)__builtin_clzll((((unsigned long long)(n_)) << 1U) | 1U)))
+#endif
+
+#include "qep_port.h"  /* QEP port */
+#include "qequeue.h"   /* POSIX-POOL needs event-queue */
+#include "qmpool.h"    /* POSIX-POOL needs memory-pool */
+#include "qf.h"        /* QF platform-independent public interface */
+
+void QF_enterCriticalSection_(void);
+void QF_leaveCriticalSection_(void);
+
+/* set clock tick rate and p-thread priority */
+void QF_setTickRate(uint32_t ticksPerSec, int_t tickPrio);
+
+/* set the clock tick rate of the additional tick rate 'tickRate' (> 0),
+* which is then ticked by the port with QF_TICK_X()
+* (NOTE ticksPerSec==0 stops ticking this rate)
+*/
+void QF_setTickRateX(uint_fast8_t tickRate, uint32_t ticksPerSec);
+
+#ifdef QF_TICKLESS /* tickless time events? see NOTE3 */
+/* arm the time event to expire in 'nsec' nanoseconds and then every
+* 'intervalNsec' nanoseconds (NOTE intervalNsec==0 for one-shot)
+*/
+void QTimeEvt_armNsec(QTimeEvt * const me,
+                      uint64_t const nsec, uint64_t const intervalNsec);
+
+/* disarm the tickless time event (returns 'true' if it was armed) */
+bool QTimeEvt_disarmNsec(QTimeEvt * const me);
+
+/* rearm the armed tickless time event to expire in 'nsec' nanoseconds */
+bool QTimeEvt_rearmNsec(QTimeEvt * const me, uint64_t const nsec);
+
+/* the number of nanoseconds until the tickless time event expires */
+uint64_t QTimeEvt_currNsec(QTimeEvt const * const me);
+#endif
+
+/* set the number of worker threads (NOTE call before starting any AO) */
+void QF_setPoolSize(uint_fast8_t nWorkers);
+
+/* clock tick callback (NOTE not called when "ticker thread" is not running) */
+void QF_onClockTick(void); /* clock tick callback (provided in the app) */
+
+/* abstractions for console access... */
+void QF_consoleSetup(void);
+void QF_consoleCleanup(void);
+int QF_consoleGetKey(void);
+int QF_consoleWaitForKey(void);
+
+/****************************************************************************/
+/* interface used only inside QF implementation, but not in applications */
+#ifdef QP_IMPL
+
+    /* QF-specific scheduler locking (not used at this point) */
+    #define QF_SCHED_STAT_
+    #define QF_SCHED_LOCK_(dummy) ((void)0)
+    #define QF_SCHED_UNLOCK_()    ((void)0)
+
+    /* POSIX-POOL active object event queue customization... */
+    #define QACTIVE_EQUEUE_WAIT_(me_) \
+        Q_ASSERT((me_)->eQueue.frontEvt != (QEvt *)0)
+
+    #define QACTIVE_EQUEUE_SIGNAL_(me_) \
+        QF_poolSchedule_((me_))
+
+    /* native QF event pool operations */
+    #define QF_EPOOL_TYPE_            QMPool
+    #define QF_EPOOL_INIT_(p_, poolSto_, poolSize_, evtSize_) \
+        (QMPool_init(&(p_), (poolSto_), (poolSize_), (evtSize_)))
+    #define QF_EPOOL_EVENT_SIZE_(p_)  ((uint_fast16_t)(p_).blockSize)
+    #define QF_EPOOL_GET_(p_, e_, m_, qs_id_) \
+        ((e_) = (QEvt *)QMPool_get(&(p_), (m_), (qs_id_)))
+    #define QF_EPOOL_PUT_(p_, e_, qs_id_) \
+        (QMPool_put(&(p_), (e_), (qs_id_)))
+
+#ifdef QF_MPOOL_ELASTIC
+    /* virtual memory for the elastic event pools, see NOTE5 */
+    #define QF_MPOOL_RESERVE_(size_)  (QF_memReserve_((size_)))
+    #define QF_MPOOL_COMMIT_(addr_, size_) \
+        (QF_memCommit_((addr_), (size_)))
+    #define QF_MPOOL_DECOMMIT_(addr_, size_) \
+        (QF_memDecommit_((addr_), (size_)))
+
+    void *QF_memReserve_(uint_fast32_t const size);
+    bool QF_memCommit_(void * const addr, uint_fast32_t const size);
+    void QF_memDecommit_(void * const addr, uint_fast32_t const size);
+#endif /* QF_MPOOL_ELASTIC */
+
+    /* make the AO ready to run in the thread pool (inside crit. section) */
+    void QF_poolSchedule_(QActive * const me);
+
+#endif /* QP_IMPL */
+
+/****************************************************************************/
+/*
+* NOTE1:
+* QF, like all real-time frameworks, needs to execute certain sections of
+* code exclusively, meaning that only one thread can execute the code at
+* the time. Such sections of code are called "critical sections"
+*
+* This port uses a pair of functions QF_enterCriticalSection_() /
+* QF_leaveCriticalSection_() to enter/leave the cirtical section,
+* respectively.
+*
+* These functions are implemented in the qf_port.c module, where they
+* manipulate the file-scope POSIX mutex object l_pThreadMutex
+* to protect all critical sections. Using the single mutex for all crtical
+* section guarantees that only one thread at a time can execute inside a
+* critical section. This prevents race conditions and data corruption.
+*
+* NOTE2:
+* This port executes all active objects in a fixed pool of worker threads
+* (by default one per online CPU, up to QF_POOL_MAX_WORKERS) instead of
+* creating a p-thread for each active object. An AO that has events in its
+* queue is "ready" and sits in the ready-set of one of the workers, or is
+* being executed by a worker. Each worker repeatedly takes the highest-
+* priority ready AO, possibly "stealing" it from the ready-set of another
+* worker, and performs one run-to-completion (RTC) step of that AO.
+*
+* An AO is never ready in more than one ready-set and is never executed
+* by two workers at the same time, so the RTC steps of every AO remain
+* serialized, even though consecutive steps might be executed by different
+* workers. The AO priorities determine which of the ready AOs is executed
+* first, but (as in any multi-core system) a lower-priority AO can run on
+* one CPU concurrently with a higher-priority AO on another CPU.
+*
+* The thread-related parameters of QACTIVE_START() (stack storage and size)
+* are not used in this port. The QActive.thread flag indicates that the AO
+* is ready or being executed.
+*
+* NOTE3:
+* The tickless mode (macro QF_TICKLESS) allows arming time events with
+* nanosecond deadlines by means of QTimeEvt_armNsec(), which are then
+* timed directly by the ticker thread without any periodic clock tick.
+* The tickless time events must be disarmed, rearmed and queried only
+* with the *Nsec() functions, while the other time events keep using the
+* periodic tick rates. Mixing the two APIs on one time event asserts.
+* In the tickless mode QF_setTickRate() accepts ticksPerSec==0, which
+* stops the periodic ticking of the tick rate 0 (and the QF_onClockTick()
+* callback) altogether. See NOTE05 in qf_port.c.
+*
+* NOTE4:
+* The reference counters of dynamic events are incremented and decremented
+* with the GCC atomic built-ins (see QF_EVT_REF_CTR_ATOMIC in qf_pkg.h),
+* so QF_gc() called by the worker threads recycles events without taking
+* the QF critical section mutex. For events referenced by more than 255
+* event queues at once, configure the wider counter with
+* Q_EVT_REF_CTR_SIZE.
+*
+* NOTE5:
+* The elastic event pools (macro QF_MPOOL_ELASTIC) reserve the address
+* space for their maximum size and commit the memory only as the pools
+* grow (see NOTE03 in ports/posix-common/qf_posix.c). QF_poolTrim() gives
+* the memory back to the OS, so the application can call it periodically
+* (e.g., from a time event of a low-priority AO) to shrink the pools after
+* a spike:
+*
+*     QF_poolInitElastic(sizeof(FrameEvt), 64U, 4096U, 64U, 8U);
+*     ...
+*     case HOUSEKEEPING_SIG: {
+*         (void)QF_poolTrim(1U);
+*         ...
+* The pools grow in the critical section of the pool, so choose nGrow
+* that keeps the growth (a single mprotect() call) infrequent.
+*/
+
+#endif /* QF_PORT_H */
@@ -45,7 +45,9 @@
 /* QF_THREAD_TYPE    not used in this port */
 
 /* The maximum number of active objects in the application */
+#ifndef QF_MAX_ACTIVE
 #define QF_MAX_ACTIVE        64U
+#endif
 
 /* The number of system clock tick rates */
 #define QF_MAX_TICK_RATE     2U
@@ -62,7 +64,14 @@
 #define QF_CRIT_ENTRY(dummy) QF_INT_DISABLE()
 #define QF_CRIT_EXIT(dummy)  QF_INT_ENABLE()
 
-/* QF_LOG2 not defined -- use the internal LOG2() implementation */
+/* QF_LOG2 with the count-leading-zeros built-in of GCC/Clang. The argument
+* is shifted into 64 bits with the lowest bit set, so that QF_LOG2(0) is 0
+* without a branch (__builtin_clz(0) is undefined).
+*/
+#if (defined __GNUC__) || (defined __clang__)
+    #define QF_LOG2(n_) ((uint_fast8_t)(63U \
+        - (unsigned)__builtin_clzll((((unsigned long long)(n_)) << 1U) | 1U)))
+#endif
 
 #include "qep_port.h"  /* QEP port */
 #include "qequeue.h"   /* QUTEST port uses QEQueue event-queue */
@@ -82,7 +91,7 @@
     #define QACTIVE_EQUEUE_WAIT_(me_) \
         Q_ASSERT_ID(0, (me_)->eQueue.frontEvt != (QEvt *)0)
     #define QACTIVE_EQUEUE_SIGNAL_(me_) \
-        QPSet_insert(&QS_rxPriv_.readySet, (uint_fast8_t)(me_)->prio)
+        QPSet_insert(&QS_rxPriv_.readySet, (uint_fast16_t)(me_)->prio)
 
     /* native QF event pool operations */
     #define QF_EPOOL_TYPE_            QMPool
@@ -94,6 +103,16 @@
     #define QF_EPOOL_PUT_(p_, e_, qs_id_) \
         (QMPool_put(&(p_), (e_), (qs_id_)))
 
+#ifdef QF_MPOOL_ELASTIC
+    /* the elastic event pools take all their memory from the heap upfront,
+    * because QUTEST tests only how the pools grow and shrink */
+    #define QF_MPOOL_RESERVE_(size_)         (malloc((size_)))
+    #define QF_MPOOL_COMMIT_(addr_, size_)   (true)
+    #define QF_MPOOL_DECOMMIT_(addr_, size_) ((void)0)
+
+    #include <stdlib.h> /* for malloc() */
+#endif /* QF_MPOOL_ELASTIC */
+
     #include "qf_pkg.h" /* internal QF interface */
 
 #endif /* QP_IMPL */
@@ -40,6 +40,8 @@
 
 /* expose features from the 2008 POSIX standard (IEEE Standard 1003.1-2008) */
 #define _POSIX_C_SOURCE 200809L
+/* expose the GNU extensions (CPU affinity of the QV partitions) */
+#define _GNU_SOURCE
 
 #define QP_IMPL           /* this is QP implementation */
 #include "qf_port.h"      /* QF port */
@@ -62,27 +64,63 @@
 #include <termios.h>
 #include <unistd.h>
 #include <signal.h>
+#include <time.h>         /* for clock_nanosleep() */
 
 Q_DEFINE_THIS_MODULE("qf_port")
 
 /* Global objects ==========================================================*/
-QPSet  QV_readySet_;        /* QV-ready set of active objects */
-pthread_cond_t QV_condVar_; /* Cond.var. to signal events */
+QVPartition QV_partition_[QV_MAX_PARTITIONS]; /* QV partitions, NOTE06 */
 
 /* Local objects ===========================================================*/
 static pthread_mutex_t l_pThreadMutex; /* POSIX mutex for critical sections */
 static bool l_isRunning;
 static struct termios l_tsav; /* structure with saved terminal attributes */
-static struct timespec l_tick;
+static uint32_t l_tickPeriod[QF_MAX_TICK_RATE]; /* 0 means not ticked */
+static int64_t l_tickNext[QF_MAX_TICK_RATE]; /* absolute tick deadlines */
+#ifdef Q_SPY
+static uint8_t const l_ticker = 0U; /* QS sender of the port-driven ticks */
+#endif
+#ifdef QF_TICKLESS
+/*! tickless time event in the min-heap of deadlines, see NOTE08 */
+typedef struct {
+    int64_t deadline;  /* absolute deadline [ns] */
+    int64_t interval;  /* period [ns] (0 for one-shot) */
+    QTimeEvt *te;      /* the armed time event */
+} QTicklessTimer;
+static QTicklessTimer l_tickless[QF_TICKLESS_MAX]; /* min-heap */
+static uint_fast16_t l_nTickless;  /* # armed tickless time events */
+static pthread_mutex_t l_ticklessMutex; /* protects the min-heap */
+static pthread_cond_t l_ticklessCond; /* wakes up the ticker */
+#endif
 static int_t l_tickPrio;
 enum { NANOSLEEP_NSEC_PER_SEC = 1000000000 }; /* see NOTE05 */
+static int_t l_partCpu[QV_MAX_PARTITIONS]; /* CPU of each partition */
+#if (QV_MAX_PARTITIONS > 1U)
+static uint8_t l_prioPart[QF_MAX_ACTIVE + 1U]; /* partition of each prio */
+static bool l_partUsed[QV_MAX_PARTITIONS]; /* partition has any AOs? */
+static pthread_t l_partThread[QV_MAX_PARTITIONS]; /* partition threads */
+static void *partition_thread(void *arg);
+#endif
 
+static void runPartition(uint_fast8_t const part);
 static void *ticker_thread(void *arg);
+static void tickerStart(void);
+static void tickerSetPeriod(uint_fast8_t const r, uint32_t const period);
+static void tickerWait(void);
+#ifdef QF_TICKLESS
+static int64_t tickerNow(void);
+static void ticklessExpire(int64_t const now);
+static void ticklessUp(uint_fast16_t i);
+static void ticklessDown(uint_fast16_t i);
+static void ticklessRemove(uint_fast16_t const i);
+static bool ticklessIsArmed(QTimeEvt const * const me);
+#endif
 static void sigIntHandler(int dummy);
 
 /* QF functions ============================================================*/
 void QF_init(void) {
     struct sigaction sig_act;
+    uint_fast8_t n;
 
     /* lock memory so we're never swapped out to disk */
     /*mlockall(MCL_CURRENT | MCL_FUTURE);  uncomment when supported */
@@ -90,13 +128,28 @@ void QF_init(void) {
     /* init the global mutex with the default non-recursive initializer */
     pthread_mutex_init(&l_pThreadMutex, NULL);
 
-    /* init the global condition variable with the default initializer */
-    pthread_cond_init(&QV_condVar_, NULL);
+    /* init the condition variables of the partitions, see NOTE06 */
+    for (n = 0U; n < QV_MAX_PARTITIONS; ++n) {
+        QPSet_setEmpty(&QV_partition_[n].readySet);
+        pthread_cond_init(&QV_partition_[n].condVar, NULL);
+        l_partCpu[n] = -1; /* no CPU pinning by default */
+    }
 
-    l_tick.tv_sec = 0;
-    l_tick.tv_nsec = NANOSLEEP_NSEC_PER_SEC/100L; /* default clock tick */
+    l_tickPeriod[0] = (uint32_t)NANOSLEEP_NSEC_PER_SEC/100U; /* default */
     l_tickPrio = sched_get_priority_min(SCHED_FIFO); /* default tick prio */
 
+#ifdef QF_TICKLESS
+    /* the tickless deadlines are measured by the monotonic clock */
+    {
+        pthread_condattr_t attr;
+        pthread_condattr_init(&attr);
+        pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+        pthread_cond_init(&l_ticklessCond, &attr);
+        pthread_condattr_destroy(&attr);
+    }
+    pthread_mutex_init(&l_ticklessMutex, NULL);
+#endif
+
     /* install the SIGINT (Ctrl-C) signal handler */
     sig_act.sa_handler = &sigIntHandler;
     sigaction(SIGINT, &sig_act, NULL);
@@ -113,14 +166,26 @@ void QF_leaveCriticalSection_(void) {
 
 /****************************************************************************/
 int_t QF_run(void) {
+    uint_fast8_t n;
+#ifdef QF_TICKLESS
+    bool isTicked = true; /* the ticker times the tickless time events */
+#else
+    bool isTicked = false;
+#endif
     QF_CRIT_STAT_
 
     QF_onStartup();  /* invoke startup callback */
 
     l_isRunning = true; /* QF is running */
 
+    for (n = 0U; n < QF_MAX_TICK_RATE; ++n) {
+        if (l_tickPeriod[n] != 0U) {
+            isTicked = true;
+        }
+    }
+
     /* system clock tick configured? */
-    if ((l_tick.tv_sec != 0) || (l_tick.tv_nsec != 0)) {
+    if (isTicked) {
         pthread_attr_t attr;
         struct sched_param param;
         pthread_t ticker;
@@ -159,22 +224,71 @@ int_t QF_run(void) {
         pthread_attr_destroy(&attr);
     }
 
-    /* the combined event-loop and background-loop of the QV kernel */
-    QF_CRIT_E_();
+#if (QV_MAX_PARTITIONS > 1U)
+    /* start the event-loop threads of the other partitions, see NOTE06 */
+    for (n = 1U; n < QV_MAX_PARTITIONS; ++n) {
+        if (l_partUsed[n]) {
+            int err = pthread_create(&l_partThread[n], NULL,
+                                     &partition_thread, (void *)(uintptr_t)n);
+            Q_ASSERT_ID(330, err == 0); /* partition thread must be created */
+        }
+    }
+#endif
 
     /* produce the QS_QF_RUN trace record */
+    QF_CRIT_E_();
     QS_BEGIN_NOCRIT_PRE_(QS_QF_RUN, 0U)
     QS_END_NOCRIT_PRE_()
+    QF_CRIT_X_();
+
+    runPartition(0U); /* partition 0 runs in the QF_run() thread */
 
+#if (QV_MAX_PARTITIONS > 1U)
+    for (n = 1U; n < QV_MAX_PARTITIONS; ++n) {
+        if (l_partUsed[n]) {
+            pthread_join(l_partThread[n], NULL);
+        }
+    }
+#endif
+
+    QF_onCleanup();  /* cleanup callback */
+    QS_EXIT();       /* cleanup the QSPY connection */
+
+    for (n = 0U; n < QV_MAX_PARTITIONS; ++n) {
+        pthread_cond_destroy(&QV_partition_[n].condVar); /* cleanup */
+    }
+    pthread_mutex_destroy(&l_pThreadMutex); /* cleanup the global mutex */
+
+    return 0; /* return success */
+}
+/*..........................................................................*/
+/* the combined event-loop and background-loop of a QV partition */
+static void runPartition(uint_fast8_t const part) {
+    QVPartition * const qv = &QV_partition_[part];
+    QF_CRIT_STAT_
+
+#ifdef __linux__
+    if (l_partCpu[part] >= 0) { /* pin this thread to the given CPU? */
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(l_partCpu[part], &cpuSet);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+    }
+#endif
+
+    QF_CRIT_E_();
     while (l_isRunning) {
+#ifdef QF_ACTIVE_GET_BATCH
+        QEvt const *batch[QF_ACTIVE_GET_BATCH];
+#endif
         QEvt const *e;
         QActive *a;
-        uint_fast8_t p;
+        uint_fast16_t p;
 
         /* find the maximum priority AO ready to run */
-        if (QPSet_notEmpty(&QV_readySet_)) {
+        if (QPSet_notEmpty(&qv->readySet)) {
 
-            QPSet_findMax(&QV_readySet_, p);
+            QPSet_findMax(&qv->readySet, p);
             a = QF_active_[p];
             QF_CRIT_X_();
 
@@ -189,14 +303,27 @@ int_t QF_run(void) {
             * 2. dispatch the event to the AO's state machine.
             * 3. determine if event is garbage and collect it if so
             */
+#ifdef QF_ACTIVE_GET_BATCH /* batched RTC steps? see NOTE09 */
+            (void)QActive_getBatch_(a, batch, Q_DIM(batch));
+            for (e = QActive_batchNext_(a);
+                 e != (QEvt *)0;
+                 e = QActive_batchNext_(a))
+            {
+                if (QF_active_[p] == a) { /* not stopped in this batch? */
+                    QHSM_DISPATCH(&a->super, e, a->prio);
+                }
+                QF_gc(e);
+            }
+#else
             e = QActive_get_(a);
             QHSM_DISPATCH(&a->super, e, a->prio);
             QF_gc(e);
+#endif
 
             QF_CRIT_E_();
 
             if (a->eQueue.frontEvt == (QEvt *)0) { /* empty queue? */
-                QPSet_remove(&QV_readySet_, p);
+                QPSet_remove(&qv->readySet, p);
             }
         }
         else {
@@ -205,39 +332,83 @@ int_t QF_run(void) {
             * for events. Instead, the POSIX-QV port efficiently waits until
             * QP events become available.
             */
-            while (QPSet_isEmpty(&QV_readySet_)) {
-                pthread_cond_wait(&QV_condVar_, &l_pThreadMutex);
+            while (QPSet_isEmpty(&qv->readySet) && l_isRunning) {
+                pthread_cond_wait(&qv->condVar, &l_pThreadMutex);
             }
         }
     }
     QF_CRIT_X_();
-    QF_onCleanup();  /* cleanup callback */
-    QS_EXIT();       /* cleanup the QSPY connection */
-
-    pthread_cond_destroy(&QV_condVar_); /* cleanup the condition variable */
-    pthread_mutex_destroy(&l_pThreadMutex); /* cleanup the global mutex */
-
-    return 0; /* return success */
+#ifdef QF_EVT_MAGAZINE
+    QF_magazineFlush(); /* return the cached events of this partition */
+#endif
 }
+#if (QV_MAX_PARTITIONS > 1U)
+/*..........................................................................*/
+static void *partition_thread(void *arg) { /* for pthread_create() */
+    runPartition((uint_fast8_t)(uintptr_t)arg);
+    return (void *)0; /* return success */
+}
+#endif
 /*..........................................................................*/
 void QF_setTickRate(uint32_t ticksPerSec, int_t tickPrio) {
     if (ticksPerSec != 0U) {
-        l_tick.tv_nsec = NANOSLEEP_NSEC_PER_SEC / ticksPerSec;
+        tickerSetPeriod(0U, (uint32_t)NANOSLEEP_NSEC_PER_SEC / ticksPerSec);
     }
     else {
-        l_tick.tv_nsec = 0; /* means NO system clock tick */
+        tickerSetPeriod(0U, 0U); /* means NO system clock tick */
     }
     l_tickPrio = tickPrio;
 }
+/*..........................................................................*/
+void QF_setTickRateX(uint_fast8_t tickRate, uint32_t ticksPerSec) {
+    /** @pre the tick rate must be ticked by QF_TICK_X() from the port */
+    Q_REQUIRE_ID(350, (0U < tickRate) && (tickRate < QF_MAX_TICK_RATE));
+    tickerSetPeriod(tickRate, (ticksPerSec != 0U)
+                    ? (uint32_t)NANOSLEEP_NSEC_PER_SEC / ticksPerSec
+                    : 0U);
+}
+
 /*..........................................................................*/
 void QF_stop(void) {
-    uint_fast8_t p;
-    l_isRunning = false; /* terminate the main event-loop thread */
+    uint_fast8_t n;
+    QF_CRIT_STAT_
 
-    /* unblock the event-loop so it can terminate */
-    p = 1U;
-    QPSet_insert(&QV_readySet_, p);
-    pthread_cond_signal(&QV_condVar_);
+    QF_CRIT_E_();
+    l_isRunning = false; /* terminate the event-loop threads */
+
+    /* unblock the event-loops so they can terminate */
+    for (n = 0U; n < QV_MAX_PARTITIONS; ++n) {
+        pthread_cond_signal(&QV_partition_[n].condVar);
+    }
+    QF_CRIT_X_();
+
+#ifdef QF_TICKLESS
+    /* unblock the ticker waiting for the tickless deadlines */
+    pthread_mutex_lock(&l_ticklessMutex);
+    pthread_cond_signal(&l_ticklessCond);
+    pthread_mutex_unlock(&l_ticklessMutex);
+#endif
+}
+/*..........................................................................*/
+void QF_setPartition(uint_fast8_t part,
+                     uint_fast16_t prioLo, uint_fast16_t prioHi, int_t cpu)
+{
+    /** @pre the partition and the priority range must be valid */
+    Q_REQUIRE_ID(340, (part < QV_MAX_PARTITIONS)
+                      && (0U < prioLo)
+                      && (prioLo <= prioHi)
+                      && (prioHi <= QF_MAX_ACTIVE));
+
+    l_partCpu[part] = cpu;
+#if (QV_MAX_PARTITIONS > 1U)
+    for (; prioLo <= prioHi; ++prioLo) {
+        l_prioPart[prioLo] = (uint8_t)part;
+    }
+    l_partUsed[part] = true;
+#else
+    (void)prioLo; /* unused parameter with a single partition */
+    (void)prioHi; /* unused parameter with a single partition */
+#endif
 }
 
 /*..........................................................................*/
@@ -273,7 +444,7 @@ int QF_consoleWaitForKey(void) {
 }
 
 /****************************************************************************/
-void QActive_start_(QActive * const me, uint_fast8_t prio,
+void QActive_start_(QActive * const me, uint_fast16_t prio,
                   QEvt const * * const qSto, uint_fast16_t const qLen,
                   void * const stkSto, uint_fast16_t const stkSize,
                   void const * const par)
@@ -285,7 +456,10 @@ void QActive_start_(QActive * const me, uint_fast8_t prio,
         && (stkSto == (void *)0)); /* statck storage must NOT...
                                        * ... be provided */
     QEQueue_init(&me->eQueue, qSto, qLen);
-    me->prio = (uint8_t)prio;
+    me->prio = (QPrio)prio;
+#if (QV_MAX_PARTITIONS > 1U)
+    me->thread = l_prioPart[prio]; /* QV partition of the AO, NOTE06 */
+#endif
     QF_add_(me); /* make QF aware of this active object */
 
     /* the top-most initial tran. (virtual) */
@@ -301,7 +475,7 @@ void QActive_stop(QActive * const me) {
 
     /* make sure the AO is no longer in "ready set" */
     QF_CRIT_E_();
-    QPSet_remove(&QV_readySet_, me->prio);
+    QPSet_remove(&QV_PART_(me)->readySet, me->prio);
     QF_CRIT_X_();
 
     QF_remove_(me); /* remove this AO from QF */
@@ -318,12 +492,19 @@ void QActive_setAttr(QActive *const me, uint32_t attr1, void const *attr2) {
 /****************************************************************************/
 static void *ticker_thread(void *arg) { /* for pthread_create() */
     (void)arg; /* unused parameter */
+    tickerStart();
     while (l_isRunning) { /* the clock tick loop... */
-        nanosleep(&l_tick, NULL); /* sleep for the number of ticks, NOTE05 */
-        QF_onClockTick(); /* clock tick callback (must call QF_TICK_X()) */
+        tickerWait(); /* wait for and deliver the due ticks, NOTE05, NOTE07 */
     }
+#ifdef QF_EVT_MAGAZINE
+    QF_magazineFlush(); /* return the cached events of this thread */
+#endif
     return (void *)0; /* return success */
 }
+/****************************************************************************/
+/* the code shared by all POSIX ports (ticker, elastic pools), see NOTE07 */
+#include "../posix-common/qf_posix.c"
+
 /*..........................................................................*/
 static void sigIntHandler(int dummy) {
     (void)dummy; /* unused parameter */
@@ -372,5 +553,41 @@ static void sigIntHandler(int dummy) {
 * In some (older) Linux kernels, the POSIX nanosleep() system call might
 * deliver only 2*actual-system-tick granularity. To compensate for this,
 * you would need to reduce the constant NANOSLEEP_NSEC_PER_SEC by factor 2.
+*
+* NOTE06:
+* Each QV partition (see NOTE2 in qf_port.h) runs the same event loop as
+* the single-threaded QV port, but considers only the AOs in its own
+* ready-set. QACTIVE_EQUEUE_SIGNAL_() inserts the recipient AO into the
+* ready-set of its partition and signals only the condition variable of
+* that partition, so posting events across partitions does not disturb
+* the other event loops. Partition 0 runs in the QF_run() thread, the
+* other partitions get their own threads, but only if any AO priorities
+* have been assigned to them.
+*
+* NOTE07:
+* The ticker is the same in all POSIX ports and is implemented in the file
+* ports/posix-common/qf_posix.c (see NOTE01 in that file). The virtual
+* memory of the elastic event pools is implemented in the same file (see
+* NOTE03 in that file).
+*
+* NOTE08:
+* The tickless time events are the same in all POSIX ports and are
+* implemented in the file ports/posix-common/qf_posix.c (see NOTE02 in
+* that file).
+*
+* NOTE09:
+* When the macro QF_ACTIVE_GET_BATCH is defined, the event loop removes
+* up to QF_ACTIVE_GET_BATCH events from the queue of the highest-priority
+* ready AO at once with QActive_getBatch_(), which takes the critical
+* section only once for the whole batch. The events are then dispatched
+* back-to-back, each one still producing its own QS_QF_ACTIVE_GET (or
+* QS_QF_ACTIVE_GET_LAST) trace record. The price is that the priorities
+* of the ready AOs are re-evaluated only between the batches, so an AO of
+* higher priority that becomes ready in the meantime can wait for up to
+* QF_ACTIVE_GET_BATCH run-to-completion steps of a lower-priority AO.
+* The events are taken from the batch with QActive_batchNext_(), so that
+* an event posted LIFO (e.g., QActive_recall()) or to a higher lane during
+* the batch is still dispatched before the rest of the batch (see NOTE2
+* in qf_actq.c).
 */
 
@@ -39,17 +39,57 @@
 #ifndef QF_PORT_H
 #define QF_PORT_H
 
+/* The maximum number of QV partitions (event-loop threads), see NOTE2 */
+#ifndef QV_MAX_PARTITIONS
+#define QV_MAX_PARTITIONS    1U
+#endif
+
 /* POSIX-QV event queue and thread types */
 #define QF_EQUEUE_TYPE  QEQueue
 /* QF_OS_OBJECT_TYPE not used in this port */
-/* QF_THREAD_TYPE    not used in this port */
+#if (QV_MAX_PARTITIONS > 1U)
+    #define QF_THREAD_TYPE  uint8_t /* QV partition of the AO */
+#else
+    /* QF_THREAD_TYPE    not used in this port */
+#endif
 
 /* The maximum number of active objects in the application */
+#ifndef QF_MAX_ACTIVE
 #define QF_MAX_ACTIVE        64U
+#endif
 
 /* The number of system clock tick rates */
 #define QF_MAX_TICK_RATE     2U
 
+/* Storage class of the thread-local objects, e.g., the event magazines */
+#define QF_THREAD_LOCAL      _Thread_local
+
+/* Dynamic events use atomic reference counting, see NOTE4 */
+#define QF_EVT_REF_CTR_ATOMIC 1
+
+/* The maximum number of missed clock ticks delivered after an overrun
+* of the ticker (see NOTE07 in qf_port.c)
+*/
+#ifndef QF_TICK_CATCHUP_MAX
+#define QF_TICK_CATCHUP_MAX  100U
+#endif
+
+#ifdef QF_TICKLESS /* tickless time events? see NOTE3 */
+/* the maximum number of simultaneously armed tickless time events */
+#ifndef QF_TICKLESS_MAX
+#define QF_TICKLESS_MAX      1024U
+#endif
+#endif
+
+/* The maximum number of events taken from the queue of an AO and
+* dispatched in one batch (see NOTE09 in qf_port.c)
+*/
+#ifdef QF_ACTIVE_GET_BATCH
+#if (QF_ACTIVE_GET_BATCH < 1)
+#error "QF_ACTIVE_GET_BATCH must be at least 1"
+#endif
+#endif
+
 /* Activate the QF QActive_stop() API */
 #define QF_ACTIVE_STOP       1
 
@@ -65,7 +105,14 @@
 #define QF_CRIT_ENTRY(dummy) QF_enterCriticalSection_()
 #define QF_CRIT_EXIT(dummy)  QF_leaveCriticalSection_()
 
-/* QF_LOG2 not defined -- use the internal LOG2() implementation */
+/* QF_LOG2 with the count-leading-zeros built-in of GCC/Clang. The argument
+* is shifted into 64 bits with the lowest bit set, so that QF_LOG2(0) is 0
+* without a branch (__builtin_clz(0) is undefined).
+*/
+#if (defined __GNUC__) || (defined __clang__)
+    #define QF_LOG2(n_) ((uint_fast8_t)(63U \
+        - (unsigned)__builtin_clzll((((unsigned long long)(n_)) << 1U) | 1U)))
+#endif
 
 #include "qep_port.h"  /* QEP port */
 #include "qequeue.h"   /* POSIX-QV needs event-queue */
@@ -80,6 +127,36 @@ void QF_leaveCriticalSection_(void);
 */
 void QF_setTickRate(uint32_t ticksPerSec, int_t tickPrio);
 
+/* set the clock tick rate of the additional tick rate 'tickRate' (> 0),
+* which is then ticked by the port with QF_TICK_X()
+* (NOTE ticksPerSec==0 stops ticking this rate)
+*/
+void QF_setTickRateX(uint_fast8_t tickRate, uint32_t ticksPerSec);
+
+#ifdef QF_TICKLESS /* tickless time events? see NOTE3 */
+/* arm the time event to expire in 'nsec' nanoseconds and then every
+* 'intervalNsec' nanoseconds (NOTE intervalNsec==0 for one-shot)
+*/
+void QTimeEvt_armNsec(QTimeEvt * const me,
+                      uint64_t const nsec, uint64_t const intervalNsec);
+
+/* disarm the tickless time event (returns 'true' if it was armed) */
+bool QTimeEvt_disarmNsec(QTimeEvt * const me);
+
+/* rearm the armed tickless time event to expire in 'nsec' nanoseconds */
+bool QTimeEvt_rearmNsec(QTimeEvt * const me, uint64_t const nsec);
+
+/* the number of nanoseconds until the tickless time event expires */
+uint64_t QTimeEvt_currNsec(QTimeEvt const * const me);
+#endif
+
+/* assign the AO priorities prioLo..prioHi to the QV partition 'part'
+* and pin the event-loop thread of the partition to the CPU 'cpu'
+* (NOTE cpu < 0 means no pinning)
+*/
+void QF_setPartition(uint_fast8_t part,
+                     uint_fast16_t prioLo, uint_fast16_t prioHi, int_t cpu);
+
 /* clock tick callback (NOTE not called when "ticker thread" is not running) */
 void QF_onClockTick(void); /* clock tick callback (provided in the app) */
 
@@ -103,10 +180,17 @@ int QF_consoleWaitForKey(void);
         Q_ASSERT((me_)->eQueue.frontEvt != (QEvt *)0)
 
     #define QACTIVE_EQUEUE_SIGNAL_(me_) do { \
-        QPSet_insert(&QV_readySet_, (me_)->prio); \
-        pthread_cond_signal(&QV_condVar_); \
+        QPSet_insert(&QV_PART_(me_)->readySet, (me_)->prio); \
+        pthread_cond_signal(&QV_PART_(me_)->condVar); \
     } while (false)
 
+    /* the QV partition of the active object 'me_' */
+#if (QV_MAX_PARTITIONS > 1U)
+    #define QV_PART_(me_) (&QV_partition_[(me_)->thread])
+#else
+    #define QV_PART_(me_) (&QV_partition_[0])
+#endif
+
     /* native QF event pool operations */
     #define QF_EPOOL_TYPE_            QMPool
     #define QF_EPOOL_INIT_(p_, poolSto_, poolSize_, evtSize_) \
@@ -117,10 +201,28 @@ int QF_consoleWaitForKey(void);
     #define QF_EPOOL_PUT_(p_, e_, qs_id_) \
         (QMPool_put(&(p_), (e_), (qs_id_)))
 
+#ifdef QF_MPOOL_ELASTIC
+    /* virtual memory for the elastic event pools, see NOTE5 */
+    #define QF_MPOOL_RESERVE_(size_)  (QF_memReserve_((size_)))
+    #define QF_MPOOL_COMMIT_(addr_, size_) \
+        (QF_memCommit_((addr_), (size_)))
+    #define QF_MPOOL_DECOMMIT_(addr_, size_) \
+        (QF_memDecommit_((addr_), (size_)))
+
+    void *QF_memReserve_(uint_fast32_t const size);
+    bool QF_memCommit_(void * const addr, uint_fast32_t const size);
+    void QF_memDecommit_(void * const addr, uint_fast32_t const size);
+#endif /* QF_MPOOL_ELASTIC */
+
     #include <pthread.h> /* POSIX-thread API */
 
-    extern QPSet QV_readySet_; /* QV-ready set of active objects */
-    extern pthread_cond_t QV_condVar_; /* Cond.var. to signal events */
+    /*! QV partition (event-loop thread) of the POSIX-QV port */
+    typedef struct {
+        QPSet readySet;         /* QV-ready set of active objects */
+        pthread_cond_t condVar; /* Cond.var. to signal events */
+    } QVPartition;
+
+    extern QVPartition QV_partition_[QV_MAX_PARTITIONS];
 
 #endif /* QP_IMPL */
 
@@ -153,6 +255,56 @@ int QF_consoleWaitForKey(void);
 * also subject to priority inversions. However, the p-thread mutex
 * implementation, such as POSIX threads, should support the priority-
 * inheritance protocol.
+*
+* NOTE2:
+* By default, all active objects are executed by a single QV event loop
+* running in the QF_run() thread. When QV_MAX_PARTITIONS is defined to
+* a value greater than 1 (e.g., on the compiler command line), the
+* application can use QF_setPartition() to assign ranges of AO priorities
+* to up to QV_MAX_PARTITIONS partitions. Each partition has its own QV
+* event loop with its own ready-set and condition variable, executed by
+* its own thread (partition 0 runs in the QF_run() thread), which can be
+* pinned to a given CPU (Linux only). Inside a partition, the AOs are
+* scheduled exactly as in the QV kernel (non-preemptive, highest-priority
+* first). Posting an event wakes up only the partition of the recipient.
+* All partitions share the QF critical section. QF_setPartition() must be
+* called before starting the AOs with the given priorities. AOs with
+* priorities not assigned to any partition belong to partition 0.
+*
+* NOTE3:
+* The tickless mode (macro QF_TICKLESS) allows arming time events with
+* nanosecond deadlines by means of QTimeEvt_armNsec(), which are then
+* timed directly by the ticker thread without any periodic clock tick.
+* The tickless time events must be disarmed, rearmed and queried only
+* with the *Nsec() functions, while the other time events keep using the
+* periodic tick rates. Mixing the two APIs on one time event asserts.
+* In the tickless mode QF_setTickRate() accepts ticksPerSec==0, which
+* stops the periodic ticking of the tick rate 0 (and the QF_onClockTick()
+* callback) altogether. See NOTE08 in qf_port.c.
+*
+* NOTE4:
+* The reference counters of dynamic events are incremented and decremented
+* with the GCC atomic built-ins (see QF_EVT_REF_CTR_ATOMIC in qf_pkg.h),
+* so QF_gc() recycles events without taking the QF critical section mutex,
+* which is contended by all QV partitions. For events referenced by more
+* than 255 event queues at once, configure the wider counter with
+* Q_EVT_REF_CTR_SIZE.
+*
+* NOTE5:
+* The elastic event pools (macro QF_MPOOL_ELASTIC) reserve the address
+* space for their maximum size and commit the memory only as the pools
+* grow (see NOTE03 in ports/posix-common/qf_posix.c). QF_poolTrim() gives
+* the memory back to the OS, so the application can call it periodically
+* (e.g., from a time event of a low-priority AO) to shrink the pools after
+* a spike:
+*
+*     QF_poolInitElastic(sizeof(FrameEvt), 64U, 4096U, 64U, 8U);
+*     ...
+*     case HOUSEKEEPING_SIG: {
+*         (void)QF_poolTrim(1U);
+*         ...
+* The pools grow in the critical section of the pool, so choose nGrow
+* that keeps the growth (a single mprotect() call) infrequent.
 */
 
 #endif /* QF_PORT_H */
@@ -40,6 +40,8 @@
 
 /* expose features from the 2008 POSIX standard (IEEE Standard 1003.1-2008) */
 #define _POSIX_C_SOURCE 200809L
+/* expose the GNU extensions (thread names, CPU affinity, syscall()) */
+#define _GNU_SOURCE
 
 #define QP_IMPL           /* this is QP implementation */
 #include "qf_port.h"      /* QF port */
@@ -62,25 +64,95 @@
 #include <termios.h>
 #include <unistd.h>
 #include <signal.h>
+#include <time.h>         /* for clock_nanosleep() */
+#ifdef __linux__
+#include <linux/mempolicy.h> /* for MPOL_PREFERRED */
+#include <sys/syscall.h>  /* for SYS_mbind */
+#endif
+#ifdef QF_FUTEX_WAKEUP
+#ifndef __linux__
+    #error "QF_FUTEX_WAKEUP requires Linux"
+#endif
+#include <linux/futex.h>  /* for FUTEX_WAIT_PRIVATE/FUTEX_WAKE_PRIVATE */
+#include <sys/syscall.h>  /* for SYS_futex */
+
+/* hint to the CPU that the thread is polling in a spin loop */
+#if (defined __i386__) || (defined __x86_64__)
+    #define QF_CPU_RELAX_()  __builtin_ia32_pause()
+#elif (defined __aarch64__)
+    #define QF_CPU_RELAX_()  __asm__ volatile ("yield" ::: "memory")
+#else
+    #define QF_CPU_RELAX_()  ((void)0)
+#endif
+#endif /* QF_FUTEX_WAKEUP */
 
 Q_DEFINE_THIS_MODULE("qf_port")
 
+/* the size of the huge pages used by QF_stoAlloc(), see NOTE9 in qf_port.h */
+#ifndef QF_HUGEPAGE_SIZE
+#define QF_HUGEPAGE_SIZE     (2U * 1024U * 1024U)
+#endif
+
+/* the maximum number of NUMA nodes known to QF_stoAlloc() */
+#ifndef QF_NUMA_MAX_NODES
+#define QF_NUMA_MAX_NODES    64
+#endif
+
 /* Global objects ==========================================================*/
 pthread_mutex_t QF_pThreadMutex_; /* mutex for QF critical section */
 
 /* Local objects ===========================================================*/
+#ifdef QF_SHARDED_CRIT
+static pthread_mutex_t l_critShard[1U << QF_CRIT_SHARD_BITS]; /* NOTE07 */
+#endif
 static pthread_mutex_t l_startupMutex;
 static bool l_isRunning;      /* flag indicating when QF is running */
 static struct termios l_tsav; /* structure with saved terminal attributes */
-static struct timespec l_tick;
+static uint32_t l_tickPeriod[QF_MAX_TICK_RATE]; /* 0 means not ticked */
+static int64_t l_tickNext[QF_MAX_TICK_RATE]; /* absolute tick deadlines */
+#ifdef Q_SPY
+static uint8_t const l_ticker = 0U; /* QS sender of the port-driven ticks */
+#endif
+#ifdef QF_TICKLESS
+/*! tickless time event in the min-heap of deadlines, see NOTE10 */
+typedef struct {
+    int64_t deadline;  /* absolute deadline [ns] */
+    int64_t interval;  /* period [ns] (0 for one-shot) */
+    QTimeEvt *te;      /* the armed time event */
+} QTicklessTimer;
+static QTicklessTimer l_tickless[QF_TICKLESS_MAX]; /* min-heap */
+static uint_fast16_t l_nTickless;  /* # armed tickless time events */
+static pthread_mutex_t l_ticklessMutex; /* protects the min-heap */
+static pthread_cond_t l_ticklessCond; /* wakes up the ticker */
+#endif
 static int_t l_tickPrio;
+static QF_THREAD_LOCAL bool l_isQfThread; /* AO or ticker thread? */
 enum { NANOSLEEP_NSEC_PER_SEC = 1000000000 }; /* see NOTE05 */
 
+static void tickerStart(void);
+static void tickerSetPeriod(uint_fast8_t const r, uint32_t const period);
+static void tickerWait(void);
+static int64_t tickerNow(void);
+static QEQueueCtr postWaitFree(QActive * const me);
+static void postWaitSignal(QActive * const me);
+#if defined QF_MPSC_QUEUE && defined QF_ACTIVE_GET_BATCH
+static QEvt const *batchPushFront(QActive * const me, QEvt const * const e);
+#endif
+#ifdef QF_TICKLESS
+static void ticklessExpire(int64_t const now);
+static void ticklessUp(uint_fast16_t i);
+static void ticklessDown(uint_fast16_t i);
+static void ticklessRemove(uint_fast16_t const i);
+static bool ticklessIsArmed(QTimeEvt const * const me);
+#endif
 static void sigIntHandler(int dummy);
 
 /* QF functions ============================================================*/
 void QF_init(void) {
     struct sigaction sig_act;
+#ifdef QF_SHARDED_CRIT
+    uint_fast16_t n;
+#endif
 
     /* lock memory so we're never swapped out to disk */
     /*mlockall(MCL_CURRENT | MCL_FUTURE);  uncomment when supported */
@@ -88,6 +160,13 @@ void QF_init(void) {
     /* init the global mutex with the default non-recursive initializer */
     pthread_mutex_init(&QF_pThreadMutex_, NULL);
 
+#ifdef QF_SHARDED_CRIT
+    /* init the per-object mutexes, see NOTE07 */
+    for (n = 0U; n < Q_DIM(l_critShard); ++n) {
+        pthread_mutex_init(&l_critShard[n], NULL);
+    }
+#endif
+
     /* init the startup mutex with the default non-recursive initializer */
     pthread_mutex_init(&l_startupMutex, NULL);
 
@@ -96,10 +175,21 @@ void QF_init(void) {
     */
     pthread_mutex_lock(&l_startupMutex);
 
-    l_tick.tv_sec = 0;
-    l_tick.tv_nsec = NANOSLEEP_NSEC_PER_SEC/100L; /* default clock tick */
+    l_tickPeriod[0] = (uint32_t)NANOSLEEP_NSEC_PER_SEC/100U; /* default */
     l_tickPrio = sched_get_priority_min(SCHED_FIFO); /* default tick prio */
 
+#ifdef QF_TICKLESS
+    /* the tickless deadlines are measured by the monotonic clock */
+    {
+        pthread_condattr_t attr;
+        pthread_condattr_init(&attr);
+        pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+        pthread_cond_init(&l_ticklessCond, &attr);
+        pthread_condattr_destroy(&attr);
+    }
+    pthread_mutex_init(&l_ticklessMutex, NULL);
+#endif
+
     /* install the SIGINT (Ctrl-C) signal handler */
     sig_act.sa_handler = &sigIntHandler;
     sigaction(SIGINT, &sig_act, NULL);
@@ -113,10 +203,28 @@ void QF_enterCriticalSection_(void) {
 void QF_leaveCriticalSection_(void) {
     pthread_mutex_unlock(&QF_pThreadMutex_);
 }
+#ifdef QF_SHARDED_CRIT
+/****************************************************************************/
+pthread_mutex_t *QF_critLock_(void const * const obj) {
+#ifndef Q_SPY
+    if (obj != (void *)0) {
+        /* Fibonacci hashing of the object address, see NOTE07 */
+        uint32_t h = (uint32_t)((uintptr_t)obj >> 3) * 0x9E3779B9U;
+        return &l_critShard[h >> (32U - QF_CRIT_SHARD_BITS)];
+    }
+#else
+    (void)obj; /* QS trace buffer needs the global mutex, see NOTE07 */
+#endif
+    return &QF_pThreadMutex_;
+}
+#endif /* QF_SHARDED_CRIT */
 
 /****************************************************************************/
 int_t QF_run(void) {
     struct sched_param sparam;
+#ifdef QF_SHARDED_CRIT
+    uint_fast16_t n;
+#endif
 
     QF_onStartup();  /* invoke startup callback */
 
@@ -138,27 +246,66 @@ int_t QF_run(void) {
     */
     pthread_mutex_unlock(&l_startupMutex);
 
+    l_isQfThread = true; /* the ticker thread, see QActive_postWait_() */
     l_isRunning = true;
+    tickerStart();
     while (l_isRunning) { /* the clock tick loop... */
-        QF_onClockTick(); /* clock tick callback (must call QF_TICK_X()) */
-
-        nanosleep(&l_tick, NULL); /* sleep for the number of ticks, NOTE05 */
+        tickerWait(); /* wait for and deliver the due ticks, NOTE05, NOTE09 */
     }
+#ifdef QF_EVT_MAGAZINE
+    QF_magazineFlush(); /* return the cached events of this thread */
+#endif
     QF_onCleanup(); /* invoke cleanup callback */
+    /* NOTE: the waitMutex and notFull of the AOs still running are not
+    * destroyed here, because their detached threads may still use them.
+    * They are destroyed when the AO thread exits (QF_ACTIVE_STOP).
+    */
     pthread_mutex_destroy(&l_startupMutex);
     pthread_mutex_destroy(&QF_pThreadMutex_);
+#ifdef QF_TICKLESS
+    pthread_cond_destroy(&l_ticklessCond);
+    pthread_mutex_destroy(&l_ticklessMutex);
+#endif
+#ifdef QF_SHARDED_CRIT
+    for (n = 0U; n < Q_DIM(l_critShard); ++n) {
+        pthread_mutex_destroy(&l_critShard[n]);
+    }
+#endif
 
     return 0; /* return success */
 }
 /*..........................................................................*/
 void QF_setTickRate(uint32_t ticksPerSec, int_t tickPrio) {
+#ifdef QF_TICKLESS
+    /* in the tickless mode the periodic tick rate 0 can be stopped */
+    tickerSetPeriod(0U, (ticksPerSec != 0U)
+                        ? (uint32_t)NANOSLEEP_NSEC_PER_SEC / ticksPerSec
+                        : 0U);
+#else
     Q_REQUIRE_ID(300, ticksPerSec != 0U);
-    l_tick.tv_nsec = NANOSLEEP_NSEC_PER_SEC / ticksPerSec;
+    tickerSetPeriod(0U, (uint32_t)NANOSLEEP_NSEC_PER_SEC / ticksPerSec);
+#endif
     l_tickPrio = tickPrio;
 }
+/*..........................................................................*/
+void QF_setTickRateX(uint_fast8_t tickRate, uint32_t ticksPerSec) {
+    /** @pre the tick rate must be ticked by QF_TICK_X() from the port */
+    Q_REQUIRE_ID(310, (0U < tickRate) && (tickRate < QF_MAX_TICK_RATE));
+    tickerSetPeriod(tickRate, (ticksPerSec != 0U)
+                    ? (uint32_t)NANOSLEEP_NSEC_PER_SEC / ticksPerSec
+                    : 0U);
+}
+
 /*..........................................................................*/
 void QF_stop(void) {
     l_isRunning = false; /* stop the loop in QF_run() */
+
+#ifdef QF_TICKLESS
+    /* unblock the ticker waiting for the tickless deadlines */
+    pthread_mutex_lock(&l_ticklessMutex);
+    pthread_cond_signal(&l_ticklessCond);
+    pthread_mutex_unlock(&l_ticklessMutex);
+#endif
 }
 
 /*..........................................................................*/
@@ -190,6 +337,168 @@ int QF_consoleWaitForKey(void) {
     return getchar();
 }
 
+/****************************************************************************/
+/* storage for event pools and event queues, see NOTE9 in qf_port.h */
+void *QF_stoAlloc(size_t const size, int const numaNode) {
+    size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    size_t len = (size + pageSize - 1U) & ~(pageSize - 1U);
+    void *sto = MAP_FAILED;
+    size_t i;
+
+    /** @pre the size must be non-zero and the NUMA node in range */
+    Q_REQUIRE_ID(920, (size != 0U) && (numaNode < QF_NUMA_MAX_NODES));
+
+#ifdef MAP_HUGETLB
+    if (size >= QF_HUGEPAGE_SIZE) { /* worth at least one huge page? */
+        size_t const hugeLen = (size + QF_HUGEPAGE_SIZE - 1U)
+                               & ~((size_t)QF_HUGEPAGE_SIZE - 1U);
+        sto = mmap((void *)0, hugeLen, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (sto != MAP_FAILED) {
+            len = hugeLen;
+            pageSize = QF_HUGEPAGE_SIZE;
+        }
+    }
+#endif /* MAP_HUGETLB */
+
+    if (sto == MAP_FAILED) { /* no huge pages reserved? use normal pages */
+        sto = mmap((void *)0, len, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        /* the storage must be mapped */
+        Q_ASSERT_ID(930, sto != MAP_FAILED);
+
+#ifdef MADV_HUGEPAGE
+        if (len >= QF_HUGEPAGE_SIZE) {
+            /* ask for the transparent huge pages instead */
+            (void)madvise(sto, len, MADV_HUGEPAGE);
+        }
+#endif
+    }
+
+#ifdef __linux__
+    if (numaNode >= 0) { /* bind the storage to the NUMA node? */
+        unsigned long nodeMask[(QF_NUMA_MAX_NODES + (8 * sizeof(long)) - 1U)
+                               / (8 * sizeof(long))];
+        memset(nodeMask, 0, sizeof(nodeMask));
+        nodeMask[(size_t)numaNode / (8U * sizeof(long))] =
+            (1UL << ((size_t)numaNode % (8U * sizeof(long))));
+
+        /* failure (e.g., kernel without NUMA) leaves the default policy */
+        (void)syscall(SYS_mbind, sto, len, MPOL_PREFERRED, nodeMask,
+                      (unsigned long)(8U * sizeof(nodeMask)) + 1UL, 0U);
+    }
+#endif /* __linux__ */
+
+    /* prefault the pages (after binding, so they land on the NUMA node) */
+    for (i = 0U; i < len; i += pageSize) {
+        ((uint8_t volatile *)sto)[i] = 0U;
+    }
+    return sto;
+}
+/*..........................................................................*/
+int QF_numaNodeOfCpu(int const cpu) {
+    int node = -1;
+#ifdef __linux__
+    int n;
+    for (n = 0; (n < QF_NUMA_MAX_NODES) && (node < 0); ++n) {
+        char path[64];
+        snprintf(path, sizeof(path),
+                 "/sys/devices/system/node/node%d/cpu%d", n, cpu);
+        if (access(path, F_OK) == 0) {
+            node = n;
+        }
+    }
+#else
+    (void)cpu; /* unused parameter */
+#endif /* __linux__ */
+    return node;
+}
+/*..........................................................................*/
+int QActive_numaNode(QActive const * const me) {
+    int node = -1;
+#ifdef __linux__
+    if (me->thread.cpuSet != (void *)0) { /* CPU affinity set? */
+        cpu_set_t const *cpuSet = (cpu_set_t const *)me->thread.cpuSet;
+        int cpu;
+        for (cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, cpuSet)) { /* the first CPU of the AO */
+                node = QF_numaNodeOfCpu(cpu);
+                break;
+            }
+        }
+    }
+#else
+    (void)me; /* unused parameter */
+#endif /* __linux__ */
+    return node;
+}
+
+/****************************************************************************/
+/* map the QF priority to the p-thread priority of the policy, see NOTE04 */
+static int pthreadPrio(int const policy, uint_fast16_t const prio) {
+    int const hi = sched_get_priority_max(policy) - 3; /* 3 reserved */
+    int const lo = sched_get_priority_min(policy);
+    int p;
+    if ((hi - lo) >= (int)QF_MAX_ACTIVE) { /* one level per QF prio? */
+        p = (int)prio + (hi - (int)QF_MAX_ACTIVE);
+    }
+    else { /* spread the QF priorities evenly over the available levels */
+        p = lo + (int)(((uint_fast32_t)(prio - 1U)
+                        * (uint_fast32_t)(hi - lo + 1))
+                       / (uint_fast32_t)QF_MAX_ACTIVE);
+    }
+    return p;
+}
+/*..........................................................................*/
+void QFSchedLock_(QFSchedLock * const lockStat, uint_fast16_t prio) {
+    struct sched_param param;
+    int policy;
+
+    lockStat->lockPrio = 0U; /* assume that the scheduler is not locked */
+
+    /* only the SCHED_FIFO threads can be protected, see NOTE7 in qf_port.h */
+    if ((pthread_getschedparam(pthread_self(), &policy, &param) == 0)
+        && (policy == SCHED_FIFO))
+    {
+        int const lockPrio = pthreadPrio(SCHED_FIFO, prio);
+
+        if (param.sched_priority < lockPrio) { /* must raise the prio? */
+            lockStat->prevPrio = param.sched_priority;
+            param.sched_priority = lockPrio;
+            if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param)
+                == 0)
+            {
+                QS_CRIT_STAT_
+                lockStat->lockPrio = prio;
+
+                QS_BEGIN_PRE_(QS_SCHED_LOCK, 0U)
+                    QS_TIME_PRE_(); /* timestamp */
+                    QS_2PRIO_PRE_(0U, prio); /* the prev and new lock prio */
+                QS_END_PRE_()
+            }
+        }
+    }
+}
+/*..........................................................................*/
+void QFSchedUnlock_(QFSchedLock const * const lockStat) {
+    struct sched_param param;
+    QS_CRIT_STAT_
+
+    /** @pre the scheduler must be locked */
+    Q_REQUIRE_ID(420, lockStat->lockPrio != 0U);
+
+    QS_BEGIN_PRE_(QS_SCHED_UNLOCK, 0U)
+        QS_TIME_PRE_(); /* timestamp */
+        QS_2PRIO_PRE_(lockStat->lockPrio, 0U); /* prev and new lock prio */
+    QS_END_PRE_()
+
+    /* restore the previous priority of the lock holder */
+    param.sched_priority = lockStat->prevPrio;
+    Q_ALLEGE_ID(430,
+        pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0);
+}
+
 /****************************************************************************/
 static void *thread_routine(void *arg) { /* the expected POSIX signature */
     QActive *act = (QActive *)arg;
@@ -198,25 +507,58 @@ static void *thread_routine(void *arg) { /* the expected POSIX signature */
     pthread_mutex_lock(&l_startupMutex);
     pthread_mutex_unlock(&l_startupMutex);
 
+    l_isQfThread = true; /* this thread runs the AO (QActive_postWait_()) */
+
+#ifdef __linux__
+    if (act->thread.name != (char const *)0) { /* thread name set? */
+        char name[16]; /* Linux limits the names to 15 characters + '\0' */
+        strncpy(name, act->thread.name, sizeof(name) - 1U);
+        name[sizeof(name) - 1U] = '\0';
+        pthread_setname_np(pthread_self(), name);
+    }
+#endif
+
 #ifdef QF_ACTIVE_STOP
-    act->thread = true;
-    while (act->thread)
+    act->thread.isRunning = true;
+    while (act->thread.isRunning)
 #else
     for (;;) /* for-ever */
 #endif
     {
+#ifdef QF_ACTIVE_GET_BATCH /* batched event dispatch? see NOTE11 */
+        QEvt const *batch[QF_ACTIVE_GET_BATCH];
+        QEvt const *e;
+        (void)QActive_getBatch_(act, batch, Q_DIM(batch));
+        postWaitSignal(act); /* the queue has more free entries now */
+        for (e = QActive_batchNext_(act); /* the RTC steps back-to-back */
+             e != (QEvt *)0;
+             e = QActive_batchNext_(act))
+        {
+            if (act->thread.isRunning) { /* not stopped in this batch? */
+                QHSM_DISPATCH(&act->super, e, act->prio);
+            }
+            QF_gc(e); /* check if the event is garbage, and collect it */
+        }
+#else
         QEvt const *e = QActive_get_(act); /* wait for the event */
+        postWaitSignal(act); /* the queue has one more free entry now */
         QHSM_DISPATCH(&act->super, e, act->prio); /* dispatch to the HSM */
         QF_gc(e); /* check if the event is garbage, and collect it if so */
+#endif
     }
+#ifdef QF_EVT_MAGAZINE
+    QF_magazineFlush(); /* return the cached events of this thread */
+#endif
 #ifdef QF_ACTIVE_STOP
     QF_remove_(act); /* remove this object from QF */
+    pthread_cond_destroy(&act->thread.notFull);
+    pthread_mutex_destroy(&act->thread.waitMutex);
 #endif
     return (void *)0; /* return success */
 }
 
 /****************************************************************************/
-void QActive_start_(QActive * const me, uint_fast8_t prio,
+void QActive_start_(QActive * const me, uint_fast16_t prio,
                     QEvt const * * const qSto, uint_fast16_t const qLen,
                     void * const stkSto, uint_fast16_t const stkSize,
                     void const * const par)
@@ -224,19 +566,47 @@ void QActive_start_(QActive * const me, uint_fast8_t prio,
     pthread_t thread;
     pthread_attr_t attr;
     struct sched_param param;
+    int policy;
+    size_t stkBytes;
     int err;
+    bool isQfThread;
 
     /* p-threads allocate stack internally */
     Q_REQUIRE_ID(600, stkSto == (void *)0);
 
+#ifdef QF_MPSC_QUEUE
+    QMPSCQueue_init(&me->eQueue, qSto, qLen);
+#else
     QEQueue_init(&me->eQueue, qSto, qLen);
+#endif
+#ifdef QF_FUTEX_WAKEUP
+    QFutexWakeup_init(&me->osObject);
+#elif (defined QF_MPSC_QUEUE)
+    pthread_mutex_init(&me->osObject.mutex, NULL);
+    pthread_cond_init(&me->osObject.cond, NULL);
+    me->osObject.waiting = 0;
+#else
     pthread_cond_init(&me->osObject, NULL);
+#endif
+    pthread_mutex_init(&me->thread.waitMutex, NULL);
+    {
+        pthread_condattr_t cattr; /* the timeouts use the monotonic clock */
+        pthread_condattr_init(&cattr);
+        pthread_condattr_setclock(&cattr, CLOCK_MONOTONIC);
+        pthread_cond_init(&me->thread.notFull, &cattr);
+        pthread_condattr_destroy(&cattr);
+    }
 
-    me->prio = (uint8_t)prio;
+    me->prio = (QPrio)prio;
     QF_add_(me); /* make QF aware of this active object */
 
-    /* the top-most initial tran. (virtual) */
+    /* the top-most initial tran. (virtual), which runs like the AO thread
+    * (QActive_postWait_()), even when called from a non-AO thread
+    */
+    isQfThread = l_isQfThread;
+    l_isQfThread = true;
     QHSM_INIT(&me->super, par, me->prio);
+    l_isQfThread = isQfThread;
     QS_FLUSH(); /* flush the trace buffer to the host */
 
     pthread_attr_init(&attr);
@@ -244,22 +614,50 @@ void QActive_start_(QActive * const me, uint_fast8_t prio,
     /* SCHED_FIFO corresponds to real-time preemptive priority-based scheduler
     * NOTE: This scheduling policy requires the superuser privileges
     */
-    pthread_attr_setschedpolicy (&attr, SCHED_FIFO);
+    policy = ((me->thread.attrs & (1U << SCHED_POLICY_ATTR)) != 0U)
+             ? me->thread.policy
+             : SCHED_FIFO;
+    pthread_attr_setschedpolicy (&attr, policy);
     pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
     pthread_attr_setdetachstate (&attr, PTHREAD_CREATE_DETACHED);
 
     /* priority of the p-thread, see NOTE04 */
-    param.sched_priority = prio
-                           + (sched_get_priority_max(SCHED_FIFO)
-                              - QF_MAX_ACTIVE - 3U);
+    if ((me->thread.attrs & (1U << SCHED_PRIO_ATTR)) != 0U) {
+        param.sched_priority = me->thread.prio;
+    }
+    else if ((policy == SCHED_FIFO) || (policy == SCHED_RR)) {
+        param.sched_priority = pthreadPrio(policy, prio);
+    }
+    else {
+        param.sched_priority = 0;
+    }
     pthread_attr_setschedparam(&attr, &param);
 
-    pthread_attr_setstacksize(&attr, (stkSize < PTHREAD_STACK_MIN
-                                      ? PTHREAD_STACK_MIN
-                                      : stkSize));
+    stkBytes = ((me->thread.attrs & (1U << STACK_SIZE_ATTR)) != 0U)
+               ? me->thread.stkSize
+               : (size_t)stkSize;
+    if (stkBytes < (size_t)PTHREAD_STACK_MIN) {
+        stkBytes = (size_t)PTHREAD_STACK_MIN;
+    }
+#ifdef QF_EVT_MAGAZINE
+    /* the thread-local event magazines are carved from the stack, NOTE12 */
+    stkBytes += QF_MAX_EPOOL * (QF_EVT_MAGAZINE + 1U) * sizeof(void *);
+#endif
+    pthread_attr_setstacksize(&attr, stkBytes);
+
+#ifdef __linux__
+    if (me->thread.cpuSet != (void *)0) { /* CPU affinity set? */
+        err = pthread_attr_setaffinity_np(&attr, sizeof(cpu_set_t),
+                  (cpu_set_t const *)me->thread.cpuSet);
+        Q_ASSERT_ID(620, err == 0); /* CPU affinity must be accepted */
+    }
+#endif
 
     err = pthread_create(&thread, &attr, &thread_routine, me);
-    if (err != 0) {
+    if ((err != 0)
+        && ((me->thread.attrs & ((1U << SCHED_POLICY_ATTR)
+                                 | (1U << SCHED_PRIO_ATTR))) == 0U))
+    {
         /* Creating p-thread with the SCHED_FIFO policy failed. Most likely
         * this application has no superuser privileges, so we just fall
         * back to the default SCHED_OTHER policy and priority 0.
@@ -280,17 +678,654 @@ void QActive_start_(QActive * const me, uint_fast8_t prio,
 #ifdef QF_ACTIVE_STOP
 void QActive_stop(QActive * const me) {
     QActive_unsubscribeAll(me); /* unsubscribe this AO from all events */
-    me->thread = false; /* stop the thread loop (see thread_routine()) */
+    me->thread.isRunning = false; /* stop the thread loop (thread_routine) */
 }
 #endif
 /*..........................................................................*/
 void QActive_setAttr(QActive *const me, uint32_t attr1, void const *attr2) {
-    (void)me;    /* unused parameter */
-    (void)attr1; /* unused parameter */
-    (void)attr2; /* unused parameter */
-    Q_ERROR_ID(900); /* this function should not be called in this QP port */
+    /** @pre the attributes must be set before starting the AO and
+    * the attribute value must be provided, see NOTE5 in qf_port.h
+    */
+    Q_REQUIRE_ID(900, (me->prio == 0U)
+                      && (attr2 != (void *)0));
+
+    switch (attr1) {
+#ifdef __linux__
+        case THREAD_NAME_ATTR:
+            me->thread.name = (char const *)attr2;
+            break;
+        case CPU_AFFINITY_ATTR:
+            me->thread.cpuSet = attr2;
+            break;
+#endif
+        case SCHED_POLICY_ATTR:
+            me->thread.policy = *(int const *)attr2;
+            break;
+        case SCHED_PRIO_ATTR:
+            me->thread.prio = *(int const *)attr2;
+            break;
+        case STACK_SIZE_ATTR:
+            me->thread.stkSize = *(size_t const *)attr2;
+            break;
+        default:
+            Q_ERROR_ID(910); /* attribute not supported in this QP port */
+            break;
+    }
+    me->thread.attrs |= (uint8_t)(1U << attr1);
 }
 
+/****************************************************************************/
+/* post with waiting for the free entries in the queue, NOTE11 in qf_port.h */
+#ifdef Q_SPY
+bool QActive_postWait_(QActive * const me, QEvt const * const e,
+                       uint_fast16_t const margin, uint64_t const nsec,
+                       void const * const sender)
+#else
+bool QActive_postWait_(QActive * const me, QEvt const * const e,
+                       uint_fast16_t const margin, uint64_t const nsec)
+#endif
+{
+    int64_t const start = tickerNow();
+    /* the absolute deadline saturates at INT64_MAX (practically forever) */
+    int64_t const deadline = (nsec < (uint64_t)(INT64_MAX - start))
+                             ? (start + (int64_t)nsec)
+                             : INT64_MAX;
+    struct timespec ts;
+    bool waited = false;
+    bool status;
+    int err = 0;
+    QS_CRIT_STAT_
+
+    /** @pre must not be called from an AO thread (it would block the AO),
+    * the event must be valid and the margin cannot be #QF_NO_MARGIN
+    */
+    Q_REQUIRE_ID(940, (!l_isQfThread)
+                      && (e != (QEvt *)0)
+                      && (margin != QF_NO_MARGIN)
+                      && (nsec < (uint64_t)INT64_MAX));
+
+    ts.tv_sec  = (time_t)(deadline / NANOSLEEP_NSEC_PER_SEC);
+    ts.tv_nsec = (long)(deadline % NANOSLEEP_NSEC_PER_SEC);
+
+    /* is it a dynamic event? */
+    if (e->poolId_ != 0U) {
+        /* keep the event across the attempts that fail to post it */
+        QF_EVT_REF_CTR_INC_(e);
+    }
+
+    do {
+        /* must wait for the free entries in the queue? */
+        if (postWaitFree(me) <= (QEQueueCtr)margin) {
+            pthread_mutex_lock(&me->thread.waitMutex);
+            (void)__atomic_add_fetch(&me->thread.nPostWait, 1,
+                                     __ATOMIC_SEQ_CST);
+            while ((err == 0) && (postWaitFree(me) <= (QEQueueCtr)margin)) {
+                waited = true;
+                err = pthread_cond_timedwait(&me->thread.notFull,
+                                             &me->thread.waitMutex, &ts);
+            }
+            (void)__atomic_sub_fetch(&me->thread.nPostWait, 1,
+                                     __ATOMIC_RELAXED);
+            pthread_mutex_unlock(&me->thread.waitMutex);
+        }
+
+        /* can still fail when other producers take the free entries */
+#ifdef Q_SPY
+        status = QActive_post_(me, e, margin, sender);
+#else
+        status = QActive_post_(me, e, margin);
+#endif
+    } while ((!status) && (err == 0));
+
+    if (waited) {
+        QS_BEGIN_PRE_(QS_QF_ACTIVE_POST_WAIT, me->prio)
+            QS_TIME_PRE_();      /* timestamp */
+            QS_OBJ_PRE_(sender); /* the sender object */
+            QS_SIG_PRE_(e->sig); /* the signal of the event */
+            QS_OBJ_PRE_(me);     /* this active object (recipient) */
+            QS_U32_PRE_((tickerNow() - start) / 1000); /* wait time [us] */
+            QS_U8_PRE_(status);  /* was the event posted? */
+        QS_END_PRE_()
+    }
+
+    QF_gc(e); /* drop the reference held above (recycle if not posted) */
+
+    return status;
+}
+/*..........................................................................*/
+/* the number of free entries in the event queue of the AO */
+static QEQueueCtr postWaitFree(QActive * const me) {
+#ifdef QF_MPSC_QUEUE
+    return __atomic_load_n(&me->eQueue.nFree, __ATOMIC_SEQ_CST);
+#else
+    QEQueueCtr nFree;
+    QF_CRIT_STAT_
+    QF_CRIT_OBJ_E_(&me->eQueue);
+    nFree = me->eQueue.nFree;
+    QF_CRIT_X_();
+    return nFree;
+#endif
+}
+/*..........................................................................*/
+/* wake up the producers waiting in QActive_postWait_() (consumer side) */
+static void postWaitSignal(QActive * const me) {
+#ifdef QF_MPSC_QUEUE
+    /* order the load of 'nPostWait' after freeing the slots, NOTE11 */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+#endif
+    if (__atomic_load_n(&me->thread.nPostWait, __ATOMIC_RELAXED) != 0) {
+        pthread_mutex_lock(&me->thread.waitMutex);
+        pthread_cond_broadcast(&me->thread.notFull);
+        pthread_mutex_unlock(&me->thread.waitMutex);
+    }
+}
+
+/****************************************************************************/
+#ifdef QF_FUTEX_WAKEUP /* futex-based AO wakeup? see NOTE08 */
+
+void QFutexWakeup_init(QFutexWakeup * const me) {
+    me->seq    = 0U;
+    me->parked = 0U;
+    me->spin   = QF_WAKEUP_SPIN;
+}
+/*..........................................................................*/
+uint32_t QFutexWakeup_seq(QFutexWakeup * const me) {
+    return __atomic_load_n(&me->seq, __ATOMIC_ACQUIRE);
+}
+/*..........................................................................*/
+void QFutexWakeup_wait(QFutexWakeup * const me, uint32_t const seq) {
+    uint32_t n;
+
+    /* spin phase... */
+    for (n = 0U; n < me->spin; ++n) {
+        if (__atomic_load_n(&me->seq, __ATOMIC_ACQUIRE) != seq) {
+            /* spinning paid off, allow spinning longer next time */
+            me->spin = 2U * me->spin;
+            if (me->spin > QF_WAKEUP_SPIN) {
+                me->spin = QF_WAKEUP_SPIN;
+            }
+            return;
+        }
+        QF_CPU_RELAX_();
+    }
+
+    /* spinning did not pay off, spin shorter next time */
+    me->spin = ((me->spin / 2U) > QF_WAKEUP_SPIN_MIN)
+               ? (me->spin / 2U)
+               : QF_WAKEUP_SPIN_MIN;
+
+    /* park phase... */
+    __atomic_store_n(&me->parked, 1U, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST); /* see NOTE08 */
+    while (__atomic_load_n(&me->seq, __ATOMIC_ACQUIRE) == seq) {
+        /* the kernel blocks only if 'seq' still holds the expected value */
+        (void)syscall(SYS_futex, &me->seq, FUTEX_WAIT_PRIVATE, seq,
+                      NULL, NULL, 0);
+    }
+    __atomic_store_n(&me->parked, 0U, __ATOMIC_RELAXED);
+}
+/*..........................................................................*/
+void QFutexWakeup_signal(QFutexWakeup * const me) {
+    (void)__atomic_add_fetch(&me->seq, 1U, __ATOMIC_RELEASE);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST); /* see NOTE08 */
+    if (__atomic_load_n(&me->parked, __ATOMIC_RELAXED) != 0U) {
+        (void)syscall(SYS_futex, &me->seq, FUTEX_WAKE_PRIVATE, 1,
+                      NULL, NULL, 0);
+    }
+}
+
+#endif /* QF_FUTEX_WAKEUP */
+
+/****************************************************************************/
+#ifdef QF_MPSC_QUEUE /* lock-free AO event queues? see NOTE06 */
+
+void QMPSCQueue_init(QMPSCQueue * const me, QEvt const * * const qSto,
+                     uint_fast16_t const qLen)
+{
+    uint_fast16_t n;
+
+    /** @pre the ring buffer must provide at least one slot */
+    Q_REQUIRE_ID(700, (qSto != (QEvt const **)0) && (qLen != 0U));
+
+    for (n = 0U; n < qLen; ++n) {
+        qSto[n] = (QEvt *)0; /* all slots empty */
+    }
+    me->ring  = qSto;
+    me->end   = (QEQueueCtr)qLen;
+    me->head  = 0U;
+    me->tail  = 0U;
+    me->nFree = (QEQueueCtr)qLen;
+    me->nMin  = (QEQueueCtr)qLen;
+}
+/*..........................................................................*/
+/* reserve 'n' slots in the queue; returns the # free slots left or -1 */
+static int_fast32_t mpscReserve(QMPSCQueue * const q, QEQueueCtr const n,
+                                uint_fast16_t const margin)
+{
+    QEQueueCtr nFree = __atomic_load_n(&q->nFree, __ATOMIC_RELAXED);
+    QEQueueCtr nMin;
+
+    do {
+        if ((nFree < n)
+            || ((margin != QF_NO_MARGIN)
+                && ((QEQueueCtr)(nFree - n) < (QEQueueCtr)margin)))
+        {
+            return -1; /* not enough free slots */
+        }
+    } while (!__atomic_compare_exchange_n(&q->nFree, &nFree, nFree - n,
+                 false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED));
+    nFree -= n; /* the free slots just used up */
+
+    /* update the low-watermark of the queue */
+    nMin = __atomic_load_n(&q->nMin, __ATOMIC_RELAXED);
+    while ((nMin > nFree)
+           && !__atomic_compare_exchange_n(&q->nMin, &nMin, nFree,
+                   false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+    }
+    return (int_fast32_t)nFree;
+}
+/*..........................................................................*/
+/* wake up the AO thread if it waits for events (producer side) */
+static void mpscSignal(QActive * const me) {
+#ifdef QF_FUTEX_WAKEUP
+    QFutexWakeup_signal(&me->osObject);
+#else
+    /* order the slot store before the load of 'waiting', see NOTE06 */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&me->osObject.waiting, __ATOMIC_RELAXED) != 0) {
+        pthread_mutex_lock(&me->osObject.mutex);
+        pthread_cond_signal(&me->osObject.cond);
+        pthread_mutex_unlock(&me->osObject.mutex);
+    }
+#endif
+}
+/*..........................................................................*/
+#ifdef Q_SPY
+bool QActive_post_(QActive * const me, QEvt const * const e,
+                   uint_fast16_t const margin, void const * const sender)
+#else
+bool QActive_post_(QActive * const me, QEvt const * const e,
+                   uint_fast16_t const margin)
+#endif
+{
+    QMPSCQueue * const q = &me->eQueue;
+    int_fast32_t nFree;
+    QS_CRIT_STAT_
+
+    /** @pre event pointer must be valid */
+    Q_REQUIRE_ID(710, e != (QEvt *)0);
+
+    /* is it a dynamic event? */
+    if (e->poolId_ != 0U) {
+        QF_EVT_REF_CTR_INC_(e); /* increment the reference counter */
+    }
+
+    nFree = mpscReserve(q, 1U, margin);
+    if (nFree >= 0) { /* slot reserved? */
+        QEQueueCtr head = __atomic_load_n(&q->head, __ATOMIC_RELAXED);
+        QEQueueCtr next;
+
+        QS_BEGIN_PRE_(QS_QF_ACTIVE_POST, me->prio)
+            QS_TIME_PRE_();               /* timestamp */
+            QS_OBJ_PRE_(sender);          /* the sender object */
+            QS_SIG_PRE_(e->sig);          /* the signal of the event */
+            QS_OBJ_PRE_(me);              /* this active object (recipient) */
+            QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
+            QS_EQC_PRE_(nFree);           /* number of free entries */
+            QS_EQC_PRE_(q->nMin);         /* min number of free entries */
+        QS_END_PRE_()
+
+        /* claim the slot at the head (counter clockwise, as QEQueue) */
+        do {
+            next = (head == 0U) ? (q->end - 1U) : (head - 1U);
+        } while (!__atomic_compare_exchange_n(&q->head, &head, next,
+                     false, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+        /* publish the event to the consumer */
+        __atomic_store_n(&QF_PTR_AT_(q->ring, head), e, __ATOMIC_RELEASE);
+
+        mpscSignal(me);
+        return true;
+    }
+
+    /* must be able to post the event */
+    Q_ASSERT_ID(720, margin != QF_NO_MARGIN);
+
+    QS_BEGIN_PRE_(QS_QF_ACTIVE_POST_ATTEMPT, me->prio)
+        QS_TIME_PRE_();       /* timestamp */
+        QS_OBJ_PRE_(sender);  /* the sender object */
+        QS_SIG_PRE_(e->sig);  /* the signal of the event */
+        QS_OBJ_PRE_(me);      /* this active object (recipient) */
+        QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
+        QS_EQC_PRE_(__atomic_load_n(&q->nFree, __ATOMIC_RELAXED));
+        QS_EQC_PRE_(margin);  /* margin requested */
+    QS_END_PRE_()
+
+    QF_gc(e); /* recycle the event to avoid a leak */
+    return false;
+}
+/*..........................................................................*/
+#ifdef Q_SPY
+bool QActive_postBatch_(QActive * const me, QEvt const * const batch[],
+                        uint_fast16_t const n, uint_fast16_t const margin,
+                        void const * const sender)
+#else
+bool QActive_postBatch_(QActive * const me, QEvt const * const batch[],
+                        uint_fast16_t const n, uint_fast16_t const margin)
+#endif
+{
+    QMPSCQueue * const q = &me->eQueue;
+    int_fast32_t nFree;
+    uint_fast16_t i;
+    QS_CRIT_STAT_
+
+    /** @pre the batch must contain at least one event and the AO must
+    * not override the post operation (e.g., ::QTicker)
+    */
+    Q_REQUIRE_ID(760, (batch != (QEvt const * const *)0) && (n != 0U)
+                      && QACTIVE_HAS_QF_POST_(me));
+
+    for (i = 0U; i < n; ++i) {
+        /* is it a dynamic event? */
+        if (batch[i]->poolId_ != 0U) {
+            QF_EVT_REF_CTR_INC_(batch[i]); /* increment the reference ctr */
+        }
+    }
+
+    /* reserve the slots for the whole batch at once, see NOTE06 */
+    nFree = mpscReserve(q, (QEQueueCtr)n, margin);
+    if (nFree >= 0) { /* slots reserved? */
+        QEQueueCtr head = __atomic_load_n(&q->head, __ATOMIC_RELAXED);
+        QEQueueCtr next;
+
+        for (i = 0U; i < n; ++i) {
+            QS_BEGIN_PRE_(QS_QF_ACTIVE_POST, me->prio)
+                QS_TIME_PRE_();          /* timestamp */
+                QS_OBJ_PRE_(sender);     /* the sender object */
+                QS_SIG_PRE_(batch[i]->sig); /* the signal of the event */
+                QS_OBJ_PRE_(me);         /* this active object (recipient) */
+                QS_2U8_PRE_(batch[i]->poolId_, batch[i]->refCtr_);
+                QS_EQC_PRE_((QEQueueCtr)nFree + (QEQueueCtr)(n - 1U - i));
+                QS_EQC_PRE_(q->nMin);    /* min number of free entries */
+            QS_END_PRE_()
+        }
+
+        /* claim 'n' consecutive slots at the head (counter clockwise) */
+        do {
+            next = (head >= (QEQueueCtr)n)
+                   ? (QEQueueCtr)(head - n)
+                   : (QEQueueCtr)(head + q->end - n);
+        } while (!__atomic_compare_exchange_n(&q->head, &head, next,
+                     false, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+        /* publish the events to the consumer in the FIFO order */
+        for (i = 0U; i < n; ++i) {
+            __atomic_store_n(&QF_PTR_AT_(q->ring, head), batch[i],
+                             __ATOMIC_RELEASE);
+            head = (head == 0U) ? (q->end - 1U) : (head - 1U);
+        }
+
+        mpscSignal(me); /* signal the consumer once per batch */
+        return true;
+    }
+
+    /* must be able to post the events */
+    Q_ASSERT_ID(770, margin != QF_NO_MARGIN);
+
+    for (i = 0U; i < n; ++i) {
+        QS_BEGIN_PRE_(QS_QF_ACTIVE_POST_ATTEMPT, me->prio)
+            QS_TIME_PRE_();       /* timestamp */
+            QS_OBJ_PRE_(sender);  /* the sender object */
+            QS_SIG_PRE_(batch[i]->sig); /* the signal of the event */
+            QS_OBJ_PRE_(me);      /* this active object (recipient) */
+            QS_2U8_PRE_(batch[i]->poolId_, batch[i]->refCtr_);
+            QS_EQC_PRE_(__atomic_load_n(&q->nFree, __ATOMIC_RELAXED));
+            QS_EQC_PRE_(margin);  /* margin requested */
+        QS_END_PRE_()
+
+        QF_gc(batch[i]); /* recycle the event to avoid a leak */
+    }
+    return false;
+}
+/*..........................................................................*/
+void QActive_postLIFO_(QActive * const me, QEvt const * const e) {
+    QMPSCQueue * const q = &me->eQueue;
+    QEvt const *qe = e;  /* the event to insert at the tail of the queue */
+    int_fast32_t nFree;
+    QS_CRIT_STAT_
+
+#ifdef QF_ACTIVE_GET_BATCH
+    /* any events of the current batch not dispatched yet? see NOTE11 */
+    if (me->batchNext < me->batchEnd) {
+        qe = batchPushFront(me, e); /* deliver before the rest */
+    }
+    if (qe == (QEvt *)0) { /* taken by the batch? */
+        nFree = (int_fast32_t)__atomic_load_n(&q->nFree, __ATOMIC_RELAXED);
+    }
+    else
+#endif
+    {
+        nFree = mpscReserve(q, 1U, QF_NO_MARGIN);
+
+        /* the queue must be able to accept the event (cannot overflow) */
+        Q_ASSERT_ID(730, nFree >= 0);
+    }
+
+    /* is it a dynamic event? */
+    if (e->poolId_ != 0U) {
+        QF_EVT_REF_CTR_INC_(e); /* increment the reference counter */
+    }
+
+    QS_BEGIN_PRE_(QS_QF_ACTIVE_POST_LIFO, me->prio)
+        QS_TIME_PRE_();      /* timestamp */
+        QS_SIG_PRE_(e->sig); /* the signal of this event */
+        QS_OBJ_PRE_(me);     /* this active object */
+        QS_2U8_PRE_(e->poolId_, e->refCtr_);/* pool Id & ref Count */
+        QS_EQC_PRE_(nFree);  /* # free entries */
+        QS_EQC_PRE_(q->nMin); /* min number of free entries */
+    QS_END_PRE_()
+    (void)nFree; /* avoid compiler warning about unused variable */
+
+#ifdef QF_ACTIVE_GET_BATCH
+    if (qe != (QEvt *)0) /* not taken by the batch? */
+#endif
+    {
+        /* only the consumer (this AO) moves the tail back, see NOTE06 */
+        ++q->tail;
+        if (q->tail == q->end) { /* need to wrap the tail? */
+            q->tail = 0U; /* wrap around */
+        }
+        __atomic_store_n(&QF_PTR_AT_(q->ring, q->tail), qe,
+                         __ATOMIC_RELEASE);
+    }
+}
+/*..........................................................................*/
+/* wait for the event at the tail of the MPSC queue, see NOTE06 */
+static QEvt const *mpscWaitTail(QActive * const me) {
+    QMPSCQueue * const q = &me->eQueue;
+    QEvt const *e;
+
+    e = __atomic_load_n(&QF_PTR_AT_(q->ring, q->tail), __ATOMIC_ACQUIRE);
+#ifdef QF_FUTEX_WAKEUP
+    while (e == (QEvt *)0) { /* queue empty (or the producer not done yet)? */
+        uint32_t const seq = QFutexWakeup_seq(&me->osObject);
+        e = __atomic_load_n(&QF_PTR_AT_(q->ring, q->tail), __ATOMIC_ACQUIRE);
+        if (e == (QEvt *)0) {
+            QFutexWakeup_wait(&me->osObject, seq); /* see NOTE08 */
+            e = __atomic_load_n(&QF_PTR_AT_(q->ring, q->tail),
+                                __ATOMIC_ACQUIRE);
+        }
+    }
+#else
+    if (e == (QEvt *)0) { /* queue empty (or the producer not done yet)? */
+        pthread_mutex_lock(&me->osObject.mutex);
+        for (;;) {
+            __atomic_store_n(&me->osObject.waiting, 1, __ATOMIC_RELAXED);
+            __atomic_thread_fence(__ATOMIC_SEQ_CST); /* see NOTE06 */
+            e = __atomic_load_n(&QF_PTR_AT_(q->ring, q->tail),
+                                __ATOMIC_ACQUIRE);
+            if (e != (QEvt *)0) {
+                break;
+            }
+            pthread_cond_wait(&me->osObject.cond, &me->osObject.mutex);
+        }
+        __atomic_store_n(&me->osObject.waiting, 0, __ATOMIC_RELAXED);
+        pthread_mutex_unlock(&me->osObject.mutex);
+    }
+#endif
+    return e;
+}
+/*..........................................................................*/
+QEvt const *QActive_get_(QActive * const me) {
+    QMPSCQueue * const q = &me->eQueue;
+    QEvt const *e = mpscWaitTail(me);
+    QEQueueCtr nFree;
+    QS_CRIT_STAT_
+
+    /* free the slot before releasing it to the producers */
+    __atomic_store_n(&QF_PTR_AT_(q->ring, q->tail), (QEvt *)0,
+                     __ATOMIC_RELAXED);
+    if (q->tail == 0U) { /* need to wrap the tail? */
+        q->tail = q->end; /* wrap around */
+    }
+    --q->tail;
+    nFree = __atomic_add_fetch(&q->nFree, 1U, __ATOMIC_RELEASE);
+
+    if (nFree < q->end) { /* any more events in the queue? */
+        QS_BEGIN_PRE_(QS_QF_ACTIVE_GET, me->prio)
+            QS_TIME_PRE_();      /* timestamp */
+            QS_SIG_PRE_(e->sig); /* the signal of this event */
+            QS_OBJ_PRE_(me);     /* this active object */
+            QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
+            QS_EQC_PRE_(nFree);  /* # free entries */
+        QS_END_PRE_()
+    }
+    else {
+        QS_BEGIN_PRE_(QS_QF_ACTIVE_GET_LAST, me->prio)
+            QS_TIME_PRE_();      /* timestamp */
+            QS_SIG_PRE_(e->sig); /* the signal of this event */
+            QS_OBJ_PRE_(me);     /* this active object */
+            QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
+        QS_END_PRE_()
+    }
+    return e;
+}
+#ifdef QF_ACTIVE_GET_BATCH
+/*..........................................................................*/
+uint_fast16_t QActive_getBatch_(QActive * const me,
+                                QEvt const * * const batch,
+                                uint_fast16_t const max)
+{
+    QMPSCQueue * const q = &me->eQueue;
+    QEvt const *e;
+    QEQueueCtr nFree;
+    uint_fast16_t n = 0U;
+    uint_fast16_t i;
+    QS_CRIT_STAT_
+
+    /** @pre the batch must be able to hold at least one event */
+    Q_REQUIRE_ID(750, max != 0U);
+
+    /* take the events already published at the tail, see NOTE11 */
+    e = mpscWaitTail(me);
+    do {
+        batch[n] = e;
+        ++n;
+
+        /* free the slot before releasing it to the producers */
+        __atomic_store_n(&QF_PTR_AT_(q->ring, q->tail), (QEvt *)0,
+                         __ATOMIC_RELAXED);
+        if (q->tail == 0U) { /* need to wrap the tail? */
+            q->tail = q->end; /* wrap around */
+        }
+        --q->tail;
+
+        e = (n < max)
+            ? __atomic_load_n(&QF_PTR_AT_(q->ring, q->tail),
+                              __ATOMIC_ACQUIRE)
+            : (QEvt *)0;
+    } while (e != (QEvt *)0);
+
+    /* release all the slots to the producers at once */
+    nFree = __atomic_add_fetch(&q->nFree, (QEQueueCtr)n, __ATOMIC_RELEASE);
+
+    for (i = 0U; i < n; ++i) { /* the trace records of the removed events */
+        QEQueueCtr const nFreeI = nFree - (QEQueueCtr)(n - 1U - i);
+        e = batch[i];
+        if (nFreeI < q->end) { /* any more events in the queue? */
+            QS_BEGIN_PRE_(QS_QF_ACTIVE_GET, me->prio)
+                QS_TIME_PRE_();      /* timestamp */
+                QS_SIG_PRE_(e->sig); /* the signal of this event */
+                QS_OBJ_PRE_(me);     /* this active object */
+                QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Cnt */
+                QS_EQC_PRE_(nFreeI); /* # free entries */
+            QS_END_PRE_()
+        }
+        else {
+            QS_BEGIN_PRE_(QS_QF_ACTIVE_GET_LAST, me->prio)
+                QS_TIME_PRE_();      /* timestamp */
+                QS_SIG_PRE_(e->sig); /* the signal of this event */
+                QS_OBJ_PRE_(me);     /* this active object */
+                QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Cnt */
+            QS_END_PRE_()
+        }
+    }
+
+    /* the events of the batch are now ahead of the queue, see NOTE11 */
+    me->batch     = batch;
+    me->batchNext = 0U;
+    me->batchEnd  = n;
+    return n;
+}
+/*..........................................................................*/
+QEvt const *QActive_batchNext_(QActive * const me) {
+    QEvt const *e = (QEvt *)0;
+    if (me->batchNext < me->batchEnd) { /* not the end of the batch? */
+        e = me->batch[me->batchNext];
+        ++me->batchNext;
+    }
+    return e;
+}
+/*..........................................................................*/
+/* insert the event in front of the undispatched rest of the batch, into
+* the slot of the event just dispatched; when no slot is free, the last
+* event of the batch is returned to go back to the queue, see NOTE11
+*/
+static QEvt const *batchPushFront(QActive * const me, QEvt const * const e) {
+    QEvt const *qe = (QEvt *)0;
+
+    if (me->batchNext == 0U) { /* no free slot in front of the rest? */
+        uint_fast16_t i;
+
+        i = me->batchEnd - 1U;
+        qe = me->batch[i]; /* the last event goes back to the queue */
+        for (; i > 0U; --i) { /* shift the rest to make the free slot */
+            me->batch[i] = me->batch[i - 1U];
+        }
+        ++me->batchNext;
+    }
+    --me->batchNext;
+    me->batch[me->batchNext] = e;
+
+    return qe;
+}
+#endif /* QF_ACTIVE_GET_BATCH */
+/*..........................................................................*/
+uint_fast16_t QF_getQueueMin(uint_fast16_t const prio) {
+    Q_REQUIRE_ID(740, (prio <= QF_MAX_ACTIVE)
+                      && (QF_active_[prio] != (QActive *)0));
+
+    return (uint_fast16_t)__atomic_load_n(&QF_active_[prio]->eQueue.nMin,
+                                          __ATOMIC_RELAXED);
+}
+
+#endif /* QF_MPSC_QUEUE */
+
+/****************************************************************************/
+/* the code shared by all POSIX ports (ticker, elastic pools), see NOTE09 */
+#include "../posix-common/qf_posix.c"
+
 /****************************************************************************/
 static void sigIntHandler(int dummy) {
     (void)dummy; /* unused parameter */
@@ -335,9 +1370,100 @@ static void sigIntHandler(int dummy) {
 * three highest p-thread priorities for the ISR-like threads (e.g., I/O),
 * and the rest highest-priorities for the active objects.
 *
+* When QF_MAX_ACTIVE exceeds the number of the remaining p-thread priority
+* levels (e.g., with the hierarchical ::QPSet of more than 64 elements),
+* the QF priorities are spread evenly over the available levels, so that
+* several adjacent QF priorities share one p-thread priority. The relative
+* order of the active objects is preserved, but the active objects sharing
+* a level no longer preempt each other.
+*
 * NOTE05:
 * In some (older) Linux kernels, the POSIX nanosleep() system call might
 * deliver only 2*actual-system-tick granularity. To compensate for this,
 * you would need to reduce the constant NANOSLEEP_NSEC_PER_SEC by factor 2.
+*
+* NOTE06:
+* The lock-free ::QMPSCQueue (macro QF_MPSC_QUEUE) works as follows.
+* A producer first reserves capacity by atomically decrementing nFree
+* (honoring the margin), then claims the slot at the head with a CAS and
+* finally publishes the event pointer into the slot with a release store.
+* The consumer (the AO thread) takes the event from the slot at the tail,
+* clears the slot and only then returns the capacity by incrementing nFree.
+* Because the number of claimed slots never exceeds the reserved capacity,
+* a claimed slot is always free. For the same reason the consumer can
+* insert an event in front of the tail (LIFO) after reserving a slot.
+* QActive_postBatch_() reserves the capacity for the whole batch and claims
+* all its slots with a single CAS, so the events of one batch are never
+* interleaved with the events of other producers.
+*
+* An empty slot at the tail means that the queue is empty, or that the
+* producer of that slot has not published the event yet. In both cases the
+* AO thread blocks on its private condition variable. The 'waiting' flag
+* and the slot are accessed in opposite order by the producer and the
+* consumer with a full fence in between (Dekker), so at least one of them
+* always sees the other's store and no wakeup can be lost.
+*
+* NOTE07:
+* When the macro QF_SHARDED_CRIT is defined, QF_critLock_() maps every
+* QF object to one of the mutexes in l_critShard[] by multiplying the
+* object address with the golden-ratio constant and keeping the top
+* QF_CRIT_SHARD_BITS bits (Fibonacci hashing). The low address bits are
+* dropped, because the objects are at least 8 bytes apart. A NULL object
+* (QF_CRIT_ENTRY()) selects the global QF_pThreadMutex_, which protects
+* the remaining QF data, such as the QF_active_[] table. In the Spy build
+* all objects use QF_pThreadMutex_, because the QS trace records are
+* produced inside the critical sections of the QF objects.
+*
+* NOTE08:
+* The ::QFutexWakeup (macro QF_FUTEX_WAKEUP) never loses a wakeup, because
+* the AO thread reads the sequence number 'seq' before it checks its event
+* queue, and the producer increments 'seq' only after it has inserted the
+* event. If the event is not visible to the AO thread yet, the increment
+* is not visible either, so the futex wait returns immediately when the
+* increment happens before the thread parks. Additionally, the 'parked'
+* flag and 'seq' are accessed in opposite order by the AO thread and the
+* producer with a full fence in between (Dekker), so the producer skips the
+* FUTEX_WAKE system call only when the AO thread is guaranteed to see the
+* new value of 'seq' before blocking in the kernel.
+*
+* NOTE09:
+* The ticker is the same in all POSIX ports and is implemented in the file
+* ports/posix-common/qf_posix.c (see NOTE01 in that file). The virtual
+* memory of the elastic event pools is implemented in the same file (see
+* NOTE03 in that file).
+*
+* NOTE10:
+* The tickless time events are the same in all POSIX ports and are
+* implemented in the file ports/posix-common/qf_posix.c (see NOTE02 in
+* that file).
+*
+* NOTE11:
+* When the macro QF_ACTIVE_GET_BATCH is defined, the AO thread removes
+* up to QF_ACTIVE_GET_BATCH events from its queue at once with
+* QActive_getBatch_() and then dispatches them back-to-back. With the
+* native event queues this takes the critical section once per batch
+* instead of once per event. With the lock-free queues (QF_MPSC_QUEUE)
+* the AO takes all the events already published in the ring and returns
+* their slots to the producers with a single atomic addition. Either way,
+* every event produces its own QS_QF_ACTIVE_GET (or QS_QF_ACTIVE_GET_LAST)
+* trace record, just as with QActive_get_(). The events taken in a batch
+* no longer occupy the queue, so QF_getQueueMin() and the margin checks
+* of QACTIVE_POST_X() see them as already consumed.
+*
+* The AO thread then takes the events one by one with QActive_batchNext_(),
+* because the undispatched rest of the batch is still the front of the
+* queue. An event posted LIFO during the batch (e.g., QActive_recall())
+* goes in front of the rest, into the slot of the event just dispatched,
+* so it is dispatched next, exactly as without batching (see also NOTE2
+* in qf_actq.c). With the batching, the LIFO posts to an AO must come from
+* the AO itself, which is the only sensible use of the LIFO policy anyway.
+*
+* NOTE12:
+* The event magazines (macro QF_EVT_MAGAZINE, see qf_dyn.c) are declared
+* QF_THREAD_LOCAL, which is _Thread_local in this port. The GNU C library
+* allocates the static thread-local storage of a p-thread at the top of
+* its stack, so the magazines would eat into the stack requested for the
+* AO. QActive_start_() therefore adds the size of the magazines to the
+* stack size of the AO thread. Every thread calls QF_magazineFlush() before
+* it terminates, so that no event blocks remain stranded in its magazines.
 */
-
@@ -40,16 +40,58 @@
 #define QF_PORT_H
 
 /* POSIX event queue and thread types */
-#define QF_EQUEUE_TYPE       QEQueue
-#define QF_OS_OBJECT_TYPE    pthread_cond_t
-#define QF_THREAD_TYPE       bool
+#ifdef QF_MPSC_QUEUE  /* lock-free AO event queues? see NOTE2 */
+    #define QF_EQUEUE_TYPE       QMPSCQueue
+    #define QF_NON_NATIVE_EQUEUE 1
+#else                 /* native QF event queues (default) */
+    #define QF_EQUEUE_TYPE       QEQueue
+#endif
+#ifdef QF_FUTEX_WAKEUP  /* futex-based AO wakeup? see NOTE4 */
+    #define QF_OS_OBJECT_TYPE    QFutexWakeup
+#elif (defined QF_MPSC_QUEUE)
+    #define QF_OS_OBJECT_TYPE    QMPSCWait
+#else
+    #define QF_OS_OBJECT_TYPE    pthread_cond_t
+#endif
+#define QF_THREAD_TYPE       QPosixThread
 
 /* The maximum number of active objects in the application */
+#ifndef QF_MAX_ACTIVE
 #define QF_MAX_ACTIVE        64U
+#endif
 
 /* The number of system clock tick rates */
 #define QF_MAX_TICK_RATE     2U
 
+/* Storage class of the thread-local objects, e.g., the event magazines */
+#define QF_THREAD_LOCAL      _Thread_local
+
+/* Dynamic events use atomic reference counting, see NOTE8 */
+#define QF_EVT_REF_CTR_ATOMIC 1
+
+/* The maximum number of missed clock ticks delivered after an overrun
+* of the ticker (see NOTE09 in qf_port.c)
+*/
+#ifndef QF_TICK_CATCHUP_MAX
+#define QF_TICK_CATCHUP_MAX  100U
+#endif
+
+#ifdef QF_TICKLESS /* tickless time events? see NOTE6 */
+/* the maximum number of simultaneously armed tickless time events */
+#ifndef QF_TICKLESS_MAX
+#define QF_TICKLESS_MAX      1024U
+#endif
+#endif
+
+/* The maximum number of events taken from the queue of an AO and
+* dispatched in one batch (see NOTE11 in qf_port.c)
+*/
+#ifdef QF_ACTIVE_GET_BATCH
+#if (QF_ACTIVE_GET_BATCH < 1)
+#error "QF_ACTIVE_GET_BATCH must be at least 1"
+#endif
+#endif
+
 /* Activate the QF QActive_stop() API */
 #define QF_ACTIVE_STOP        1
 
@@ -61,22 +103,196 @@
 #define QF_TIMEEVT_CTR_SIZE  4U
 
 /* QF critical section entry/exit for POSIX, see NOTE1 */
-/* QF_CRIT_STAT_TYPE not defined */
-#define QF_CRIT_ENTRY(dummy) QF_enterCriticalSection_()
-#define QF_CRIT_EXIT(dummy)  QF_leaveCriticalSection_()
+#ifdef QF_SHARDED_CRIT  /* per-object critical sections? see NOTE3 */
+    #define QF_CRIT_STAT_TYPE    pthread_mutex_t *
+    #define QF_CRIT_ENTRY(stat_) QF_CRIT_OBJ_ENTRY((stat_), (void *)0)
+    #define QF_CRIT_OBJ_ENTRY(stat_, obj_) \
+        ((stat_) = QF_critLock_(obj_), (void)pthread_mutex_lock(stat_))
+    #define QF_CRIT_EXIT(stat_)  ((void)pthread_mutex_unlock(stat_))
+
+    /* number of bits of the object hash selecting the lock (64 locks) */
+    #ifndef QF_CRIT_SHARD_BITS
+    #define QF_CRIT_SHARD_BITS   6U
+    #endif
+    #ifdef QF_PUBLISH_FANOUT
+    #error "QF_PUBLISH_FANOUT requires the global critical section"
+    #endif
+#else
+    /* QF_CRIT_STAT_TYPE not defined */
+    #define QF_CRIT_ENTRY(dummy) QF_enterCriticalSection_()
+    #define QF_CRIT_EXIT(dummy)  QF_leaveCriticalSection_()
+#endif
+
+/* QF_LOG2 with the count-leading-zeros built-in of GCC/Clang. The argument
+* is shifted into 64 bits with the lowest bit set, so that QF_LOG2(0) is 0
+* without a branch (__builtin_clz(0) is undefined).
+*/
+#if (defined __GNUC__) || (defined __clang__)
+    #define QF_LOG2(n_) ((uint_fast8_t)(63U \
+        - (unsigned)__builtin_clzll((((unsigned long long)(n_)) << 1U) | 1U)))
+#endif
 
 #include <pthread.h>   /* POSIX-thread API */
 #include "qep_port.h"  /* QEP port */
 #include "qequeue.h"   /* POSIX needs event-queue */
 #include "qmpool.h"    /* POSIX needs memory-pool */
+
+/*! Thread-related data of an active object in the POSIX port */
+/**
+* @description
+* The attributes are set with QActive_setAttr() before starting the AO
+* and are applied when the p-thread of the AO is created. See NOTE5.
+*/
+typedef struct {
+    char const *name;   /*!< thread name (THREAD_NAME_ATTR) */
+    void const *cpuSet; /*!< cpu_set_t of allowed CPUs (CPU_AFFINITY_ATTR) */
+    size_t stkSize;     /*!< stack size [bytes] (STACK_SIZE_ATTR) */
+    int policy;         /*!< scheduling policy (SCHED_POLICY_ATTR) */
+    int prio;           /*!< p-thread priority (SCHED_PRIO_ATTR) */
+    uint8_t attrs;      /*!< bitmask of the attributes set (1U << attr) */
+    bool isRunning;     /*!< the thread loop is running (QActive_stop()) */
+    pthread_mutex_t waitMutex; /*!< protects notFull (QActive_postWait_()) */
+    pthread_cond_t notFull; /*!< signaled when the AO frees queue entries */
+    int nPostWait;      /*!< number of producers waiting on notFull */
+} QPosixThread;
+
+#ifdef QF_MPSC_QUEUE
+
+/*! Bounded lock-free multiple-producer/single-consumer event queue */
+/**
+* @description
+* The queue is used as the event queue of active objects when the macro
+* #QF_MPSC_QUEUE is defined. Producers (any threads) reserve a free slot
+* by atomically decrementing @c nFree and then claim the slot at @c head.
+* The only consumer (the AO thread) owns the @c tail. See NOTE2.
+*/
+typedef struct {
+    QEvt const **ring;   /*!< ring buffer (empty slots hold NULL) */
+    QEQueueCtr end;      /*!< number of slots in the ring buffer */
+    QEQueueCtr head;     /*!< next slot claimed by producers (atomic) */
+    QEQueueCtr tail;     /*!< next slot to consume (consumer only) */
+    QEQueueCtr nFree;    /*!< # free slots, incl. reserved ones (atomic) */
+    QEQueueCtr nMin;     /*!< minimum # free slots ever (atomic) */
+} QMPSCQueue;
+
+/*! Object for blocking the AO thread on an empty ::QMPSCQueue */
+typedef struct {
+    pthread_mutex_t mutex; /*!< mutex for the condition variable */
+    pthread_cond_t  cond;  /*!< condition signaled when events arrive */
+    int waiting;           /*!< AO thread waits for events (atomic) */
+} QMPSCWait;
+
+/*! Initialize the lock-free event queue */
+void QMPSCQueue_init(QMPSCQueue * const me, QEvt const * * const qSto,
+                     uint_fast16_t const qLen);
+
+#endif /* QF_MPSC_QUEUE */
+
+#ifdef QF_FUTEX_WAKEUP
+
+/* maximum # polling iterations before the AO thread parks, see NOTE4 */
+#ifndef QF_WAKEUP_SPIN
+#define QF_WAKEUP_SPIN       4000U
+#endif
+
+/* minimum # polling iterations (never 0, unless spinning is disabled) */
+#if (QF_WAKEUP_SPIN >= 16U)
+#define QF_WAKEUP_SPIN_MIN   (QF_WAKEUP_SPIN / 16U)
+#elif (QF_WAKEUP_SPIN > 0U)
+#define QF_WAKEUP_SPIN_MIN   1U
+#else
+#define QF_WAKEUP_SPIN_MIN   0U
+#endif
+
+/*! Object for waking up the AO thread based on the Linux futex */
+/**
+* @description
+* The AO thread first polls the futex word @c seq for up to @c spin
+* iterations and only then parks in the kernel. The @c spin limit adapts
+* to the arrival rate of events between QF_WAKEUP_SPIN_MIN and
+* QF_WAKEUP_SPIN. See NOTE4.
+*/
+typedef struct {
+    uint32_t seq;    /*!< futex word incremented by each wakeup (atomic) */
+    uint32_t parked; /*!< AO thread is parked in the kernel (atomic) */
+    uint32_t spin;   /*!< current spin limit (used by the AO thread only) */
+} QFutexWakeup;
+
+/*! Initialize the futex-based wakeup object */
+void QFutexWakeup_init(QFutexWakeup * const me);
+
+/*! Obtain the wakeup sequence number before checking for events */
+uint32_t QFutexWakeup_seq(QFutexWakeup * const me);
+
+/*! Wait (spin, then park) until the sequence number differs from @p seq */
+void QFutexWakeup_wait(QFutexWakeup * const me, uint32_t const seq);
+
+/*! Wake up the AO thread waiting on the wakeup object */
+void QFutexWakeup_signal(QFutexWakeup * const me);
+
+#endif /* QF_FUTEX_WAKEUP */
+
 #include "qf.h"        /* QF platform-independent public interface */
 
+/* attributes of the AO threads for QActive_setAttr(), see NOTE5 */
+enum POSIX_ThreadAttrs {
+    THREAD_NAME_ATTR,  /* attr2: char const * name of the thread */
+    CPU_AFFINITY_ATTR, /* attr2: cpu_set_t const * CPUs to run the thread */
+    SCHED_POLICY_ATTR, /* attr2: int const * policy, such as SCHED_RR */
+    SCHED_PRIO_ATTR,   /* attr2: int const * p-thread priority */
+    STACK_SIZE_ATTR    /* attr2: size_t const * stack size [bytes] */
+};
+
 void QF_enterCriticalSection_(void);
 void QF_leaveCriticalSection_(void);
 
+#ifdef QF_SHARDED_CRIT
+/* get the mutex protecting the given QF object (NULL for global mutex) */
+pthread_mutex_t *QF_critLock_(void const * const obj);
+#endif
+
+/* post an event to the AO, waiting up to 'nsec_' nanoseconds for the free
+* entries in its queue above 'margin_' (not from an AO thread), NOTE11
+*/
+#ifdef Q_SPY
+    bool QActive_postWait_(QActive * const me, QEvt const * const e,
+                           uint_fast16_t const margin, uint64_t const nsec,
+                           void const * const sender);
+    #define QACTIVE_POST_WAIT(me_, e_, margin_, nsec_, sender_) \
+        (QActive_postWait_((me_), (e_), (margin_), (nsec_), (sender_)))
+#else
+    bool QActive_postWait_(QActive * const me, QEvt const * const e,
+                           uint_fast16_t const margin, uint64_t const nsec);
+    #define QACTIVE_POST_WAIT(me_, e_, margin_, nsec_, sender_) \
+        (QActive_postWait_((me_), (e_), (margin_), (nsec_)))
+#endif
+
 /* set clock tick rate and p-thread priority */
 void QF_setTickRate(uint32_t ticksPerSec, int_t tickPrio);
 
+/* set the clock tick rate of the additional tick rate 'tickRate' (> 0),
+* which is then ticked by the port with QF_TICK_X()
+* (NOTE ticksPerSec==0 stops ticking this rate)
+*/
+void QF_setTickRateX(uint_fast8_t tickRate, uint32_t ticksPerSec);
+
+#ifdef QF_TICKLESS /* tickless time events? see NOTE6 */
+/* arm the time event to expire in 'nsec' nanoseconds and then every
+* 'intervalNsec' nanoseconds (NOTE intervalNsec==0 for one-shot)
+*/
+void QTimeEvt_armNsec(QTimeEvt * const me,
+                      uint64_t const nsec, uint64_t const intervalNsec);
+
+/* disarm the tickless time event (returns 'true' if it was armed) */
+bool QTimeEvt_disarmNsec(QTimeEvt * const me);
+
+/* rearm the armed tickless time event to expire in 'nsec' nanoseconds */
+bool QTimeEvt_rearmNsec(QTimeEvt * const me, uint64_t const nsec);
+
+/* the number of nanoseconds until the tickless time event expires */
+uint64_t QTimeEvt_currNsec(QTimeEvt const * const me);
+#endif
+
 /* clock tick callback (NOTE not called when "ticker thread" is not running) */
 void QF_onClockTick(void); /* clock tick callback (provided in the app) */
 
@@ -86,22 +302,69 @@ void QF_consoleCleanup(void);
 int QF_consoleGetKey(void);
 int QF_consoleWaitForKey(void);
 
+/* storage for event pools and event queues backed by huge pages and
+* bound to the NUMA node 'numaNode' (-1 for no binding), see NOTE9
+*/
+void *QF_stoAlloc(size_t const size, int const numaNode);
+
+/* the NUMA node of the CPU 'cpu' (-1 if unknown) */
+int QF_numaNodeOfCpu(int const cpu);
+
+/* the NUMA node of the first CPU in the affinity of the AO (-1 if none) */
+int QActive_numaNode(QActive const * const me);
+
 /****************************************************************************/
 /* interface used only inside QF implementation, but not in applications */
 #ifdef QP_IMPL
 
-    /* QF-specific scheduler locking (not used at this point) */
-    #define QF_SCHED_STAT_
-    #define QF_SCHED_LOCK_(dummy) ((void)0)
-    #define QF_SCHED_UNLOCK_()    ((void)0)
+    /*! POSIX-specific scheduler locking (implemented in qf_port.c) */
+    typedef struct {
+        uint_fast16_t lockPrio;/*!< lock prio [QF numbering], 0 if unlocked */
+        int prevPrio;          /*!< previous SCHED_FIFO prio of the thread */
+    } QFSchedLock;
+
+    /* QF-specific scheduler locking, see NOTE7 */
+    #define QF_SCHED_STAT_ QFSchedLock lockStat_;
+    #define QF_SCHED_LOCK_(prio_) (QFSchedLock_(&lockStat_, (prio_)))
+    #define QF_SCHED_UNLOCK_() do {     \
+        if (lockStat_.lockPrio != 0U) { \
+            QFSchedUnlock_(&lockStat_); \
+        }                               \
+    } while (false)
+
+    /* internal implementation of scheduler locking/unlocking */
+    void QFSchedLock_(QFSchedLock * const lockStat, uint_fast16_t prio);
+    void QFSchedUnlock_(QFSchedLock const * const lockStat);
 
+#ifndef QF_MPSC_QUEUE
     /* POSIX active object event queue customization... */
+#ifdef QF_FUTEX_WAKEUP
+    #define QACTIVE_EQUEUE_WAIT_(me_) \
+        while ((me_)->eQueue.frontEvt == (QEvt *)0) { \
+            uint32_t const seq_ = QFutexWakeup_seq(&(me_)->osObject); \
+            QF_CRIT_X_(); \
+            QFutexWakeup_wait(&(me_)->osObject, seq_); \
+            QF_CRIT_OBJ_E_(&(me_)->eQueue); \
+        }
+    #define QACTIVE_EQUEUE_SIGNAL_(me_) \
+        Q_ASSERT_ID(410, QF_active_[(me_)->prio] != (QActive *)0); \
+        QFutexWakeup_signal(&(me_)->osObject)
+#elif (defined QF_SHARDED_CRIT)
+    #define QACTIVE_EQUEUE_WAIT_(me_) \
+        while ((me_)->eQueue.frontEvt == (QEvt *)0) \
+            pthread_cond_wait(&(me_)->osObject, \
+                              QF_critLock_(&(me_)->eQueue))
+#else
     #define QACTIVE_EQUEUE_WAIT_(me_) \
         while ((me_)->eQueue.frontEvt == (QEvt *)0) \
             pthread_cond_wait(&(me_)->osObject, &QF_pThreadMutex_)
+#endif
+#ifndef QF_FUTEX_WAKEUP
     #define QACTIVE_EQUEUE_SIGNAL_(me_) \
         Q_ASSERT_ID(410, QF_active_[(me_)->prio] != (QActive *)0); \
         pthread_cond_signal(&(me_)->osObject)
+#endif
+#endif /* QF_MPSC_QUEUE */
 
     /* native QF event pool operations */
     #define QF_EPOOL_TYPE_            QMPool
@@ -113,6 +376,19 @@ int QF_consoleWaitForKey(void);
     #define QF_EPOOL_PUT_(p_, e_, qs_id_) \
         (QMPool_put(&(p_), (e_), (qs_id_)))
 
+#ifdef QF_MPOOL_ELASTIC
+    /* virtual memory for the elastic event pools, see NOTE10 */
+    #define QF_MPOOL_RESERVE_(size_)  (QF_memReserve_((size_)))
+    #define QF_MPOOL_COMMIT_(addr_, size_) \
+        (QF_memCommit_((addr_), (size_)))
+    #define QF_MPOOL_DECOMMIT_(addr_, size_) \
+        (QF_memDecommit_((addr_), (size_)))
+
+    void *QF_memReserve_(uint_fast32_t const size);
+    bool QF_memCommit_(void * const addr, uint_fast32_t const size);
+    void QF_memDecommit_(void * const addr, uint_fast32_t const size);
+#endif /* QF_MPOOL_ELASTIC */
+
     /* mutex for QF critical section */
     extern pthread_mutex_t QF_pThreadMutex_;
 
@@ -147,6 +423,185 @@ int QF_consoleWaitForKey(void);
 * also subject to priority inversions. However, the p-thread mutex
 * implementation, such as POSIX threads, should support the priority-
 * inheritance protocol.
+*
+* NOTE2:
+* When the macro QF_MPSC_QUEUE is defined (e.g., on the compiler command
+* line), the active objects use the bounded lock-free ::QMPSCQueue instead
+* of the native ::QEQueue protected by the global QF_pThreadMutex_. Posting
+* events then scales with the number of cores, because producers only
+* contend on the atomic counters of the target queue. The operations
+* QActive_post_(), QActive_postLIFO_() and QActive_get_() are provided in
+* qf_port.c and produce the same QS trace records as the native queue.
+*
+* The lock-free queue differs from ::QEQueue in the following respects:
+* - the capacity of the queue is qLen (there is no extra frontEvt location);
+* - QActive_postLIFO_() may be called only from the thread of the AO itself
+*   (self-posting and QActive_recall());
+* - the reference counters of dynamic events must be updated atomically
+*   (see NOTE8);
+* - the ::QTicker active object is not available (qf_actq.c is excluded).
+*
+* NOTE3:
+* When the macro QF_SHARDED_CRIT is defined (e.g., on the compiler command
+* line), the QF critical section is no longer global. Instead, QF enters
+* the critical section for the specific object it operates on with the
+* macro QF_CRIT_OBJ_ENTRY(stat_, obj_): each event queue, each event pool,
+* each tick-rate list of time events, the subscriber table and each dynamic
+* event (for its reference counter). The object is mapped to one of the
+* 2^QF_CRIT_SHARD_BITS mutexes by hashing its address, so that operations
+* on different objects (e.g., posting to different active objects and
+* allocating events from different pools) can proceed in parallel on
+* different cores. The selected mutex is stored in the critical section
+* status variable, so that QF_CRIT_EXIT() releases the right mutex.
+*
+* The QF code never nests critical sections of different objects, so the
+* hashing of two objects to the same mutex cannot cause a deadlock. The
+* reference counters of dynamic events are updated atomically (NOTE8),
+* because they are incremented in the critical sections of the event
+* queues.
+*
+* In the Spy build configuration (Q_SPY defined) all objects are mapped
+* to the global QF_pThreadMutex_, because the QS trace buffer is shared
+* by all QF objects and is protected by the same critical section.
+*
+* NOTE4:
+* When the macro QF_FUTEX_WAKEUP is defined (e.g., on the compiler command
+* line), the AO threads block on the Linux futex inside ::QFutexWakeup
+* instead of the POSIX condition variable. This works with both the native
+* and the lock-free (QF_MPSC_QUEUE) event queues. An AO thread that finds
+* its queue empty first polls the futex word without leaving the CPU (spin
+* phase) and parks in the kernel only when no event arrives within the
+* current spin limit. The spin limit doubles whenever spinning succeeds and
+* halves whenever the thread has to park, so busy AOs (e.g., running on
+* dedicated cores) receive events without any system call, while idle AOs
+* sleep in the kernel. The posting thread makes the FUTEX_WAKE system call
+* only when the AO thread is actually parked.
+*
+* The maximum spin limit is set by the macro QF_WAKEUP_SPIN (4000 polling
+* iterations by default). Setting QF_WAKEUP_SPIN to 0 disables the spin
+* phase. The spin limit never decays below QF_WAKEUP_SPIN_MIN, which is
+* at least 1 for any non-zero QF_WAKEUP_SPIN, so that a successful spin
+* can always grow the limit again.
+*
+* NOTE5:
+* By default, the p-thread of an AO runs under the SCHED_FIFO policy with
+* the priority mapped from the QF priority (see NOTE04 in qf_port.c). When
+* the application has insufficient privileges for SCHED_FIFO, the thread
+* silently falls back to the SCHED_OTHER policy. The following attributes
+* can be set with QActive_setAttr() before calling QACTIVE_START():
+*
+* QActive_setAttr(&ao, THREAD_NAME_ATTR, "Philo");
+* QActive_setAttr(&ao, CPU_AFFINITY_ATTR, &cpuSet);
+* QActive_setAttr(&ao, SCHED_POLICY_ATTR, &policy);
+* QActive_setAttr(&ao, SCHED_PRIO_ATTR, &prio);
+* QActive_setAttr(&ao, STACK_SIZE_ATTR, &stkSize);
+*
+* The name (truncated to 15 characters) and the CPU set (cpu_set_t, see
+* CPU_SET(3)) are used directly, so they must remain valid until the AO
+* is started. These two attributes are available only on Linux. When the
+* scheduling policy or priority is set explicitly, the thread creation
+* does not fall back to SCHED_OTHER, but fails with an assertion instead.
+* The STACK_SIZE_ATTR overrides the stack size passed to QACTIVE_START().
+*
+* NOTE6:
+* The tickless mode (macro QF_TICKLESS) allows arming time events with
+* nanosecond deadlines by means of QTimeEvt_armNsec(), which are then
+* timed directly by the ticker thread without any periodic clock tick.
+* The tickless time events must be disarmed, rearmed and queried only
+* with the *Nsec() functions, while the other time events keep using the
+* periodic tick rates. Mixing the two APIs on one time event asserts.
+* In the tickless mode QF_setTickRate() accepts ticksPerSec==0, which
+* stops the periodic ticking of the tick rate 0 (and the QF_onClockTick()
+* callback) altogether. See NOTE10 in qf_port.c.
+*
+* NOTE7:
+* The scheduler locking (used in QF_publish_()) temporarily raises the
+* SCHED_FIFO priority of the calling thread to the p-thread priority of
+* the highest-priority subscriber. The subscribers woken up during the
+* multicasting then cannot preempt the publisher before it has posted
+* the event to all of them. The scheduler is not locked when the calling
+* thread does not run under SCHED_FIFO (e.g., due to insufficient
+* privileges) or when it already has sufficiently high priority, which
+* then costs no system calls. The lock priority is mapped from the QF
+* priority in the same way as the default priority of the AO threads
+* (see NOTE04 in qf_port.c).
+*
+* NOTE8:
+* The reference counters of dynamic events are incremented and decremented
+* with the GCC atomic built-ins (see QF_EVT_REF_CTR_ATOMIC in qf_pkg.h),
+* so QF_gc() recycles events without entering the QF critical section,
+* which is always the global mutex or one of the shared mutexes in this
+* port. This is also required by the lock-free event queues (NOTE2) and
+* the sharded critical section (NOTE3), which update the counters outside
+* of any common critical section. For events referenced by more than 255
+* event queues at once (e.g., published to many subscribers), configure
+* the wider counter with Q_EVT_REF_CTR_SIZE in qep_port.h or on the
+* compiler command line.
+*
+* NOTE9:
+* QF_stoAlloc() provides the storage for QF_poolInit() and for the event
+* queues of QACTIVE_START() as an alternative to static arrays. Storage of
+* at least QF_HUGEPAGE_SIZE (2MB by default) is mapped with MAP_HUGETLB,
+* which reduces the TLB misses. When no huge pages are reserved (see
+* /proc/sys/vm/nr_hugepages), the storage falls back to the normal pages
+* with the advice to use transparent huge pages. The storage is then bound
+* with mbind(MPOL_PREFERRED) to the given NUMA node, so that it stays local
+* to the consuming AO on multi-socket machines, and finally all its pages
+* are prefaulted, so that no page faults occur at run time. For example:
+*
+*     QActive_setAttr(&l_sensor.super, CPU_AFFINITY_ATTR, &sensorCpus);
+*     poolSto = QF_stoAlloc(poolSize, QActive_numaNode(&l_sensor.super));
+*     QF_poolInit(poolSto, poolSize, sizeof(FrameEvt));
+*     qSto = QF_stoAlloc(qLen * sizeof(QEvt *),
+*                        QActive_numaNode(&l_sensor.super));
+*     QACTIVE_START(&l_sensor.super, 5U, qSto, qLen, (void *)0, 0U,
+*                   (void *)0);
+*
+* The storage is meant for the lifetime of the application and is never
+* freed. The NUMA node of a CPU is found in the sysfs, so both
+* QF_numaNodeOfCpu() and QActive_numaNode() return -1 (no binding) when
+* the sysfs is not available.
+*
+* NOTE10:
+* The elastic event pools (macro QF_MPOOL_ELASTIC) reserve the address
+* space for their maximum size and commit the memory only as the pools
+* grow (see NOTE03 in ports/posix-common/qf_posix.c). QF_poolTrim() gives
+* the memory back to the OS, so the application can call it periodically
+* (e.g., from a time event of a low-priority AO) to shrink the pools after
+* a spike:
+*
+*     QF_poolInitElastic(sizeof(FrameEvt), 64U, 4096U, 64U, 8U);
+*     ...
+*     case HOUSEKEEPING_SIG: {
+*         (void)QF_poolTrim(1U);
+*         ...
+* The pools grow in the critical section of the pool, so choose nGrow
+* that keeps the growth (a single mprotect() call) infrequent.
+*
+* NOTE11:
+* QACTIVE_POST_WAIT() applies the back-pressure to the producer threads
+* outside the framework (e.g., the threads reading a socket). Instead of
+* failing, it blocks the producer on the condition variable of the AO
+* until the queue has more than 'margin_' free entries, or until the
+* timeout expires, and returns false (the event recycled) only then:
+*
+*     e = Q_NEW(FrameEvt, FRAME_SIG);
+*     ...
+*     if (!QACTIVE_POST_WAIT(AO_Parser, &e->super, 2U, 50000000U, &l_rx)) {
+*         ++l_dropped; (the parser did not catch up within 50 ms)
+*     }
+*
+* The AO thread signals the condition only when some producer waits, so
+* the AOs pay a single load per event otherwise (the full fence with
+* QF_MPSC_QUEUE pairs with the fence of the atomic increment of the
+* waiting count by the producer). The wait time is reported with the
+* QS_QF_ACTIVE_POST_WAIT trace record. The AO threads must not wait for
+* each other in this way (deadlock), so the call is asserted to come from
+* a non-AO thread. The clock-tick thread (QF_onClockTick()) and the
+* initial transitions of the AOs are asserted in the same way, so they
+* must keep using the non-blocking QACTIVE_POST_X(). The condition
+* variable of an AO is destroyed when the AO stops (QF_ACTIVE_STOP) or
+* when QF_run() returns, so no producer may wait for it at that time.
 */
 
 #endif /* QF_PORT_H */
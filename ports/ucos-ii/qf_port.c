@@ -82,7 +82,7 @@ void QActive_setAttr(QActive *const me, uint32_t attr1, void const *attr2) {
 }
 
 /*..........................................................................*/
-void QActive_start_(QActive * const me, uint_fast8_t prio,
+void QActive_start_(QActive * const me, uint_fast16_t prio,
                     QEvt const * * const qSto, uint_fast16_t const qLen,
                     void * const stkSto, uint_fast16_t const stkSize,
                     void const * const par)
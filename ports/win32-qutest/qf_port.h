@@ -46,7 +46,9 @@
 /* QF_THREAD_TYPE     not used */
 
 /* The maximum number of active objects in the application */
+#ifndef QF_MAX_ACTIVE
 #define QF_MAX_ACTIVE        64U
+#endif
 
 /* The number of system clock tick rates */
 #define QF_MAX_TICK_RATE     2U
@@ -83,7 +85,7 @@
     #define QACTIVE_EQUEUE_WAIT_(me_) \
         Q_ASSERT_ID(110, (me_)->eQueue.frontEvt != (QEvt *)0)
     #define QACTIVE_EQUEUE_SIGNAL_(me_) \
-        QPSet_insert(&QS_rxPriv_.readySet, (uint_fast8_t)(me_)->prio)
+        QPSet_insert(&QS_rxPriv_.readySet, (uint_fast16_t)(me_)->prio)
 
     /* native QF event pool operations */
     #define QF_EPOOL_TYPE_            QMPool
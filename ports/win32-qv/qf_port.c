@@ -186,7 +186,7 @@ int QF_consoleWaitForKey(void) {
 }
 
 /* QActive functions =======================================================*/
-void QActive_start_(QActive * const me, uint_fast8_t prio,
+void QActive_start_(QActive * const me, uint_fast16_t prio,
                     QEvt const * * const qSto, uint_fast16_t const qLen,
                     void * const stkSto, uint_fast16_t const stkSize,
                     void const * const par)
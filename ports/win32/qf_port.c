@@ -140,7 +140,7 @@ void QF_setWin32Prio(QActive *act, int_t win32Prio) {
 }
 
 /* QActive functions =======================================================*/
-void QActive_start_(QActive * const me, uint_fast8_t prio,
+void QActive_start_(QActive * const me, uint_fast16_t prio,
                     QEvt const * * const qSto, uint_fast16_t const qLen,
                     void * const stkSto, uint_fast16_t const stkSize,
                     void const * const par)
@@ -46,6 +46,10 @@
 #else
     #include "qs_dummy.h" /* disable the QS software tracing */
 #endif /* Q_SPY */
+#ifdef QHSM_SUPER_CACHE   /* the superstate cache uses QF critical section */
+    #include "qf_port.h"  /* QF port */
+    #include "qf_pkg.h"   /* QF package-scope interface */
+#endif
 
 Q_DEFINE_THIS_MODULE("qep_hsm")
 
@@ -80,6 +84,35 @@ static QEvt const QEP_reservedEvt_[] = {
 #define QEP_TRIG_(state_, sig_) \
     ((*(state_))(me, &QEP_reservedEvt_[(sig_)]))
 
+/*! helper macro to find the superstate of a state in an HSM (sets temp) */
+#ifndef QHSM_SUPER_CACHE
+    #define QEP_SUPER_(state_) QEP_TRIG_((state_), QEP_EMPTY_SIG_)
+#else
+    #define QEP_SUPER_(state_) QHsm_super_(me, (state_))
+
+    /*! helper macro to look up the superstate of a state in the cache */
+    #define QEP_CACHE_SUPER_(state_) \
+        (me->cache->super[QHsm_cacheFind_(me, (state_))])
+
+    /*! helper macro to look up the nesting depth of a state in the cache */
+    #define QEP_CACHE_DEPTH_(state_) \
+        (me->cache->depth[QHsm_cacheFind_(me, (state_))])
+
+    /* the state of a cache entry is published after its superstate and
+    * depth and is looked up without the critical section, see NOTE1
+    */
+    #if (defined __GNUC__) || (defined __clang__)
+    #define QEP_CACHE_STATE_(cache_, i_) \
+        (__atomic_load_n(&(cache_)->state[(i_)], __ATOMIC_ACQUIRE))
+    #define QEP_CACHE_PUBLISH_(cache_, i_, state_) \
+        (__atomic_store_n(&(cache_)->state[(i_)], (state_), __ATOMIC_RELEASE))
+    #else /* the critical section cannot be preempted (single core) */
+    #define QEP_CACHE_STATE_(cache_, i_) ((cache_)->state[(i_)])
+    #define QEP_CACHE_PUBLISH_(cache_, i_, state_) \
+        ((void)((cache_)->state[(i_)] = (state_)))
+    #endif
+#endif
+
 /*! helper macro to trigger exit action in an HSM */
 #define QEP_EXIT_(state_, qs_id_) do {                              \
     if (QEP_TRIG_((state_), Q_EXIT_SIG) == (QState)Q_RET_HANDLED) { \
@@ -104,12 +137,31 @@ static QEvt const QEP_reservedEvt_[] = {
 #ifdef Q_SPY
 static int_fast8_t QHsm_tran_(QHsm * const me,
                               QStateHandler path[QHSM_MAX_NEST_DEPTH_],
-                              uint_fast8_t const qs_id);
+                              uint_fast16_t const qs_id);
 #else
 static int_fast8_t QHsm_tran_(QHsm * const me,
                               QStateHandler path[QHSM_MAX_NEST_DEPTH_]);
 #endif
 
+#ifdef QHSM_SUPER_CACHE
+/*! helper function to find the superstate of a state (cache or probing) */
+static QState QHsm_super_(QHsm * const me, QStateHandler const state);
+
+/*! helper function to find the cache entry of a state (filled on a miss) */
+static uint_fast16_t QHsm_cacheFind_(QHsm * const me,
+                                     QStateHandler const state);
+
+/*! helper function to execute a transition chain with the cache */
+#ifdef Q_SPY
+static int_fast8_t QHsm_tranCache_(QHsm * const me,
+                                   QStateHandler path[QHSM_MAX_NEST_DEPTH_],
+                                   uint_fast16_t const qs_id);
+#else
+static int_fast8_t QHsm_tranCache_(QHsm * const me,
+                                   QStateHandler path[QHSM_MAX_NEST_DEPTH_]);
+#endif
+#endif /* QHSM_SUPER_CACHE */
+
 
 /****************************************************************************/
 /**
@@ -139,6 +191,9 @@ void QHsm_ctor(QHsm * const me, QStateHandler initial) {
     me->vptr      = &vtable;
     me->state.fun = Q_STATE_CAST(&QHsm_top);
     me->temp.fun  = initial;
+#ifdef QHSM_SUPER_CACHE
+    me->cache     = (QHsmSuperCache *)0; /* no cache, see QHsm_setCache() */
+#endif
 }
 
 /****************************************************************************/
@@ -154,7 +209,7 @@ void QHsm_ctor(QHsm * const me, QStateHandler initial) {
 */
 #ifdef Q_SPY
 void QHsm_init_(QHsm * const me, void const * const e,
-                uint_fast8_t const qs_id)
+                uint_fast16_t const qs_id)
 #else
 void QHsm_init_(QHsm * const me, void const * const e)
 #endif
@@ -189,12 +244,12 @@ void QHsm_init_(QHsm * const me, void const * const e)
         int_fast8_t ip = 0; /* tran entry path index */
 
         path[0] = me->temp.fun;
-        (void)QEP_TRIG_(me->temp.fun, QEP_EMPTY_SIG_);
+        (void)QEP_SUPER_(me->temp.fun);
         while (me->temp.fun != t) {
             ++ip;
             Q_ASSERT_ID(220, ip < (int_fast8_t)Q_DIM(path));
             path[ip] = me->temp.fun;
-            (void)QEP_TRIG_(me->temp.fun, QEP_EMPTY_SIG_);
+            (void)QEP_SUPER_(me->temp.fun);
         }
         me->temp.fun = path[0];
 
@@ -267,7 +322,7 @@ QState QHsm_top(void const * const me, QEvt const * const e) {
 */
 #ifdef Q_SPY
 void QHsm_dispatch_(QHsm * const me, QEvt const * const e,
-                    uint_fast8_t const qs_id)
+                    uint_fast16_t const qs_id)
 #else
 void QHsm_dispatch_(QHsm * const me, QEvt const * const e)
 #endif
@@ -303,7 +358,7 @@ void QHsm_dispatch_(QHsm * const me, QEvt const * const e)
                 QS_FUN_PRE_(s);      /* the current state */
             QS_END_PRE_()
 
-            r = QEP_TRIG_(s, QEP_EMPTY_SIG_); /* find superstate of s */
+            r = QEP_SUPER_(s); /* find superstate of s */
         }
     } while (r == (QState)Q_RET_SUPER);
 
@@ -324,15 +379,27 @@ void QHsm_dispatch_(QHsm * const me, QEvt const * const e)
                     QS_FUN_PRE_(t);   /* the exited state */
                 QS_END_PRE_()
 
-                (void)QEP_TRIG_(t, QEP_EMPTY_SIG_); /* find superstate of t */
+                (void)QEP_SUPER_(t); /* find superstate of t */
             }
         }
 
+#ifdef QHSM_SUPER_CACHE
+        if (me->cache != (QHsmSuperCache *)0) {
 #ifdef Q_SPY
-        ip = QHsm_tran_(me, path, qs_id);
+            ip = QHsm_tranCache_(me, path, qs_id);
 #else
-        ip = QHsm_tran_(me, path);
+            ip = QHsm_tranCache_(me, path);
 #endif
+        }
+        else
+#endif /* QHSM_SUPER_CACHE */
+        {
+#ifdef Q_SPY
+            ip = QHsm_tran_(me, path, qs_id);
+#else
+            ip = QHsm_tran_(me, path);
+#endif
+        }
 
 #ifdef Q_SPY
         if (r == (QState)Q_RET_TRAN_HIST) {
@@ -366,12 +433,12 @@ void QHsm_dispatch_(QHsm * const me, QEvt const * const e)
             ip = 0;
             path[0] = me->temp.fun;
 
-            (void)QEP_TRIG_(me->temp.fun, QEP_EMPTY_SIG_);/*find superstate */
+            (void)QEP_SUPER_(me->temp.fun);/*find superstate */
 
             while (me->temp.fun != t) {
                 ++ip;
                 path[ip] = me->temp.fun;
-                (void)QEP_TRIG_(me->temp.fun, QEP_EMPTY_SIG_);/* find super */
+                (void)QEP_SUPER_(me->temp.fun);/* find super */
             }
             me->temp.fun = path[0];
 
@@ -440,7 +507,7 @@ void QHsm_dispatch_(QHsm * const me, QEvt const * const e)
 #ifdef Q_SPY
 static int_fast8_t QHsm_tran_(QHsm * const me,
                               QStateHandler path[QHSM_MAX_NEST_DEPTH_],
-                              uint_fast8_t const qs_id)
+                              uint_fast16_t const qs_id)
 #else
 static int_fast8_t QHsm_tran_(QHsm * const me,
                               QStateHandler path[QHSM_MAX_NEST_DEPTH_])
@@ -576,6 +643,255 @@ static int_fast8_t QHsm_tran_(QHsm * const me,
     return ip;
 }
 
+#ifdef QHSM_SUPER_CACHE
+/****************************************************************************/
+/**
+* @description
+* Static helper function to find the superstate of a state in a HSM. It
+* stores the superstate in me->temp.fun, just like the state-handler
+* called with the empty signal, but takes it from the cache when a cache
+* is attached.
+*
+* @param[in,out] me    pointer (see @ref oop)
+* @param[in]     state pointer to the state-handler function
+*
+* @returns
+* #Q_RET_SUPER, or #Q_RET_IGNORED for QHsm_top() (without a superstate)
+*/
+static QState QHsm_super_(QHsm * const me, QStateHandler const state) {
+    QState r;
+
+    if (me->cache == (QHsmSuperCache *)0) { /* no cache attached? */
+        r = QEP_TRIG_(state, QEP_EMPTY_SIG_); /* probe the state-handler */
+    }
+    else if (state == Q_STATE_CAST(&QHsm_top)) {
+        r = (QState)Q_RET_IGNORED; /* the top state has no superstate */
+    }
+    else {
+        me->temp.fun = QEP_CACHE_SUPER_(state);
+        r = (QState)Q_RET_SUPER;
+    }
+    return r;
+}
+
+/****************************************************************************/
+/**
+* @description
+* Static helper function to find the entry of the state in the superstate
+* cache, or the free entry for the state when the state is not cached.
+*
+* @param[in] cache pointer to the superstate cache
+* @param[in] state pointer to the state-handler function
+*
+* @returns
+* the index of the entry of the @p state or of the free entry for it, or
+* QHSM_SUPER_CACHE when the state is not in the full cache
+*
+* @note
+* The cache is an open-addressing hash table indexed by the address of the
+* state-handler. The states are never removed from the cache. The function
+* does not need the critical section, but it can return the index of a free
+* entry that another thread fills meanwhile (see NOTE1).
+*/
+static uint_fast16_t QHsm_cacheSlot_(QHsmSuperCache const * const cache,
+                                     QStateHandler const state)
+{
+    /* Fibonacci hash of the address of the state-handler */
+    uint_fast16_t i = (uint_fast16_t)
+        ((((uint32_t)(uintptr_t)state * 0x9E3779B1U) >> 24)
+         & (QHSM_SUPER_CACHE - 1U));
+    uint_fast16_t n = (uint_fast16_t)QHSM_SUPER_CACHE;
+    QStateHandler s = QEP_CACHE_STATE_(cache, i);
+
+    /* linear probing until the state or a free entry is found... */
+    while ((s != state) && (s != Q_STATE_CAST(0))) {
+        --n;
+        if (n == 0U) { /* the whole cache probed? */
+            i = (uint_fast16_t)QHSM_SUPER_CACHE;
+            s = state; /* break out of the loop */
+        }
+        else {
+            i = (i + 1U) & (QHSM_SUPER_CACHE - 1U);
+            s = QEP_CACHE_STATE_(cache, i);
+        }
+    }
+    return i;
+}
+
+/****************************************************************************/
+/**
+* @description
+* Static helper function to find the entry of the state in the superstate
+* cache. Upon a cache miss, the function discovers the superstates of the
+* state with the empty signal up to a state already in the cache (or up to
+* QHsm_top()) and adds all the discovered states with their depths in the
+* critical section, so that the cache can be shared by the state machines
+* dispatched in different threads (see NOTE1).
+*
+* @param[in,out] me    pointer (see @ref oop)
+* @param[in]     state pointer to the state-handler function (not top)
+*
+* @returns
+* the index of the cache entry of the @p state
+*/
+static uint_fast16_t QHsm_cacheFind_(QHsm * const me,
+                                     QStateHandler const state)
+{
+    QHsmSuperCache * const cache = me->cache;
+    uint_fast16_t i = QHsm_cacheSlot_(cache, state);
+
+    /* cache miss? */
+    if ((i == (uint_fast16_t)QHSM_SUPER_CACHE)
+        || (QEP_CACHE_STATE_(cache, i) != state))
+    {
+        QStateHandler path[QHSM_MAX_NEST_DEPTH_]; /* the states to add */
+        QStateHandler s = state;
+        int_fast8_t ip = -1;
+        uint_fast8_t depth = 0U; /* the depth of QHsm_top() */
+        bool isKnown = false;
+        QF_CRIT_STAT_
+
+        /* discover the superstates up to a known state... */
+        do {
+            ++ip;
+            /* the state nesting must not be too deep */
+            Q_ASSERT_ID(710, ip < QHSM_MAX_NEST_DEPTH_);
+            path[ip] = s;
+            (void)QEP_TRIG_(s, QEP_EMPTY_SIG_); /* find superstate of s */
+            s = me->temp.fun;
+
+            if (s == Q_STATE_CAST(&QHsm_top)) {
+                isKnown = true;
+            }
+            else {
+                i = QHsm_cacheSlot_(cache, s);
+                if ((i < (uint_fast16_t)QHSM_SUPER_CACHE)
+                    && (QEP_CACHE_STATE_(cache, i) == s)) /* known? */
+                {
+                    depth = cache->depth[i];
+                    isKnown = true;
+                }
+            }
+        } while (!isKnown);
+
+        /* add the discovered states top-down with their superstates... */
+        QF_CRIT_OBJ_E_(cache);
+        do {
+            ++depth;
+            i = QHsm_cacheSlot_(cache, path[ip]);
+            /* the cache must not be full (too small QHSM_SUPER_CACHE) */
+            Q_ASSERT_CRIT_(700, i < (uint_fast16_t)QHSM_SUPER_CACHE);
+            /* not added by another thread meanwhile? */
+            if (cache->state[i] != path[ip]) {
+                cache->super[i] = s;
+                cache->depth[i] = (uint8_t)depth;
+                QEP_CACHE_PUBLISH_(cache, i, path[ip]); /* the last */
+            }
+            s = path[ip];
+            --ip;
+        } while (ip >= 0);
+        QF_CRIT_X_();
+    }
+    return i;
+}
+
+/****************************************************************************/
+/**
+* @description
+* Static helper function to execute transition sequence in a hierarchical
+* state machine (HSM) with the superstate cache attached. Unlike
+* QHsm_tran_(), this function finds the least common ancestor (LCA) of the
+* source and target by equalizing their nesting depths, so it makes only
+* one lookup per state on the exit and entry paths.
+*
+* @param[in,out] me   pointer (see @ref oop)
+* @param[in,out] path array of pointers to state-handler functions
+*                     to execute the entry actions
+* @param[in]     qs_id QS-id of this state machine (for QS local filter)
+*
+* @returns
+* the depth of the entry path stored in the @p path parameter.
+*
+* @note
+* The function exits and enters exactly the same states as QHsm_tran_():
+* the source is not exited when it is a superstate of the target, and
+* the target is not exited (nor entered) when it is a superstate of the
+* source, while the transition to self exits and enters the source.
+*/
+#ifdef Q_SPY
+static int_fast8_t QHsm_tranCache_(QHsm * const me,
+                                   QStateHandler path[QHSM_MAX_NEST_DEPTH_],
+                                   uint_fast16_t const qs_id)
+#else
+static int_fast8_t QHsm_tranCache_(QHsm * const me,
+                                   QStateHandler path[QHSM_MAX_NEST_DEPTH_])
+#endif
+{
+    int_fast8_t ip = -1; /* transition entry path index */
+    QStateHandler t = path[0];
+    QStateHandler const s = path[2];
+    QS_CRIT_STAT_
+
+    /* (a) check source==target (transition to self)... */
+    if (s == t) {
+        QEP_EXIT_(s, qs_id); /* exit the source */
+        ip = 0; /* enter the target */
+    }
+    else {
+        uint_fast8_t dt = QEP_CACHE_DEPTH_(t); /* depth of the target */
+        uint_fast8_t ds = QEP_CACHE_DEPTH_(s); /* depth of the source */
+
+        /* store the entry path of the target up to the source depth... */
+        while (dt > ds) {
+            ++ip;
+            /* entry path must not overflow */
+            Q_ASSERT_ID(720, ip < QHSM_MAX_NEST_DEPTH_);
+            path[ip] = t;
+            t = QEP_CACHE_SUPER_(t);
+            --dt;
+        }
+
+        /* the source is NOT a superstate of the target? */
+        if (t != s) {
+            QStateHandler u = QEP_CACHE_SUPER_(s); /* source->super */
+            uint_fast8_t du = (uint_fast8_t)(ds - 1U);
+
+            QEP_EXIT_(s, qs_id); /* exit the source */
+
+            /* exit the superstates of the source down to the target depth */
+            while (du > dt) {
+                QEP_EXIT_(u, qs_id);
+                u = QEP_CACHE_SUPER_(u);
+                --du;
+            }
+
+            /* store the entry path of the target down to the source depth */
+            while (dt > du) {
+                ++ip;
+                /* entry path must not overflow */
+                Q_ASSERT_ID(730, ip < QHSM_MAX_NEST_DEPTH_);
+                path[ip] = t;
+                t = QEP_CACHE_SUPER_(t);
+                --dt;
+            }
+
+            /* ascend on both sides (at the same depth) until the LCA... */
+            while (u != t) {
+                QEP_EXIT_(u, qs_id);
+                u = QEP_CACHE_SUPER_(u);
+
+                ++ip;
+                /* entry path must not overflow */
+                Q_ASSERT_ID(740, ip < QHSM_MAX_NEST_DEPTH_);
+                path[ip] = t;
+                t = QEP_CACHE_SUPER_(t);
+            }
+        }
+    }
+    return ip;
+}
+#endif /* QHSM_SUPER_CACHE */
+
 /****************************************************************************/
 /**
 * @description
@@ -605,7 +921,7 @@ bool QHsm_isIn(QHsm * const me, QStateHandler const state) {
             r = (QState)Q_RET_IGNORED; /* break out of the loop */
         }
         else {
-            r = QEP_TRIG_(me->temp.fun, QEP_EMPTY_SIG_);
+            r = QEP_SUPER_(me->temp.fun);
         }
     } while (r != (QState)Q_RET_IGNORED); /* QHsm_top() state not reached */
     me->temp.fun = me->state.fun; /* restore the stable state configuration */
@@ -653,7 +969,7 @@ QStateHandler QHsm_childState_(QHsm * const me,
         }
         else {
             child = me->temp.fun;
-            r = QEP_TRIG_(me->temp.fun, QEP_EMPTY_SIG_);
+            r = QEP_SUPER_(me->temp.fun);
         }
     } while (r != (QState)Q_RET_IGNORED); /* QHsm_top() state not reached */
     me->temp.fun = me->state.fun; /* establish stable state configuration */
@@ -667,3 +983,21 @@ QStateHandler QHsm_childState_(QHsm * const me,
     return child; /* return the child */
 }
 
+/*****************************************************************************
+* NOTE1:
+* The superstate cache (macro QHSM_SUPER_CACHE) can be shared by the state
+* machines dispatched in different threads, so it is filled in the QF
+* critical section (of the cache object with QF_CRIT_OBJ_ENTRY()), while
+* the lookups are made without it. Every new entry gets its superstate and
+* depth first and only then its state-handler, with the release store that
+* pairs with the acquire loads of the state-handlers in QHsm_cacheSlot_().
+* Therefore a thread that finds a state in the cache also sees its
+* superstate and depth. The entries are never changed after they have
+* been published and a state that two threads add concurrently is added
+* only once (in the critical section), so the lookups outside of the
+* critical section can only miss a state that is just being added, and
+* then they add it again in the critical section, where the state is found.
+* On the compilers without the atomic built-ins, the critical section
+* must not be preempted by the threads looking up the cache (e.g.,
+* single-core targets, where the critical section disables interrupts).
+*/
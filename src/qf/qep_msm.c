@@ -79,7 +79,7 @@ static struct QMState const l_msm_top_s = {
 #ifdef Q_SPY
 static QState QMsm_execTatbl_(QHsm * const me,
                               struct QMTranActTable const *tatbl,
-                              uint_fast8_t const qs_id);
+                              uint_fast16_t const qs_id);
 #else
 static QState QMsm_execTatbl_(QHsm * const me,
                               struct QMTranActTable const *tatbl);
@@ -91,7 +91,7 @@ static QState QMsm_execTatbl_(QHsm * const me,
 #ifdef Q_SPY
 static void QMsm_exitToTranSource_(QHsm * const me, QMState const *cs,
                                    QMState const *ts,
-                                   uint_fast8_t const qs_id);
+                                   uint_fast16_t const qs_id);
 #else
 static void QMsm_exitToTranSource_(QHsm * const me, QMState const *cs,
                                    QMState const *ts);
@@ -102,7 +102,7 @@ static void QMsm_exitToTranSource_(QHsm * const me, QMState const *cs,
 */
 #ifdef Q_SPY
 static QState QMsm_enterHistory_(QHsm * const me, QMState const * const hist,
-                                 uint_fast8_t const qs_id);
+                                 uint_fast16_t const qs_id);
 #else
 static QState QMsm_enterHistory_(QHsm * const me, QMState const * const hist);
 #endif
@@ -159,7 +159,7 @@ void QMsm_ctor(QMsm * const me, QStateHandler initial) {
 */
 #ifdef Q_SPY
 void QMsm_init_(QHsm * const me, void const * const e,
-                uint_fast8_t const qs_id)
+                uint_fast16_t const qs_id)
 #else
 void QMsm_init_(QHsm * const me, void const * const e)
 #endif
@@ -224,7 +224,7 @@ void QMsm_init_(QHsm * const me, void const * const e)
 */
 #ifdef Q_SPY
 void QMsm_dispatch_(QHsm * const me, QEvt const * const e,
-                    uint_fast8_t const qs_id)
+                    uint_fast16_t const qs_id)
 #else
 void QMsm_dispatch_(QHsm * const me, QEvt const * const e)
 #endif
@@ -432,7 +432,7 @@ void QMsm_dispatch_(QHsm * const me, QEvt const * const e)
 #ifdef Q_SPY
 static QState QMsm_execTatbl_(QHsm * const me,
                               struct QMTranActTable const *tatbl,
-                              uint_fast8_t const qs_id)
+                              uint_fast16_t const qs_id)
 #else
 static QState QMsm_execTatbl_(QHsm * const me,
                               struct QMTranActTable const *tatbl)
@@ -514,7 +514,7 @@ static QState QMsm_execTatbl_(QHsm * const me,
 #ifdef Q_SPY
 static void QMsm_exitToTranSource_(QHsm * const me, QMState const *cs,
                                    QMState const *ts,
-                                   uint_fast8_t const qs_id)
+                                   uint_fast16_t const qs_id)
 #else
 static void QMsm_exitToTranSource_(QHsm * const me, QMState const *cs,
                                    QMState const *ts)
@@ -562,7 +562,7 @@ static void QMsm_exitToTranSource_(QHsm * const me, QMState const *cs,
 */
 #ifdef Q_SPY
 static QState QMsm_enterHistory_(QHsm * const me, QMState const *const hist,
-                                 uint_fast8_t const qs_id)
+                                 uint_fast16_t const qs_id)
 #else
 static QState QMsm_enterHistory_(QHsm * const me, QMState const *const hist)
 #endif
@@ -68,7 +68,7 @@ QActive *QF_active_[QF_MAX_ACTIVE + 1U]; /* to be used by QF ports only */
 * @sa QF_remove_()
 */
 void QF_add_(QActive * const a) {
-    uint_fast8_t p = (uint_fast8_t)a->prio;
+    uint_fast16_t p = (uint_fast16_t)a->prio;
     QF_CRIT_STAT_
 
     /** @pre the priority of the active object must not be zero and cannot
@@ -101,7 +101,7 @@ void QF_add_(QActive * const a) {
 * @sa QF_add_()
 */
 void QF_remove_(QActive * const a) {
-    uint_fast8_t p = (uint_fast8_t)a->prio;
+    uint_fast16_t p = (uint_fast16_t)a->prio;
     QF_CRIT_STAT_
 
     /** @pre the priority of the active object must not be zero and cannot
@@ -185,3 +185,27 @@ void QF_bzero(void * const start, uint_fast16_t len) {
 
 #endif /* QF_LOG2 */
 
+#if (QF_MAX_ACTIVE > 64U)
+/****************************************************************************/
+/**
+* @description
+* Finds the maximum element in the hierarchical priority set of more than
+* 64 elements in two steps: the highest non-empty leaf from the summary
+* bitmask and then the highest element in that leaf.
+*
+* @param[in]  me  pointer to the priority set
+*
+* @returns the maximum element in the set or zero if the set is empty.
+*/
+uint_fast16_t QPSet_findMax_(QPSet const * const me) {
+    uint64_t const summary = me->summary;
+    uint_fast16_t n = 0U;
+    if (summary != 0U) {
+        uint_fast16_t const w = QF_LOG2_64_(summary) - 1U;
+        uint64_t const leaf = me->leaf[w];
+        n = (w << 6U) + QF_LOG2_64_(leaf);
+    }
+    return n;
+}
+#endif /* QF_MAX_ACTIVE > 64U */
+
@@ -5,6 +5,8 @@
 * @note
 * this source file is only included in the application build when the native
 * QF active object queue is used (instead of a message queue of an RTOS).
+* A QF port that replaces the native queue in the same build can define the
+* macro #QF_NON_NATIVE_EQUEUE to exclude the code in this file.
 *
 * @ingroup qf
 * @cond
@@ -53,8 +55,30 @@
     #include "qs_dummy.h" /* disable the QS software tracing */
 #endif /* Q_SPY */
 
+#if (defined QF_ACTIVE_LANES) && (defined QF_NON_NATIVE_EQUEUE)
+    #error "QF_ACTIVE_LANES requires the native QF event queue"
+#endif
+#if (defined QACTIVE_POST_CONFLATE_X) && (defined QF_NON_NATIVE_EQUEUE)
+    #error "QACTIVE_POST_CONFLATE_X() requires the native QF event queue"
+#endif
+
+#ifndef QF_NON_NATIVE_EQUEUE /* QF port uses the native ::QEQueue? */
+
 Q_DEFINE_THIS_MODULE("qf_actq")
 
+static bool QActive_conflates_(QEvt const * const q, QEvt const * const e,
+                               QEvtMatchHandler const match);
+static void QActive_pushFront_(QActive * const me, QEvt const * const e);
+#ifdef QF_ACTIVE_LANES
+static bool QActive_laneNext_(QActive * const me);
+#endif
+#ifdef QF_ACTIVE_GET_BATCH
+static QEvt const *QActive_batchPushFront_(QActive * const me,
+                                           QEvt const * const e);
+#ifdef QF_ACTIVE_LANES
+static QEvt const *QActive_laneGet_(QActive * const me);
+#endif
+#endif
 
 /****************************************************************************/
 #ifdef Q_SPY
@@ -104,7 +128,7 @@ bool QActive_post_(QActive * const me, QEvt const * const e,
     /** @pre event pointer must be valid */
     Q_REQUIRE_ID(100, e != (QEvt *)0);
 
-    QF_CRIT_E_();
+    QF_CRIT_OBJ_E_(&me->eQueue);
     nFree = me->eQueue.nFree; /* get volatile into the temporary */
 
     /* test-probe#1 for faking queue overflow */
@@ -214,6 +238,380 @@ bool QActive_post_(QActive * const me, QEvt const * const e,
     return status;
 }
 
+/****************************************************************************/
+#ifdef Q_SPY
+/**
+* @description
+* Posts the @p n events from the array @p batch to the event queue of the
+* active object @p me (FIFO, in the order of the array) in a single
+* critical section. The batch is admitted as a whole or not at all: the
+* posting succeeds only when the queue has room for all @p n events with
+* the @p margin of free slots still available afterwards. The consumer of
+* the queue is signaled at most once per batch.
+*
+* @param[in,out] me     pointer (see @ref oop)
+* @param[in]     batch  array of the events to be posted
+* @param[in]     n      number of events in the @p batch array
+* @param[in]     margin number of required free slots in the queue after
+*                       posting all the events. The special value
+*                       #QF_NO_MARGIN means that this function will assert
+*                       if posting fails.
+* @param[in]     sender pointer to a sender object (used only for QS tracing)
+*
+* @returns
+* 'true' (success) if all the events have been posted and 'false' (failure)
+* when none of them have been posted (the events are then recycled).
+*
+* @attention
+* This function should be called only via the macro QACTIVE_POST_BATCH().
+*
+* @note
+* Every posted event produces its own QS_QF_ACTIVE_POST trace record
+* (or QS_QF_ACTIVE_POST_ATTEMPT when the batch is rejected).
+*
+* @sa QActive_post_(), QACTIVE_POST_X()
+*/
+bool QActive_postBatch_(QActive * const me, QEvt const * const batch[],
+                        uint_fast16_t const n, uint_fast16_t const margin,
+                        void const * const sender)
+#else
+bool QActive_postBatch_(QActive * const me, QEvt const * const batch[],
+                        uint_fast16_t const n, uint_fast16_t const margin)
+#endif
+{
+    QEQueueCtr nFree; /* temporary to avoid UB for volatile access */
+    uint_fast16_t i;
+    bool status;
+    bool wasEmpty;
+    QF_CRIT_STAT_
+    QS_TEST_PROBE_DEF(&QActive_postBatch_)
+
+    /** @pre the batch must contain at least one event and the AO must
+    * not override the post operation (e.g., ::QTicker or ::QXThread)
+    */
+    Q_REQUIRE_ID(150, (batch != (QEvt const * const *)0) && (n != 0U)
+                      && QACTIVE_HAS_QF_POST_(me));
+
+    QF_CRIT_OBJ_E_(&me->eQueue);
+    nFree = me->eQueue.nFree; /* get volatile into the temporary */
+    wasEmpty = (me->eQueue.frontEvt == (QEvt *)0);
+
+    /* test-probe#1 for faking queue overflow */
+    QS_TEST_PROBE_ID(1,
+        nFree = 0U;
+    )
+
+    if (margin == QF_NO_MARGIN) {
+        if (nFree >= (QEQueueCtr)n) {
+            status = true; /* can post */
+        }
+        else {
+            status = false; /* cannot post */
+            Q_ERROR_CRIT_(160); /* must be able to post all the events */
+        }
+    }
+    else if ((nFree >= (QEQueueCtr)n)
+             && ((QEQueueCtr)(nFree - (QEQueueCtr)n) >= (QEQueueCtr)margin))
+    {
+        status = true; /* can post */
+    }
+    else {
+        status = false; /* cannot post, but don't assert */
+    }
+
+    for (i = 0U; i < n; ++i) {
+        QEvt const * const e = batch[i];
+
+        /* is it a dynamic event? */
+        if (e->poolId_ != 0U) {
+            QF_EVT_REF_CTR_INC_(e); /* increment the reference counter */
+        }
+
+        if (status) { /* can post the events? */
+            --nFree; /* one free entry just used up */
+
+            QS_BEGIN_NOCRIT_PRE_(QS_QF_ACTIVE_POST, me->prio)
+                QS_TIME_PRE_();      /* timestamp */
+                QS_OBJ_PRE_(sender); /* the sender object */
+                QS_SIG_PRE_(e->sig); /* the signal of the event */
+                QS_OBJ_PRE_(me);     /* this active object (recipient) */
+                QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & refCtr */
+                QS_EQC_PRE_(nFree);  /* number of free entries */
+                QS_EQC_PRE_((me->eQueue.nMin > nFree) /* min # free */
+                            ? nFree : me->eQueue.nMin);
+            QS_END_NOCRIT_PRE_()
+
+            /* empty queue? */
+            if (me->eQueue.frontEvt == (QEvt *)0) {
+                me->eQueue.frontEvt = e; /* deliver event directly */
+            }
+            /* queue is not empty, insert event into the ring-buffer */
+            else {
+                /* insert event into the ring buffer (FIFO) */
+                QF_PTR_AT_(me->eQueue.ring, me->eQueue.head) = e;
+
+                if (me->eQueue.head == 0U) { /* need to wrap head? */
+                    me->eQueue.head = me->eQueue.end; /* wrap around */
+                }
+                --me->eQueue.head; /* advance the head (counter clockwise) */
+            }
+        }
+        else { /* cannot post the events */
+            QS_BEGIN_NOCRIT_PRE_(QS_QF_ACTIVE_POST_ATTEMPT, me->prio)
+                QS_TIME_PRE_();      /* timestamp */
+                QS_OBJ_PRE_(sender); /* the sender object */
+                QS_SIG_PRE_(e->sig); /* the signal of the event */
+                QS_OBJ_PRE_(me);     /* this active object (recipient) */
+                QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & refCtr */
+                QS_EQC_PRE_(nFree);  /* number of free entries */
+                QS_EQC_PRE_(margin); /* margin requested */
+            QS_END_NOCRIT_PRE_()
+        }
+
+#ifdef Q_UTEST
+        /* callback to examine the posted event under the same conditions
+        * as producing the #QS_QF_ACTIVE_POST trace record, which are:
+        * the local filter for this AO ('me->prio') is set
+        */
+        if ((QS_priv_.locFilter[me->prio >> 3U]
+             & (1U << (me->prio & 7U))) != 0U)
+        {
+            QS_onTestPost(sender, me, e, status);
+        }
+#endif
+    }
+
+    if (status) { /* were the events posted? */
+        me->eQueue.nFree = nFree; /* update the volatile */
+        if (me->eQueue.nMin > nFree) {
+            me->eQueue.nMin = nFree; /* update minimum so far */
+        }
+
+        /* was the queue empty before this batch? */
+        if (wasEmpty) {
+            QACTIVE_EQUEUE_SIGNAL_(me); /* signal the event queue once */
+        }
+        QF_CRIT_X_();
+    }
+    else {
+        QF_CRIT_X_();
+
+        for (i = 0U; i < n; ++i) {
+            QF_gc(batch[i]); /* recycle the events to avoid a leak */
+        }
+    }
+
+    return status;
+}
+
+/****************************************************************************/
+#ifdef Q_SPY
+/**
+* @description
+* Posts the event @p e to the event queue of the active object @p me, but
+* first looks for an undelivered event in the queue with the same signal
+* as @p e, for which the optional function @p match returns 'true'. Such
+* an event is replaced in place by @p e, so @p e is delivered at the
+* position of the replaced (stale) event, and the replaced event is
+* recycled. Otherwise, @p e is posted at the end of the queue (FIFO).
+*
+* @param[in,out] me     pointer (see @ref oop)
+* @param[in]     e      pointer to the event to be posted
+* @param[in]     match  pointer to the function comparing the queued event
+*                       with @p e (e.g., by a key in the event parameters),
+*                       or NULL to replace any event with the same signal
+* @param[in]     margin number of required free slots in the queue after
+*                       posting the event (not used when an event is
+*                       replaced). The special value #QF_NO_MARGIN means
+*                       that this function will assert if posting fails.
+* @param[in]     sender pointer to a sender object (used only for QS tracing)
+*
+* @returns
+* 'true' (success) if the event has been posted or has replaced a queued
+* event, and 'false' (failure) when the posting fails.
+*
+* @attention
+* This function should be called only via the macro QACTIVE_POST_CONFLATE()
+* or QACTIVE_POST_CONFLATE_X().
+*
+* @note
+* The search takes linear time in the number of the queued events (in the
+* critical section), so the conflating post is intended for the queues
+* that it keeps short. With the priority lanes (#QF_ACTIVE_LANES), only
+* the lane 0 and the front location of the queue are searched.
+*
+* @sa QActive_post_(), QACTIVE_POST_CONFLATE_X()
+*/
+bool QActive_postConflate_(QActive * const me, QEvt const * const e,
+                           QEvtMatchHandler const match,
+                           uint_fast16_t const margin,
+                           void const * const sender)
+#else
+bool QActive_postConflate_(QActive * const me, QEvt const * const e,
+                           QEvtMatchHandler const match,
+                           uint_fast16_t const margin)
+#endif
+{
+    QEvt const *old = (QEvt *)0; /* the replaced (conflated) event */
+    QEQueueCtr nFree; /* temporary to avoid UB for volatile access */
+    bool status;
+    QF_CRIT_STAT_
+    QS_TEST_PROBE_DEF(&QActive_postConflate_)
+
+    /** @pre event pointer must be valid and the AO must not override
+    * the post operation (e.g., ::QTicker or ::QXThread)
+    */
+    Q_REQUIRE_ID(600, (e != (QEvt *)0) && QACTIVE_HAS_QF_POST_(me));
+
+    QF_CRIT_OBJ_E_(&me->eQueue);
+    nFree = me->eQueue.nFree; /* get volatile into the temporary */
+
+    /* is it a dynamic event? */
+    if (e->poolId_ != 0U) {
+        QF_EVT_REF_CTR_INC_(e); /* increment the reference counter */
+    }
+
+    /* any undelivered events in the queue? */
+    if (me->eQueue.frontEvt != (QEvt *)0) {
+        if (QActive_conflates_(me->eQueue.frontEvt, e, match)) {
+            old = me->eQueue.frontEvt;
+            me->eQueue.frontEvt = e; /* replace the front event */
+        }
+        else {
+            /* the number of events in the ring buffer */
+            QEQueueCtr n = (QEQueueCtr)(me->eQueue.end - nFree);
+            QEQueueCtr i = me->eQueue.tail; /* from the oldest event */
+
+            for (; (n != 0U) && (old == (QEvt *)0); --n) {
+                QEvt const * const q = QF_PTR_AT_(me->eQueue.ring, i);
+                if (QActive_conflates_(q, e, match)) {
+                    old = q;
+                    QF_PTR_AT_(me->eQueue.ring, i) = e; /* replace */
+                }
+                else {
+                    if (i == 0U) { /* need to wrap the index? */
+                        i = me->eQueue.end; /* wrap around */
+                    }
+                    --i; /* advance toward the head (counter clockwise) */
+                }
+            }
+        }
+    }
+
+    if (old != (QEvt *)0) { /* was a queued event replaced? */
+        status = true;
+
+        QS_BEGIN_NOCRIT_PRE_(QS_QF_ACTIVE_CONFLATE, me->prio)
+            QS_TIME_PRE_();      /* timestamp */
+            QS_OBJ_PRE_(sender); /* the sender object */
+            QS_SIG_PRE_(e->sig); /* the signal of the event */
+            QS_OBJ_PRE_(me);     /* this active object (recipient) */
+            QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
+            QS_EQC_PRE_(nFree);  /* number of free entries (unchanged) */
+        QS_END_NOCRIT_PRE_()
+    }
+    else {
+        /* test-probe#1 for faking queue overflow */
+        QS_TEST_PROBE_ID(1,
+            nFree = 0U;
+        )
+
+        if (margin == QF_NO_MARGIN) {
+            if (nFree > 0U) {
+                status = true; /* can post */
+            }
+            else {
+                status = false; /* cannot post */
+                Q_ERROR_CRIT_(610); /* must be able to post the event */
+            }
+        }
+        else if (nFree > (QEQueueCtr)margin) {
+            status = true; /* can post */
+        }
+        else {
+            status = false; /* cannot post, but don't assert */
+        }
+
+        if (status) { /* can post the event? */
+
+            --nFree; /* one free entry just used up */
+            me->eQueue.nFree = nFree; /* update the volatile */
+            if (me->eQueue.nMin > nFree) {
+                me->eQueue.nMin = nFree; /* increase minimum so far */
+            }
+
+            QS_BEGIN_NOCRIT_PRE_(QS_QF_ACTIVE_POST, me->prio)
+                QS_TIME_PRE_();      /* timestamp */
+                QS_OBJ_PRE_(sender); /* the sender object */
+                QS_SIG_PRE_(e->sig); /* the signal of the event */
+                QS_OBJ_PRE_(me);     /* this active object (recipient) */
+                QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & refCtr */
+                QS_EQC_PRE_(nFree);  /* number of free entries */
+                QS_EQC_PRE_(me->eQueue.nMin); /* min number of free entries */
+            QS_END_NOCRIT_PRE_()
+
+            /* empty queue? */
+            if (me->eQueue.frontEvt == (QEvt *)0) {
+                me->eQueue.frontEvt = e;    /* deliver event directly */
+                QACTIVE_EQUEUE_SIGNAL_(me); /* signal the event queue */
+            }
+            /* queue is not empty, insert event into the ring-buffer */
+            else {
+                /* insert event into the ring buffer (FIFO) */
+                QF_PTR_AT_(me->eQueue.ring, me->eQueue.head) = e;
+
+                if (me->eQueue.head == 0U) { /* need to wrap head? */
+                    me->eQueue.head = me->eQueue.end; /* wrap around */
+                }
+                --me->eQueue.head; /* advance the head (counter clockwise) */
+            }
+        }
+        else { /* cannot post the event */
+
+            QS_BEGIN_NOCRIT_PRE_(QS_QF_ACTIVE_POST_ATTEMPT, me->prio)
+                QS_TIME_PRE_();      /* timestamp */
+                QS_OBJ_PRE_(sender); /* the sender object */
+                QS_SIG_PRE_(e->sig); /* the signal of the event */
+                QS_OBJ_PRE_(me);     /* this active object (recipient) */
+                QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & refCtr */
+                QS_EQC_PRE_(nFree);  /* number of free entries */
+                QS_EQC_PRE_(margin); /* margin requested */
+            QS_END_NOCRIT_PRE_()
+
+            old = e; /* recycle the event to avoid a leak */
+        }
+    }
+
+#ifdef Q_UTEST
+    /* callback to examine the posted event under the same conditions
+    * as producing the #QS_QF_ACTIVE_POST trace record, which are:
+    * the local filter for this AO ('me->prio') is set
+    */
+    if ((QS_priv_.locFilter[me->prio >> 3U]
+         & (1U << (me->prio & 7U))) != 0U)
+    {
+        QS_onTestPost(sender, me, e, status);
+    }
+#endif
+
+    QF_CRIT_X_();
+
+    if (old != (QEvt *)0) {
+        QF_gc(old); /* recycle the replaced (or not posted) event */
+    }
+
+    return status;
+}
+
+/****************************************************************************/
+/* can the queued event 'q' be replaced by the event 'e'? */
+static bool QActive_conflates_(QEvt const * const q, QEvt const * const e,
+                               QEvtMatchHandler const match)
+{
+    return (q->sig == e->sig)
+           && ((match == (QEvtMatchHandler)0) || (*match)(q, e));
+}
+
 /****************************************************************************/
 /**
 * @description
@@ -233,12 +631,12 @@ bool QActive_post_(QActive * const me, QEvt const * const e,
 * @sa QActive_post_(), QACTIVE_POST(), QACTIVE_POST_X()
 */
 void QActive_postLIFO_(QActive * const me, QEvt const * const e) {
-    QEvt const *frontEvt;  /* temporary to avoid UB for volatile access */
+    QEvt const *qe = e;    /* the event to insert at the front of the queue */
     QEQueueCtr nFree;      /* temporary to avoid UB for volatile access */
     QF_CRIT_STAT_
     QS_TEST_PROBE_DEF(&QActive_postLIFO_)
 
-    QF_CRIT_E_();
+    QF_CRIT_OBJ_E_(&me->eQueue);
     nFree = me->eQueue.nFree; /* get volatile into the temporary */
 
     /* test-probe#1 for faking queue overflow */
@@ -246,20 +644,29 @@ void QActive_postLIFO_(QActive * const me, QEvt const * const e) {
         nFree = 0U;
     )
 
-    /* the queue must be able to accept the event (cannot overflow) */
-    Q_ASSERT_CRIT_(210, nFree != 0U);
+#ifdef QF_ACTIVE_GET_BATCH
+    /* any events of the current batch not dispatched yet? see NOTE2 */
+    if (me->batchNext < me->batchEnd) {
+        qe = QActive_batchPushFront_(me, e); /* deliver before the rest */
+    }
+    if (qe != (QEvt *)0) /* must the queue take an event? */
+#endif
+    {
+        /* the queue must be able to accept the event (cannot overflow) */
+        Q_ASSERT_CRIT_(210, nFree != 0U);
+
+        --nFree; /* one free entry just used up */
+        me->eQueue.nFree = nFree; /* update the volatile */
+        if (me->eQueue.nMin > nFree) {
+            me->eQueue.nMin = nFree; /* update minimum so far */
+        }
+    }
 
     /* is it a dynamic event? */
     if (e->poolId_ != 0U) {
         QF_EVT_REF_CTR_INC_(e); /* increment the reference counter */
     }
 
-    --nFree; /* one free entry just used up */
-    me->eQueue.nFree = nFree; /* update the volatile */
-    if (me->eQueue.nMin > nFree) {
-        me->eQueue.nMin = nFree; /* update minimum so far */
-    }
-
     QS_BEGIN_NOCRIT_PRE_(QS_QF_ACTIVE_POST_LIFO, me->prio)
         QS_TIME_PRE_();      /* timestamp */
         QS_SIG_PRE_(e->sig); /* the signal of this event */
@@ -281,6 +688,22 @@ void QActive_postLIFO_(QActive * const me, QEvt const * const e) {
         }
 #endif
 
+#ifdef QF_ACTIVE_GET_BATCH
+    if (qe != (QEvt *)0) /* not taken by the batch? */
+#endif
+    {
+        QActive_pushFront_(me, qe);
+    }
+    QF_CRIT_X_();
+}
+
+/****************************************************************************/
+/* insert the event at the front of the queue, that is, before all the events
+* in all lanes (must be called in the critical section)
+*/
+static void QActive_pushFront_(QActive * const me, QEvt const * const e) {
+    QEvt const *frontEvt;  /* temporary to avoid UB for volatile access */
+
     frontEvt = me->eQueue.frontEvt; /* read volatile into the temporary */
     me->eQueue.frontEvt = e; /* deliver the event directly to the front */
 
@@ -288,6 +711,25 @@ void QActive_postLIFO_(QActive * const me, QEvt const * const e) {
     if (frontEvt == (QEvt *)0) {
         QACTIVE_EQUEUE_SIGNAL_(me); /* signal the event queue */
     }
+#ifdef QF_ACTIVE_LANES
+    /* was the front event from a higher lane? return it there, NOTE1 */
+    else if (me->frontLane != 0U) {
+        QEQueue * const lq = &me->lane[me->frontLane - 1U];
+
+        me->frontLane = 0U;
+        ++me->eQueue.nFree; /* front event no longer in the lane 0 */
+
+        if (lq->frontEvt != (QEvt *)0) { /* the lane not empty? */
+            ++lq->tail;
+            /* need to wrap the tail? */
+            if (lq->tail == lq->end) {
+                lq->tail = 0U; /* wrap around */
+            }
+            QF_PTR_AT_(lq->ring, lq->tail) = lq->frontEvt;
+        }
+        lq->frontEvt = frontEvt; /* back to the front of the lane */
+    }
+#endif
     /* queue was not empty, leave the event in the ring-buffer */
     else {
         ++me->eQueue.tail;
@@ -298,9 +740,243 @@ void QActive_postLIFO_(QActive * const me, QEvt const * const e) {
 
         QF_PTR_AT_(me->eQueue.ring, me->eQueue.tail) = frontEvt;
     }
+}
+
+#ifdef QF_ACTIVE_LANES
+/****************************************************************************/
+/**
+* @description
+* Provides the storage for the priority lane @p lane of the event queue of
+* the active object @p me. The lane 0 is the event queue provided to
+* QACTIVE_START(), so @p lane must be in the range 1..#QF_ACTIVE_LANES-1.
+* Just like the lane 0, the lane can hold up to @p qLen + 1 events.
+*
+* @param[in,out] me    pointer (see @ref oop)
+* @param[in]     lane  the priority lane (1..#QF_ACTIVE_LANES-1)
+* @param[in]     qSto  pointer to the storage for the ring buffer of the lane
+* @param[in]     qLen  length of the ring buffer of the lane (might be 0)
+*
+* @note
+* This function must be called after the constructor of the active object
+* and before QACTIVE_START(). The lanes without storage cannot accept any
+* events.
+*
+* @sa QACTIVE_POST_LANE(), QACTIVE_POST_LANE_X()
+*/
+void QActive_setLane(QActive * const me, uint_fast8_t const lane,
+                     QEvt const * * const qSto, uint_fast16_t const qLen)
+{
+    /** @pre the lane must be in range and must not hold any events */
+    Q_REQUIRE_ID(500, (0U < lane)
+                      && (lane < (uint_fast8_t)QF_ACTIVE_LANES)
+                      && (me->lane[lane - 1U].frontEvt == (QEvt *)0));
+
+    QEQueue_init(&me->lane[lane - 1U], qSto, qLen);
+}
+
+/****************************************************************************/
+#ifdef Q_SPY
+/**
+* @description
+* Posts the event @p e to the priority lane @p lane of the event queue of
+* the active object @p me (see NOTE1). The events from the higher lanes are
+* delivered before the events from the lower lanes, and the events within
+* one lane are delivered in the FIFO order. The lane 0 is the regular event
+* queue of the active object, so posting to it is the same as calling
+* QActive_post_().
+*
+* @param[in,out] me     pointer (see @ref oop)
+* @param[in]     e      pointer to the event to be posted
+* @param[in]     lane   the priority lane (0..#QF_ACTIVE_LANES-1)
+* @param[in]     margin number of required free slots in the lane after
+*                       posting the event. The special value #QF_NO_MARGIN
+*                       means that this function will assert if posting fails.
+* @param[in]     sender pointer to a sender object (used only for QS tracing)
+*
+* @returns
+* 'true' (success) if the posting succeeded (with the provided margin) and
+* 'false' (failure) when the posting fails.
+*
+* @attention
+* This function should be called only via the macro QACTIVE_POST_LANE()
+* or QACTIVE_POST_LANE_X().
+*
+* @sa QActive_setLane(), QActive_post_()
+*/
+bool QActive_postLane_(QActive * const me, QEvt const * const e,
+                       uint_fast8_t const lane, uint_fast16_t const margin,
+                       void const * const sender)
+#else
+bool QActive_postLane_(QActive * const me, QEvt const * const e,
+                       uint_fast8_t const lane, uint_fast16_t const margin)
+#endif
+{
+    QEQueue *lq;       /* the lane of the event queue */
+    QEQueueCtr nFree;  /* temporary to avoid UB for volatile access */
+    bool status;
+    QF_CRIT_STAT_
+    QS_TEST_PROBE_DEF(&QActive_postLane_)
+
+    /** @pre event pointer must be valid, the lane in range and the AO
+    * must not override the post operation (e.g., ::QTicker or ::QXThread)
+    */
+    Q_REQUIRE_ID(510, (e != (QEvt *)0)
+                      && (lane < (uint_fast8_t)QF_ACTIVE_LANES)
+                      && QACTIVE_HAS_QF_POST_(me));
+
+    lq = (lane == 0U) ? &me->eQueue : &me->lane[lane - 1U];
+
+    QF_CRIT_OBJ_E_(&me->eQueue);
+    nFree = lq->nFree; /* get volatile into the temporary */
+
+    /* test-probe#1 for faking queue overflow */
+    QS_TEST_PROBE_ID(1,
+        nFree = 0U;
+    )
+
+    if (margin == QF_NO_MARGIN) {
+        if (nFree > 0U) {
+            status = true; /* can post */
+        }
+        else {
+            status = false; /* cannot post */
+            Q_ERROR_CRIT_(520); /* must be able to post the event */
+        }
+    }
+    else if (nFree > (QEQueueCtr)margin) {
+        status = true; /* can post */
+    }
+    else {
+        status = false; /* cannot post, but don't assert */
+    }
+
+    /* is it a dynamic event? */
+    if (e->poolId_ != 0U) {
+        QF_EVT_REF_CTR_INC_(e); /* increment the reference counter */
+    }
+
+    if (status) { /* can post the event? */
+
+#ifdef QF_ACTIVE_GET_BATCH
+        if (lane != 0U) { /* higher lane? */
+            me->batchBreak = 1U; /* deliver before the rest, see NOTE2 */
+        }
+#endif
+
+        /* empty queue (all lanes empty)? */
+        if (me->eQueue.frontEvt == (QEvt *)0) {
+            me->eQueue.frontEvt = e; /* deliver event directly */
+            if (lane != 0U) { /* the front location used by a higher lane? */
+                me->frontLane = (uint8_t)lane;
+                --me->eQueue.nFree; /* see NOTE1 */
+            }
+            QACTIVE_EQUEUE_SIGNAL_(me); /* signal the event queue */
+        }
+        /* empty higher lane? */
+        else if (lq->frontEvt == (QEvt *)0) {
+            lq->frontEvt = e; /* deliver event to the front of the lane */
+        }
+        /* the lane is not empty, insert event into its ring-buffer */
+        else {
+            /* insert event into the ring buffer (FIFO) */
+            QF_PTR_AT_(lq->ring, lq->head) = e;
+
+            if (lq->head == 0U) { /* need to wrap head? */
+                lq->head = lq->end; /* wrap around */
+            }
+            --lq->head; /* advance the head (counter clockwise) */
+        }
+
+        --nFree; /* one free entry just used up */
+        lq->nFree = nFree; /* update the volatile */
+        if (lq->nMin > nFree) {
+            lq->nMin = nFree; /* increase minimum so far */
+        }
+
+        QS_BEGIN_NOCRIT_PRE_(QS_QF_ACTIVE_POST, me->prio)
+            QS_TIME_PRE_();      /* timestamp */
+            QS_OBJ_PRE_(sender); /* the sender object */
+            QS_SIG_PRE_(e->sig); /* the signal of the event */
+            QS_OBJ_PRE_(me);     /* this active object (recipient) */
+            QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
+            QS_EQC_PRE_(nFree);  /* number of free entries */
+            QS_EQC_PRE_(lq->nMin); /* min number of free entries */
+        QS_END_NOCRIT_PRE_()
+    }
+    else { /* cannot post the event */
+
+        QS_BEGIN_NOCRIT_PRE_(QS_QF_ACTIVE_POST_ATTEMPT, me->prio)
+            QS_TIME_PRE_();       /* timestamp */
+            QS_OBJ_PRE_(sender);  /* the sender object */
+            QS_SIG_PRE_(e->sig);  /* the signal of the event */
+            QS_OBJ_PRE_(me);      /* this active object (recipient) */
+            QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
+            QS_EQC_PRE_(nFree);   /* number of free entries */
+            QS_EQC_PRE_(margin);  /* margin requested */
+        QS_END_NOCRIT_PRE_()
+    }
+
+#ifdef Q_UTEST
+    /* callback to examine the posted event under the same conditions
+    * as producing the #QS_QF_ACTIVE_POST trace record, which are:
+    * the local filter for this AO ('me->prio') is set
+    */
+    if ((QS_priv_.locFilter[me->prio >> 3U]
+         & (1U << (me->prio & 7U))) != 0U)
+    {
+        QS_onTestPost(sender, me, e, status);
+    }
+#endif
+
     QF_CRIT_X_();
+
+    if (!status) {
+        QF_gc(e); /* recycle the event to avoid a leak */
+    }
+
+    return status;
 }
 
+/****************************************************************************/
+/* free the lane entry of the event just removed from the front location and
+* move the front event of the highest non-empty higher-priority lane to the
+* front location (must be called in the critical section), see NOTE1
+*/
+static bool QActive_laneNext_(QActive * const me) {
+    uint_fast8_t k;
+    bool found = false;
+
+    if (me->frontLane != 0U) { /* was the removed event from a lane? */
+        ++me->lane[me->frontLane - 1U].nFree; /* free its entry */
+        me->frontLane = 0U;
+    }
+
+    for (k = (uint_fast8_t)QF_ACTIVE_LANES - 1U; (k != 0U) && (!found); --k)
+    {
+        QEQueue * const lq = &me->lane[k - 1U];
+        if (lq->frontEvt != (QEvt *)0) { /* any events in this lane? */
+            me->eQueue.frontEvt = lq->frontEvt; /* move to the front */
+            me->frontLane = (uint8_t)k; /* the entry in lane stays used */
+
+            /* any more events in the ring buffer of the lane? */
+            if (lq->nFree < lq->end) {
+                /* remove event from the tail */
+                lq->frontEvt = QF_PTR_AT_(lq->ring, lq->tail);
+                if (lq->tail == 0U) { /* need to wrap the tail? */
+                    lq->tail = lq->end; /* wrap around */
+                }
+                --lq->tail;
+            }
+            else {
+                lq->frontEvt = (QEvt *)0; /* the lane becomes empty */
+            }
+            found = true;
+        }
+    }
+    return found;
+}
+#endif /* QF_ACTIVE_LANES */
+
 /****************************************************************************/
 /**
 * @description
@@ -328,13 +1004,29 @@ QEvt const *QActive_get_(QActive * const me) {
     QEvt const *e;
     QF_CRIT_STAT_
 
-    QF_CRIT_E_();
+    QF_CRIT_OBJ_E_(&me->eQueue);
     QACTIVE_EQUEUE_WAIT_(me);  /* wait for event to arrive directly */
 
     e = me->eQueue.frontEvt; /* always remove event from the front location */
     nFree = me->eQueue.nFree + 1U; /* get volatile into tmp */
     me->eQueue.nFree = nFree; /* update the number of free */
 
+#ifdef QF_ACTIVE_LANES
+    /* any events in the higher-priority lanes? see NOTE1 */
+    if (QActive_laneNext_(me)) {
+        --nFree; /* the event from the lane takes the front location */
+        me->eQueue.nFree = nFree; /* update the number of free */
+
+        QS_BEGIN_NOCRIT_PRE_(QS_QF_ACTIVE_GET, me->prio)
+            QS_TIME_PRE_();      /* timestamp */
+            QS_SIG_PRE_(e->sig); /* the signal of this event */
+            QS_OBJ_PRE_(me);     /* this active object */
+            QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
+            QS_EQC_PRE_(nFree);  /* # free entries */
+        QS_END_NOCRIT_PRE_()
+    }
+    else
+#endif
     /* any events in the ring buffer? */
     if (nFree <= me->eQueue.end) {
 
@@ -370,6 +1062,272 @@ QEvt const *QActive_get_(QActive * const me) {
     return e;
 }
 
+#ifdef QF_ACTIVE_GET_BATCH
+/****************************************************************************/
+/**
+* @description
+* Removes up to @p max events from the event queue of an active object
+* in a single critical section. Just like QActive_get_(), this function
+* can block (depending on QACTIVE_EQUEUE_WAIT_()) until at least one event
+* is available, but it never blocks waiting for more events.
+*
+* @param[in,out] me     pointer (see @ref oop)
+* @param[out]    batch  array receiving the removed events
+* @param[in]     max    capacity of the @p batch array
+*
+* @returns
+* the number of events removed into @p batch (at least 1).
+*
+* @note
+* The function produces the same QS_QF_ACTIVE_GET/QS_QF_ACTIVE_GET_LAST
+* trace records for every removed event as the calls to QActive_get_()
+* would. The events must be then obtained one by one with
+* QActive_batchNext_() (rather than directly from the @p batch array),
+* which keeps the order of events posted with QActive_postLIFO_() and to
+* the higher priority lanes during the batch (see NOTE2).
+*
+* @sa QActive_get_(), QActive_batchNext_()
+*/
+uint_fast16_t QActive_getBatch_(QActive * const me,
+                                QEvt const * * const batch,
+                                uint_fast16_t const max)
+{
+    QEQueueCtr nFree;
+    uint_fast16_t n = 0U;
+#ifdef QF_ACTIVE_LANES
+    bool more;
+#else
+    bool const more = true;
+#endif
+    QF_CRIT_STAT_
+
+    /** @pre the batch must be able to hold at least one event */
+    Q_REQUIRE_ID(320, max != 0U);
+
+    QF_CRIT_OBJ_E_(&me->eQueue);
+    QACTIVE_EQUEUE_WAIT_(me);  /* wait for event to arrive directly */
+
+    nFree = me->eQueue.nFree; /* get volatile into tmp */
+#ifdef QF_ACTIVE_LANES
+    /* an event from a higher lane makes a batch of its own, see NOTE2 */
+    more = (me->frontLane == 0U);
+    me->batchBreak = 0U;
+#endif
+    do {
+        QEvt const *e = me->eQueue.frontEvt; /* remove from the front */
+        batch[n] = e;
+        ++n;
+        ++nFree;
+
+#ifdef QF_ACTIVE_LANES
+        /* any events in the higher-priority lanes? see NOTE1 */
+        if (QActive_laneNext_(me)) {
+            --nFree; /* the event from the lane takes the front location */
+
+            QS_BEGIN_NOCRIT_PRE_(QS_QF_ACTIVE_GET, me->prio)
+                QS_TIME_PRE_();      /* timestamp */
+                QS_SIG_PRE_(e->sig); /* the signal of this event */
+                QS_OBJ_PRE_(me);     /* this active object */
+                QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
+                QS_EQC_PRE_(nFree);  /* # free entries */
+            QS_END_NOCRIT_PRE_()
+        }
+        else
+#endif
+        /* any events in the ring buffer? */
+        if (nFree <= me->eQueue.end) {
+
+            /* remove event from the tail */
+            me->eQueue.frontEvt = QF_PTR_AT_(me->eQueue.ring,
+                                             me->eQueue.tail);
+            if (me->eQueue.tail == 0U) { /* need to wrap the tail? */
+                me->eQueue.tail = me->eQueue.end;   /* wrap around */
+            }
+            --me->eQueue.tail;
+
+            QS_BEGIN_NOCRIT_PRE_(QS_QF_ACTIVE_GET, me->prio)
+                QS_TIME_PRE_();      /* timestamp */
+                QS_SIG_PRE_(e->sig); /* the signal of this event */
+                QS_OBJ_PRE_(me);     /* this active object */
+                QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
+                QS_EQC_PRE_(nFree);  /* # free entries */
+            QS_END_NOCRIT_PRE_()
+        }
+        else {
+            me->eQueue.frontEvt = (QEvt *)0; /* queue becomes empty */
+
+            /* all entries in the queue must be free (+1 for fronEvt) */
+            Q_ASSERT_CRIT_(330, nFree == (me->eQueue.end + 1U));
+
+            QS_BEGIN_NOCRIT_PRE_(QS_QF_ACTIVE_GET_LAST, me->prio)
+                QS_TIME_PRE_();      /* timestamp */
+                QS_SIG_PRE_(e->sig); /* the signal of this event */
+                QS_OBJ_PRE_(me);     /* this active object */
+                QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
+            QS_END_NOCRIT_PRE_()
+        }
+#ifdef QF_ACTIVE_LANES
+        if (me->frontLane != 0U) { /* next event from a higher lane? */
+            more = false; /* leave it for the next batch */
+        }
+#endif
+    } while ((n < max) && (me->eQueue.frontEvt != (QEvt *)0) && more);
+
+    me->eQueue.nFree = nFree; /* update the number of free */
+
+    /* the events of the batch are now ahead of the queue, see NOTE2 */
+    me->batch     = batch;
+    me->batchNext = 0U;
+    me->batchEnd  = n;
+    QF_CRIT_X_();
+    return n;
+}
+
+/****************************************************************************/
+/**
+* @description
+* Delivers the events of the batch obtained by QActive_getBatch_() one by
+* one, including the events inserted in front of the batch with
+* QActive_postLIFO_() during the batch (see NOTE2). With the priority lanes
+* (#QF_ACTIVE_LANES) the events posted to the higher lanes during the batch
+* are delivered before the rest of the batch.
+*
+* @param[in,out] me  pointer (see @ref oop)
+*
+* @returns
+* the next event to dispatch, or NULL at the end of the batch.
+*
+* @note
+* This function must be called only by the thread of the active object,
+* which has obtained the batch.
+*
+* @sa QActive_getBatch_()
+*/
+QEvt const *QActive_batchNext_(QActive * const me) {
+    QEvt const *e = (QEvt *)0;
+
+#ifdef QF_ACTIVE_LANES
+    /* any events posted to the higher lanes during the batch? */
+    if ((me->batchBreak != 0U) && (me->batchNext < me->batchEnd)) {
+        QF_CRIT_STAT_
+        QF_CRIT_OBJ_E_(&me->eQueue);
+        e = QActive_laneGet_(me);
+        if (e == (QEvt *)0) { /* no more events in the higher lanes? */
+            me->batchBreak = 0U;
+        }
+        QF_CRIT_X_();
+    }
+    if (e == (QEvt *)0)
+#endif
+    {
+        if (me->batchNext < me->batchEnd) { /* not the end of the batch? */
+            e = me->batch[me->batchNext];
+            ++me->batchNext;
+        }
+    }
+    return e;
+}
+
+/****************************************************************************/
+/* insert the event in front of the undispatched rest of the batch. The slots
+* before the rest are free, because their events have been dispatched. When
+* no slot is free, the last event of the batch moves to the front of the
+* queue and is returned, so that the caller can charge it to the queue.
+* (must be called in the critical section), see NOTE2
+*/
+static QEvt const *QActive_batchPushFront_(QActive * const me,
+                                           QEvt const * const e)
+{
+    QEvt const *qe = (QEvt *)0;
+
+    if (me->batchNext == 0U) { /* no free slot in front of the rest? */
+        uint_fast16_t i;
+
+        i = me->batchEnd - 1U;
+        qe = me->batch[i]; /* the last event goes back to the queue */
+        for (; i > 0U; --i) { /* shift the rest to make the free slot */
+            me->batch[i] = me->batch[i - 1U];
+        }
+        ++me->batchNext;
+    }
+    --me->batchNext;
+    me->batch[me->batchNext] = e;
+
+    return qe;
+}
+
+#ifdef QF_ACTIVE_LANES
+/****************************************************************************/
+/* remove the next event of the higher lanes, which is delivered before the
+* undispatched rest of the batch, or return NULL when the higher lanes are
+* empty (must be called in the critical section), see NOTE2
+*/
+static QEvt const *QActive_laneGet_(QActive * const me) {
+    QEvt const *e = (QEvt *)0;
+
+    if (me->frontLane != 0U) { /* a higher-lane event at the front? */
+        e = me->eQueue.frontEvt; /* remove it from the front */
+        ++me->eQueue.nFree;
+
+        if (QActive_laneNext_(me)) { /* the next higher-lane event? */
+            --me->eQueue.nFree; /* it takes the front location */
+        }
+        /* any events in the ring buffer of the lane 0? */
+        else if (me->eQueue.nFree <= me->eQueue.end) {
+            me->eQueue.frontEvt = QF_PTR_AT_(me->eQueue.ring,
+                                             me->eQueue.tail);
+            if (me->eQueue.tail == 0U) { /* need to wrap the tail? */
+                me->eQueue.tail = me->eQueue.end; /* wrap around */
+            }
+            --me->eQueue.tail;
+        }
+        else {
+            me->eQueue.frontEvt = (QEvt *)0; /* queue becomes empty */
+        }
+    }
+    else {
+        uint_fast8_t k;
+        /* take the front event of the highest non-empty lane directly,
+        * while the event at the front of the lane 0 stays in place
+        */
+        for (k = (uint_fast8_t)QF_ACTIVE_LANES - 1U;
+             (k != 0U) && (e == (QEvt *)0);
+             --k)
+        {
+            QEQueue * const lq = &me->lane[k - 1U];
+            if (lq->frontEvt != (QEvt *)0) { /* any events in this lane? */
+                e = lq->frontEvt;
+
+                /* any more events in the ring buffer of the lane? */
+                if (lq->nFree < lq->end) {
+                    lq->frontEvt = QF_PTR_AT_(lq->ring, lq->tail);
+                    if (lq->tail == 0U) { /* need to wrap the tail? */
+                        lq->tail = lq->end; /* wrap around */
+                    }
+                    --lq->tail;
+                }
+                else {
+                    lq->frontEvt = (QEvt *)0; /* the lane becomes empty */
+                }
+                ++lq->nFree; /* free the entry of the removed event */
+            }
+        }
+    }
+
+    if (e != (QEvt *)0) {
+        QS_BEGIN_NOCRIT_PRE_(QS_QF_ACTIVE_GET, me->prio)
+            QS_TIME_PRE_();      /* timestamp */
+            QS_SIG_PRE_(e->sig); /* the signal of this event */
+            QS_OBJ_PRE_(me);     /* this active object */
+            QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
+            QS_EQC_PRE_(me->eQueue.nFree); /* # free entries */
+        QS_END_NOCRIT_PRE_()
+    }
+    return e;
+}
+#endif /* QF_ACTIVE_LANES */
+#endif /* QF_ACTIVE_GET_BATCH */
+
 /****************************************************************************/
 /**
 * @description
@@ -388,15 +1346,19 @@ QEvt const *QActive_get_(QActive * const me) {
 * @returns
 * the minimum of free ever present in the given event queue of an active
 * object with priority @p prio, since the active object was started.
+*
+* @note
+* With the priority lanes (#QF_ACTIVE_LANES) this is the minimum of the
+* lane 0. The minimum of the lane k is QEQueue_getNMin(&ao->lane[k-1]).
 */
-uint_fast16_t QF_getQueueMin(uint_fast8_t const prio) {
+uint_fast16_t QF_getQueueMin(uint_fast16_t const prio) {
     uint_fast16_t min;
     QF_CRIT_STAT_
 
     Q_REQUIRE_ID(400, (prio <= QF_MAX_ACTIVE)
                       && (QF_active_[prio] != (QActive *)0));
 
-    QF_CRIT_E_();
+    QF_CRIT_OBJ_E_(&QF_active_[prio]->eQueue);
     min = (uint_fast16_t)QF_active_[prio]->eQueue.nMin;
     QF_CRIT_X_();
 
@@ -407,9 +1369,9 @@ uint_fast16_t QF_getQueueMin(uint_fast8_t const prio) {
 
 #ifdef Q_SPY
     static void QTicker_init_(QHsm * const me, void const *par,
-                              uint_fast8_t const qs_id);
+                              uint_fast16_t const qs_id);
     static void QTicker_dispatch_(QHsm * const me, QEvt const * const e,
-                              uint_fast8_t const qs_id);
+                              uint_fast16_t const qs_id);
     /*! virtual function to asynchronously post (FIFO) an event to an AO */
     static bool QTicker_post_(QActive * const me, QEvt const * const e,
                    uint_fast16_t const margin, void const * const sender);
@@ -452,7 +1414,7 @@ void QTicker_ctor(QTicker * const me, uint_fast8_t tickRate) {
 /*..........................................................................*/
 #ifdef Q_SPY
 static void QTicker_init_(QHsm * const me, void const *par,
-                              uint_fast8_t const qs_id)
+                              uint_fast16_t const qs_id)
 #else
 static void QTicker_init_(QHsm * const me, void const *par)
 #endif
@@ -467,7 +1429,7 @@ static void QTicker_init_(QHsm * const me, void const *par)
 /*..........................................................................*/
 #ifdef Q_SPY
 static void QTicker_dispatch_(QHsm * const me, QEvt const * const e,
-                              uint_fast8_t const qs_id)
+                              uint_fast16_t const qs_id)
 #else
 static void QTicker_dispatch_(QHsm * const me, QEvt const * const e)
 #endif
@@ -480,7 +1442,7 @@ static void QTicker_dispatch_(QHsm * const me, QEvt const * const e)
     (void)qs_id; /* unused parameter */
 #endif
 
-    QF_CRIT_E_();
+    QF_CRIT_OBJ_E_(&QTICKER_CAST_(me)->eQueue);
     nTicks = QTICKER_CAST_(me)->eQueue.tail; /* save the # of ticks */
     QTICKER_CAST_(me)->eQueue.tail = 0U; /* clear the # ticks */
     QF_CRIT_X_();
@@ -504,7 +1466,7 @@ static bool QTicker_post_(QActive * const me, QEvt const * const e,
     (void)e; /* unused parameter */
     (void)margin; /* unused parameter */
 
-    QF_CRIT_E_();
+    QF_CRIT_OBJ_E_(&me->eQueue);
     if (me->eQueue.frontEvt == (QEvt *)0) {
 
         static QEvt const tickEvt = { 0U, 0U, 0U };
@@ -537,3 +1499,51 @@ static void QTicker_postLIFO_(QActive * const me, QEvt const * const e) {
     Q_ERROR_ID(900);
 }
 
+#endif /* QF_NON_NATIVE_EQUEUE */
+
+/*****************************************************************************
+* NOTE1:
+* With the priority lanes (macro QF_ACTIVE_LANES), the event queue of an
+* active object consists of the lane 0 (the regular eQueue) and the higher
+* lanes 1..QF_ACTIVE_LANES-1 (the lane[] array), each with its own ring
+* buffer, number of free entries and the low watermark. The front location
+* of the eQueue holds the next event to deliver from any lane, so the QF
+* ports keep detecting the empty/non-empty queue by eQueue.frontEvt only.
+* Whenever QActive_get_() frees the front location, it moves there the
+* front event of the highest non-empty lane, and only when all the higher
+* lanes are empty, the next event from the ring buffer of the lane 0.
+*
+* An event moved to the front location from a higher lane (frontLane != 0)
+* keeps its entry in that lane and also uses one entry of the lane 0 until
+* it is delivered. This costs one entry of each lane at most, but the ring
+* buffer of the lane 0 cannot overflow and QActive_postLIFO_() can always
+* return the event to the front of its lane, so the events within a lane
+* are never reordered.
+*
+* An event in the front location is delivered next regardless of its lane,
+* so an urgent event waits at most for the event currently in processing
+* and for one event already at the front, independently of the number of
+* events in the lower lanes.
+*
+* NOTE2:
+* The events removed by QActive_getBatch_() are no longer in the queue, but
+* they must still be delivered before all events left in the queue. The
+* batch array is therefore treated as the front part of the queue, which
+* only the thread of the active object accesses. QActive_postLIFO_()
+* (self-posting, e.g., QActive_recall()) during the batch inserts the event
+* in front of the undispatched rest of the batch, into the slot freed by
+* the event just dispatched, so the event is delivered next, exactly as
+* without batching. Only when more events are posted LIFO in one RTC step
+* than there are free slots, the last event of the batch moves back to the
+* front of the queue, which costs the queue entry that the LIFO post
+* would use anyway, so the queue can never overflow. The batch array is
+* accessed without the critical section, so with the batching the LIFO
+* posts to an AO must come from the AO itself (e.g., QActive_recall()),
+* which is the intended use of the LIFO policy anyway.
+*
+* With the priority lanes, an event from a higher lane always makes a batch
+* of its own, so the undispatched rest of a batch holds only the events of
+* the lane 0. The events posted to the higher lanes during the batch set the
+* batchBreak flag, and then QActive_batchNext_() delivers them before the
+* rest of the batch, without reordering the events within any lane.
+*/
@@ -126,7 +126,7 @@ bool QActive_recall(QActive * const me, QEQueue * const eq) {
 
         QACTIVE_POST_LIFO(me, e); /* post it to the front of the AO's queue */
 
-        QF_CRIT_E_();
+        QF_CRIT_OBJ_E_(e);
 
         /* is it a dynamic event? */
         if (e->poolId_ != 0U) {
@@ -50,11 +50,88 @@
 
 Q_DEFINE_THIS_MODULE("qf_dyn")
 
+#ifdef QF_EVT_MAGAZINE
+#ifndef QF_THREAD_LOCAL
+    #error "QF_EVT_MAGAZINE requires QF_THREAD_LOCAL in the QF port"
+#endif
+#if (QF_EVT_MAGAZINE < 2)
+    #error "QF_EVT_MAGAZINE must be at least 2"
+#endif
+#endif /* QF_EVT_MAGAZINE */
+
 
 /* Package-scope objects ****************************************************/
 QF_EPOOL_TYPE_ QF_pool_[QF_MAX_EPOOL]; /* allocate the event pools */
 uint_fast8_t QF_maxPool_; /* number of initialized event pools */
 
+#ifdef QF_EVT_MAGAZINE
+/*! thread-local cache of free blocks of one event pool, see NOTE1 */
+typedef struct {
+    void *blk[QF_EVT_MAGAZINE]; /*!< the cached free blocks (LIFO) */
+    uint_fast16_t n;            /*!< the number of cached blocks */
+} QFMagazine;
+
+/* QS ID of the event pool idx_ for the pool operations of the magazines */
+#ifdef Q_SPY
+    #define QF_MAG_QS_ID_(idx_) ((uint_fast16_t)QS_EP_ID + (idx_) + 1U)
+#else
+    #define QF_MAG_QS_ID_(idx_) 0U
+#endif
+
+/* the event magazines of the calling thread, one for every event pool */
+static QF_THREAD_LOCAL QFMagazine l_magazine[QF_MAX_EPOOL];
+
+static QEvt *QF_magazineGet_(uint_fast8_t const idx,
+                             uint_fast16_t const margin);
+static void QF_magazinePut_(uint_fast8_t const idx, QEvt * const e);
+#endif /* QF_EVT_MAGAZINE */
+
+#ifdef QF_EVT_SIZE_LUT
+/* the granule (in bytes) of the event sizes in the size-class table */
+#define QF_SIZE_CLASS_GRAN_   ((uint_fast16_t)sizeof(QFreeBlock))
+
+/* the size-class table: the event size in granules (rounded up) maps to
+* the index of the smallest event pool that can hold it, plus one
+* (0 means no pool), see NOTE3
+*/
+static uint8_t l_sizeClass[((QF_EVT_SIZE_LUT + sizeof(QFreeBlock) - 1U)
+                            / sizeof(QFreeBlock)) + 1U];
+#endif /* QF_EVT_SIZE_LUT */
+
+#ifdef QF_EPOOL_STATS
+/* can the statistics be updated without the critical section? NOTE5 */
+#if (defined __GCC_ATOMIC_INT_LOCK_FREE) \
+    && (__GCC_ATOMIC_INT_LOCK_FREE == 2) \
+    && (__GCC_ATOMIC_SHORT_LOCK_FREE == 2)
+    #define QF_EPOOL_STATS_ATOMIC_
+#endif
+
+/* the allocation statistics of the event pools, see QF_getPoolStats() */
+static QPoolStats l_poolStats[QF_MAX_EPOOL];
+
+static void QF_poolStatsUpdate_(uint_fast8_t const idx,
+                                uint_fast16_t const evtSize,
+                                bool const allocated);
+#endif /* QF_EPOOL_STATS */
+
+#ifdef QF_EVT_PAYLOAD
+/* the pool ID of the payload events follows all regular event pools */
+#define QF_PAYLOAD_POOL_ID_   ((uint_fast8_t)QF_MAX_EPOOL + 1U)
+
+/* QS ID of the payload event pool */
+#ifdef Q_SPY
+    #define QF_PAYLOAD_QS_ID_ ((uint_fast16_t)QS_EP_ID + QF_PAYLOAD_POOL_ID_)
+#else
+    #define QF_PAYLOAD_QS_ID_ 0U
+#endif
+
+/* the event pool of the payload events, see NOTE4 */
+static QF_EPOOL_TYPE_ l_payloadPool;
+#endif /* QF_EVT_PAYLOAD */
+
+static void QF_poolAdd_(void);
+static void QF_gcRecycle_(QEvt const * const e);
+
 /****************************************************************************/
 #ifdef Q_EVT_CTOR  /* Provide the constructor for the ::QEvt class? */
 
@@ -104,6 +181,14 @@ QEvt *QEvt_ctor(QEvt * const me, enum_t const sig) {
 * of the blocks that the pool might perform. You can always check the
 * capacity of the pool by calling QF_getPoolMin().
 *
+* @note When the macro #QF_MPOOL_LOCKFREE is defined, its value is the
+* bitmask of the event pools managed without the critical section (bit 0
+* for the first pool, bit 1 for the second, etc.). See QMPool_initLockFree().
+*
+* @note When the macro #QF_EVT_SIZE_LUT is defined, QF_poolInit() also
+* records the event sizes served by the pool in the size-class table used
+* by QF_newX_() (see NOTE3).
+*
 * @note The dynamic allocation of events is optional, meaning that you
 * might choose not to use dynamic events. In that case calling QF_poolInit()
 * and using up memory for the memory blocks is unnecessary.
@@ -121,14 +206,123 @@ void QF_poolInit(void * const poolSto, uint_fast32_t const poolSize,
             < evtSize));
 
     /* perform the platform-dependent initialization of the pool */
+#ifdef QF_MPOOL_LOCKFREE
+    /* the bit (poolId - 1) of QF_MPOOL_LOCKFREE selects a lock-free pool */
+    if ((((uint_fast32_t)QF_MPOOL_LOCKFREE >> QF_maxPool_) & 1U) != 0U) {
+        QMPool_initLockFree(&QF_pool_[QF_maxPool_], poolSto, poolSize,
+                            evtSize);
+    }
+    else {
+        QF_EPOOL_INIT_(QF_pool_[QF_maxPool_], poolSto, poolSize, evtSize);
+    }
+#else
     QF_EPOOL_INIT_(QF_pool_[QF_maxPool_], poolSto, poolSize, evtSize);
+#endif
+    QF_poolAdd_(); /* one more pool */
+}
+
+#ifdef QF_MPOOL_ELASTIC
+/****************************************************************************/
+/**
+* @description
+* Initializes the next event pool as an elastic memory pool, which starts
+* with @p nInit blocks of @p evtSize bytes and grows by @p nGrow blocks,
+* up to @p nMax blocks, whenever its free blocks drop to @p lowMark
+* (see QMPool_initElastic()). The storage of the pool is provided by the
+* QF port, so no @c poolSto is needed. Otherwise, the elastic event pool
+* is the same as the pools initialized with QF_poolInit() and must
+* follow the same ascending order of @p evtSize.
+*
+* @param[in] evtSize the block-size of the pool in bytes
+* @param[in] nInit   the initial number of blocks in the pool
+* @param[in] nMax    the maximum number of blocks in the pool
+* @param[in] nGrow   the number of blocks the pool grows by at once
+* @param[in] lowMark the number of free blocks triggering the growth
+*
+* @sa QF_poolTrim()
+*/
+void QF_poolInitElastic(uint_fast16_t const evtSize,
+                        uint_fast32_t const nInit, uint_fast32_t const nMax,
+                        uint_fast16_t const nGrow,
+                        uint_fast16_t const lowMark)
+{
+    /** @pre cannot exceed the number of available memory pools */
+    Q_REQUIRE_ID(200, QF_maxPool_ < Q_DIM(QF_pool_));
+    /** @pre please initialize event pools in ascending order of evtSize: */
+    Q_REQUIRE_ID(201, (QF_maxPool_ == 0U)
+        || (QF_EPOOL_EVENT_SIZE_(QF_pool_[QF_maxPool_ - 1U])
+            < evtSize));
+
+    QMPool_initElastic(&QF_pool_[QF_maxPool_], evtSize, nInit, nMax,
+                       nGrow, lowMark);
+    QF_poolAdd_(); /* one more pool */
+}
+
+/****************************************************************************/
+/**
+* @description
+* Releases the blocks that the elastic event pool has grown by, as long
+* as they are all free (see QMPool_trim()). The application can call this
+* function periodically, for example when it is idle, so that the memory
+* of the event pools tracks the actual load.
+*
+* @param[in] poolId  event pool ID in the range 1..QF_maxPool_
+*
+* @returns
+* the number of event blocks released (0 for the regular event pools).
+*
+* @note
+* The event blocks cached in the event magazines (QF_EVT_MAGAZINE) count
+* as used, so call QF_magazineFlush() first in the threads that allocate
+* from the elastic event pools.
+*/
+uint_fast32_t QF_poolTrim(uint_fast8_t const poolId) {
+    /** @pre the poolId must be in range */
+    Q_REQUIRE_ID(210, (0U < poolId) && (poolId <= QF_maxPool_));
+
+#ifdef Q_SPY
+    return QMPool_trim(&QF_pool_[poolId - 1U],
+                       (uint_fast16_t)QS_EP_ID + poolId);
+#else
+    return QMPool_trim(&QF_pool_[poolId - 1U], 0U);
+#endif
+}
+#endif /* QF_MPOOL_ELASTIC */
+
+/****************************************************************************/
+/* register the just initialized event pool QF_pool_[QF_maxPool_] */
+static void QF_poolAdd_(void) {
     ++QF_maxPool_; /* one more pool */
 
+#ifdef QF_EVT_SIZE_LUT
+    /* map the event sizes not covered by the smaller pools to this pool */
+    {
+        uint_fast32_t const size =
+            (uint_fast32_t)QF_EPOOL_EVENT_SIZE_(QF_pool_[QF_maxPool_ - 1U]);
+        uint_fast16_t i;
+        for (i = 0U; i < (uint_fast16_t)Q_DIM(l_sizeClass); ++i) {
+            /* the smallest size in the granule i is (i-1)*GRAN + 1 */
+            if ((l_sizeClass[i] == 0U)
+                && (((uint_fast32_t)i * QF_SIZE_CLASS_GRAN_)
+                    < (size + QF_SIZE_CLASS_GRAN_)))
+            {
+                l_sizeClass[i] = (uint8_t)QF_maxPool_;
+            }
+        }
+    }
+#endif /* QF_EVT_SIZE_LUT */
+
 #ifdef Q_SPY
     /* generate the object-dictionary entry for the initialized pool */
     {
-        char_t obj_name[9] = "EvtPool?";
-        obj_name[7] = '0' + (QF_maxPool_ & 0x7FU);
+        char_t obj_name[10] = "EvtPool?";
+        if (QF_maxPool_ < 10U) {
+            obj_name[7] = (char_t)('0' + QF_maxPool_);
+        }
+        else {
+            obj_name[7] = (char_t)('0' + (QF_maxPool_ / 10U));
+            obj_name[8] = (char_t)('0' + (QF_maxPool_ % 10U));
+        }
         QS_obj_dict_pre_(&QF_pool_[QF_maxPool_ - 1U], obj_name);
     }
 #endif /* Q_SPY*/
@@ -168,8 +362,23 @@ QEvt *QF_newX_(uint_fast16_t const evtSize,
     uint_fast8_t idx;
     QS_CRIT_STAT_
 
+#ifdef QF_EVT_SIZE_LUT
+    /* look up the smallest pool that might fit the event size, NOTE3 */
+    {
+        uint_fast16_t i = (evtSize + QF_SIZE_CLASS_GRAN_ - 1U)
+                          / QF_SIZE_CLASS_GRAN_;
+        if (i >= (uint_fast16_t)Q_DIM(l_sizeClass)) { /* above the table? */
+            i = (uint_fast16_t)Q_DIM(l_sizeClass) - 1U;
+        }
+        idx = (uint_fast8_t)l_sizeClass[i];
+        idx = (idx != 0U) ? (idx - 1U) : QF_maxPool_;
+    }
+#else
+    idx = 0U;
+#endif /* QF_EVT_SIZE_LUT */
+
     /* find the pool index that fits the requested event size ... */
-    for (idx = 0U; idx < QF_maxPool_; ++idx) {
+    for (; idx < QF_maxPool_; ++idx) {
         if (evtSize <= QF_EPOOL_EVENT_SIZE_(QF_pool_[idx])) {
             break;
         }
@@ -178,22 +387,28 @@ QEvt *QF_newX_(uint_fast16_t const evtSize,
     Q_ASSERT_ID(310, idx < QF_maxPool_);
 
     /* get e -- platform-dependent */
-#ifdef Q_SPY
+#ifdef QF_EVT_MAGAZINE
+    e = QF_magazineGet_(idx, margin);
+#elif (defined Q_SPY)
     QF_EPOOL_GET_(QF_pool_[idx], e,
                   ((margin != QF_NO_MARGIN) ? margin : 0U),
-                  (uint_fast8_t)QS_EP_ID + idx + 1U);
+                  (uint_fast16_t)QS_EP_ID + idx + 1U);
 #else
     QF_EPOOL_GET_(QF_pool_[idx], e,
                   ((margin != QF_NO_MARGIN) ? margin : 0U), 0U);
 #endif
 
+#ifdef QF_EPOOL_STATS
+    QF_poolStatsUpdate_(idx, evtSize, e != (QEvt *)0);
+#endif
+
     /* was e allocated correctly? */
     if (e != (QEvt *)0) {
         e->sig = (QSignal)sig;     /* set signal for this event */
         e->poolId_ = (uint8_t)(idx + 1U); /* store the pool ID */
         e->refCtr_ = 0U; /* set the reference counter to 0 */
 
-        QS_BEGIN_PRE_(QS_QF_NEW, (uint_fast8_t)QS_EP_ID + e->poolId_)
+        QS_BEGIN_PRE_(QS_QF_NEW, (uint_fast16_t)QS_EP_ID + e->poolId_)
             QS_TIME_PRE_();        /* timestamp */
             QS_EVS_PRE_(evtSize);  /* the size of the event */
             QS_SIG_PRE_(sig);      /* the signal of the event */
@@ -204,7 +419,7 @@ QEvt *QF_newX_(uint_fast16_t const evtSize,
         /* must tolerate failed allocation */
         Q_ASSERT_ID(320, margin != QF_NO_MARGIN);
 
-        QS_BEGIN_PRE_(QS_QF_NEW_ATTEMPT, (uint_fast8_t)QS_EP_ID + idx + 1U)
+        QS_BEGIN_PRE_(QS_QF_NEW_ATTEMPT, (uint_fast16_t)QS_EP_ID + idx + 1U)
             QS_TIME_PRE_();        /* timestamp */
             QS_EVS_PRE_(evtSize);  /* the size of the event */
             QS_SIG_PRE_(sig);      /* the signal of the event */
@@ -241,14 +456,44 @@ void QF_gc(QEvt const * const e) {
 
     /* is it a dynamic event? */
     if (e->poolId_ != 0U) {
+#ifdef QF_EVT_REF_CTR_ATOMIC
+        /* atomic reference counting, see NOTE2 */
+        QEvtRefCtr const ctr = QF_EVT_REF_CTR_GET_(e);
+#ifdef Q_SPY
+        QSignal const sig = e->sig;        /* e might be recycled by... */
+        uint8_t const poolId = e->poolId_; /* ...another thread, NOTE2 */
+#endif
+        QS_CRIT_STAT_
+
+        /* isn't this the last reference? */
+        if ((ctr > 1U) && (QF_EVT_REF_CTR_DEC_(e) != 0U)) {
+            QS_BEGIN_PRE_(QS_QF_GC_ATTEMPT,
+                          (uint_fast16_t)QS_EP_ID + poolId)
+                QS_TIME_PRE_();         /* timestamp */
+                QS_SIG_PRE_(sig);       /* the signal of the event */
+                QS_2U8_PRE_(poolId, ctr); /* pool Id & ref Count */
+            QS_END_PRE_()
+        }
+        /* this is the last reference to this event, recycle it */
+        else {
+            QS_BEGIN_PRE_(QS_QF_GC,
+                          (uint_fast16_t)QS_EP_ID + e->poolId_)
+                QS_TIME_PRE_();         /* timestamp */
+                QS_SIG_PRE_(sig);       /* the signal of the event */
+                QS_2U8_PRE_(e->poolId_, ctr); /* pool Id & ref Count */
+            QS_END_PRE_()
+
+            QF_gcRecycle_(e);
+        }
+#else
         QF_CRIT_STAT_
-        QF_CRIT_E_();
+        QF_CRIT_OBJ_E_(e);
 
         /* isn't this the last reference? */
         if (e->refCtr_ > 1U) {
 
             QS_BEGIN_NOCRIT_PRE_(QS_QF_GC_ATTEMPT,
-                                 (uint_fast8_t)QS_EP_ID + e->poolId_)
+                                 (uint_fast16_t)QS_EP_ID + e->poolId_)
                 QS_TIME_PRE_();         /* timestamp */
                 QS_SIG_PRE_(e->sig);    /* the signal of the event */
                 QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
@@ -260,10 +505,8 @@ void QF_gc(QEvt const * const e) {
         }
         /* this is the last reference to this event, recycle it */
         else {
-            uint_fast8_t idx = (uint_fast8_t)e->poolId_ - 1U;
-
             QS_BEGIN_NOCRIT_PRE_(QS_QF_GC,
-                                 (uint_fast8_t)QS_EP_ID + e->poolId_)
+                                 (uint_fast16_t)QS_EP_ID + e->poolId_)
                 QS_TIME_PRE_();         /* timestamp */
                 QS_SIG_PRE_(e->sig);    /* the signal of the event */
                 QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
@@ -271,17 +514,44 @@ void QF_gc(QEvt const * const e) {
 
             QF_CRIT_X_();
 
-            /* pool ID must be in range */
-            Q_ASSERT_ID(410, idx < QF_maxPool_);
+            QF_gcRecycle_(e);
+        }
+#endif /* QF_EVT_REF_CTR_ATOMIC */
+    }
+}
 
-            /* cast 'const' away, which is OK, because it's a pool event */
-#ifdef Q_SPY
-            QF_EPOOL_PUT_(QF_pool_[idx], QF_EVT_CONST_CAST_(e),
-                          (uint_fast8_t)QS_EP_ID + e->poolId_);
+/****************************************************************************/
+/*! return the dynamic event @p e without references back to its pool */
+static void QF_gcRecycle_(QEvt const * const e) {
+    uint_fast8_t idx = (uint_fast8_t)e->poolId_ - 1U;
+
+#ifdef QF_EVT_PAYLOAD
+    /* a payload event? */
+    if (idx == (QF_PAYLOAD_POOL_ID_ - 1U)) {
+        QPayload * const payload = ((QPayloadEvt const *)e)->payload;
+
+        /* cast 'const' away, which is OK, because it's a pool event */
+        QF_EPOOL_PUT_(l_payloadPool, QF_EVT_CONST_CAST_(e),
+                      QF_PAYLOAD_QS_ID_);
+
+        /* the event no longer references the payload */
+        QPayload_release(payload);
+    }
+    else
+#endif /* QF_EVT_PAYLOAD */
+    {
+        /* pool ID must be in range */
+        Q_ASSERT_ID(410, idx < QF_maxPool_);
+
+        /* cast 'const' away, which is OK, because it's a pool event */
+#ifdef QF_EVT_MAGAZINE
+        QF_magazinePut_(idx, QF_EVT_CONST_CAST_(e));
+#elif (defined Q_SPY)
+        QF_EPOOL_PUT_(QF_pool_[idx], QF_EVT_CONST_CAST_(e),
+                      (uint_fast16_t)QS_EP_ID + e->poolId_);
 #else
-            QF_EPOOL_PUT_(QF_pool_[idx], QF_EVT_CONST_CAST_(e), 0U);
+        QF_EPOOL_PUT_(QF_pool_[idx], QF_EVT_CONST_CAST_(e), 0U);
 #endif
-        }
     }
 }
 
@@ -309,12 +579,12 @@ QEvt const *QF_newRef_(QEvt const * const e, void const * const evtRef) {
         (e->poolId_ != 0U)
         && (evtRef == (void *)0));
 
-    QF_CRIT_E_();
+    QF_CRIT_OBJ_E_(e);
 
     QF_EVT_REF_CTR_INC_(e); /* increments the ref counter */
 
     QS_BEGIN_NOCRIT_PRE_(QS_QF_NEW_REF,
-                         (uint_fast8_t)QS_EP_ID + e->poolId_)
+                         (uint_fast16_t)QS_EP_ID + e->poolId_)
         QS_TIME_PRE_();      /* timestamp */
         QS_SIG_PRE_(e->sig); /* the signal of the event */
         QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
@@ -340,7 +610,7 @@ void QF_deleteRef_(void const * const evtRef) {
     QEvt const * const e = (QEvt const *)evtRef;
 
     QS_BEGIN_PRE_(QS_QF_DELETE_REF,
-                  (uint_fast8_t)QS_EP_ID + e->poolId_)
+                  (uint_fast16_t)QS_EP_ID + e->poolId_)
         QS_TIME_PRE_();      /* timestamp */
         QS_SIG_PRE_(e->sig); /* the signal of the event */
         QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
@@ -358,3 +628,476 @@ uint_fast16_t QF_poolGetMaxBlockSize(void) {
     return QF_EPOOL_EVENT_SIZE_(QF_pool_[QF_maxPool_ - 1U]);
 }
 
+#ifdef QF_EVT_PAYLOAD
+/****************************************************************************/
+/**
+* @description
+* Initializes the event pool for the payload events (see ::QPayloadEvt).
+* The payload events are allocated only from this pool by the macros
+* Q_NEW_PAYLOAD() and Q_NEW_PAYLOAD_X() and never by Q_NEW(), so the pool
+* can be initialized in any order relative to the regular event pools
+* initialized with QF_poolInit(). The pool has the pool ID
+* (#QF_MAX_EPOOL + 1).
+*
+* @param[in] poolSto  pointer to the storage for the event pool
+* @param[in] poolSize size of the storage for the pool in bytes
+* @param[in] evtSize  the block-size of the pool in bytes, which must be
+*                     at least sizeof(QPayloadEvt)
+*/
+void QF_payloadPoolInit(void * const poolSto, uint_fast32_t const poolSize,
+                        uint_fast16_t const evtSize)
+{
+    /** @pre the pool must not be initialized yet and the blocks must
+    * fit the payload events */
+    Q_REQUIRE_ID(700, (QF_EPOOL_EVENT_SIZE_(l_payloadPool) == 0U)
+                      && (evtSize >= (uint_fast16_t)sizeof(QPayloadEvt)));
+
+    QF_EPOOL_INIT_(l_payloadPool, poolSto, poolSize, evtSize);
+
+#ifdef Q_SPY
+    /* generate the object-dictionary entry for the payload pool */
+    QS_obj_dict_pre_(&l_payloadPool, "PayloadPool");
+#endif /* Q_SPY*/
+}
+
+/****************************************************************************/
+/**
+* @description
+* Allocates a payload event from the payload event pool and attaches the
+* external payload to it, which adds one reference to the payload.
+*
+* @param[in] evtSize the size (in bytes) of the event to allocate
+* @param[in] margin  the number of un-allocated events still available
+*                    in the payload pool after the allocation completes.
+*                    The special value #QF_NO_MARGIN means that this
+*                    function will assert if allocation fails.
+* @param[in] sig     the signal to be assigned to the allocated event
+* @param[in] payload the external payload to attach to the event
+*
+* @returns
+* pointer to the newly allocated event. This pointer can be NULL only if
+* margin != #QF_NO_MARGIN and the event cannot be allocated with the
+* specified margin still available in the payload pool.
+*
+* @note
+* The application code should not call this function directly.
+* The only allowed use is thorough the macros Q_NEW_PAYLOAD() or
+* Q_NEW_PAYLOAD_X().
+*/
+QPayloadEvt *QF_newPayload_(uint_fast16_t const evtSize,
+                            uint_fast16_t const margin, enum_t const sig,
+                            QPayload * const payload)
+{
+    QEvt *e;
+    QS_CRIT_STAT_
+
+    /** @pre the payload must be provided and the event must fit in
+    * the blocks of the (initialized) payload pool */
+    Q_REQUIRE_ID(710, (payload != (QPayload *)0)
+                      && (evtSize <= QF_EPOOL_EVENT_SIZE_(l_payloadPool)));
+
+    QF_EPOOL_GET_(l_payloadPool, e,
+                  ((margin != QF_NO_MARGIN) ? margin : 0U),
+                  QF_PAYLOAD_QS_ID_);
+
+    /* was e allocated correctly? */
+    if (e != (QEvt *)0) {
+        e->sig = (QSignal)sig;     /* set signal for this event */
+        e->poolId_ = (uint8_t)QF_PAYLOAD_POOL_ID_; /* the payload pool */
+        e->refCtr_ = 0U; /* set the reference counter to 0 */
+
+        QPayload_addRef(payload); /* the event references the payload */
+        ((QPayloadEvt *)e)->payload = payload;
+
+        QS_BEGIN_PRE_(QS_QF_NEW, QF_PAYLOAD_QS_ID_)
+            QS_TIME_PRE_();        /* timestamp */
+            QS_EVS_PRE_(evtSize);  /* the size of the event */
+            QS_SIG_PRE_(sig);      /* the signal of the event */
+        QS_END_PRE_()
+    }
+    /* event cannot be allocated */
+    else {
+        /* must tolerate failed allocation */
+        Q_ASSERT_ID(720, margin != QF_NO_MARGIN);
+
+        QS_BEGIN_PRE_(QS_QF_NEW_ATTEMPT, QF_PAYLOAD_QS_ID_)
+            QS_TIME_PRE_();        /* timestamp */
+            QS_EVS_PRE_(evtSize);  /* the size of the event */
+            QS_SIG_PRE_(sig);      /* the signal of the event */
+        QS_END_PRE_()
+    }
+    return (QPayloadEvt *)e;
+}
+
+/****************************************************************************/
+/**
+* @description
+* Constructs a payload describing the external buffer @p buf with
+* @p len bytes of data and no references. The payload can then be
+* attached to payload events with Q_NEW_PAYLOAD().
+*
+* @param[in,out] me      pointer (see @ref oop)
+* @param[in]     buf     the external buffer
+* @param[in]     len     the length of the data in @p buf
+* @param[in]     release the handler called when the payload is no longer
+*                        referenced
+*/
+void QPayload_ctor(QPayload * const me, void * const buf, uint32_t len,
+                   QPayloadReleaseHandler release)
+{
+    /** @pre the release handler must be provided */
+    Q_REQUIRE_ID(800, release != (QPayloadReleaseHandler)0);
+
+    me->next    = (QPayload *)0;
+    me->buf     = buf;
+    me->len     = len;
+    me->release = release;
+    me->refCtr_ = 0U;
+}
+
+/****************************************************************************/
+/**
+* @description
+* Adds a reference to the payload. Q_NEW_PAYLOAD() calls it for the new
+* event. The application calls it to keep the payload alive outside of
+* payload events, e.g., while it is still attaching the payload to several
+* events, and then drops the reference with QPayload_release().
+*
+* @param[in,out] me      pointer (see @ref oop)
+*/
+void QPayload_addRef(QPayload * const me) {
+#ifdef QF_EVT_REF_CTR_ATOMIC
+    QEvtRefCtr const ctr = __atomic_add_fetch(&me->refCtr_, 1U,
+                                              __ATOMIC_RELAXED);
+
+    /* the reference counter must not overflow */
+    Q_ASSERT_ID(810, ctr != 0U);
+#else
+    QF_CRIT_STAT_
+    QF_CRIT_OBJ_E_(me);
+
+    /* the reference counter must not overflow */
+    Q_ASSERT_CRIT_(810, me->refCtr_ < QF_EVT_REF_CTR_MAX_);
+
+    ++me->refCtr_;
+    QF_CRIT_X_();
+#endif /* QF_EVT_REF_CTR_ATOMIC */
+}
+
+/****************************************************************************/
+/**
+* @description
+* Drops a reference to the payload and calls the release handler of the
+* payload when the last reference is dropped. QF_gc() calls it when it
+* recycles a payload event.
+*
+* @param[in,out] me      pointer (see @ref oop)
+*
+* @note
+* The release handler is called in the context of the thread (or ISR)
+* that drops the last reference, outside of any QF critical section.
+*/
+void QPayload_release(QPayload * const me) {
+    QEvtRefCtr ctr;
+
+#ifdef QF_EVT_REF_CTR_ATOMIC
+    ctr = __atomic_load_n(&me->refCtr_, __ATOMIC_RELAXED);
+
+    /** @pre the payload must be referenced */
+    Q_REQUIRE_ID(900, ctr != 0U);
+
+    ctr = __atomic_sub_fetch(&me->refCtr_, 1U, __ATOMIC_ACQ_REL);
+#else
+    QF_CRIT_STAT_
+    QF_CRIT_OBJ_E_(me);
+
+    /** @pre the payload must be referenced */
+    Q_REQUIRE_CRIT_(900, me->refCtr_ != 0U);
+
+    ctr = me->refCtr_ - 1U;
+    me->refCtr_ = ctr;
+    QF_CRIT_X_();
+#endif /* QF_EVT_REF_CTR_ATOMIC */
+
+    if (ctr == 0U) { /* the last reference dropped? */
+        (*me->release)(me);
+    }
+}
+#endif /* QF_EVT_PAYLOAD */
+
+#ifdef QF_EPOOL_STATS
+/****************************************************************************/
+/**
+* @description
+* Obtains the statistics of the allocations from the given event pool
+* (size class) since the pool has been initialized, which helps to size
+* the event pools tightly. For example, a big difference between the
+* maxSize and blockSize statistics means that the block size of the pool
+* can be reduced, while a big difference between the minSize and maxSize
+* means that the events might be better split into more size classes.
+*
+* @param[in]  poolId  event pool ID in the range 1..QF_maxPool_, where
+*                     QF_maxPool_ is the number of event pools initialized
+*                     with the function QF_poolInit().
+* @param[out] stats   the statistics of the event pool
+*
+* @note
+* The statistics are collected only when the macro #QF_EPOOL_STATS is
+* defined. They are updated in QF_newX_() without the critical section
+* where the compiler provides lock-free atomic operations (see NOTE5).
+* The minimum number of free blocks of the pool is available from
+* QF_getPoolMin().
+*/
+void QF_getPoolStats(uint_fast8_t const poolId, QPoolStats * const stats) {
+    QPoolStats const *ps;
+#ifndef QF_EPOOL_STATS_ATOMIC_
+    QF_CRIT_STAT_
+#endif
+
+    /** @pre the poolId must be in range */
+    Q_REQUIRE_ID(600, (0U < poolId) && (poolId <= QF_maxPool_));
+
+    ps = &l_poolStats[poolId - 1U];
+
+#ifdef QF_EPOOL_STATS_ATOMIC_
+    stats->nAlloc  = __atomic_load_n(&ps->nAlloc,  __ATOMIC_RELAXED);
+    stats->nFail   = __atomic_load_n(&ps->nFail,   __ATOMIC_RELAXED);
+    stats->minSize = __atomic_load_n(&ps->minSize, __ATOMIC_RELAXED);
+    stats->maxSize = __atomic_load_n(&ps->maxSize, __ATOMIC_RELAXED);
+#else
+    QF_CRIT_OBJ_E_(&QF_pool_[poolId - 1U]);
+    *stats = *ps;
+    QF_CRIT_X_();
+#endif
+
+    stats->blockSize =
+        (QEvtSize)QF_EPOOL_EVENT_SIZE_(QF_pool_[poolId - 1U]);
+}
+
+/****************************************************************************/
+/* account the allocation attempt of an event of evtSize from the pool idx */
+static void QF_poolStatsUpdate_(uint_fast8_t const idx,
+                                uint_fast16_t const evtSize,
+                                bool const allocated)
+{
+    QPoolStats * const stats = &l_poolStats[idx];
+#ifdef QF_EPOOL_STATS_ATOMIC_
+    if (allocated) {
+        QEvtSize size;
+
+        (void)__atomic_fetch_add(&stats->nAlloc, 1U, __ATOMIC_RELAXED);
+
+        /* the sizes are written only when they change, see NOTE5 */
+        size = __atomic_load_n(&stats->minSize, __ATOMIC_RELAXED);
+        while (((size == 0U) || (size > evtSize))
+               && (!__atomic_compare_exchange_n(&stats->minSize, &size,
+                        (QEvtSize)evtSize, true,
+                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)))
+        {
+        }
+        size = __atomic_load_n(&stats->maxSize, __ATOMIC_RELAXED);
+        while ((size < evtSize)
+               && (!__atomic_compare_exchange_n(&stats->maxSize, &size,
+                        (QEvtSize)evtSize, true,
+                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)))
+        {
+        }
+    }
+    else {
+        (void)__atomic_fetch_add(&stats->nFail, 1U, __ATOMIC_RELAXED);
+    }
+#else
+    QF_CRIT_STAT_
+
+    QF_CRIT_OBJ_E_(&QF_pool_[idx]);
+    if (allocated) {
+        ++stats->nAlloc;
+        if ((stats->minSize == 0U) || (stats->minSize > evtSize)) {
+            stats->minSize = (QEvtSize)evtSize;
+        }
+        if (stats->maxSize < evtSize) {
+            stats->maxSize = (QEvtSize)evtSize;
+        }
+    }
+    else {
+        ++stats->nFail;
+    }
+    QF_CRIT_X_();
+#endif /* QF_EPOOL_STATS_ATOMIC_ */
+}
+#endif /* QF_EPOOL_STATS */
+
+#ifdef QF_EVT_MAGAZINE
+/****************************************************************************/
+/**
+* @description
+* Returns all event blocks cached in the event magazines of the calling
+* thread to their event pools.
+*
+* @note
+* Every thread that allocates or recycles dynamic events should call this
+* function before it terminates, because the blocks cached in the magazines
+* of a terminated thread would be lost for the rest of the application.
+* The QF ports call it at the end of the threads they create.
+*/
+void QF_magazineFlush(void) {
+    uint_fast8_t idx;
+    for (idx = 0U; idx < QF_maxPool_; ++idx) {
+        QFMagazine * const mag = &l_magazine[idx];
+        if (mag->n != 0U) {
+            QMPool_putBatch_(&QF_pool_[idx], &mag->blk[0], mag->n,
+                             QF_MAG_QS_ID_(idx));
+            mag->n = 0U;
+        }
+    }
+}
+
+/****************************************************************************/
+/* allocate an event from the magazine of the pool idx, see NOTE1 */
+static QEvt *QF_magazineGet_(uint_fast8_t const idx,
+                             uint_fast16_t const margin)
+{
+    QFMagazine * const mag = &l_magazine[idx];
+    QEvt *e;
+
+    /* the allocations with a margin go to the shared pool, NOTE1 */
+    if (margin != QF_NO_MARGIN) {
+        e = (QEvt *)QMPool_get(&QF_pool_[idx], margin,
+                               QF_MAG_QS_ID_(idx));
+    }
+    else {
+        if (mag->n == 0U) { /* magazine empty? refill half of it */
+            mag->n = QMPool_getBatch_(&QF_pool_[idx], &mag->blk[0],
+                                      (uint_fast16_t)QF_EVT_MAGAZINE / 2U,
+                                      QF_MAG_QS_ID_(idx));
+        }
+        if (mag->n != 0U) {
+            --mag->n;
+            e = (QEvt *)mag->blk[mag->n];
+        }
+        else {
+            e = (QEvt *)0; /* the shared pool is exhausted as well */
+        }
+    }
+    return e;
+}
+
+/****************************************************************************/
+/* recycle the event e to the magazine of the pool idx, see NOTE1 */
+static void QF_magazinePut_(uint_fast8_t const idx, QEvt * const e) {
+    QFMagazine * const mag = &l_magazine[idx];
+
+    if (mag->n == (uint_fast16_t)QF_EVT_MAGAZINE) { /* magazine full? */
+        uint_fast16_t const half = (uint_fast16_t)QF_EVT_MAGAZINE / 2U;
+        uint_fast16_t i;
+
+        /* flush the older half of the magazine to the shared pool and
+        * keep the recently recycled (cache-hot) blocks
+        */
+        QMPool_putBatch_(&QF_pool_[idx], &mag->blk[0], half,
+                         QF_MAG_QS_ID_(idx));
+        for (i = half; i < mag->n; ++i) {
+            mag->blk[i - half] = mag->blk[i];
+        }
+        mag->n -= half;
+    }
+    mag->blk[mag->n] = e;
+    ++mag->n;
+}
+
+/*****************************************************************************
+* NOTE1:
+* The event magazines (enabled by defining QF_EVT_MAGAZINE as the capacity
+* of one magazine) are small per-thread caches of free event blocks placed
+* in front of the shared event pools. Q_NEW() takes a block from the
+* magazine of the calling thread and QF_gc() returns the block to the
+* magazine of the thread that recycles it, both without entering any
+* critical section. Only when a magazine runs empty (or full) the thread
+* refills (or flushes) half of the magazine from (or to) the shared pool
+* in a single critical section with QMPool_getBatch_() (or
+* QMPool_putBatch_()).
+*
+* From the point of view of the shared pool, the blocks cached in the
+* magazines are allocated. Consequently, the pool statistics reported by
+* QF_getPoolMin() and in the QS_QF_MPOOL_GET records count the cached
+* blocks as used and the pool might run empty while some blocks still
+* sit in the magazines of other threads. The event pools should be sized
+* with this in mind: every thread can hold at most QF_EVT_MAGAZINE blocks
+* of every pool. For the same reason, allocations with an explicit margin
+* (Q_NEW_X()) bypass the magazines and go directly to the shared pool,
+* where the margin is meaningful.
+*
+* The magazines are thread-local objects declared with the storage class
+* QF_THREAD_LOCAL, which the QF port must define. This excludes the ports
+* where events can be allocated or recycled in ISRs that run on the stack
+* of the interrupted thread.
+*/
+#endif /* QF_EVT_MAGAZINE */
+
+/*****************************************************************************
+* NOTE2:
+* When the QF port defines QF_EVT_REF_CTR_ATOMIC, all operations on the
+* event reference counter are atomic and QF_gc() does not enter the
+* critical section. The counter is first read, and only a counter greater
+* than one is decremented atomically. A counter of one (or zero for an
+* event that has never been posted) means that the caller holds the only
+* reference, so no other thread can change the counter concurrently and
+* the event is recycled without decrementing it. When the atomic decrement
+* brings the counter to zero, other threads have released their references
+* in the meantime and the calling thread recycles the event.
+*
+* Once the counter is decremented, the event can be recycled and reused by
+* another thread at any time, which is why the QS records use only the
+* values read before the decrement.
+*/
+
+/*****************************************************************************
+* NOTE3:
+* When the macro QF_EVT_SIZE_LUT is defined (e.g., on the compiler command
+* line) as the largest event size (in bytes) to be covered, QF_newX_()
+* selects the event pool in constant time from the size-class table
+* l_sizeClass[] instead of searching all pools from the smallest one. This
+* matters for applications with many event sizes served by many tightly
+* sized pools (up to QF_MAX_EPOOL of 15). The table is indexed by the event
+* size in granules of sizeof(QFreeBlock) bytes, the unit in which QMPool
+* rounds up the block sizes, and it is filled by QF_poolInit(). The table
+* entry points to the smallest pool that fits the smallest size in the
+* granule, so QF_newX_() needs at most one more comparison when the pool
+* block sizes are multiples of the granule. The requests for events larger
+* than QF_EVT_SIZE_LUT search the pools starting from the pool of the last
+* table entry. The table takes one byte per granule, e.g., 129 bytes for
+* QF_EVT_SIZE_LUT of 1024 on a 64-bit machine.
+*/
+
+/*****************************************************************************
+* NOTE4:
+* When the macro QF_EVT_PAYLOAD is defined, large payloads (e.g., frames
+* of many kilobytes) can flow through posting, publishing and deferring
+* without copying them into the event pools. The payload stays in an
+* external buffer described by ::QPayload and only a small ::QPayloadEvt
+* referencing it is allocated from the dedicated payload event pool,
+* which has the pool ID QF_MAX_EPOOL + 1 and is not used by Q_NEW().
+* The pool ID is all that QF_gc() needs to recognize a payload event when
+* it recycles the event, at which point it drops the reference of the
+* event to the payload. The release handler of the payload is called when
+* the last payload event referencing it is recycled (and the application
+* has released its own references, if any).
+*
+* The payload reference counter is updated atomically when the QF port
+* defines QF_EVT_REF_CTR_ATOMIC, and in the critical section otherwise.
+* The payload data must not be modified while it is referenced, because
+* the payload events can be processed by several active objects at once.
+*
+* NOTE5:
+* The event pool statistics (macro QF_EPOOL_STATS) are updated on every
+* allocation, so they must not serialize the allocations that otherwise
+* avoid the critical section (#QF_EVT_MAGAZINE, #QF_MPOOL_LOCKFREE). When
+* the compiler provides lock-free atomic operations, the counters are
+* updated with relaxed atomic additions, and the minimum and maximum event
+* sizes with a compare-and-swap only when the size actually changes, which
+* stops happening soon after startup. Otherwise the statistics are updated
+* in the critical section of the event pool. Either way, the fields read
+* by QF_getPoolStats() are individually consistent, but not necessarily
+* all from the same moment.
+*/
+
@@ -50,6 +50,40 @@
 
 Q_DEFINE_THIS_MODULE("qf_mem")
 
+#ifdef QF_MPOOL_LOCKFREE
+#ifndef __GNUC__
+    #error "QF_MPOOL_LOCKFREE requires the GNU-C __atomic built-ins"
+#endif
+
+/* the free block at the head word 'top_' of the lock-free list of 'me_' */
+#define QF_LF_BLOCK_(me_, top_) \
+    ((QFreeBlock *)((uint8_t *)(me_)->start + ((uint32_t)(top_) - 1U)))
+
+/* the head word for the block offset 'off_' and the ABA tag after 'top_' */
+#define QF_LF_TOP_(top_, off_) \
+    (((((top_) >> 32U) + 1U) << 32U) | (uint64_t)(off_))
+
+static void *QMPool_getLF_(QMPool * const me, uint_fast16_t const margin,
+                           uint_fast16_t const qs_id);
+static void QMPool_putLF_(QMPool * const me, void * const b,
+                          uint_fast16_t const qs_id);
+#endif /* QF_MPOOL_LOCKFREE */
+
+#ifdef QF_MPOOL_ELASTIC
+#ifndef QF_MPOOL_RESERVE_
+    #error "QF_MPOOL_ELASTIC requires QF_MPOOL_RESERVE_(), \
+QF_MPOOL_COMMIT_() and QF_MPOOL_DECOMMIT_() in the QF port"
+#endif
+
+/* does the elastic pool 'me_' need to grow to keep 'n_' free blocks? */
+#define QF_MPOOL_LOW_(me_, n_) \
+    (((me_)->limit != (void *)0) \
+     && ((uint_fast32_t)(me_)->nFree \
+         <= ((uint_fast32_t)(me_)->lowMark + (uint_fast32_t)(n_))))
+
+static void QMPool_grow_(QMPool * const me, uint_fast16_t const qs_id);
+#endif /* QF_MPOOL_ELASTIC */
+
 /****************************************************************************/
 /**
 * @description
@@ -132,8 +166,229 @@ void QMPool_init(QMPool * const me, void * const poolSto,
     me->nMin  = me->nTot;        /* the minimum number of free blocks */
     me->start = poolSto;         /* the original start this pool buffer */
     me->end   = fb;              /* the last block in this pool */
+#ifdef QF_MPOOL_LOCKFREE
+    me->top      = 0U;           /* the lock-free list is not used */
+    me->lockFree = false;
+#endif
+#ifdef QF_MPOOL_ELASTIC
+    me->limit    = (void *)0;    /* the pool cannot grow */
+#endif
+}
+
+#ifdef QF_MPOOL_LOCKFREE
+/****************************************************************************/
+/**
+* @description
+* Initializes the native memory pool exactly like QMPool_init(), but
+* the pool is then managed without the critical section (lock-free).
+* QMPool_get() and QMPool_put() then take and return the blocks with
+* atomic compare-and-swap operations on a tagged head of the free list,
+* so that many threads can use the pool concurrently without a lock
+* (see NOTE1).
+*
+* @param[in,out] me       pointer (see @ref oop)
+* @param[in]     poolSto  pointer to the memory buffer for pool storage
+* @param[in]     poolSize size of the storage buffer in bytes
+* @param[in]     blockSize fixed-size of the memory blocks in bytes
+*
+* @note
+* The pool storage must not exceed 4GB, because the lock-free free list
+* identifies the blocks by their 32-bit offsets from the pool start.
+*/
+void QMPool_initLockFree(QMPool * const me, void * const poolSto,
+                         uint_fast32_t poolSize, uint_fast16_t blockSize)
+{
+    QMPool_init(me, poolSto, poolSize, blockSize);
+
+    /* the offsets of all blocks must fit the lock-free list */
+    Q_ASSERT_ID(120, (uint64_t)((uint8_t *)me->end - (uint8_t *)me->start)
+                     < (uint64_t)0xFFFFFFFFU);
+
+    me->top      = 1U; /* the first block (offset 0) is at the head, tag 0 */
+    me->lockFree = true;
+}
+#endif /* QF_MPOOL_LOCKFREE */
+
+#ifdef QF_MPOOL_ELASTIC
+/****************************************************************************/
+/**
+* @description
+* Initializes the native memory pool that starts with @p nInit blocks and
+* grows on demand up to @p nMax blocks (see NOTE2). The pool reserves the
+* address space for all @p nMax blocks, but commits the memory only for
+* the blocks actually in the pool. Whenever an allocation finds only
+* @p lowMark (or fewer) free blocks above the requested margin, the pool
+* grows by @p nGrow blocks before allocating, so that allocations with
+* #QF_NO_MARGIN do not fail under traffic spikes. The blocks grown beyond
+* @p nInit can be released again with QMPool_trim().
+*
+* @param[in,out] me        pointer (see @ref oop)
+* @param[in]     blockSize fixed-size of the memory blocks in bytes
+* @param[in]     nInit     the initial number of blocks
+* @param[in]     nMax      the maximum number of blocks
+* @param[in]     nGrow     the number of blocks added at once
+* @param[in]     lowMark   the number of free blocks triggering the growth
+*
+* @note
+* The memory of the elastic pool is reserved and committed by the QF port
+* with the macros QF_MPOOL_RESERVE_(), QF_MPOOL_COMMIT_() and
+* QF_MPOOL_DECOMMIT_(), which are available only in the ports with
+* virtual memory, such as the POSIX ports.
+*/
+void QMPool_initElastic(QMPool * const me, uint_fast16_t blockSize,
+                        uint_fast32_t const nInit, uint_fast32_t const nMax,
+                        uint_fast16_t const nGrow,
+                        uint_fast16_t const lowMark)
+{
+    uint8_t *sto;
+    bool committed;
+
+    /** @pre the numbers of blocks must be consistent and the maximum
+    * number of blocks must fit the block counters of the pool */
+    Q_REQUIRE_ID(130, (0U < nInit) && (nInit <= nMax) && (nGrow != 0U)
+                      && (nMax <= (uint_fast32_t)((QMPoolCtr)(~0U))));
+
+    /* round up the blockSize exactly as QMPool_init() does */
+    blockSize = (uint_fast16_t)(((blockSize + sizeof(QFreeBlock) - 1U)
+                                 / sizeof(QFreeBlock)) * sizeof(QFreeBlock));
+
+    /* reserve the address space for all blocks and commit the initial */
+    sto = (uint8_t *)QF_MPOOL_RESERVE_(nMax * blockSize);
+    committed = (sto != (uint8_t *)0)
+                && QF_MPOOL_COMMIT_(sto, nInit * blockSize);
+    Q_ASSERT_ID(140, committed);
+    (void)committed; /* avoid compiler warning about unused variable */
+
+    QMPool_init(me, sto, nInit * blockSize, blockSize);
+
+    me->limit   = &sto[nMax * blockSize];
+    me->nGrow   = (QMPoolCtr)nGrow;
+    me->lowMark = (QMPoolCtr)lowMark;
+    me->nInit   = (QMPoolCtr)nInit;
+}
+
+/****************************************************************************/
+/**
+* @description
+* Releases the blocks grown beyond the initial size of the elastic pool
+* (see QMPool_initElastic()), as long as all blocks at the end of the pool
+* are free. The pool shrinks in steps of the growth size, from the last
+* blocks added, and the memory of the released blocks is decommitted.
+*
+* @param[in,out] me      pointer (see @ref oop)
+* @param[in]     qs_id   QS ID of the pool
+*
+* @returns
+* the number of blocks released.
+*
+* @note
+* The function walks the list of free blocks in the critical section of
+* the pool, so it is intended to be called periodically (e.g., when the
+* application is idle) rather than in the time-critical paths.
+*/
+uint_fast32_t QMPool_trim(QMPool * const me, uint_fast16_t const qs_id) {
+    uint_fast32_t nTrim = 0U;
+    bool more = true;
+    QF_CRIT_STAT_
+
+    (void)qs_id; /* unused parameter (outside Q_SPY build configuration) */
+
+    QF_CRIT_OBJ_E_(me);
+    while (more && (me->limit != (void *)0) && (me->nTot > me->nInit)) {
+        /* the blocks at or above 'cut' are released together */
+        QMPoolCtr const n = ((QMPoolCtr)(me->nTot - me->nInit) < me->nGrow)
+                            ? (QMPoolCtr)(me->nTot - me->nInit)
+                            : me->nGrow;
+        uint8_t * const cut = (uint8_t *)me->start
+            + ((uint_fast32_t)(me->nTot - n) * me->blockSize);
+        QFreeBlock *fb;
+        QMPoolCtr nFree = 0U;
+
+        /* count the free blocks above the cut */
+        for (fb = (QFreeBlock *)me->free_head; fb != (QFreeBlock *)0;
+             fb = fb->next)
+        {
+            if ((uint8_t *)fb >= cut) {
+                ++nFree;
+            }
+        }
+
+        if (nFree == n) { /* all blocks above the cut free? */
+            QFreeBlock * volatile *link = (QFreeBlock * volatile *)
+                                          &me->free_head;
+
+            /* unlink the blocks above the cut from the free list */
+            while (*link != (QFreeBlock *)0) {
+                if ((uint8_t *)(*link) >= cut) {
+                    *link = (*link)->next;
+                }
+                else {
+                    link = &(*link)->next;
+                }
+            }
+
+            me->nTot  -= n;
+            me->nFree -= n;
+            if (me->nMin > me->nFree) {
+                me->nMin = me->nFree;
+            }
+            me->end = cut - me->blockSize; /* the new last block */
+            QF_MPOOL_DECOMMIT_(cut, (uint_fast32_t)n * me->blockSize);
+            nTrim += n;
+
+            QS_BEGIN_NOCRIT_PRE_(QS_QF_MPOOL_TRIM, qs_id)
+                QS_TIME_PRE_();         /* timestamp */
+                QS_OBJ_PRE_(me);        /* this memory pool */
+                QS_MPC_PRE_(n);         /* # blocks released */
+                QS_MPC_PRE_(me->nTot);  /* # blocks in the pool now */
+            QS_END_NOCRIT_PRE_()
+        }
+        else {
+            more = false; /* some blocks above the cut still in use */
+        }
+    }
+    QF_CRIT_X_();
+
+    return nTrim;
 }
 
+/****************************************************************************/
+/* grow the elastic pool by up to nGrow blocks (in the critical section) */
+static void QMPool_grow_(QMPool * const me, uint_fast16_t const qs_id) {
+    uint8_t * const blk = (uint8_t *)me->end + me->blockSize;
+    uint_fast32_t n = (uint_fast32_t)((uint8_t *)me->limit - blk)
+                      / me->blockSize; /* room left in the reserved memory */
+
+    (void)qs_id; /* unused parameter (outside Q_SPY build configuration) */
+
+    if (n > me->nGrow) {
+        n = me->nGrow;
+    }
+    if ((n != 0U) && QF_MPOOL_COMMIT_(blk, n * me->blockSize)) {
+        QFreeBlock *fb = (QFreeBlock *)blk;
+        uint_fast32_t i;
+
+        /* chain the new blocks in front of the free list */
+        for (i = 1U; i < n; ++i) {
+            fb->next = (QFreeBlock *)((uint8_t *)fb + me->blockSize);
+            fb = fb->next;
+        }
+        fb->next = (QFreeBlock *)me->free_head;
+        me->free_head = blk;
+        me->end = fb; /* the new last block */
+        me->nTot  += (QMPoolCtr)n;
+        me->nFree += (QMPoolCtr)n;
+
+        QS_BEGIN_NOCRIT_PRE_(QS_QF_MPOOL_GROW, qs_id)
+            QS_TIME_PRE_();         /* timestamp */
+            QS_OBJ_PRE_(me);        /* this memory pool */
+            QS_MPC_PRE_(n);         /* # blocks added */
+            QS_MPC_PRE_(me->nTot);  /* # blocks in the pool now */
+        QS_END_NOCRIT_PRE_()
+    }
+}
+#endif /* QF_MPOOL_ELASTIC */
+
 /****************************************************************************/
 /**
 * @description
@@ -156,7 +411,7 @@ void QMPool_init(QMPool * const me, void * const poolSto,
 * The following example illustrates how to use QMPool_put():
 * @include qmp_use.c
 */
-void QMPool_put(QMPool * const me, void *b, uint_fast8_t const qs_id) {
+void QMPool_put(QMPool * const me, void *b, uint_fast16_t const qs_id) {
     QF_CRIT_STAT_
 
     /** @pre # free blocks cannot exceed the total # blocks and
@@ -167,7 +422,14 @@ void QMPool_put(QMPool * const me, void *b, uint_fast8_t const qs_id) {
 
     (void)qs_id; /* unused parameter (outside Q_SPY build configuration) */
 
-    QF_CRIT_E_();
+#ifdef QF_MPOOL_LOCKFREE
+    if (me->lockFree) {
+        QMPool_putLF_(me, b, qs_id);
+        return;
+    }
+#endif
+
+    QF_CRIT_OBJ_E_(me);
     ((QFreeBlock *)b)->next = (QFreeBlock *)me->free_head;/* link into list */
     me->free_head = b;      /* set as new head of the free list */
     ++me->nFree;            /* one more free block in this pool */
@@ -211,14 +473,27 @@ void QMPool_put(QMPool * const me, void *b, uint_fast8_t const qs_id) {
 * @include qmp_use.c
 */
 void *QMPool_get(QMPool * const me, uint_fast16_t const margin,
-                 uint_fast8_t const qs_id)
+                 uint_fast16_t const qs_id)
 {
     QFreeBlock *fb;
     QF_CRIT_STAT_
 
     (void)qs_id; /* unused parameter (outside Q_SPY build configuration) */
 
-    QF_CRIT_E_();
+#ifdef QF_MPOOL_LOCKFREE
+    if (me->lockFree) {
+        return QMPool_getLF_(me, margin, qs_id);
+    }
+#endif
+
+    QF_CRIT_OBJ_E_(me);
+
+#ifdef QF_MPOOL_ELASTIC
+    /* elastic pool running low on free blocks? see NOTE2 */
+    if (QF_MPOOL_LOW_(me, margin)) {
+        QMPool_grow_(me, qs_id);
+    }
+#endif
 
     /* have more free blocks than the requested margin? */
     if (me->nFree > (QMPoolCtr)margin) {
@@ -278,6 +553,154 @@ void *QMPool_get(QMPool * const me, uint_fast16_t const margin,
     return fb;  /* return the block or NULL pointer to the caller */
 }
 
+#ifdef QF_EVT_MAGAZINE
+/****************************************************************************/
+/**
+* @description
+* Allocates up to @p n memory blocks from the pool in one critical section.
+* This is used to refill the thread-local event magazines (see
+* #QF_EVT_MAGAZINE), so that the shared free list is accessed once per
+* batch instead of once per block.
+*
+* @param[in,out] me      pointer (see @ref oop)
+* @param[out]    blocks  array receiving the allocated blocks
+* @param[in]     n       the maximum number of blocks to allocate
+* @param[in]     qs_id   QS ID of the pool
+*
+* @returns
+* the number of blocks actually allocated (0..@p n), which is less than
+* @p n when the pool runs out of free blocks.
+*
+* @note
+* The pool statistics (nFree and nMin) are updated exactly as if the blocks
+* were allocated one by one with QMPool_get().
+*/
+uint_fast16_t QMPool_getBatch_(QMPool * const me, void * * const blocks,
+                               uint_fast16_t const n,
+                               uint_fast16_t const qs_id)
+{
+    uint_fast16_t i;
+    QF_CRIT_STAT_
+
+    (void)qs_id; /* unused parameter (outside Q_SPY build configuration) */
+
+#ifdef QF_MPOOL_LOCKFREE
+    if (me->lockFree) {
+        for (i = 0U; i < n; ++i) {
+            blocks[i] = QMPool_getLF_(me, 0U, qs_id);
+            if (blocks[i] == (void *)0) {
+                break;
+            }
+        }
+        return i;
+    }
+#endif
+
+    QF_CRIT_OBJ_E_(me);
+
+#ifdef QF_MPOOL_ELASTIC
+    /* elastic pool running low on free blocks? see NOTE2 */
+    if (QF_MPOOL_LOW_(me, n)) {
+        QMPool_grow_(me, qs_id);
+    }
+#endif
+
+    for (i = 0U; (i < n) && (me->nFree > 0U); ++i) {
+        QFreeBlock * const fb = (QFreeBlock *)me->free_head;
+        void *fb_next;
+
+        /* the pool has some free blocks, so a free block must be available */
+        Q_ASSERT_CRIT_(340, fb != (QFreeBlock *)0);
+
+        fb_next = fb->next; /* put volatile to a temporary to avoid UB */
+
+        --me->nFree; /* one less free block */
+        if (me->nFree == 0U) {
+            /* pool is becoming empty, so the next free block must be NULL */
+            Q_ASSERT_CRIT_(350, fb_next == (QFreeBlock *)0);
+
+            me->nMin = 0U; /* remember that the pool got empty */
+        }
+        else {
+            /* the next free block must be in range (see QMPool_get()) */
+            Q_ASSERT_CRIT_(360, QF_PTR_RANGE_(fb_next, me->start, me->end));
+
+            /* is the number of free blocks the new minimum so far? */
+            if (me->nMin > me->nFree) {
+                me->nMin = me->nFree; /* remember the new minimum */
+            }
+        }
+
+        me->free_head = fb_next; /* set the head to the next free block */
+        blocks[i] = fb;
+
+        QS_BEGIN_NOCRIT_PRE_(QS_QF_MPOOL_GET, qs_id)
+            QS_TIME_PRE_();         /* timestamp */
+            QS_OBJ_PRE_(me);        /* this memory pool */
+            QS_MPC_PRE_(me->nFree); /* # of free blocks in the pool */
+            QS_MPC_PRE_(me->nMin);  /* min # free blocks ever in the pool */
+        QS_END_NOCRIT_PRE_()
+    }
+    QF_CRIT_X_();
+
+    return i;
+}
+
+/****************************************************************************/
+/**
+* @description
+* Recycles @p n memory blocks to the pool in one critical section.
+* This is used to flush the thread-local event magazines (see
+* #QF_EVT_MAGAZINE) back to the shared pool.
+*
+* @param[in,out] me      pointer (see @ref oop)
+* @param[in]     blocks  array of the blocks to recycle
+* @param[in]     n       the number of blocks to recycle
+* @param[in]     qs_id   QS ID of the pool
+*/
+void QMPool_putBatch_(QMPool * const me, void * const * const blocks,
+                      uint_fast16_t const n, uint_fast16_t const qs_id)
+{
+    uint_fast16_t i;
+    QF_CRIT_STAT_
+
+    (void)qs_id; /* unused parameter (outside Q_SPY build configuration) */
+
+#ifdef QF_MPOOL_LOCKFREE
+    if (me->lockFree) {
+        for (i = 0U; i < n; ++i) {
+            QMPool_put(me, blocks[i], qs_id); /* checks the preconditions */
+        }
+        return;
+    }
+#endif
+
+    QF_CRIT_OBJ_E_(me);
+
+    /** @pre # free blocks cannot exceed the total # blocks */
+    Q_REQUIRE_CRIT_(210, ((uint_fast16_t)me->nFree + n)
+                         <= (uint_fast16_t)me->nTot);
+
+    for (i = 0U; i < n; ++i) {
+        void * const b = blocks[i];
+
+        /** @pre every block pointer must be from this pool */
+        Q_REQUIRE_CRIT_(220, QF_PTR_RANGE_(b, me->start, me->end));
+
+        ((QFreeBlock *)b)->next = (QFreeBlock *)me->free_head;
+        me->free_head = b;  /* set as new head of the free list */
+        ++me->nFree;        /* one more free block in this pool */
+
+        QS_BEGIN_NOCRIT_PRE_(QS_QF_MPOOL_PUT, qs_id)
+            QS_TIME_PRE_();         /* timestamp */
+            QS_OBJ_PRE_(me);        /* this memory pool */
+            QS_MPC_PRE_(me->nFree); /* the number of free blocks in the pool */
+        QS_END_NOCRIT_PRE_()
+    }
+    QF_CRIT_X_();
+}
+#endif /* QF_EVT_MAGAZINE */
+
 /****************************************************************************/
 /**
 * @description
@@ -290,6 +713,11 @@ void *QMPool_get(QMPool * const me, uint_fast16_t const margin,
 *
 * @returns
 * the minimum number of unused blocks in the given event pool.
+*
+* @note
+* With the thread-local event magazines (see #QF_EVT_MAGAZINE) the blocks
+* cached in the magazines count as used, so the returned minimum remains
+* a conservative measure of the pool head-room.
 */
 uint_fast16_t QF_getPoolMin(uint_fast8_t const poolId) {
     uint_fast16_t min;
@@ -299,10 +727,168 @@ uint_fast16_t QF_getPoolMin(uint_fast8_t const poolId) {
     Q_REQUIRE_ID(400, (0U < poolId) && (poolId <= QF_maxPool_)
                       && (poolId <= QF_MAX_EPOOL));
 
-    QF_CRIT_E_();
+    QF_CRIT_OBJ_E_(&QF_pool_[poolId - 1U]);
     min = (uint_fast16_t)QF_pool_[poolId - 1U].nMin;
     QF_CRIT_X_();
 
     return min;
 }
 
+#ifdef QF_MPOOL_LOCKFREE
+/****************************************************************************/
+/* lock-free QMPool_get(), see NOTE1 */
+static void *QMPool_getLF_(QMPool * const me, uint_fast16_t const margin,
+                           uint_fast16_t const qs_id)
+{
+    QFreeBlock *fb = (QFreeBlock *)0;
+    QMPoolCtr nFree = __atomic_load_n(&me->nFree, __ATOMIC_RELAXED);
+    QS_CRIT_STAT_
+
+    (void)qs_id; /* unused parameter (outside Q_SPY build configuration) */
+
+    /* reserve one free block while keeping the margin */
+    while ((nFree > (QMPoolCtr)margin)
+           && (!__atomic_compare_exchange_n(&me->nFree, &nFree,
+                   (QMPoolCtr)(nFree - 1U), true,
+                   __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)))
+    {
+    }
+
+    if (nFree > (QMPoolCtr)margin) { /* block reserved? */
+        uint64_t top = __atomic_load_n(&me->top, __ATOMIC_ACQUIRE);
+        QFreeBlock *fb_next;
+        uint64_t off;
+        QMPoolCtr nMin;
+
+        /* pop the head of the free list */
+        do {
+            /* the reserved block must be in the list */
+            Q_ASSERT_ID(310, (uint32_t)top != 0U);
+
+            fb = QF_LF_BLOCK_(me, top);
+
+            /* the block might be taken and overwritten by another thread
+            * in the meantime, in which case the CAS below fails
+            */
+            fb_next = __atomic_load_n(&fb->next, __ATOMIC_RELAXED);
+            off = (fb_next != (QFreeBlock *)0)
+                  ? ((uint64_t)((uint8_t *)fb_next - (uint8_t *)me->start)
+                     + 1U)
+                  : 0U;
+        } while (!__atomic_compare_exchange_n(&me->top, &top,
+                     QF_LF_TOP_(top, off), true,
+                     __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+
+        /* the next free block must be in range (see QMPool_get()) */
+        Q_ASSERT_ID(330, (fb_next == (QFreeBlock *)0)
+                         || QF_PTR_RANGE_((void *)fb_next,
+                                          me->start, me->end));
+
+        /* update the low watermark with the reserved count */
+        --nFree;
+        nMin = __atomic_load_n(&me->nMin, __ATOMIC_RELAXED);
+        while ((nFree < nMin)
+               && (!__atomic_compare_exchange_n(&me->nMin, &nMin, nFree,
+                       true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)))
+        {
+        }
+
+        QS_BEGIN_PRE_(QS_QF_MPOOL_GET, qs_id)
+            QS_TIME_PRE_();         /* timestamp */
+            QS_OBJ_PRE_(me);        /* this memory pool */
+            QS_MPC_PRE_(nFree);     /* # of free blocks in the pool */
+            QS_MPC_PRE_(me->nMin);  /* min # free blocks ever in the pool */
+        QS_END_PRE_()
+    }
+    else {
+        QS_BEGIN_PRE_(QS_QF_MPOOL_GET_ATTEMPT, qs_id)
+            QS_TIME_PRE_();         /* timestamp */
+            QS_OBJ_PRE_(me);        /* this memory pool */
+            QS_MPC_PRE_(nFree);     /* the number of free blocks in the pool */
+            QS_MPC_PRE_(margin);    /* the requested margin */
+        QS_END_PRE_()
+    }
+
+    return fb;  /* return the block or NULL pointer to the caller */
+}
+
+/****************************************************************************/
+/* lock-free QMPool_put(), see NOTE1 */
+static void QMPool_putLF_(QMPool * const me, void * const b,
+                          uint_fast16_t const qs_id)
+{
+    QFreeBlock * const fb = (QFreeBlock *)b;
+    uint64_t const off = (uint64_t)((uint8_t *)b - (uint8_t *)me->start)
+                         + 1U;
+    uint64_t top = __atomic_load_n(&me->top, __ATOMIC_RELAXED);
+    QMPoolCtr nFree;
+    QS_CRIT_STAT_
+
+    (void)qs_id; /* unused parameter (outside Q_SPY build configuration) */
+
+    /* push the block to the head of the free list */
+    do {
+        __atomic_store_n(&fb->next,
+                         ((uint32_t)top != 0U)
+                             ? QF_LF_BLOCK_(me, top)
+                             : (QFreeBlock *)0,
+                         __ATOMIC_RELAXED);
+    } while (!__atomic_compare_exchange_n(&me->top, &top,
+                 QF_LF_TOP_(top, off), true,
+                 __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+
+    /* only now the block can be reserved by QMPool_getLF_() */
+    nFree = __atomic_add_fetch(&me->nFree, 1U, __ATOMIC_RELEASE);
+    (void)nFree; /* unused variable (outside Q_SPY build configuration) */
+
+    QS_BEGIN_PRE_(QS_QF_MPOOL_PUT, qs_id)
+        QS_TIME_PRE_();         /* timestamp */
+        QS_OBJ_PRE_(me);        /* this memory pool */
+        QS_MPC_PRE_(nFree);     /* the number of free blocks in the pool */
+    QS_END_PRE_()
+}
+#endif /* QF_MPOOL_LOCKFREE */
+
+/*****************************************************************************
+* NOTE1:
+* The lock-free memory pool (see QMPool_initLockFree()) is a Treiber stack
+* of the free blocks. The ABA problem (a thread reads the head block A and
+* its successor, gets preempted while other threads take A, take its
+* successor and return A, and then swaps in the stale successor) is
+* avoided by the tag in the high 32 bits of the head word, which changes
+* with every update, so the stale compare-and-swap fails. Identifying the
+* head block by its 32-bit offset from the pool start keeps the whole head
+* word in 64 bits, so it works with the plain 64-bit compare-and-swap on
+* all hosts (no double-width CAS is required).
+*
+* The number of free blocks @c nFree is maintained separately and governs
+* the admission to the pool: QMPool_get() first reserves a block by
+* decrementing @c nFree (only while @c nFree stays above the requested
+* margin) and only then pops the list, while QMPool_put() first pushes the
+* block and only then increments @c nFree. This way @c nFree never exceeds
+* the length of the list, so a reserved block is always in the list, which
+* assertion 310 verifies, and the margin semantics is exactly the same as
+* with the critical section. The low watermark @c nMin is updated with
+* an atomic minimum. In the common case both operations complete with two
+* compare-and-swap operations and do not wait for other threads.
+*/
+
+/*****************************************************************************
+* NOTE2:
+* An elastic memory pool (macro QF_MPOOL_ELASTIC and QMPool_initElastic())
+* keeps all its blocks in one contiguous range of the address space, which
+* is reserved up front for the maximum number of blocks. Growing the pool
+* only commits the memory of the next nGrow blocks and chains them in
+* front of the free list, so the range-check assertions of QMPool_put()
+* and QMPool_get() remain valid and the blocks never move. The growth is
+* reported with the QS_QF_MPOOL_GROW trace record. A pool that has
+* already grown to its maximum behaves as a regular pool, so the
+* allocations with QF_NO_MARGIN still assert when it runs dry.
+*
+* QMPool_trim() releases the blocks from the end of the range, but only
+* when all of them are free, and reports it with QS_QF_MPOOL_TRIM. The
+* blocks of the initial size are never released. The low watermark nMin
+* of an elastic pool counts the free blocks at the time, so it does not
+* show how many blocks would have sufficed; the QS_QF_MPOOL_GROW records
+* show that instead.
+*/
@@ -50,11 +50,53 @@
 
 Q_DEFINE_THIS_MODULE("qf_ps")
 
+#ifdef QF_PUBLISH_FANOUT
+#if (defined QF_NON_NATIVE_EQUEUE)
+    #error "QF_PUBLISH_FANOUT requires the native QF event queue"
+#endif
+#if (defined QK_H) || (defined QXK_H)
+    #error "QF_PUBLISH_FANOUT is not supported in the QK and QXK kernels"
+#endif
+
+#ifdef Q_UTEST /* every post must reach QS_onTestPost(), see NOTE1 */
+    #undef QF_PUBLISH_FANOUT
+#endif
+#endif /* QF_PUBLISH_FANOUT */
+
+#ifdef QF_PUBLISH_FANOUT
+/* publishing to many subscribers in one pass, see NOTE1 */
+static uint_fast16_t QF_fanoutSubscr_(QPSet const * const subscrList,
+                                      QPSet * const fanSet);
+#ifdef Q_SPY
+static void QF_publishFanout_(QEvt const * const e,
+                              QPSet * const subscrList,
+                              QPSet * const fanSet,
+                              uint_fast16_t const nSubscr,
+                              void const * const sender);
+#else
+static void QF_publishFanout_(QEvt const * const e,
+                              QPSet * const subscrList,
+                              QPSet * const fanSet,
+                              uint_fast16_t const nSubscr);
+#endif
+#endif /* QF_PUBLISH_FANOUT */
 
 /* Package-scope objects ****************************************************/
 QSubscrList *QF_subscrList_;
 enum_t QF_maxPubSignal_;
 
+#ifdef QF_SPARSE_SUBSCR
+/* Local objects ***********************************************************/
+static QSubscr *l_subscrHash[1U << QF_SUBSCR_HASH_BITS]; /* signal buckets */
+static QSubscr *l_subscrOfAO[QF_MAX_ACTIVE + 1U]; /* the reverse index */
+static QSubscr *l_subscrFree; /* the free list of subscriptions */
+
+/*! the hash bucket of the signal @p sig_ (Fibonacci hashing) */
+#define QF_SUBSCR_BUCKET_(sig_) \
+    (l_subscrHash[((uint32_t)(sig_) * 0x9E3779B1U) \
+                  >> (32U - QF_SUBSCR_HASH_BITS)])
+#endif /* QF_SPARSE_SUBSCR */
+
 /****************************************************************************/
 /**
 * @description
@@ -84,6 +126,7 @@ enum_t QF_maxPubSignal_;
 * The following example shows the typical initialization sequence of QF:
 * @include qf_main.c
 */
+#ifndef QF_SPARSE_SUBSCR
 void QF_psInit(QSubscrList * const subscrSto, enum_t const maxSignal) {
     QF_subscrList_   = subscrSto;
     QF_maxPubSignal_ = maxSignal;
@@ -94,6 +137,49 @@ void QF_psInit(QSubscrList * const subscrSto, enum_t const maxSignal) {
     */
     QF_bzero(subscrSto, (uint_fast16_t)maxSignal * sizeof(QSubscrList));
 }
+#else /* QF_SPARSE_SUBSCR */
+
+/****************************************************************************/
+/**
+* @description
+* This function initializes the publish-subscribe facilities of QF with
+* the sparse subscriber store (see ::QSubscr) and must be called exactly
+* once before any subscriptions/publications occur in the application.
+*
+* @param[in] subscrSto pointer to the storage for the subscriptions
+* @param[in] subscrLen the maximum number of subscriptions, which is the
+*                      sum of the numbers of signals subscribed by all
+*                      active objects at the same time.
+* @param[in] maxSignal the maximum signal that can be published or
+*                      subscribed (not the dimension of any array).
+*
+* @note
+* Running out of the subscription storage in QActive_subscribe() is
+* considered an error and QF will raise an assertion.
+*/
+void QF_psInitSparse(QSubscr * const subscrSto,
+                     uint_fast16_t const subscrLen,
+                     enum_t const maxSignal)
+{
+    uint_fast16_t n;
+
+    /** @pre the storage must provide at least one subscription */
+    Q_REQUIRE_ID(100, (subscrSto != (QSubscr *)0) && (subscrLen != 0U));
+
+    QF_subscrList_   = (QSubscrList *)0; /* the dense store is not used */
+    QF_maxPubSignal_ = maxSignal;
+
+    QF_bzero(&l_subscrHash[0], sizeof(l_subscrHash));
+    QF_bzero(&l_subscrOfAO[0], sizeof(l_subscrOfAO));
+
+    /* chain all the subscriptions into the free list */
+    l_subscrFree = (QSubscr *)0;
+    for (n = subscrLen; n > 0U; --n) {
+        QF_PTR_AT_(subscrSto, n - 1U).sigNext = l_subscrFree;
+        l_subscrFree = &QF_PTR_AT_(subscrSto, n - 1U);
+    }
+}
+#endif /* QF_SPARSE_SUBSCR */
 
 /****************************************************************************/
 /**
@@ -113,6 +199,11 @@ void QF_psInit(QSubscrList * const subscrSto, enum_t const maxSignal) {
 * priority subscriber, so any AOs of even higher priority, which did not
 * subscribe to this event are _not_ affected.
 *
+* @note
+* When the macro #QF_PUBLISH_FANOUT is defined, the events with at least
+* #QF_PUBLISH_FANOUT subscribers are posted to all the subscribers in
+* a single pass, see NOTE1 at the end of this file.
+*
 * @attention this function should be called only via the macro QF_PUBLISH()
 */
 #ifndef Q_SPY
@@ -127,7 +218,7 @@ void QF_publish_(QEvt const * const e, void const * const sender)
     /** @pre the published signal must be within the configured range */
     Q_REQUIRE_ID(200, e->sig < (QSignal)QF_maxPubSignal_);
 
-    QF_CRIT_E_();
+    QF_CRIT_OBJ_E_(QF_subscrList_);
 
     QS_BEGIN_NOCRIT_PRE_(QS_QF_PUBLISH, 0U)
         QS_TIME_PRE_();          /* the timestamp */
@@ -148,18 +239,51 @@ void QF_publish_(QEvt const * const e, void const * const sender)
         QF_EVT_REF_CTR_INC_(e);
     }
 
+#ifndef QF_SPARSE_SUBSCR
     /* make a local, modifiable copy of the subscriber list */
     subscrList = QF_PTR_AT_(QF_subscrList_, e->sig);
+#else
+    {   /* collect the subscribers from the hash bucket of the signal */
+        QSubscr const *s = QF_SUBSCR_BUCKET_(e->sig);
+        QPSet_setEmpty(&subscrList);
+        for (; s != (QSubscr *)0; s = s->sigNext) {
+            if (s->sig == e->sig) {
+                QPSet_insert(&subscrList, s->prio);
+            }
+        }
+    }
+#endif
     QF_CRIT_X_();
 
     if (QPSet_notEmpty(&subscrList)) { /* any subscribers? */
-        uint_fast8_t p;
+        uint_fast16_t p;
         QF_SCHED_STAT_
 
         QPSet_findMax(&subscrList, p); /* the highest-prio subscriber */
 
         QF_SCHED_LOCK_(p); /* lock the scheduler up to prio 'p' */
-        do { /* loop over all subscribers */
+#ifdef QF_PUBLISH_FANOUT
+        {
+            QPSet fanSet; /* the subscribers for the fan-out, see NOTE1 */
+            uint_fast16_t const nSubscr =
+                QF_fanoutSubscr_(&subscrList, &fanSet);
+            if (nSubscr >= (uint_fast16_t)QF_PUBLISH_FANOUT) {
+#ifdef Q_SPY
+                QF_publishFanout_(e, &subscrList, &fanSet, nSubscr, sender);
+#else
+                QF_publishFanout_(e, &subscrList, &fanSet, nSubscr);
+#endif
+                /* any subscribers left for QACTIVE_POST()? */
+                if (QPSet_notEmpty(&subscrList)) {
+                    QPSet_findMax(&subscrList, p);
+                }
+                else {
+                    p = 0U; /* all subscribers handled */
+                }
+            }
+        }
+#endif /* QF_PUBLISH_FANOUT */
+        while (p != 0U) { /* loop over all subscribers */
             /* the prio of the AO must be registered with the framework */
             Q_ASSERT_ID(210, QF_active_[p] != (QActive *)0);
 
@@ -173,7 +297,7 @@ void QF_publish_(QEvt const * const e, void const * const sender)
             else {
                 p = 0U; /* no more subscribers */
             }
-        } while (p != 0U);
+        }
         QF_SCHED_UNLOCK_(); /* unlock the scheduler */
     }
 
@@ -204,7 +328,7 @@ void QF_publish_(QEvt const * const e, void const * const sender)
 * QF_publish_(), QActive_unsubscribe(), and QActive_unsubscribeAll()
 */
 void QActive_subscribe(QActive const * const me, enum_t const sig) {
-    uint_fast8_t p = (uint_fast8_t)me->prio;
+    uint_fast16_t p = (uint_fast16_t)me->prio;
     QF_CRIT_STAT_
 
     Q_REQUIRE_ID(300, ((enum_t)Q_USER_SIG <= sig)
@@ -212,7 +336,7 @@ void QActive_subscribe(QActive const * const me, enum_t const sig) {
               && (0U < p) && (p <= QF_MAX_ACTIVE)
               && (QF_active_[p] == me));
 
-    QF_CRIT_E_();
+    QF_CRIT_OBJ_E_(QF_subscrList_);
 
     QS_BEGIN_NOCRIT_PRE_(QS_QF_ACTIVE_SUBSCRIBE, me->prio)
         QS_TIME_PRE_();    /* timestamp */
@@ -220,8 +344,36 @@ void QActive_subscribe(QActive const * const me, enum_t const sig) {
         QS_OBJ_PRE_(me);   /* this active object */
     QS_END_NOCRIT_PRE_()
 
+#ifndef QF_SPARSE_SUBSCR
     /* set the priority bit */
     QPSet_insert(&QF_PTR_AT_(QF_subscrList_, sig), p);
+#else
+    {
+        QSubscr **bucket = &QF_SUBSCR_BUCKET_(sig);
+        QSubscr *s = *bucket;
+
+        while ((s != (QSubscr *)0)
+               && ((s->sig != (QSignal)sig) || (s->prio != p)))
+        {
+            s = s->sigNext;
+        }
+        if (s == (QSubscr *)0) { /* not subscribed yet? */
+            s = l_subscrFree;
+
+            /* the subscription storage must not be exhausted */
+            Q_ASSERT_CRIT_(310, s != (QSubscr *)0);
+
+            l_subscrFree = s->sigNext;
+            s->sig  = (QSignal)sig;
+            s->prio = (QPrio)p;
+
+            s->sigNext = *bucket; /* link into the bucket of the signal */
+            *bucket = s;
+            s->aoNext = l_subscrOfAO[p]; /* link into the AO's index */
+            l_subscrOfAO[p] = s;
+        }
+    }
+#endif
 
     QF_CRIT_X_();
 }
@@ -252,7 +404,7 @@ void QActive_subscribe(QActive const * const me, enum_t const sig) {
 * QF_publish_(), QActive_subscribe(), and QActive_unsubscribeAll()
 */
 void QActive_unsubscribe(QActive const * const me, enum_t const sig) {
-    uint_fast8_t p = (uint_fast8_t)me->prio;
+    uint_fast16_t p = (uint_fast16_t)me->prio;
     QF_CRIT_STAT_
 
     /** @pre the singal and the prioriy must be in ragne, the AO must also
@@ -263,7 +415,7 @@ void QActive_unsubscribe(QActive const * const me, enum_t const sig) {
               && (0U < p) && (p <= QF_MAX_ACTIVE)
               && (QF_active_[p] == me));
 
-    QF_CRIT_E_();
+    QF_CRIT_OBJ_E_(QF_subscrList_);
 
     QS_BEGIN_NOCRIT_PRE_(QS_QF_ACTIVE_UNSUBSCRIBE, me->prio)
         QS_TIME_PRE_();    /* timestamp */
@@ -271,8 +423,33 @@ void QActive_unsubscribe(QActive const * const me, enum_t const sig) {
         QS_OBJ_PRE_(me);   /* this active object */
     QS_END_NOCRIT_PRE_()
 
+#ifndef QF_SPARSE_SUBSCR
     /* clear priority bit */
     QPSet_remove(&QF_PTR_AT_(QF_subscrList_, sig), p);
+#else
+    {
+        QSubscr **link = &QF_SUBSCR_BUCKET_(sig);
+
+        while ((*link != (QSubscr *)0)
+               && (((*link)->sig != (QSignal)sig) || ((*link)->prio != p)))
+        {
+            link = &(*link)->sigNext;
+        }
+        if (*link != (QSubscr *)0) { /* subscribed? */
+            QSubscr * const s = *link;
+            *link = s->sigNext; /* unlink from the bucket of the signal */
+
+            link = &l_subscrOfAO[p]; /* unlink from the AO's index */
+            while (*link != s) {
+                link = &(*link)->aoNext;
+            }
+            *link = s->aoNext;
+
+            s->sigNext = l_subscrFree; /* return to the free list */
+            l_subscrFree = s;
+        }
+    }
+#endif
 
     QF_CRIT_X_();
 }
@@ -301,15 +478,52 @@ void QActive_unsubscribe(QActive const * const me, enum_t const sig) {
 * QF_publish_(), QActive_subscribe(), and QActive_unsubscribe()
 */
 void QActive_unsubscribeAll(QActive const * const me) {
-    uint_fast8_t p = (uint_fast8_t)me->prio;
+    uint_fast16_t p = (uint_fast16_t)me->prio;
+#ifndef QF_SPARSE_SUBSCR
     enum_t sig;
+#else
+    bool more = true;
+#endif
 
     Q_REQUIRE_ID(500, (0U < p) && (p <= QF_MAX_ACTIVE)
                         && (QF_active_[p] == me));
 
+#ifdef QF_SPARSE_SUBSCR
+    /* visit only the subscriptions of this AO (the reverse index) */
+    while (more) {
+        QF_CRIT_STAT_
+        QF_CRIT_OBJ_E_(QF_subscrList_);
+        if (l_subscrOfAO[p] != (QSubscr *)0) {
+            QSubscr * const s = l_subscrOfAO[p];
+            QSubscr **link = &QF_SUBSCR_BUCKET_(s->sig);
+
+            l_subscrOfAO[p] = s->aoNext; /* unlink from the AO's index */
+            while (*link != s) { /* unlink from the bucket of the signal */
+                link = &(*link)->sigNext;
+            }
+            *link = s->sigNext;
+
+            QS_BEGIN_NOCRIT_PRE_(QS_QF_ACTIVE_UNSUBSCRIBE, me->prio)
+                QS_TIME_PRE_();      /* timestamp */
+                QS_SIG_PRE_(s->sig); /* the signal of this event */
+                QS_OBJ_PRE_(me);     /* this active object */
+            QS_END_NOCRIT_PRE_()
+
+            s->sigNext = l_subscrFree; /* return to the free list */
+            l_subscrFree = s;
+        }
+        else {
+            more = false; /* no more subscriptions */
+        }
+        QF_CRIT_X_();
+
+        /* prevent merging critical sections */
+        QF_CRIT_EXIT_NOP();
+    }
+#else
     for (sig = (enum_t)Q_USER_SIG; sig < QF_maxPubSignal_; ++sig) {
         QF_CRIT_STAT_
-        QF_CRIT_E_();
+        QF_CRIT_OBJ_E_(QF_subscrList_);
         if (QPSet_hasElement(&QF_PTR_AT_(QF_subscrList_, sig), p)) {
             QPSet_remove(&QF_PTR_AT_(QF_subscrList_, sig), p);
 
@@ -324,5 +538,156 @@ void QActive_unsubscribeAll(QActive const * const me) {
         /* prevent merging critical sections */
         QF_CRIT_EXIT_NOP();
     }
+#endif /* QF_SPARSE_SUBSCR */
 }
 
+#ifdef QF_PUBLISH_FANOUT
+/****************************************************************************/
+/*! collect in @p fanSet the subscribers from @p subscrList using the QF
+* post operation (the others must get the event from QACTIVE_POST()),
+* and return their number
+*/
+static uint_fast16_t QF_fanoutSubscr_(QPSet const * const subscrList,
+                                      QPSet * const fanSet)
+{
+    QPSet set = *subscrList; /* local, modifiable copy */
+    uint_fast16_t n = 0U;
+
+    QPSet_setEmpty(fanSet);
+    while (QPSet_notEmpty(&set)) {
+        uint_fast16_t p;
+        QActive const *a;
+
+        QPSet_findMax(&set, p);
+        a = QF_active_[p];
+
+        /* the prio of the AO must be registered with the framework */
+        Q_ASSERT_ID(210, a != (QActive *)0);
+
+        if (QACTIVE_HAS_QF_POST_(a)) { /* not overriding the post? */
+            QPSet_insert(fanSet, p);
+            ++n;
+        }
+        QPSet_remove(&set, p);
+    }
+    return n;
+}
+
+/****************************************************************************/
+/*! post the event @p e to all @p nSubscr subscribers in @p fanSet in one
+* pass and remove them from @p subscrList
+*/
+#ifdef Q_SPY
+static void QF_publishFanout_(QEvt const * const e,
+                              QPSet * const subscrList,
+                              QPSet * const fanSet,
+                              uint_fast16_t const nSubscr,
+                              void const * const sender)
+#else
+static void QF_publishFanout_(QEvt const * const e,
+                              QPSet * const subscrList,
+                              QPSet * const fanSet,
+                              uint_fast16_t const nSubscr)
+#endif
+{
+    QPSet wakeSet; /* the subscribers whose event queues were empty */
+    uint_fast16_t p;
+    QF_CRIT_STAT_
+
+    QPSet_setEmpty(&wakeSet);
+
+    QF_CRIT_E_();
+
+    /* is it a dynamic event? */
+    if (e->poolId_ != 0U) {
+        /* the reference counter must not overflow */
+        Q_ASSERT_CRIT_(230, (uint_fast32_t)nSubscr
+            <= (uint_fast32_t)(QF_EVT_REF_CTR_MAX_
+                               - QF_EVT_REF_CTR_GET_(e)));
+
+        /* one reference for every subscriber, added at once */
+        QF_EVT_REF_CTR_ADD_(e, nSubscr);
+    }
+
+    do { /* loop over all the subscribers of the fan-out */
+        QActive *a;
+        QEQueueCtr nFree;
+
+        QPSet_findMax(fanSet, p); /* the highest-prio subscriber */
+        a = QF_active_[p];
+
+        nFree = a->eQueue.nFree; /* get volatile into the temporary */
+
+        /* the queue must not overflow, just as in QACTIVE_POST() */
+        Q_ASSERT_CRIT_(220, nFree != 0U);
+
+        --nFree; /* one free entry just used up */
+        a->eQueue.nFree = nFree; /* update the volatile */
+        if (a->eQueue.nMin > nFree) {
+            a->eQueue.nMin = nFree; /* update minimum so far */
+        }
+
+        QS_BEGIN_NOCRIT_PRE_(QS_QF_ACTIVE_POST, a->prio)
+            QS_TIME_PRE_();               /* timestamp */
+            QS_OBJ_PRE_(sender);          /* the sender object */
+            QS_SIG_PRE_(e->sig);          /* the signal of the event */
+            QS_OBJ_PRE_(a);               /* the active object (recipient) */
+            QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
+            QS_EQC_PRE_(nFree);           /* number of free entries */
+            QS_EQC_PRE_(a->eQueue.nMin);  /* min number of free entries */
+        QS_END_NOCRIT_PRE_()
+
+        /* empty queue? */
+        if (a->eQueue.frontEvt == (QEvt *)0) {
+            a->eQueue.frontEvt = e; /* deliver event directly */
+            QPSet_insert(&wakeSet, p); /* signal it after the fan-out */
+        }
+        /* queue is not empty, insert event into the ring-buffer */
+        else {
+            QF_PTR_AT_(a->eQueue.ring, a->eQueue.head) = e;
+
+            if (a->eQueue.head == 0U) { /* need to wrap head? */
+                a->eQueue.head = a->eQueue.end; /* wrap around */
+            }
+            --a->eQueue.head; /* advance the head (counter clockwise) */
+        }
+
+        QPSet_remove(fanSet, p); /* remove the handled subscriber */
+        QPSet_remove(subscrList, p);
+    } while (QPSet_notEmpty(fanSet));
+
+    /* the deferred wakeups of the subscribers, highest-priority first */
+    while (QPSet_notEmpty(&wakeSet)) {
+        QPSet_findMax(&wakeSet, p);
+        QACTIVE_EQUEUE_SIGNAL_(QF_active_[p]);
+        QPSet_remove(&wakeSet, p);
+    }
+
+    QF_CRIT_X_();
+}
+#endif /* QF_PUBLISH_FANOUT */
+
+/*****************************************************************************
+* NOTE1:
+* When the macro QF_PUBLISH_FANOUT is defined, an event published to at
+* least QF_PUBLISH_FANOUT subscribers is posted to all of them in a single
+* pass through one critical section, instead of calling QACTIVE_POST() for
+* every subscriber. The reference counter of the event is incremented only
+* once (by the number of subscribers) and the subscribers, whose queues
+* were empty, are signaled only at the end, after the event is already
+* in all the queues. As with QACTIVE_POST(), the queues of the subscribers
+* must be able to accept the event (assertion 220).
+*
+* The single pass keeps the critical section for the whole fan-out, so
+* QF_PUBLISH_FANOUT should be tuned against the acceptable interrupt (or
+* thread) latency. The fan-out path manipulates the native event queues
+* directly, so it is not available with the non-native event queues, nor
+* in the QK and QXK kernels, which rely on posting through QACTIVE_POST().
+*
+* The fan-out takes only the subscribers using the QF post operation
+* QActive_post_(). The subscribers overriding it (e.g., ::QTicker or an
+* AO with its own vtable) stay in the subscriber list and get the event
+* from QACTIVE_POST() afterwards, just as without QF_PUBLISH_FANOUT. In
+* the QUTest builds (Q_UTEST) the fan-out is disabled altogether, so that
+* every post reaches the QS_onTestPost() callback.
+*/
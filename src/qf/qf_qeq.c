@@ -113,7 +113,7 @@ void QEQueue_init(QEQueue * const me, QEvt const * * const qSto,
 * @sa QEQueue_postLIFO(), QEQueue_get()
 */
 bool QEQueue_post(QEQueue * const me, QEvt const * const e,
-                  uint_fast16_t const margin, uint_fast8_t const qs_id)
+                  uint_fast16_t const margin, uint_fast16_t const qs_id)
 {
     QEQueueCtr nFree; /* temporary to avoid UB for volatile access */
     bool status;
@@ -124,7 +124,7 @@ bool QEQueue_post(QEQueue * const me, QEvt const * const e,
 
     (void)qs_id; /* unused parameter (outside Q_SPY build configuration) */
 
-    QF_CRIT_E_();
+    QF_CRIT_OBJ_E_(me);
     nFree = me->nFree; /* get volatile into the temporary */
 
     /* required margin available? */
@@ -213,7 +213,7 @@ bool QEQueue_post(QEQueue * const me, QEvt const * const e,
 * QEQueue_post(), QEQueue_get(), QActive_defer()
 */
 void QEQueue_postLIFO(QEQueue * const me, QEvt const * const e,
-                      uint_fast8_t const qs_id)
+                      uint_fast16_t const qs_id)
 {
     QEvt const *frontEvt; /* temporary to avoid UB for volatile access */
     QEQueueCtr nFree;     /* temporary to avoid UB for volatile access */
@@ -221,7 +221,7 @@ void QEQueue_postLIFO(QEQueue * const me, QEvt const * const e,
 
     (void)qs_id; /* unused parameter (outside Q_SPY build configuration) */
 
-    QF_CRIT_E_();
+    QF_CRIT_OBJ_E_(me);
     nFree = me->nFree;    /* get volatile into the temporary */
 
     /** @pre the queue must be able to accept the event (cannot overflow) */
@@ -281,13 +281,13 @@ void QEQueue_postLIFO(QEQueue * const me, QEvt const * const e,
 * @sa
 * QEQueue_post(), QEQueue_postLIFO(), QActive_recall()
 */
-QEvt const *QEQueue_get(QEQueue * const me, uint_fast8_t const qs_id) {
+QEvt const *QEQueue_get(QEQueue * const me, uint_fast16_t const qs_id) {
     QEvt const *e;
     QF_CRIT_STAT_
 
     (void)qs_id; /* unused parameter (outside Q_SPY build configuration) */
 
-    QF_CRIT_E_();
+    QF_CRIT_OBJ_E_(me);
     e = me->frontEvt; /* always remove the event from the front location */
 
     /* was the queue not empty? */
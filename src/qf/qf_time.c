@@ -52,6 +52,19 @@ Q_DEFINE_THIS_MODULE("qf_time")
 
 /* Package-scope objects ****************************************************/
 QTimeEvt QF_timeEvtHead_[QF_MAX_TICK_RATE]; /* heads of time event lists */
+#ifdef QF_TIMEEVT_WHEEL
+QTimeWheel QF_timeWheel_[QF_MAX_TICK_RATE]; /* timing wheels, see NOTE2 */
+
+static void QF_timeWheelLink_(QTimeWheel * const w, QTimeEvt * const t);
+
+/* the number of clock ticks remaining until the time event expires */
+#define QTimeEvt_ctr_(me_) (((me_)->ctr != 0U)                            \
+    ? (QTimeEvtCtr)((me_)->expiry - QF_timeWheel_[                        \
+          (uint_fast8_t)(me_)->super.refCtr_ & TE_TICK_RATE].now)         \
+    : (QTimeEvtCtr)0U)
+#else
+#define QTimeEvt_ctr_(me_) ((me_)->ctr)
+#endif
 
 /****************************************************************************/
 #ifdef Q_SPY
@@ -79,11 +92,101 @@ void QF_tickX_(uint_fast8_t const tickRate, void const * const sender)
 #else
 void QF_tickX_(uint_fast8_t const tickRate)
 #endif
+#ifdef QF_TIMEEVT_WHEEL
+{
+    QTimeWheel * const w = &QF_timeWheel_[tickRate];
+    uint_fast8_t lev;
+    QF_CRIT_STAT_
+
+    QF_CRIT_OBJ_E_(&QF_timeEvtHead_[tickRate]);
+
+    QS_BEGIN_NOCRIT_PRE_(QS_QF_TICK, 0U)
+        ++QF_timeEvtHead_[tickRate].ctr;
+        QS_TEC_PRE_(QF_timeEvtHead_[tickRate].ctr); /* tick ctr */
+        QS_U8_PRE_(tickRate);   /* tick rate */
+    QS_END_NOCRIT_PRE_()
+
+    ++w->now;
+
+    /* cascade the time events from the slot of every higher level, whose
+    * lower levels have just wrapped around, see NOTE2
+    */
+    for (lev = 1U; lev < QF_TIMEEVT_WHEEL_LEVELS; ++lev) {
+        uint_fast8_t const idx = (uint_fast8_t)(w->now
+            >> ((lev - 1U) * QF_TIMEEVT_WHEEL_BITS))
+            & (QF_TIMEEVT_WHEEL_SLOTS - 1U);
+        QTimeEvt *t;
+
+        if (idx != 0U) { /* the lower level did not wrap around? */
+            break;
+        }
+        t = w->slot[lev][(w->now >> (lev * QF_TIMEEVT_WHEEL_BITS))
+                         & (QF_TIMEEVT_WHEEL_SLOTS - 1U)];
+        w->slot[lev][(w->now >> (lev * QF_TIMEEVT_WHEEL_BITS))
+                     & (QF_TIMEEVT_WHEEL_SLOTS - 1U)] = (QTimeEvt *)0;
+        while (t != (QTimeEvt *)0) {
+            QTimeEvt * const next = t->next;
+            QF_timeWheelLink_(w, t); /* re-link to a lower level */
+            t = next;
+        }
+    }
+
+    /* all time events in the current slot of level 0 expire now... */
+    for (;;) {
+        QTimeEvt * const t =
+            w->slot[0][w->now & (QF_TIMEEVT_WHEEL_SLOTS - 1U)];
+        QActive *act;
+
+        if (t == (QTimeEvt *)0) { /* no more expiring time events? */
+            break;
+        }
+
+        /* sanity check */
+        Q_ASSERT_CRIT_(120, t->expiry == w->now);
+
+        act = (QActive *)t->act; /* temp. for volatile */
+        QF_timeWheelRemove_(t, tickRate);
+
+        /* periodic time evt? */
+        if (t->interval != 0U) {
+            t->ctr = t->interval; /* rearm the time event */
+            QF_timeWheelInsert_(t, tickRate, t->interval);
+        }
+        /* one-shot time event: automatically disarm */
+        else {
+            t->ctr = 0U;
+
+            QS_BEGIN_NOCRIT_PRE_(QS_QF_TIMEEVT_AUTO_DISARM, act->prio)
+                QS_OBJ_PRE_(t);        /* this time event object */
+                QS_OBJ_PRE_(act);      /* the target AO */
+                QS_U8_PRE_(tickRate);  /* tick rate */
+            QS_END_NOCRIT_PRE_()
+        }
+
+        QS_BEGIN_NOCRIT_PRE_(QS_QF_TIMEEVT_POST, act->prio)
+            QS_TIME_PRE_();            /* timestamp */
+            QS_OBJ_PRE_(t);            /* the time event object */
+            QS_SIG_PRE_(t->super.sig); /* signal of this time event */
+            QS_OBJ_PRE_(act);          /* the target AO */
+            QS_U8_PRE_(tickRate);      /* tick rate */
+        QS_END_NOCRIT_PRE_()
+
+        QF_CRIT_X_(); /* exit critical section before posting */
+
+        /* QACTIVE_POST() asserts internally if the queue overflows */
+        QACTIVE_POST(act, &t->super, sender);
+
+        /* re-enter crit. section to continue */
+        QF_CRIT_OBJ_E_(&QF_timeEvtHead_[tickRate]);
+    }
+    QF_CRIT_X_();
+}
+#else /* the linked lists of time events */
 {
     QTimeEvt *prev = &QF_timeEvtHead_[tickRate];
     QF_CRIT_STAT_
 
-    QF_CRIT_E_();
+    QF_CRIT_OBJ_E_(&QF_timeEvtHead_[tickRate]);
 
     QS_BEGIN_NOCRIT_PRE_(QS_QF_TICK, 0U)
         ++prev->ctr;
@@ -170,10 +273,75 @@ void QF_tickX_(uint_fast8_t const tickRate)
                 QF_CRIT_EXIT_NOP();
             }
         }
-        QF_CRIT_E_(); /* re-enter crit. section to continue */
+        /* re-enter crit. section to continue */
+        QF_CRIT_OBJ_E_(&QF_timeEvtHead_[tickRate]);
     }
     QF_CRIT_X_();
 }
+#endif /* QF_TIMEEVT_WHEEL */
+
+#ifdef QF_TIMEEVT_WHEEL
+/****************************************************************************/
+/**
+* @description
+* Inserts the time event into the slot of the timing wheel, in which it
+* expires in @p nTicks clock ticks at the given tick rate.
+*
+* @note
+* This function must be called in the critical section of the tick rate.
+*/
+void QF_timeWheelInsert_(QTimeEvt * const t, uint_fast8_t const tickRate,
+                         QTimeEvtCtr const nTicks)
+{
+    QTimeWheel * const w = &QF_timeWheel_[tickRate];
+
+    t->expiry = (QTimeEvtCtr)(w->now + nTicks);
+    t->super.refCtr_ |= TE_IS_LINKED; /* mark as linked */
+    ++w->nArmed;
+    QF_timeWheelLink_(w, t);
+}
+/*..........................................................................*/
+/**
+* @description
+* Unlinks the time event from its slot of the timing wheel in O(1) time.
+*
+* @note
+* This function must be called in the critical section of the tick rate.
+*/
+void QF_timeWheelRemove_(QTimeEvt * const t, uint_fast8_t const tickRate) {
+    *t->prevNext = t->next;
+    if (t->next != (QTimeEvt *)0) {
+        t->next->prevNext = t->prevNext;
+    }
+    t->next = (QTimeEvt *)0;
+    t->super.refCtr_ &= (uint8_t)(~TE_IS_LINKED & 0xFFU);
+    --QF_timeWheel_[tickRate].nArmed;
+}
+/*..........................................................................*/
+/* link the time event to the slot of the lowest wheel level, which still
+* spans the remaining time until the expiry of the time event
+*/
+static void QF_timeWheelLink_(QTimeWheel * const w, QTimeEvt * const t) {
+    QTimeEvtCtr const delta = (QTimeEvtCtr)(t->expiry - w->now);
+    QTimeEvt * volatile *head;
+    uint_fast8_t lev = 0U;
+
+    while ((lev < (QF_TIMEEVT_WHEEL_LEVELS - 1U))
+           && ((delta >> ((lev + 1U) * QF_TIMEEVT_WHEEL_BITS)) != 0U))
+    {
+        ++lev;
+    }
+    head = &w->slot[lev][(t->expiry >> (lev * QF_TIMEEVT_WHEEL_BITS))
+                         & (QF_TIMEEVT_WHEEL_SLOTS - 1U)];
+
+    t->next = *head;
+    if (t->next != (QTimeEvt *)0) {
+        t->next->prevNext = &t->next;
+    }
+    *head = t;
+    t->prevNext = head;
+}
+#endif /* QF_TIMEEVT_WHEEL */
 
 /*****************************************************************************
 * NOTE1:
@@ -185,6 +353,24 @@ void QF_tickX_(uint_fast8_t const tickRate)
 * The QF_CRIT_EXIT_NOP() macro contains minimal code required
 * to prevent such merging of critical sections in QF ports,
 * in which it can occur.
+*
+* NOTE2:
+* The hierarchical timing wheel (macro QF_TIMEEVT_WHEEL) of every tick rate
+* consists of QF_TIMEEVT_WHEEL_LEVELS levels, each with
+* 2^QF_TIMEEVT_WHEEL_BITS slots. Level 'n' resolves the bits
+* [n*QF_TIMEEVT_WHEEL_BITS...(n+1)*QF_TIMEEVT_WHEEL_BITS-1] of the absolute
+* expiry tick of a time event, and a time event is linked into the lowest
+* level whose range still spans the remaining time to its expiry. The slots
+* of level 0 therefore contain only the time events that expire exactly at
+* the tick, at which the slot is visited.
+*
+* Whenever the index of a level wraps around to zero, the time events in the
+* current slot of the next higher level are cascaded (re-linked) to the lower
+* levels. Every time event is cascaded at most QF_TIMEEVT_WHEEL_LEVELS-1
+* times, so the amortized cost of QF_tickX_() is proportional only to the
+* number of expiring time events. The levels of the wheel together resolve
+* all bits of ::QTimeEvtCtr, so any delay that fits in the ::QTimeEvtCtr
+* counter can be represented.
 */
 
 
@@ -205,6 +391,9 @@ void QF_tickX_(uint_fast8_t const tickRate)
 bool QF_noTimeEvtsActiveX(uint_fast8_t const tickRate) {
     bool inactive;
 
+#ifdef QF_TIMEEVT_WHEEL
+    inactive = (QF_timeWheel_[tickRate].nArmed == 0U);
+#else
     if (QF_timeEvtHead_[tickRate].next != (QTimeEvt *)0) {
         inactive = false;
     }
@@ -214,6 +403,7 @@ bool QF_noTimeEvtsActiveX(uint_fast8_t const tickRate) {
     else {
         inactive = true;
     }
+#endif /* QF_TIMEEVT_WHEEL */
     return inactive;
 }
 
@@ -300,15 +490,17 @@ void QTimeEvt_armX(QTimeEvt * const me,
     uint_fast8_t tickRate = ((uint_fast8_t)me->super.refCtr_ & TE_TICK_RATE);
     QTimeEvtCtr ctr = me->ctr;
 #ifdef Q_SPY
-    uint_fast8_t const qs_id = ((QActive *)(me->act))->prio;
+    uint_fast16_t const qs_id = ((QActive *)(me->act))->prio;
 #endif
     QF_CRIT_STAT_
 
-    /** @pre the host AO must be valid, time evnet must be disarmed,
-    * number of clock ticks cannot be zero, and the signal must be valid.
+    /** @pre the host AO must be valid, time evnet must be disarmed
+    * (also in the tickless mode of the port), number of clock ticks
+    * cannot be zero, and the signal must be valid.
     */
     Q_REQUIRE_ID(400, (me->act != (void *)0)
                  && (ctr == 0U)
+                 && ((me->super.refCtr_ & TE_IS_TICKLESS) == 0U)
                  && (nTicks != 0U)
                  && (tickRate < (uint_fast8_t)QF_MAX_TICK_RATE)
                  && (me->super.sig >= (QSignal)Q_USER_SIG));
@@ -316,10 +508,13 @@ void QTimeEvt_armX(QTimeEvt * const me,
     (void)ctr; /* avoid compiler warning about unused variable */
 #endif
 
-    QF_CRIT_E_();
+    QF_CRIT_OBJ_E_(&QF_timeEvtHead_[tickRate]);
     me->ctr = nTicks;
     me->interval = interval;
 
+#ifdef QF_TIMEEVT_WHEEL
+    QF_timeWheelInsert_(me, tickRate, nTicks); /* O(1), see NOTE2 */
+#else
     /* is the time event unlinked?
     * NOTE: For the duration of a single clock tick of the specified tick
     * rate a time event can be disarmed and yet still linked into the list,
@@ -339,6 +534,7 @@ void QTimeEvt_armX(QTimeEvt * const me,
         me->next = (QTimeEvt *)QF_timeEvtHead_[tickRate].act;
         QF_timeEvtHead_[tickRate].act = me;
     }
+#endif /* QF_TIMEEVT_WHEEL */
 
     QS_BEGIN_NOCRIT_PRE_(QS_QF_TIMEEVT_ARM, qs_id)
         QS_TIME_PRE_();        /* timestamp */
@@ -374,11 +570,15 @@ void QTimeEvt_armX(QTimeEvt * const me,
 bool QTimeEvt_disarm(QTimeEvt * const me) {
     bool wasArmed;
 #ifdef Q_SPY
-    uint_fast8_t const qs_id = ((QActive *)(me->act))->prio;
+    uint_fast16_t const qs_id = ((QActive *)(me->act))->prio;
 #endif
     QF_CRIT_STAT_
 
-    QF_CRIT_E_();
+    QF_CRIT_OBJ_E_(&QF_timeEvtHead_[
+        (uint_fast8_t)me->super.refCtr_ & TE_TICK_RATE]);
+
+    /* the tickless time events must be disarmed by QTimeEvt_disarmNsec() */
+    Q_ASSERT_CRIT_(500, (me->super.refCtr_ & TE_IS_TICKLESS) == 0U);
 
     /* is the time event actually armed? */
     if (me->ctr != 0U) {
@@ -389,11 +589,15 @@ bool QTimeEvt_disarm(QTimeEvt * const me) {
             QS_TIME_PRE_();            /* timestamp */
             QS_OBJ_PRE_(me);           /* this time event object */
             QS_OBJ_PRE_(me->act);      /* the target AO */
-            QS_TEC_PRE_(me->ctr);      /* the number of ticks */
+            QS_TEC_PRE_(QTimeEvt_ctr_(me)); /* the number of ticks */
             QS_TEC_PRE_(me->interval); /* the interval */
             QS_U8_PRE_(me->super.refCtr_ & TE_TICK_RATE);
         QS_END_NOCRIT_PRE_()
 
+#ifdef QF_TIMEEVT_WHEEL
+        QF_timeWheelRemove_(me, (uint_fast8_t)me->super.refCtr_
+                                & TE_TICK_RATE);
+#endif
         me->ctr = 0U;  /* schedule removal from the list */
     }
     else { /* the time event was already disarmed automatically */
@@ -437,20 +641,33 @@ bool QTimeEvt_rearm(QTimeEvt * const me, QTimeEvtCtr const nTicks) {
     uint_fast8_t tickRate = (uint_fast8_t)me->super.refCtr_ & TE_TICK_RATE;
     bool wasArmed;
 #ifdef Q_SPY
-    uint_fast8_t const qs_id = ((QActive *)(me->act))->prio;
+    uint_fast16_t const qs_id = ((QActive *)(me->act))->prio;
 #endif
     QF_CRIT_STAT_
 
     /** @pre AO must be valid, tick rate must be in range, nTicks must not
-    * be zero, and the signal of this time event must be valid
+    * be zero, the time event must not be armed in the tickless mode of the
+    * port, and the signal of this time event must be valid
     */
     Q_REQUIRE_ID(600, (me->act != (void *)0)
                       && (tickRate < QF_MAX_TICK_RATE)
+                      && ((me->super.refCtr_ & TE_IS_TICKLESS) == 0U)
                       && (nTicks != 0U)
                       && (me->super.sig >= (QSignal)Q_USER_SIG));
 
-    QF_CRIT_E_();
+    QF_CRIT_OBJ_E_(&QF_timeEvtHead_[tickRate]);
 
+#ifdef QF_TIMEEVT_WHEEL
+    /* is the time evt running? */
+    if (me->ctr != 0U) {
+        wasArmed = true;
+        QF_timeWheelRemove_(me, tickRate);
+    }
+    else {
+        wasArmed = false;
+    }
+    QF_timeWheelInsert_(me, tickRate, nTicks); /* O(1), see NOTE2 */
+#else
     /* is the time evt not running? */
     if (me->ctr == 0U) {
         wasArmed = false;
@@ -479,6 +696,7 @@ bool QTimeEvt_rearm(QTimeEvt * const me, QTimeEvtCtr const nTicks) {
     else { /* the time event was armed */
         wasArmed = true;
     }
+#endif /* QF_TIMEEVT_WHEEL */
     me->ctr = nTicks; /* re-load the tick counter (shift the phasing) */
 
     QS_BEGIN_NOCRIT_PRE_(QS_QF_TIMEEVT_REARM, qs_id)
@@ -542,8 +760,11 @@ QTimeEvtCtr QTimeEvt_currCtr(QTimeEvt const * const me) {
     QTimeEvtCtr ret;
     QF_CRIT_STAT_
 
-    QF_CRIT_E_();
-    ret = me->ctr;
+    QF_CRIT_OBJ_E_(&QF_timeEvtHead_[
+        (uint_fast8_t)me->super.refCtr_ & TE_TICK_RATE]);
+    /* the tickless time events must be queried by QTimeEvt_currNsec() */
+    Q_ASSERT_CRIT_(700, (me->super.refCtr_ & TE_IS_TICKLESS) == 0U);
+    ret = QTimeEvt_ctr_(me);
     QF_CRIT_X_();
 
     return ret;
@@ -86,6 +86,26 @@
     #define QF_CRIT_X_()     QF_CRIT_EXIT(critStat_)
 #endif
 
+#ifndef QF_CRIT_OBJ_ENTRY
+    /*! This is an internal macro for entering a critical section that
+    * protects only the given object @p obj_. */
+    /**
+    * @description
+    * Ports that protect different QF objects (event queues, event pools,
+    * time event lists, the subscriber table) with different locks define
+    * the macro QF_CRIT_OBJ_ENTRY(stat_, obj_), which enters the critical
+    * section for the object @p obj_ and saves the information needed
+    * to exit it in the status variable @p stat_. The critical section
+    * is exited with the common QF_CRIT_X_().
+    * Otherwise this macro enters the global critical section.
+    */
+    #define QF_CRIT_OBJ_E_(obj_) QF_CRIT_E_()
+#elif (defined QF_CRIT_STAT_TYPE)
+    #define QF_CRIT_OBJ_E_(obj_) QF_CRIT_OBJ_ENTRY(critStat_, (obj_))
+#else
+    #error "QF_CRIT_OBJ_ENTRY() requires QF_CRIT_STAT_TYPE"
+#endif
+
 /****************************************************************************/
 /* Assertions inside the crticial section */
 #ifdef Q_NASSERT /* Q_NASSERT defined--assertion checking disabled */
@@ -116,7 +136,7 @@
 /* internal implementation (should be used via vtable only) */
 
 /*! Implementation of the active object start operation */
-void QActive_start_(QActive * const me, uint_fast8_t prio,
+void QActive_start_(QActive * const me, uint_fast16_t prio,
                     QEvt const * * const qSto, uint_fast16_t const qLen,
                     void * const stkSto, uint_fast16_t const stkSize,
                     void const * const par);
@@ -124,6 +144,18 @@ void QActive_start_(QActive * const me, uint_fast8_t prio,
 /*! Get an event from the event queue of an active object. */
 QEvt const *QActive_get_(QActive *const me);
 
+#ifdef QF_ACTIVE_GET_BATCH
+/*! Get a batch of up to @p max events from the event queue of
+* an active object in one critical section. */
+uint_fast16_t QActive_getBatch_(QActive * const me,
+                                QEvt const * * const batch,
+                                uint_fast16_t const max);
+
+/*! Get the next event to dispatch from the batch of an active object
+* (NULL at the end of the batch). */
+QEvt const *QActive_batchNext_(QActive * const me);
+#endif
+
 #ifdef Q_SPY
     /*! Implementation of the active object post (FIFO) operation */
     bool QActive_post_(QActive * const me, QEvt const * const e,
@@ -137,6 +169,13 @@ QEvt const *QActive_get_(QActive *const me);
 /*! Implementation of the active object post LIFO operation */
 void QActive_postLIFO_(QActive * const me, QEvt const * const e);
 
+/*! true when the active object @p me_ posts with QActive_post_(), that is,
+* uses the event queue of the QF port (the non-polymorphic post operations
+* such as QActive_postBatch_() require it)
+*/
+#define QACTIVE_HAS_QF_POST_(me_) \
+    (((QActiveVtable const *)(me_)->super.vptr)->post == &QActive_post_)
+
 
 /****************************************************************************/
 /*! heads of linked lists of time events, one for every clock tick rate */
@@ -149,8 +188,36 @@ extern QTimeEvt QF_timeEvtHead_[QF_MAX_TICK_RATE];
 */
 #define TE_IS_LINKED      (1U << 7)
 #define TE_WAS_DISARMED   (1U << 6)
+#define TE_IS_TICKLESS    (1U << 5) /* armed by QTimeEvt_armNsec() (ports) */
 #define TE_TICK_RATE      0x0FU
 
+#ifdef QF_TIMEEVT_WHEEL
+/*! the number of levels of the hierarchical timing wheel */
+#define QF_TIMEEVT_WHEEL_LEVELS \
+    ((QF_TIMEEVT_CTR_SIZE * 8U) / QF_TIMEEVT_WHEEL_BITS)
+
+/*! the number of slots in one level of the timing wheel */
+#define QF_TIMEEVT_WHEEL_SLOTS  (1U << QF_TIMEEVT_WHEEL_BITS)
+
+/*! hierarchical timing wheel of the time events at one tick rate */
+typedef struct {
+    /*! heads of the lists of time events in the slots of every level */
+    QTimeEvt * volatile slot[QF_TIMEEVT_WHEEL_LEVELS][QF_TIMEEVT_WHEEL_SLOTS];
+    QTimeEvtCtr now;     /*!< the number of ticks processed (wraps around) */
+    uint_fast16_t nArmed; /*!< the number of armed time events */
+} QTimeWheel;
+
+/*! timing wheels of time events, one for every clock tick rate */
+extern QTimeWheel QF_timeWheel_[QF_MAX_TICK_RATE];
+
+/*! insert the time event @p t to expire in @p nTicks into the wheel */
+void QF_timeWheelInsert_(QTimeEvt * const t, uint_fast8_t const tickRate,
+                         QTimeEvtCtr const nTicks);
+
+/*! remove the time event @p t from the timing wheel */
+void QF_timeWheelRemove_(QTimeEvt * const t, uint_fast8_t const tickRate);
+#endif /* QF_TIMEEVT_WHEEL */
+
 extern QF_EPOOL_TYPE_ QF_pool_[QF_MAX_EPOOL]; /*!< allocate event pools */
 extern uint_fast8_t QF_maxPool_;     /*!< # of initialized event pools */
 extern QSubscrList *QF_subscrList_;  /*!< the subscriber list array */
@@ -161,16 +228,77 @@ typedef struct QFreeBlock {
     struct QFreeBlock * volatile next;
 } QFreeBlock;
 
+#ifdef QF_EVT_MAGAZINE
+/*! allocate up to @p n blocks from the pool @p me in one critical section */
+uint_fast16_t QMPool_getBatch_(QMPool * const me, void * * const blocks,
+                               uint_fast16_t const n,
+                               uint_fast16_t const qs_id);
+
+/*! recycle @p n blocks to the pool @p me in one critical section */
+void QMPool_putBatch_(QMPool * const me, void * const * const blocks,
+                      uint_fast16_t const n, uint_fast16_t const qs_id);
+#endif /* QF_EVT_MAGAZINE */
+
 /* internal helper macros ***************************************************/
 
 /*! helper macro to cast const away from an event pointer @p e_ */
 #define QF_EVT_CONST_CAST_(e_)  ((QEvt *)(e_))
 
+#ifdef QF_EVT_REF_CTR_ATOMIC
+/* The QF port supports atomic operations on the event reference counter,
+* so the reference counting does not need the critical section and
+* QF_gc() does not lock it at all. The port defining this macro must
+* define it for all QF code, because all operations on the counter
+* must be atomic for this to work.
+*/
+#ifndef QF_EVT_REF_CTR_INC_
+#define QF_EVT_REF_CTR_INC_(e_) \
+    (__atomic_add_fetch(&QF_EVT_CONST_CAST_(e_)->refCtr_, 1U, \
+                        __ATOMIC_RELAXED))
+#endif
+#ifndef QF_EVT_REF_CTR_ADD_
+#define QF_EVT_REF_CTR_ADD_(e_, n_) \
+    (__atomic_add_fetch(&QF_EVT_CONST_CAST_(e_)->refCtr_, \
+                        (QEvtRefCtr)(n_), __ATOMIC_RELAXED))
+#endif
+#ifndef QF_EVT_REF_CTR_DEC_
+#define QF_EVT_REF_CTR_DEC_(e_) \
+    (__atomic_sub_fetch(&QF_EVT_CONST_CAST_(e_)->refCtr_, 1U, \
+                        __ATOMIC_ACQ_REL))
+#endif
+#ifndef QF_EVT_REF_CTR_GET_
+#define QF_EVT_REF_CTR_GET_(e_) \
+    (__atomic_load_n(&(e_)->refCtr_, __ATOMIC_ACQUIRE))
+#endif
+#endif /* QF_EVT_REF_CTR_ATOMIC */
+
+#ifndef QF_EVT_REF_CTR_INC_
 /*! increment the refCtr of an event @p e_ casting const away */
+/**
+* @note the QF port can override this macro, e.g., to perform an atomic
+* increment when the event posting does not use the critical section.
+*/
 #define QF_EVT_REF_CTR_INC_(e_) (++QF_EVT_CONST_CAST_(e_)->refCtr_)
+#endif
+
+#ifndef QF_EVT_REF_CTR_ADD_
+/*! add @p n_ to the refCtr of an event @p e_ casting const away */
+#define QF_EVT_REF_CTR_ADD_(e_, n_) \
+    (QF_EVT_CONST_CAST_(e_)->refCtr_ += (QEvtRefCtr)(n_))
+#endif
 
+#ifndef QF_EVT_REF_CTR_DEC_
 /*! decrement the refCtr of an event @p e_ casting const away */
 #define QF_EVT_REF_CTR_DEC_(e_) (--QF_EVT_CONST_CAST_(e_)->refCtr_)
+#endif
+
+#ifndef QF_EVT_REF_CTR_GET_
+/*! read the refCtr of an event @p e_ */
+#define QF_EVT_REF_CTR_GET_(e_) ((e_)->refCtr_)
+#endif
+
+/*! the maximum value of the event reference counter */
+#define QF_EVT_REF_CTR_MAX_     ((QEvtRefCtr)(~(QEvtRefCtr)0U))
 
 /*! access element at index @p i_ from the base pointer @p base_ */
 #define QF_PTR_AT_(base_, i_)   ((base_)[(i_)])
@@ -55,6 +55,14 @@
 
 Q_DEFINE_THIS_MODULE("qk")
 
+/* the number of bits of a priority in the ::QSchedStatus */
+#define QK_PRIO_BITS_  (sizeof(QPrio) * 8U)
+
+/* the mask of a priority in the ::QSchedStatus, which is also the status
+* returned when the scheduler was not locked (no such priority exists)
+*/
+#define QK_PRIO_MASK_  ((QSchedStatus)(QPrio)(~0U))
+
 /* Global-scope objects *****************************************************/
 QK_PrivAttr QK_attr_; /* private attributes of the QK kernel */
 
@@ -76,6 +84,9 @@ void QF_init(void) {
 
     QF_bzero(&QF_timeEvtHead_[0], sizeof(QF_timeEvtHead_));
     QF_bzero(&QF_active_[0],      sizeof(QF_active_));
+#ifdef QF_TIMEEVT_WHEEL
+    QF_bzero(&QF_timeWheel_[0],   sizeof(QF_timeWheel_));
+#endif
     QF_bzero(&QK_attr_,           sizeof(QK_attr_));
 
     QK_attr_.actPrio  = 0U; /* priority of the QK idle loop */
@@ -172,7 +183,7 @@ int_t QF_run(void) {
 * The following example shows starting an AO when a per-task stack is needed:
 * @include qf_start.c
 */
-void QActive_start_(QActive * const me, uint_fast8_t prio,
+void QActive_start_(QActive * const me, uint_fast16_t prio,
                     QEvt const * * const qSto, uint_fast16_t const qLen,
                     void * const stkSto, uint_fast16_t const stkSize,
                     void const * const par)
@@ -191,7 +202,7 @@ void QActive_start_(QActive * const me, uint_fast8_t prio,
 
     QEQueue_init(&me->eQueue, qSto, qLen); /* initialize the built-in queue */
 
-    me->prio = (uint8_t)prio; /* set the QF priority of the AO */
+    me->prio = (QPrio)prio; /* set the QF priority of the AO */
     QF_add_(me); /* make QF aware of this active object */
 
     QHSM_INIT(&me->super, par, me->prio); /* top-most initial tran. */
@@ -227,7 +238,7 @@ void QActive_start_(QActive * const me, uint_fast8_t prio,
 * The following example shows how to lock and unlock the QK scheduler:
 * @include qk_lock.c
 */
-QSchedStatus QK_schedLock(uint_fast8_t ceiling) {
+QSchedStatus QK_schedLock(uint_fast16_t ceiling) {
     QSchedStatus stat;
     QF_CRIT_STAT_
     QF_CRIT_E_();
@@ -239,13 +250,13 @@ QSchedStatus QK_schedLock(uint_fast8_t ceiling) {
 
     /* first store the previous lock prio */
     if (QK_attr_.lockPrio < ceiling) { /* raising lock prio? */
-        stat = ((QSchedStatus)QK_attr_.lockPrio << 8);
-        QK_attr_.lockPrio = (uint8_t)ceiling;
+        stat = ((QSchedStatus)QK_attr_.lockPrio << QK_PRIO_BITS_);
+        QK_attr_.lockPrio = (QPrio)ceiling;
 
         QS_BEGIN_NOCRIT_PRE_(QS_SCHED_LOCK, 0U)
             QS_TIME_PRE_();   /* timestamp */
-            QS_2U8_PRE_(stat, /* the previous lock prio */
-                        QK_attr_.lockPrio); /* the new lock prio */
+            QS_2PRIO_PRE_(stat >> QK_PRIO_BITS_, /* the previous lock prio */
+                          QK_attr_.lockPrio); /* the new lock prio */
         QS_END_NOCRIT_PRE_()
 
         /* add the previous lock holder priority */
@@ -254,7 +265,7 @@ QSchedStatus QK_schedLock(uint_fast8_t ceiling) {
         QK_attr_.lockHolder = QK_attr_.actPrio;
     }
     else {
-       stat = 0xFFU;
+       stat = QK_PRIO_MASK_;
     }
     QF_CRIT_X_();
 
@@ -279,9 +290,9 @@ QSchedStatus QK_schedLock(uint_fast8_t ceiling) {
 */
 void QK_schedUnlock(QSchedStatus stat) {
     /* has the scheduler been actually locked by the last QK_schedLock()? */
-    if (stat != 0xFFU) {
-        uint_fast8_t lockPrio = (uint_fast8_t)QK_attr_.lockPrio;
-        uint_fast8_t prevPrio = (uint_fast8_t)(stat >> 8);
+    if (stat != QK_PRIO_MASK_) {
+        uint_fast16_t lockPrio = (uint_fast16_t)QK_attr_.lockPrio;
+        uint_fast16_t prevPrio = (uint_fast16_t)(stat >> QK_PRIO_BITS_);
         QF_CRIT_STAT_
         QF_CRIT_E_();
 
@@ -294,13 +305,13 @@ void QK_schedUnlock(QSchedStatus stat) {
 
         QS_BEGIN_NOCRIT_PRE_(QS_SCHED_UNLOCK, 0U)
             QS_TIME_PRE_(); /* timestamp */
-            QS_2U8_PRE_(lockPrio,  /* lock prio before unlocking */
-                        prevPrio); /* lock prio after unlocking */
+            QS_2PRIO_PRE_(lockPrio,  /* lock prio before unlocking */
+                          prevPrio); /* lock prio after unlocking */
         QS_END_NOCRIT_PRE_()
 
         /* restore the previous lock priority and lock holder */
-        QK_attr_.lockPrio   = (uint8_t)prevPrio;
-        QK_attr_.lockHolder = (uint8_t)(stat & 0xFFU);
+        QK_attr_.lockPrio   = (QPrio)prevPrio;
+        QK_attr_.lockHolder = (QPrio)(stat & QK_PRIO_MASK_);
 
         /* find the highest-prio thread ready to run */
         if (QK_sched_() != 0U) { /* priority found? */
@@ -326,22 +337,22 @@ void QK_schedUnlock(QSchedStatus stat) {
 * QK_sched_() must be always called with interrupts **disabled** and
 * returns with interrupts **disabled**.
 */
-uint_fast8_t QK_sched_(void) {
-    uint_fast8_t p; /* for priority */
+uint_fast16_t QK_sched_(void) {
+    uint_fast16_t p; /* for priority */
 
     /* find the highest-prio AO with non-empty event queue */
     QPSet_findMax(&QK_attr_.readySet, p);
 
     /* is the highest-prio below the active priority? */
-    if (p <= (uint_fast8_t)QK_attr_.actPrio) {
+    if (p <= (uint_fast16_t)QK_attr_.actPrio) {
         p = 0U; /* no activation needed */
     }
-    else if (p <= (uint_fast8_t)QK_attr_.lockPrio) { /* below the lock prio?*/
+    else if (p <= (uint_fast16_t)QK_attr_.lockPrio) {/* below the lock prio?*/
         p = 0U; /* no activation needed */
     }
     else {
         Q_ASSERT_ID(410, p <= QF_MAX_ACTIVE);
-        QK_attr_.nextPrio = (uint8_t)p; /* next AO to run */
+        QK_attr_.nextPrio = (QPrio)p; /* next AO to run */
     }
     return p;
 }
@@ -357,11 +368,11 @@ uint_fast8_t QK_sched_(void) {
 * interrupts **disabled**.
 */
 void QK_activate_(void) {
-    uint_fast8_t const pin = (uint_fast8_t)QK_attr_.actPrio;  /* save */
-    uint_fast8_t p = (uint_fast8_t)QK_attr_.nextPrio; /* next prio to run */
+    uint_fast16_t const pin = (uint_fast16_t)QK_attr_.actPrio; /* save */
+    uint_fast16_t p = (uint_fast16_t)QK_attr_.nextPrio; /* next to run */
     QActive *a;
 #if (defined QK_ON_CONTEXT_SW) || (defined Q_SPY)
-    uint_fast8_t pprev;
+    uint_fast16_t pprev;
 #endif /* QK_ON_CONTEXT_SW || Q_SPY */
 
     /* QK_attr_.actPrio and QK_attr_.nextPrio must be in ragne */
@@ -379,12 +390,12 @@ void QK_activate_(void) {
     do  {
         QEvt const *e;
         a = QF_active_[p]; /* obtain the pointer to the AO */
-        QK_attr_.actPrio = (uint8_t)p; /* this becomes the active prio */
+        QK_attr_.actPrio = (QPrio)p; /* this becomes the active prio */
 
         QS_BEGIN_NOCRIT_PRE_(QS_SCHED_NEXT, a->prio)
             QS_TIME_PRE_();     /* timestamp */
-            QS_2U8_PRE_(p,      /* priority of the scheduled AO */
-                        pprev); /* previous priority */
+            QS_2PRIO_PRE_(p,      /* priority of the scheduled AO */
+                          pprev); /* previous priority */
         QS_END_NOCRIT_PRE_()
 
 #if (defined QK_ON_CONTEXT_SW) || (defined Q_SPY)
@@ -427,7 +438,7 @@ void QK_activate_(void) {
         if (p <= pin) {
             p = 0U;
         }
-        else if (p <= (uint_fast8_t)QK_attr_.lockPrio) {/* below lock prio? */
+        else if (p <= (uint_fast16_t)QK_attr_.lockPrio) {/*below lock prio?*/
             p = 0U; /* active object not eligible */
         }
         else {
@@ -435,7 +446,7 @@ void QK_activate_(void) {
         }
     } while (p != 0U);
 
-    QK_attr_.actPrio = (uint8_t)pin; /* restore the active priority */
+    QK_attr_.actPrio = (QPrio)pin; /* restore the active priority */
 
 #if (defined QK_ON_CONTEXT_SW) || (defined Q_SPY)
     if (pin != 0U) { /* resuming an active object? */
@@ -443,8 +454,8 @@ void QK_activate_(void) {
 
         QS_BEGIN_NOCRIT_PRE_(QS_SCHED_RESUME, a->prio)
             QS_TIME_PRE_();     /* timestamp */
-            QS_2U8_PRE_(pin,    /* priority of the resumed AO */
-                        pprev); /* previous priority */
+            QS_2PRIO_PRE_(pin,    /* priority of the resumed AO */
+                          pprev); /* previous priority */
         QS_END_NOCRIT_PRE_()
     }
     else {  /* resuming priority==0 --> idle */
@@ -452,7 +463,7 @@ void QK_activate_(void) {
 
         QS_BEGIN_NOCRIT_PRE_(QS_SCHED_IDLE, 0U)
             QS_TIME_PRE_();     /* timestamp */
-            QS_U8_PRE_(pprev);  /* previous priority */
+            QS_PRIO_PRE_(pprev);  /* previous priority */
         QS_END_NOCRIT_PRE_()
     }
 
@@ -163,11 +163,13 @@ void QS_glbFilter_(int_fast16_t const filter) {
                 QS_priv_.glbFilter[1] &= (uint8_t)(~0xFCU & 0xFFU);
                 QS_priv_.glbFilter[2] &= (uint8_t)(~0x07U & 0xFFU);
                 QS_priv_.glbFilter[5] &= (uint8_t)(~0x20U & 0xFFU);
+                QS_priv_.glbFilter[9] &= (uint8_t)(~0x0CU & 0xFFU);
             }
             else {
                 QS_priv_.glbFilter[1] |= 0xFCU;
                 QS_priv_.glbFilter[2] |= 0x07U;
                 QS_priv_.glbFilter[5] |= 0x20U;
+                QS_priv_.glbFilter[9] |= 0x0CU;
             }
             break;
         case QS_EQ_RECORDS:
@@ -184,10 +186,12 @@ void QS_glbFilter_(int_fast16_t const filter) {
             if (isRemove) {
                 QS_priv_.glbFilter[3] &= (uint8_t)(~0x03U & 0xFFU);
                 QS_priv_.glbFilter[5] &= (uint8_t)(~0x80U & 0xFFU);
+                QS_priv_.glbFilter[9] &= (uint8_t)(~0x03U & 0xFFU);
             }
             else {
                 QS_priv_.glbFilter[3] |= 0x03U;
                 QS_priv_.glbFilter[5] |= 0x80U;
+                QS_priv_.glbFilter[9] |= 0x03U;
             }
             break;
         case QS_QF_RECORDS:
@@ -196,12 +200,14 @@ void QS_glbFilter_(int_fast16_t const filter) {
                 QS_priv_.glbFilter[3] &= (uint8_t)(~0xFCU & 0xFFU);
                 QS_priv_.glbFilter[4] &= (uint8_t)(~0xC0U & 0xFFU);
                 QS_priv_.glbFilter[5] &= (uint8_t)(~0x1FU & 0xFFU);
+                QS_priv_.glbFilter[8] &= (uint8_t)(~0x80U & 0xFFU);
             }
             else {
                 QS_priv_.glbFilter[2] |= 0x80U;
                 QS_priv_.glbFilter[3] |= 0xFCU;
                 QS_priv_.glbFilter[4] |= 0xC0U;
                 QS_priv_.glbFilter[5] |= 0x1FU;
+                QS_priv_.glbFilter[8] |= 0x80U;
             }
             break;
         case QS_TE_RECORDS:
@@ -304,7 +310,8 @@ void QS_glbFilter_(int_fast16_t const filter) {
 *
 * @param[in] qs_id  the QS object-id or group to enable in the filter,
 *                 if positive or disable, if negative. The qs_id numbers
-*                 must be in the range 1..127.
+*                 must be in the range 1..127 (with more than 64 AO
+*                 priorities, up to #QS_AP_ID + 31, see ::QSpyIdOffsets).
 * @note
 * Filtering based on the object-id (local filter) is the second layer of
 * filtering. The first layer is based on the QS record-type (gloabl filter).
@@ -313,9 +320,11 @@ void QS_glbFilter_(int_fast16_t const filter) {
 */
 void QS_locFilter_(int_fast16_t const filter) {
     bool isRemove = (filter < 0);
-    uint8_t qs_id = isRemove ? (uint8_t)(-filter) : (uint8_t)filter;
+    uint_fast16_t qs_id = isRemove
+                          ? (uint_fast16_t)(-filter)
+                          : (uint_fast16_t)filter;
     uint8_t tmp = (isRemove ? 0x00U : 0xFFU);
-    uint_fast8_t i;
+    uint_fast16_t i;
     switch (qs_id) {
         case QS_ALL_IDS:
             /* set all global filters (partially unrolled loop) */
@@ -327,7 +336,7 @@ void QS_locFilter_(int_fast16_t const filter) {
             }
             break;
         case QS_AO_IDS:
-            for (i = 0U; i < 8U; i += 4U) {
+            for (i = 0U; i < ((uint_fast16_t)QS_EP_ID >> 3U); i += 4U) {
                 QS_priv_.locFilter[i     ] = tmp;
                 QS_priv_.locFilter[i + 1U] = tmp;
                 QS_priv_.locFilter[i + 2U] = tmp;
@@ -335,19 +344,19 @@ void QS_locFilter_(int_fast16_t const filter) {
             }
             break;
         case QS_EP_IDS:
-            i = 8U;
+            i = ((uint_fast16_t)QS_EP_ID >> 3U);
             QS_priv_.locFilter[i     ] = tmp;
             QS_priv_.locFilter[i + 1U] = tmp;
             break;
         case QS_AP_IDS:
-            i = 12U;
+            i = ((uint_fast16_t)QS_AP_ID >> 3U);
             QS_priv_.locFilter[i     ] = tmp;
             QS_priv_.locFilter[i + 1U] = tmp;
             QS_priv_.locFilter[i + 2U] = tmp;
             QS_priv_.locFilter[i + 3U] = tmp;
             break;
         default:
-            if (qs_id < 0x7FU) {
+            if (qs_id < ((uint_fast16_t)QS_AP_ID + 31U)) {
                 if (isRemove) {
                     QS_priv_.locFilter[qs_id >> 3U]
                         &= (uint8_t)(~(1U << (qs_id & 7U)) & 0xFFU);
@@ -466,7 +475,11 @@ void QS_target_info_pre_(uint8_t isReset) {
         QS_U8_PRE_(QS_TIME_SIZE);
 
         /* send the limits... */
+#if (QF_MAX_ACTIVE <= 255U)
         QS_U8_PRE_(QF_MAX_ACTIVE);
+#else /* the full QF_MAX_ACTIVE follows the build date, see ::QSpyRecords */
+        QS_U8_PRE_(255U);
+#endif
         QS_U8_PRE_(QF_MAX_EPOOL | (QF_MAX_TICK_RATE << 4U));
 
         /* send the build time in three bytes (sec, min, hour)... */
@@ -535,6 +548,11 @@ void QS_target_info_pre_(uint8_t isReset) {
         QS_U8_PRE_(b); /* store the month */
         QS_U8_PRE_((10U * (uint8_t)(DATE[9] - ZERO))
                    + (uint8_t)(DATE[10] - ZERO));
+
+#if (QF_MAX_ACTIVE > 255U)
+        /* trailing extension (16-bit priorities), see ::QSpyRecords */
+        QS_U16_PRE_(QF_MAX_ACTIVE);
+#endif
     QS_endRec_();
 }
 
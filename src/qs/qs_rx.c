@@ -931,9 +931,26 @@ static void QS_rxHandleGoodFrame_(uint8_t state) {
                 QS_priv_.glbFilter[15] &= 0x1FU;
             }
             else if (l_rx.var.flt.recId == (uint8_t)QS_RX_LOC_FILTER) {
+#if (QF_MAX_ACTIVE <= 64U)
                 for (i = 0U; i < Q_DIM(QS_priv_.locFilter); ++i) {
                     QS_priv_.locFilter[i] = l_rx.var.flt.data[i];
                 }
+#else
+                /* the received filter has the layout for 64 AO priorities
+                * (EP IDs from 64, EQ IDs from 80, AP IDs from 96), which
+                * is mapped to the relocated IDs (see ::QSpyIdOffsets).
+                * The AOs above 64 are filtered with QS_RX_AO_FILTER.
+                */
+                for (i = 0U; i < 8U; ++i) {
+                    QS_priv_.locFilter[i] = l_rx.var.flt.data[i];
+                }
+                for (i = 0U; i < 4U; ++i) {
+                    QS_priv_.locFilter[((uint_fast16_t)QS_EP_ID >> 3U) + i]
+                        = l_rx.var.flt.data[8U + i];
+                    QS_priv_.locFilter[((uint_fast16_t)QS_AP_ID >> 3U) + i]
+                        = l_rx.var.flt.data[12U + i];
+                }
+#endif
                 /* leave QS_ID == 0 always on */
                 QS_priv_.locFilter[0] |= 0x01U;
             }
@@ -1041,7 +1058,11 @@ static void QS_rxHandleGoodFrame_(uint8_t state) {
             if (l_rx.var.evt.prio == 0U) { /* publish */
                 QF_PUBLISH(l_rx.var.evt.e, &QS_rxPriv_);
             }
+#if (QF_MAX_ACTIVE < 255U)
             else if (l_rx.var.evt.prio < QF_MAX_ACTIVE) {
+#else /* the 8-bit prio from QSPY reaches only AOs below the special 255 */
+            else if (l_rx.var.evt.prio < 255U) {
+#endif
                 if (QACTIVE_POST_X(QF_active_[l_rx.var.evt.prio],
                                l_rx.var.evt.e,
                                0U, /* margin */
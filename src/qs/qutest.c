@@ -89,7 +89,7 @@ int_t QF_run(void) {
 }
 
 /*..........................................................................*/
-void QActive_start_(QActive * const me, uint_fast8_t prio,
+void QActive_start_(QActive * const me, uint_fast16_t prio,
                     QEvt const * * const qSto, uint_fast16_t const qLen,
                     void * const stkSto, uint_fast16_t const stkSize,
                     void const * const par)
@@ -101,7 +101,7 @@ void QActive_start_(QActive * const me, uint_fast8_t prio,
     (void)stkSize;
 
     QEQueue_init(&me->eQueue, qSto, qLen); /* initialize the built-in queue */
-    me->prio = (uint8_t)prio; /* set the current priority of the AO */
+    me->prio = (QPrio)prio; /* set the current priority of the AO */
 
     QF_add_(me); /* make QF aware of this active object */
 
@@ -110,13 +110,13 @@ void QActive_start_(QActive * const me, uint_fast8_t prio,
 
 /****************************************************************************/
 static void QActiveDummy_init_(QHsm * const me, void const * const par,
-                               uint_fast8_t const qs_id);
+                               uint_fast16_t const qs_id);
 static void QActiveDummy_dispatch_(QHsm * const me, QEvt const * const e,
-                               uint_fast8_t const qs_id);
+                               uint_fast16_t const qs_id);
 static bool QActiveDummy_post_(QActive * const me, QEvt const * const e,
                    uint_fast16_t const margin, void const * const sender);
 static void QActiveDummy_postLIFO_(QActive * const me, QEvt const * const e);
-static void QActiveDummy_start_(QActive * const me, uint_fast8_t prio,
+static void QActiveDummy_start_(QActive * const me, uint_fast16_t prio,
                                 QEvt const * * const qSto, uint_fast16_t qLen,
                                 void *stkSto, uint_fast16_t stkSize,
                                 void const * const par);
@@ -135,7 +135,7 @@ void QActiveDummy_ctor(QActiveDummy * const me) {
     me->super.super.vptr = &vtable.super;      /* hook the vptr */
 }
 /*..........................................................................*/
-static void QActiveDummy_start_(QActive * const me, uint_fast8_t prio,
+static void QActiveDummy_start_(QActive * const me, uint_fast16_t prio,
                                 QEvt const * * const qSto, uint_fast16_t qLen,
                                 void *stkSto, uint_fast16_t stkSize,
                                 void const * const par)
@@ -148,7 +148,7 @@ static void QActiveDummy_start_(QActive * const me, uint_fast8_t prio,
     (void)stkSto;  /* unusuded parameter */
     (void)stkSize; /* unusuded parameter */
 
-    me->prio = (uint8_t)prio; /* set the current priority of the AO */
+    me->prio = (QPrio)prio; /* set the current priority of the AO */
 
     QF_add_(me); /* make QF aware of this active object */
 
@@ -165,7 +165,7 @@ void QActive_stop(QActive * const me) {
 
 /*..........................................................................*/
 static void QActiveDummy_init_(QHsm * const me, void const * const par,
-                               uint_fast8_t const qs_id)
+                               uint_fast16_t const qs_id)
 {
     QS_CRIT_STAT_
 
@@ -180,7 +180,7 @@ static void QActiveDummy_init_(QHsm * const me, void const * const par,
 }
 /*..........................................................................*/
 static void QActiveDummy_dispatch_(QHsm * const me, QEvt const * const e,
-                                   uint_fast8_t const qs_id)
+                                   uint_fast16_t const qs_id)
 {
     QS_CRIT_STAT_
 
@@ -235,9 +235,7 @@ static bool QActiveDummy_post_(QActive * const me, QEvt const * const e,
     * as producing the #QS_QF_ACTIVE_POST trace record, which are:
     * the local filter for this AO ('me->prio') is set
     */
-    if ((QS_priv_.locFilter[me->prio >> 3U]
-         & (1U << (me->prio & 7U))) != 0U)
-    {
+    if (QS_LOC_CHECK_(me->prio)) {
         QS_onTestPost(sender, me, e, status);
     }
     QF_CRIT_X_();
@@ -298,9 +296,12 @@ void QS_processTestEvts_(void) {
     QS_TEST_PROBE(return;)
 
     while (QPSet_notEmpty(&QS_rxPriv_.readySet)) {
+#ifdef QF_ACTIVE_GET_BATCH
+        QEvt const *batch[QF_ACTIVE_GET_BATCH];
+#endif
         QEvt const *e;
         QActive *a;
-        uint_fast8_t p;
+        uint_fast16_t p;
 
         QPSet_findMax(&QS_rxPriv_.readySet, p);
         a = QF_active_[p];
@@ -311,9 +312,20 @@ void QS_processTestEvts_(void) {
         * 2. dispatch the event to the AO's state machine.
         * 3. determine if event is garbage and collect it if so
         */
+#ifdef QF_ACTIVE_GET_BATCH /* batched RTC steps, as in the target port */
+        (void)QActive_getBatch_(a, batch, Q_DIM(batch));
+        for (e = QActive_batchNext_(a);
+             e != (QEvt *)0;
+             e = QActive_batchNext_(a))
+        {
+            QHSM_DISPATCH(&a->super, e, a->prio);
+            QF_gc(e);
+        }
+#else
         e = QActive_get_(a);
         QHSM_DISPATCH(&a->super, e, a->prio);
         QF_gc(e);
+#endif
 
         if (a->eQueue.frontEvt == (QEvt *)0) { /* empty queue? */
             QPSet_remove(&QS_rxPriv_.readySet, p);
@@ -353,9 +365,15 @@ void QS_tickX_(uint_fast8_t const tickRate, void const * const sender) {
         /* the recipient AO must be provided */
         Q_ASSERT_ID(820, act != (QActive *)0);
 
+#ifdef QF_TIMEEVT_WHEEL
+        QF_timeWheelRemove_(t, tickRate);
+#endif
         /* periodic time evt? */
         if (t->interval != 0U) {
             t->ctr = t->interval; /* rearm the time event */
+#ifdef QF_TIMEEVT_WHEEL
+            QF_timeWheelInsert_(t, tickRate, t->interval);
+#endif
         }
         else { /* one-shot time event: automatically disarm */
             t->ctr = 0U; /* auto-disarm */
@@ -384,6 +402,7 @@ void QS_tickX_(uint_fast8_t const tickRate, void const * const sender) {
         QF_CRIT_E_();
     }
 
+#ifndef QF_TIMEEVT_WHEEL /* the wheel has no disarmed time events */
     /* update the linked list of time events */
     for (;;) {
         t = prev->next;  /* advance down the time evt. list */
@@ -425,6 +444,7 @@ void QS_tickX_(uint_fast8_t const tickRate, void const * const sender) {
         }
         QF_CRIT_E_(); /* re-enter crit. section to continue */
     }
+#endif /* QF_TIMEEVT_WHEEL */
 
     QF_CRIT_X_();
 }
@@ -97,6 +97,23 @@
 /*! Internal QS macro to output a predefined uint32_t data element */
 #define QS_U32_PRE_(data_)      (QS_u32_raw_((uint32_t)(data_)))
 
+#if (QF_MAX_ACTIVE <= 255U)
+    /*! Internal QS macro to output a predefined priority data element */
+    /**
+    * @note the size of the priority depends on the macro #QF_MAX_ACTIVE
+    * (8-bit up to 255U, 16-bit above, see ::QSpyRecords).
+    */
+    #define QS_PRIO_PRE_(prio_) (QS_u8_raw_((uint8_t)(prio_)))
+
+    /*! Internal QS macro to output 2 predefined priority data elements */
+    #define QS_2PRIO_PRE_(prio1_, prio2_) \
+        (QS_2u8_raw_((uint8_t)(prio1_), (uint8_t)(prio2_)))
+#else
+    #define QS_PRIO_PRE_(prio_) (QS_u16_raw_((uint16_t)(prio_)))
+    #define QS_2PRIO_PRE_(prio1_, prio2_) \
+        (QS_u16_raw_((uint16_t)(prio1_)), QS_u16_raw_((uint16_t)(prio2_)))
+#endif
+
 /*! Internal QS macro to output a predefined zero-terminated string element */
 #define QS_STR_PRE_(msg_)       (QS_str_raw_((msg_)))
 
@@ -77,6 +77,9 @@ void QF_init(void) {
 
     QF_bzero(&QF_timeEvtHead_[0], sizeof(QF_timeEvtHead_));
     QF_bzero(&QF_active_[0],      sizeof(QF_active_));
+#ifdef QF_TIMEEVT_WHEEL
+    QF_bzero(&QF_timeWheel_[0],   sizeof(QF_timeWheel_));
+#endif
     QF_bzero(&QV_readySet_,       sizeof(QV_readySet_));
 
 #ifdef QV_INIT
@@ -116,7 +119,7 @@ void QF_stop(void) {
 */
 int_t QF_run(void) {
 #ifdef Q_SPY
-    uint_fast8_t pprev = 0U; /* previously used priority */
+    uint_fast16_t pprev = 0U; /* previously used priority */
 #endif
 
     QF_onStartup(); /* application-specific startup callback */
@@ -131,7 +134,7 @@ int_t QF_run(void) {
     for (;;) {
         QEvt const *e;
         QActive *a;
-        uint_fast8_t p;
+        uint_fast16_t p;
 
         /* find the maximum priority AO ready to run */
         if (QPSet_notEmpty(&QV_readySet_)) {
@@ -141,8 +144,8 @@ int_t QF_run(void) {
 #ifdef Q_SPY
             QS_BEGIN_NOCRIT_PRE_(QS_SCHED_NEXT, a->prio)
                 QS_TIME_PRE_();     /* timestamp */
-                QS_2U8_PRE_(p,      /* priority of the scheduled AO */
-                            pprev); /* previous priority */
+                QS_2PRIO_PRE_(p,      /* priority of the scheduled AO */
+                              pprev); /* previous priority */
             QS_END_NOCRIT_PRE_()
 
             pprev = p; /* update previous priority */
@@ -171,7 +174,7 @@ int_t QF_run(void) {
             if (pprev != 0U) {
                 QS_BEGIN_NOCRIT_PRE_(QS_SCHED_IDLE, 0U)
                     QS_TIME_PRE_();    /* timestamp */
-                    QS_U8_PRE_(pprev); /* previous priority */
+                    QS_PRIO_PRE_(pprev); /* previous priority */
                 QS_END_NOCRIT_PRE_()
 
                 pprev = 0U; /* update previous priority */
@@ -217,7 +220,7 @@ int_t QF_run(void) {
 * The following example shows starting an AO when a per-task stack is needed:
 * @include qf_start.c
 */
-void QActive_start_(QActive * const me, uint_fast8_t prio,
+void QActive_start_(QActive * const me, uint_fast16_t prio,
                     QEvt const * * const qSto, uint_fast16_t const qLen,
                     void * const stkSto, uint_fast16_t const stkSize,
                     void const * const par)
@@ -231,7 +234,7 @@ void QActive_start_(QActive * const me, uint_fast8_t prio,
                       && (stkSto == (void *)0));
 
     QEQueue_init(&me->eQueue, qSto, qLen); /* initialize the built-in queue */
-    me->prio = (uint8_t)prio; /* set the current priority of the AO */
+    me->prio = (QPrio)prio; /* set the current priority of the AO */
     QF_add_(me); /* make QF aware of this active object */
 
     QHSM_INIT(&me->super, par, me->prio); /* top-most initial tran. */
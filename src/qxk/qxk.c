@@ -79,6 +79,9 @@ void QF_init(void) {
 
     QF_bzero(&QF_timeEvtHead_[0], sizeof(QF_timeEvtHead_));
     QF_bzero(&QF_active_[0],      sizeof(QF_active_));
+#ifdef QF_TIMEEVT_WHEEL
+    QF_bzero(&QF_timeWheel_[0],   sizeof(QF_timeWheel_));
+#endif
     QF_bzero(&QXK_attr_,          sizeof(QXK_attr_));
     QF_bzero(&l_idleThread,       sizeof(l_idleThread));
 
@@ -181,7 +184,7 @@ int_t QF_run(void) {
 * The following example shows starting an AO when a per-task stack is needed:
 * @include qf_start.c
 */
-void QActive_start_(QActive * const me, uint_fast8_t prio,
+void QActive_start_(QActive * const me, uint_fast16_t prio,
                     QEvt const * * const qSto, uint_fast16_t const qLen,
                     void * const stkSto, uint_fast16_t const stkSize,
                     void const * const par)
@@ -76,14 +76,14 @@ Q_DEFINE_THIS_MODULE("qxk_xthr")
                     uint_fast16_t const margin);
 #else
     static void QXThread_init_(QHsm * const me, void const * const par,
-                    uint_fast8_t const qs_id);
+                    uint_fast16_t const qs_id);
     static void QXThread_dispatch_(QHsm * const me, QEvt const * const e,
-                    uint_fast8_t const qs_id);
+                    uint_fast16_t const qs_id);
     static bool QXThread_post_(QActive * const me, QEvt const * const e,
                     uint_fast16_t const margin, void const * const sender);
 #endif
 static void QXThread_postLIFO_(QActive * const me, QEvt const * const e);
-static void QXThread_start_(QActive * const me, uint_fast8_t prio,
+static void QXThread_start_(QActive * const me, uint_fast16_t prio,
                     QEvt const * * const qSto, uint_fast16_t const qLen,
                     void * const stkSto, uint_fast16_t const stkSize,
                     void const * const par);
@@ -138,7 +138,7 @@ void QXThread_ctor(QXThread * const me,
 static void QXThread_init_(QHsm * const me, void const * const par)
 #else
 static void QXThread_init_(QHsm * const me, void const * const par,
-                           uint_fast8_t const qs_id)
+                           uint_fast16_t const qs_id)
 #endif
 {
     (void)me; /* unused parameter */
@@ -154,7 +154,7 @@ static void QXThread_init_(QHsm * const me, void const * const par,
 static void QXThread_dispatch_(QHsm * const me, QEvt const * const e)
 #else
 static void QXThread_dispatch_(QHsm * const me, QEvt const * const e,
-                               uint_fast8_t const qs_id)
+                               uint_fast16_t const qs_id)
 #endif
 {
     (void)me; /* unused parameter */
@@ -190,7 +190,7 @@ static void QXThread_dispatch_(QHsm * const me, QEvt const * const e,
 * The following example shows starting an extended thread:
 * @include qxk_start.c
 */
-static void QXThread_start_(QActive * const me, uint_fast8_t prio,
+static void QXThread_start_(QActive * const me, uint_fast16_t prio,
                         QEvt const * * const qSto, uint_fast16_t const qLen,
                         void * const stkSto, uint_fast16_t const stkSize,
                         void const * const par)
@@ -591,6 +591,11 @@ void QXThread_teArm_(QXThread * const me, QSignal sig,
         me->timeEvt.ctr = (QTimeEvtCtr)nTicks;
         me->timeEvt.interval = 0U;
 
+#ifdef QF_TIMEEVT_WHEEL
+        QF_timeWheelInsert_(&me->timeEvt,
+            (uint_fast8_t)me->timeEvt.super.refCtr_ & TE_TICK_RATE,
+            (QTimeEvtCtr)nTicks);
+#else
         /* is the time event unlinked?
         * NOTE: For the duration of a single clock tick of the specified tick
         * rate a time event can be disarmed and yet still linked in the list,
@@ -614,6 +619,7 @@ void QXThread_teArm_(QXThread * const me, QSignal sig,
                 = QXK_PTR_CAST_(QTimeEvt*, QF_timeEvtHead_[tickRate].act);
             QF_timeEvtHead_[tickRate].act = &me->timeEvt;
         }
+#endif /* QF_TIMEEVT_WHEEL */
     }
 }
 
@@ -630,6 +636,10 @@ bool QXThread_teDisarm_(QXThread * const me) {
     /* is the time evt running? */
     if (me->timeEvt.ctr != 0U) {
         wasArmed = true;
+#ifdef QF_TIMEEVT_WHEEL
+        QF_timeWheelRemove_(&me->timeEvt,
+            (uint_fast8_t)me->timeEvt.super.refCtr_ & TE_TICK_RATE);
+#endif
         me->timeEvt.ctr = 0U; /* schedule removal from list */
     }
     /* the time event was already automatically disarmed */